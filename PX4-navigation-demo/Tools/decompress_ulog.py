@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+
+""" Convert compressed ULog files (.ulgz) written with SDLOG_COMPRESS enabled to regular ULog files (.ulg) """
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b'ULogCmp'
+HEADER_SIZE = 10
+FRAME_HEADER_SIZE = 4
+
+
+class BitReader:
+    def __init__(self, data):
+        self.data = data
+        self.bit_index = 0
+
+    def remaining(self):
+        return len(self.data) * 8 - self.bit_index
+
+    def read(self, count):
+        value = 0
+        for _ in range(count):
+            byte = self.data[self.bit_index >> 3]
+            value = (value << 1) | ((byte >> (7 - (self.bit_index & 7))) & 1)
+            self.bit_index += 1
+        return value
+
+
+def heatshrink_decode(data, uncompressed_size, window_bits, lookahead_bits):
+    """ Decode a heatshrink stream (see src/lib/heatshrink/heatshrink_encode.py for the encoder) """
+    bits = BitReader(data)
+    output = bytearray()
+
+    while len(output) < uncompressed_size:
+        if bits.remaining() < 1:
+            break
+        if bits.read(1):
+            if bits.remaining() < 8:
+                break
+            output.append(bits.read(8))
+        else:
+            if bits.remaining() < window_bits + lookahead_bits:
+                break
+            index = bits.read(window_bits) + 1
+            count = bits.read(lookahead_bits) + 1
+            for _ in range(count):
+                # the window starts zero-filled, so references may reach before the start of the frame
+                output.append(output[-index] if index <= len(output) else 0)
+
+    if len(output) != uncompressed_size:
+        raise ValueError('frame decodes to {:} instead of {:} bytes'.format(len(output), uncompressed_size))
+    return output
+
+
+def decompress(data):
+    """ Decompress the content of a compressed log file, a truncated last frame is ignored """
+    if not data.startswith(MAGIC) or len(data) < HEADER_SIZE:
+        raise ValueError('not a compressed ULog file')
+
+    version, window_bits, lookahead_bits = struct.unpack_from('<BBB', data, len(MAGIC))
+    if version != 1:
+        raise ValueError('unsupported version {:}'.format(version))
+
+    output = bytearray()
+    offset = HEADER_SIZE
+
+    while offset + FRAME_HEADER_SIZE <= len(data):
+        compressed_size, uncompressed_size = struct.unpack_from('<HH', data, offset)
+        offset += FRAME_HEADER_SIZE
+        if offset + compressed_size > len(data):
+            break
+        frame = data[offset:offset + compressed_size]
+        if compressed_size == uncompressed_size:
+            output += frame
+        else:
+            output += heatshrink_decode(frame, uncompressed_size, window_bits, lookahead_bits)
+        offset += compressed_size
+
+    return output
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('files', metavar='file', nargs='+', help='compressed log file (output: file with .ulg extension)')
+    args = parser.parse_args()
+
+    result = 0
+    for file_name in args.files:
+        with open(file_name, 'rb') as f:
+            data = f.read()
+
+        try:
+            output = decompress(data)
+        except ValueError as e:
+            print('{:}: {:}'.format(file_name, e))
+            result = 1
+            continue
+
+        output_name = os.path.splitext(file_name)[0] + '.ulg'
+        with open(output_name, 'wb') as f:
+            f.write(output)
+
+        print('{:} ({:.2f}x)'.format(output_name, len(output) / len(data)))
+
+    return result
+
+
+if __name__ == '__main__':
+    sys.exit(main())
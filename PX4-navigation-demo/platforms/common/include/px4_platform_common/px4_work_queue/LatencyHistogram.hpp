@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace px4
+{
+
+/**
+ * Compact histogram of latencies in microseconds, with logarithmic buckets.
+ *
+ * Bucket 0 counts 0 us, bucket i counts [2^(i-1), 2^i) us and the last bucket everything above.
+ * Once a bucket saturates all counts are halved, so older samples fade out.
+ */
+class LatencyHistogram
+{
+public:
+	static constexpr int NUM_BUCKETS = 16;
+
+	void record(uint32_t latency_us)
+	{
+		int bucket = (latency_us == 0) ? 0 : (32 - __builtin_clz(latency_us));
+
+		if (bucket >= NUM_BUCKETS) {
+			bucket = NUM_BUCKETS - 1;
+		}
+
+		if (_buckets[bucket] == UINT16_MAX) {
+			for (uint16_t &count : _buckets) {
+				count /= 2;
+			}
+		}
+
+		_buckets[bucket]++;
+
+		if (latency_us > _max) {
+			_max = latency_us;
+		}
+	}
+
+	void reset() { *this = LatencyHistogram{}; }
+
+	uint32_t count() const
+	{
+		uint32_t total = 0;
+
+		for (uint16_t count : _buckets) {
+			total += count;
+		}
+
+		return total;
+	}
+
+	/**
+	 * Latency that the given fraction of the samples does not exceed.
+	 *
+	 * This is the upper end of the bucket the percentile falls into, so it overestimates
+	 * by less than a factor of 2, but never exceeds the maximum.
+	 *
+	 * @param fraction	0 to 1, e.g. 0.99 for the 99th percentile
+	 */
+	uint32_t percentile(float fraction) const
+	{
+		const uint32_t total = count();
+
+		if (total == 0) {
+			return 0;
+		}
+
+		// rank of the sample, rounded up
+		uint32_t rank = static_cast<uint32_t>(fraction * total);
+
+		if (rank < 1 || (float)rank < fraction * total) {
+			rank++;
+		}
+
+		uint32_t cumulative = 0;
+
+		for (int i = 0; i < NUM_BUCKETS - 1; i++) {
+			cumulative += _buckets[i];
+
+			if (cumulative >= rank) {
+				const uint32_t upper = (i == 0) ? 0 : ((1u << i) - 1);
+				return (upper < _max) ? upper : _max;
+			}
+		}
+
+		return _max;
+	}
+
+	uint32_t max() const { return _max; }
+
+private:
+	uint16_t _buckets[NUM_BUCKETS] {};
+	uint32_t _max{0};
+};
+
+} // namespace px4
@@ -108,7 +108,7 @@ protected:
 		}
 	}
 
-	friend void WorkQueue::Run();
+	friend class WorkQueue;
 	virtual void Run() = 0;
 
 	/**
@@ -122,6 +122,11 @@ protected:
 	bool Init(const wq_config_t &config);
 	void Deinit();
 
+	/**
+	 * Print the scheduling latency (and reset it), completing the line of print_run_status().
+	 */
+	void print_latency();
+
 	float elapsed_time() const;
 	float average_rate() const;
 	float average_interval() const;
@@ -134,6 +139,11 @@ private:
 
 	WorkQueue	*_wq{nullptr};
 
+	// protected by the work queue lock
+	hrt_abstime		_time_queued{0};
+	LatencyHistogram	_wait_latency{};
+	LatencyHistogram	_run_latency{};
+
 };
 
 } // namespace px4
@@ -33,11 +33,13 @@
 
 #pragma once
 
+#include "LatencyHistogram.hpp"
 #include "WorkQueueManager.hpp"
 
 #include <containers/BlockingList.hpp>
 #include <containers/List.hpp>
 #include <containers/IntrusiveQueue.hpp>
+#include <drivers/drv_hrt.h>
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/sem.h>
@@ -69,10 +71,46 @@ public:
 
 	void Run();
 
+#if defined(PX4_WQ_EXECUTOR)
+	/**
+	 * Take over the run token on a shared executor thread and drain the backlog of queued WorkItems.
+	 * While the work queue thread holds the token this waits until it hands over at the next WorkItem boundary.
+	 * Only call between AcquireExecutor() and ReleaseExecutor().
+	 *
+	 * @param runner The executor thread (1 to CONFIG_WQ_EXECUTOR_THREADS).
+	 * @return true if the work queue was taken over
+	 */
+	bool RunStolen(int runner);
+
+	// keep the work queue alive while an executor thread uses it
+	void AcquireExecutor() { _executor_refs.fetch_add(1); }
+	void ReleaseExecutor() { _executor_refs.fetch_sub(1); }
+
+	/**
+	 * Check if an executor thread may take over this queue right now.
+	 */
+	bool HasStealableWork();
+
+	/**
+	 * Number of WorkItem runs on executor threads since the last print_status().
+	 */
+	uint32_t stolen_count();
+#endif // PX4_WQ_EXECUTOR
+
 	void request_stop() { _should_exit.store(true); }
 
 	void print_status(bool last = false);
 
+	/**
+	 * Copy the scheduling latency of the work queue or one of its WorkItems and reset it, see WorkQueueLatency().
+	 */
+	bool GetLatency(int entry_index, wq_latency_t &latency);
+
+	/**
+	 * Copy the scheduling latency of one WorkItem, without resetting it.
+	 */
+	void GetItemLatency(WorkItem *item, LatencyHistogram &wait, LatencyHistogram &run);
+
 	// WorkQueues sorted numerically by relative priority (-1 to -255)
 	bool operator<=(const WorkQueue &rhs) const { return _config.relative_priority >= rhs.get_config().relative_priority; }
 
@@ -82,6 +120,26 @@ private:
 
 	inline void SignalWorkerThread();
 
+	/**
+	 * Pop the next WorkItem to run and account its wait since it was scheduled.
+	 * Needs work_lock().
+	 *
+	 * @param runner The thread running the WorkItem, 0 for the work queue thread.
+	 */
+	WorkItem *PopRunnable(int runner);
+
+	/**
+	 * Account the duration of a WorkItem run started with PopRunnable(). Needs work_lock().
+	 */
+	void FinishRun(int runner, WorkItem *work, hrt_abstime time_started);
+
+#if defined(PX4_WQ_EXECUTOR)
+	/**
+	 * Check if WorkItems queue up behind the thread that should run them. Needs work_lock().
+	 */
+	bool Backlogged() const;
+#endif // PX4_WQ_EXECUTOR
+
 #ifdef __PX4_NUTTX
 	// In NuttX work can be enqueued from an ISR
 	void work_lock() { _flags = enter_critical_section(); }
@@ -101,6 +159,35 @@ private:
 	BlockingList<WorkItem *>	_work_items;
 	px4::atomic_bool		_should_exit{false};
 
+	// scheduling latency of all WorkItems
+	LatencyHistogram		_wait_latency{};
+	LatencyHistogram		_run_latency{};
+
+#if defined(PX4_WQ_EXECUTOR)
+	static constexpr int		MAX_RUNNERS{1 + CONFIG_WQ_EXECUTOR_THREADS};
+#else
+	static constexpr int		MAX_RUNNERS{1};
+#endif // PX4_WQ_EXECUTOR
+
+	// per thread, cleared on Detach() (item destruction), otherwise only compared, never dereferenced
+	WorkItem			*_running[MAX_RUNNERS] {};
+
+#if defined(PX4_WQ_EXECUTOR)
+	const bool			_stealable;
+	uint32_t			_stolen_count{0};
+
+	// thread draining _q, only the holder runs WorkItems: RUN_TOKEN_FREE, 0 (work queue thread) or an executor thread
+	static constexpr int		RUN_TOKEN_FREE{-1};
+	int				_run_token{RUN_TOKEN_FREE};
+
+	// an executor thread waits on _handoff_lock for the work queue thread to hand over the run token
+	bool				_handoff_requested{false};
+	int				_handoff_runner{RUN_TOKEN_FREE};
+	px4_sem_t			_handoff_lock;
+
+	px4::atomic_int			_executor_refs{0};
+#endif // PX4_WQ_EXECUTOR
+
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	int _lockstep_component {-1};
 #endif // ENABLE_LOCKSTEP_SCHEDULER
@@ -36,6 +36,13 @@
 #include <stdint.h>
 #include <px4_boardconfig.h>
 
+#include "LatencyHistogram.hpp"
+
+#if defined(CONFIG_WQ_EXECUTOR) && defined(__PX4_POSIX) && !defined(ENABLE_LOCKSTEP_SCHEDULER)
+// shared executor threads taking over busy work queues
+#define PX4_WQ_EXECUTOR
+#endif
+
 namespace px4
 {
 
@@ -47,6 +54,13 @@ struct wq_config_t {
 	int8_t relative_priority; // relative to max
 };
 
+struct wq_latency_t {
+	const char *wq_name;
+	const char *item_name; // nullptr for the whole work queue
+	LatencyHistogram wait; // from ScheduleNow() to Run() (us)
+	LatencyHistogram run;  // duration of Run() (us)
+};
+
 namespace wq_configurations
 {
 // All values are now configured via KConfig options.
@@ -96,6 +110,7 @@ static constexpr wq_config_t lp_default{"wq:lp_default", CONFIG_WQ_LP_DEFAULT_ST
 
 static constexpr wq_config_t test1{"wq:test1", 2000, 0};
 static constexpr wq_config_t test2{"wq:test2", 2000, 0};
+static constexpr wq_config_t test3{"wq:test3", 2000, -100}; // below the shared executor (CONFIG_WQ_EXECUTOR)
 
 
 } // namespace wq_configurations
@@ -141,5 +156,25 @@ const wq_config_t &serial_port_to_wq(const char *serial);
 
 const wq_config_t &ins_instance_to_wq(uint8_t instance);
 
+/**
+ * Scheduling latency of a work queue or one of its WorkItems, accumulated since the previous call for the same entry.
+ *
+ * The latency is reset by this call only, so there must be a single caller (load_mon). `work_queue status`
+ * shows the same histograms without resetting them.
+ *
+ * @param wq_index		Index of the work queue, in order of priority.
+ * @param entry_index		0 for the work queue itself, 1 and up for its WorkItems.
+ * @param latency		The latency.
+ * @return		false if there is no such work queue or WorkItem.
+ */
+bool WorkQueueLatency(int wq_index, int entry_index, wq_latency_t &latency);
+
+#if defined(PX4_WQ_EXECUTOR)
+/**
+ * Wake a shared executor thread to take over a busy work queue.
+ */
+void WorkQueueExecutorSignal();
+#endif // PX4_WQ_EXECUTOR
+
 
 } // namespace px4
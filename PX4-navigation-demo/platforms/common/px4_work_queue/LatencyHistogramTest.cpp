@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <px4_platform_common/px4_work_queue/LatencyHistogram.hpp>
+
+using px4::LatencyHistogram;
+
+TEST(LatencyHistogramTest, Empty)
+{
+	LatencyHistogram histogram;
+	EXPECT_EQ(histogram.count(), 0u);
+	EXPECT_EQ(histogram.percentile(0.5f), 0u);
+	EXPECT_EQ(histogram.percentile(0.99f), 0u);
+	EXPECT_EQ(histogram.max(), 0u);
+}
+
+TEST(LatencyHistogramTest, Percentiles)
+{
+	LatencyHistogram histogram;
+
+	// 98 samples of 10 us, 2 samples of 1000 us
+	for (int i = 0; i < 98; i++) {
+		histogram.record(10);
+	}
+
+	histogram.record(1000);
+	histogram.record(1000);
+
+	EXPECT_EQ(histogram.count(), 100u);
+	EXPECT_EQ(histogram.max(), 1000u);
+
+	// 10 us falls into [8, 16) us, reported as the upper end of the bucket
+	EXPECT_EQ(histogram.percentile(0.5f), 15u);
+	EXPECT_EQ(histogram.percentile(0.98f), 15u);
+
+	// 1000 us falls into [512, 1024) us, capped at the maximum
+	EXPECT_EQ(histogram.percentile(0.99f), 1000u);
+	EXPECT_EQ(histogram.percentile(1.f), 1000u);
+
+	histogram.reset();
+	EXPECT_EQ(histogram.count(), 0u);
+	EXPECT_EQ(histogram.max(), 0u);
+}
+
+TEST(LatencyHistogramTest, ZeroAndLarge)
+{
+	LatencyHistogram histogram;
+	histogram.record(0);
+	EXPECT_EQ(histogram.percentile(1.f), 0u);
+
+	// beyond the last bucket
+	histogram.record(10'000'000);
+	EXPECT_EQ(histogram.count(), 2u);
+	EXPECT_EQ(histogram.percentile(0.5f), 0u);
+	EXPECT_EQ(histogram.percentile(1.f), 10'000'000u);
+}
+
+TEST(LatencyHistogramTest, SaturationHalves)
+{
+	LatencyHistogram histogram;
+
+	for (int i = 0; i < UINT16_MAX; i++) {
+		histogram.record(1);
+	}
+
+	histogram.record(100);
+	EXPECT_EQ(histogram.count(), static_cast<uint32_t>(UINT16_MAX) + 1);
+
+	// all buckets are halved once one saturates, the single 100 us sample fades out
+	histogram.record(1);
+	EXPECT_EQ(histogram.count(), static_cast<uint32_t>(UINT16_MAX) / 2 + 1);
+	EXPECT_EQ(histogram.percentile(0.5f), 1u);
+	EXPECT_EQ(histogram.max(), 100u);
+}
@@ -39,6 +39,8 @@
 #include <px4_platform_common/log.h>
 #include <drivers/drv_hrt.h>
 
+#include <inttypes.h>
+
 namespace px4
 {
 
@@ -134,10 +136,25 @@ float WorkItem::average_interval() const
 
 void WorkItem::print_run_status()
 {
-	PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us\n", _item_name, (double)average_rate(), (double)average_interval());
+	PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us", _item_name, (double)average_rate(), (double)average_interval());
+	print_latency();
 
 	// reset statistics
 	_run_count = 0;
 }
 
+void WorkItem::print_latency()
+{
+	LatencyHistogram wait{};
+	LatencyHistogram run{};
+
+	if (_wq != nullptr) {
+		_wq->GetItemLatency(this, wait, run);
+	}
+
+	PX4_INFO_RAW("  wait %" PRIu32 "/%" PRIu32 "/%" PRIu32 " us, run %" PRIu32 "/%" PRIu32 "/%" PRIu32 " us\n",
+		     wait.percentile(0.5f), wait.percentile(0.99f), wait.max(),
+		     run.percentile(0.5f), run.percentile(0.99f), run.max());
+}
+
 } // namespace px4
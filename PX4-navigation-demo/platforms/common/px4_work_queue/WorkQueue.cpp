@@ -34,6 +34,7 @@
 #include <px4_platform_common/px4_work_queue/WorkQueue.hpp>
 #include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 
+#include <inttypes.h>
 #include <string.h>
 
 #include <px4_platform_common/log.h>
@@ -46,6 +47,9 @@ namespace px4
 
 WorkQueue::WorkQueue(const wq_config_t &config) :
 	_config(config)
+#if defined(PX4_WQ_EXECUTOR)
+	, _stealable(config.relative_priority <= CONFIG_WQ_EXECUTOR_PRIORITY)
+#endif // PX4_WQ_EXECUTOR
 {
 	// set the threads name
 #ifdef __PX4_DARWIN
@@ -63,10 +67,25 @@ WorkQueue::WorkQueue(const wq_config_t &config) :
 
 	px4_sem_init(&_exit_lock, 0, 1);
 	px4_sem_setprotocol(&_exit_lock, SEM_PRIO_NONE);
+
+#if defined(PX4_WQ_EXECUTOR)
+	px4_sem_init(&_handoff_lock, 0, 0);
+	px4_sem_setprotocol(&_handoff_lock, SEM_PRIO_NONE);
+#endif // PX4_WQ_EXECUTOR
 }
 
 WorkQueue::~WorkQueue()
 {
+#if defined(PX4_WQ_EXECUTOR)
+
+	// already removed from the work queue list, wait for executor threads still using it
+	while (_executor_refs.load() > 0) {
+		px4_usleep(1000);
+	}
+
+	px4_sem_destroy(&_handoff_lock);
+
+#endif // PX4_WQ_EXECUTOR
 
 	work_lock();
 
@@ -105,6 +124,13 @@ void WorkQueue::Detach(WorkItem *item)
 
 	_work_items.remove(item);
 
+	// the item might be destroyed while running, don't touch it once that is done
+	for (int i = 0; i < MAX_RUNNERS; i++) {
+		if (_running[i] == item) {
+			_running[i] = nullptr;
+		}
+	}
+
 	if (_work_items.size() == 0) {
 		// shutdown, no active WorkItems
 		PX4_DEBUG("stopping: %s, last active WorkItem closing", _config.name);
@@ -138,10 +164,28 @@ void WorkQueue::Add(WorkItem *item)
 
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
+	if (item->_time_queued == 0) {
+		item->_time_queued = hrt_absolute_time();
+	}
+
 	_q.push(item);
+
+#if defined(PX4_WQ_EXECUTOR)
+	// work queue thread busy or not scheduled, let an executor thread take over
+	const bool steal = _stealable && Backlogged();
+#endif // PX4_WQ_EXECUTOR
+
 	work_unlock();
 
 	SignalWorkerThread();
+
+#if defined(PX4_WQ_EXECUTOR)
+
+	if (steal) {
+		WorkQueueExecutorSignal();
+	}
+
+#endif // PX4_WQ_EXECUTOR
 }
 
 void WorkQueue::SignalWorkerThread()
@@ -156,7 +200,11 @@ void WorkQueue::SignalWorkerThread()
 void WorkQueue::Remove(WorkItem *item)
 {
 	work_lock();
-	_q.remove(item);
+
+	if (_q.remove(item)) {
+		item->_time_queued = 0;
+	}
+
 	work_unlock();
 }
 
@@ -165,7 +213,7 @@ void WorkQueue::Clear()
 	work_lock();
 
 	while (!_q.empty()) {
-		_q.pop();
+		_q.pop()->_time_queued = 0;
 	}
 
 	work_unlock();
@@ -179,17 +227,47 @@ void WorkQueue::Run()
 
 		work_lock();
 
+#if defined(PX4_WQ_EXECUTOR)
+
+		// an executor thread drains the queue, it signals if it hands the queue back with work left
+		if (_run_token != RUN_TOKEN_FREE) {
+			work_unlock();
+			continue;
+		}
+
+		_run_token = 0;
+#endif // PX4_WQ_EXECUTOR
+
 		// process queued work
-		while (!_q.empty()) {
-			WorkItem *work = _q.pop();
+		WorkItem *work = nullptr;
+
+		while ((work = PopRunnable(0)) != nullptr) {
 
 			work_unlock(); // unlock work queue to run (item may requeue itself)
+			const hrt_abstime time_started = hrt_absolute_time();
 			work->RunPreamble();
 			work->Run();
 			// Note: after Run() we cannot access work anymore, as it might have been deleted
 			work_lock(); // re-lock
+
+			FinishRun(0, work, time_started);
 		}
 
+#if defined(PX4_WQ_EXECUTOR)
+		_run_token = RUN_TOKEN_FREE;
+
+		if (_handoff_requested) {
+			// pass the token straight to the waiting executor thread, unless the backlog is gone
+			if (!_q.empty()) {
+				_run_token = _handoff_runner;
+			}
+
+			_handoff_requested = false;
+			px4_sem_post(&_handoff_lock);
+		}
+
+#endif // PX4_WQ_EXECUTOR
+
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 
 		if (_q.empty()) {
@@ -205,10 +283,160 @@ void WorkQueue::Run()
 	PX4_DEBUG("%s: exiting", _config.name);
 }
 
+WorkItem *WorkQueue::PopRunnable(int runner)
+{
+	WorkItem *work = nullptr;
+
+#if defined(PX4_WQ_EXECUTOR)
+
+	// an executor thread waits to take over, hand over at this WorkItem boundary
+	if ((runner == 0) && _handoff_requested) {
+		return nullptr;
+	}
+
+#endif // PX4_WQ_EXECUTOR
+
+	if (!_q.empty()) {
+		work = _q.pop();
+	}
+
+	if (work != nullptr) {
+		_running[runner] = work;
+
+		const uint32_t wait = hrt_elapsed_time(&work->_time_queued);
+		work->_time_queued = 0;
+
+		work->_wait_latency.record(wait);
+		_wait_latency.record(wait);
+	}
+
+	return work;
+}
+
+void WorkQueue::FinishRun(int runner, WorkItem *work, hrt_abstime time_started)
+{
+	const uint32_t run = hrt_elapsed_time(&time_started);
+
+	// still attached, so it was not destroyed while running
+	if (_running[runner] == work) {
+		work->_run_latency.record(run);
+	}
+
+	_run_latency.record(run);
+	_running[runner] = nullptr;
+}
+
+#if defined(PX4_WQ_EXECUTOR)
+bool WorkQueue::Backlogged() const
+{
+	// more than one WorkItem waiting behind the work queue thread (or for it to be scheduled at all)
+	return (_run_token == RUN_TOKEN_FREE || _run_token == 0) && !_q.empty() && (_q.front() != _q.back());
+}
+
+bool WorkQueue::HasStealableWork()
+{
+	if (!_stealable) {
+		return false;
+	}
+
+	work_lock();
+	const bool backlogged = Backlogged() && !_handoff_requested;
+	work_unlock();
+
+	return backlogged;
+}
+
+bool WorkQueue::RunStolen(int runner)
+{
+	work_lock();
+
+	if ((_run_token == 0) && !_handoff_requested && !_q.empty()) {
+		// the work queue thread is running a WorkItem, it hands over once that returns
+		_handoff_requested = true;
+		_handoff_runner = runner;
+		work_unlock();
+
+		// loop as the wait may be interrupted by a signal
+		do {} while (px4_sem_wait(&_handoff_lock) != 0);
+
+		work_lock();
+
+	} else if ((_run_token == RUN_TOKEN_FREE) && !_q.empty()) {
+		// the work queue thread was signalled but did not get to run yet
+		_run_token = runner;
+	}
+
+	if (_run_token != runner) {
+		work_unlock();
+		return false;
+	}
+
+	// drain the backlog found at take over, WorkItems requeued meanwhile go back to the work queue thread
+	size_t backlog = _q.size();
+	WorkItem *work = nullptr;
+
+	while ((backlog-- > 0) && (work = PopRunnable(runner)) != nullptr) {
+		_stolen_count++;
+		work_unlock(); // unlock work queue to run (item may requeue itself)
+
+		const hrt_abstime time_started = hrt_absolute_time();
+		work->RunPreamble();
+		work->Run();
+		// Note: after Run() we cannot access work anymore, as it might have been deleted
+
+		work_lock();
+		FinishRun(runner, work, time_started);
+	}
+
+	_run_token = RUN_TOKEN_FREE;
+	const bool pending = !_q.empty();
+	work_unlock();
+
+	// the work queue thread skipped its wakeups while the token was held here
+	if (pending) {
+		SignalWorkerThread();
+	}
+
+	return true;
+}
+
+uint32_t WorkQueue::stolen_count()
+{
+	work_lock();
+	const uint32_t stolen_count = _stolen_count;
+	work_unlock();
+
+	return stolen_count;
+}
+#endif // PX4_WQ_EXECUTOR
+
 void WorkQueue::print_status(bool last)
 {
 	const size_t num_items = _work_items.size();
-	PX4_INFO_RAW("%-16s\n", get_name());
+
+	work_lock();
+	// the latency window belongs to the work_item_latency publication, only read it here
+	const LatencyHistogram wait = _wait_latency;
+	const LatencyHistogram run = _run_latency;
+#if defined(PX4_WQ_EXECUTOR)
+	const uint32_t stolen_count = _stolen_count;
+	_stolen_count = 0;
+#endif // PX4_WQ_EXECUTOR
+	work_unlock();
+
+	PX4_INFO_RAW("%-16s wait %" PRIu32 "/%" PRIu32 "/%" PRIu32 " us, run %" PRIu32 "/%" PRIu32 "/%" PRIu32 " us (p50/p99/max)",
+		     get_name(), wait.percentile(0.5f), wait.percentile(0.99f), wait.max(),
+		     run.percentile(0.5f), run.percentile(0.99f), run.max());
+
+#if defined(PX4_WQ_EXECUTOR)
+
+	if (_stealable) {
+		PX4_INFO_RAW(", stolen: %" PRIu32, stolen_count);
+	}
+
+#endif // PX4_WQ_EXECUTOR
+
+	PX4_INFO_RAW("\n");
 	unsigned i = 0;
 
 	for (WorkItem *item : _work_items) {
@@ -232,4 +460,50 @@ void WorkQueue::print_status(bool last)
 	}
 }
 
+bool WorkQueue::GetLatency(int entry_index, wq_latency_t &latency)
+{
+	bool found = false;
+
+	// Attach() and Detach() change the WorkItem list under the same lock
+	work_lock();
+
+	if (entry_index == 0) {
+		latency.wq_name = get_name();
+		latency.item_name = nullptr;
+		latency.wait = _wait_latency;
+		latency.run = _run_latency;
+		_wait_latency.reset();
+		_run_latency.reset();
+		found = true;
+
+	} else {
+		int i = 0;
+
+		for (WorkItem *item : _work_items) {
+			if (++i == entry_index) {
+				latency.wq_name = get_name();
+				latency.item_name = item->ItemName();
+				latency.wait = item->_wait_latency;
+				latency.run = item->_run_latency;
+				item->_wait_latency.reset();
+				item->_run_latency.reset();
+				found = true;
+				break;
+			}
+		}
+	}
+
+	work_unlock();
+
+	return found;
+}
+
+void WorkQueue::GetItemLatency(WorkItem *item, LatencyHistogram &wait, LatencyHistogram &run)
+{
+	work_lock();
+	wait = item->_wait_latency;
+	run = item->_run_latency;
+	work_unlock();
+}
+
 } // namespace px4
@@ -63,6 +63,14 @@ static BlockingQueue<const wq_config_t *, 1> *_wq_manager_create_queue{nullptr};
 static px4::atomic_bool _wq_manager_should_exit{true};
 static px4::atomic_bool _wq_manager_running{false};
 
+#if defined(PX4_WQ_EXECUTOR)
+// shared executor threads, woken when a busy work queue gets more work
+static px4_sem_t _wq_executor_sem;
+static pthread_t _wq_executor_threads[CONFIG_WQ_EXECUTOR_THREADS] {};
+static int _wq_executor_num_threads{0};
+static px4::atomic_bool _wq_executor_should_exit{false};
+#endif // PX4_WQ_EXECUTOR
+
 
 static WorkQueue *
 FindWorkQueueByName(const char *name)
@@ -254,11 +262,147 @@ WorkQueueRunner(int argc, char *argv[])
 }
 #endif
 
+#if defined(PX4_WQ_EXECUTOR)
+void
+WorkQueueExecutorSignal()
+{
+	int sem_val;
+
+	// one pending wakeup per executor thread is enough
+	if (px4_sem_getvalue(&_wq_executor_sem, &sem_val) == 0 && sem_val < _wq_executor_num_threads) {
+		px4_sem_post(&_wq_executor_sem);
+	}
+}
+
+static void *
+WorkQueueExecutorRun(void *context)
+{
+	// runner 0 is the thread of each work queue itself
+	const int runner = (int)(intptr_t)context;
+
+	char name[16];
+	snprintf(name, sizeof(name), "wq:executor%d", runner);
+	pthread_setname_np(pthread_self(), name);
+
+	while (!_wq_executor_should_exit.load()) {
+		// loop as the wait may be interrupted by a signal
+		do {} while (px4_sem_wait(&_wq_executor_sem) != 0);
+
+		// steal until no work queue has runnable work left, highest priority first
+		bool ran = true;
+
+		while (ran && !_wq_executor_should_exit.load()) {
+			WorkQueue *wq = nullptr;
+
+			{
+				LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+				for (WorkQueue *candidate : *_wq_manager_wqs_list) {
+					if (candidate->HasStealableWork()) {
+						candidate->AcquireExecutor();
+						wq = candidate;
+						break;
+					}
+				}
+			}
+
+			// the list lock is not held while running, WorkItems may create work queues
+			ran = (wq != nullptr) && wq->RunStolen(runner);
+
+			if (wq != nullptr) {
+				wq->ReleaseExecutor();
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+static void
+WorkQueueExecutorStart()
+{
+	px4_sem_init(&_wq_executor_sem, 0, 0);
+	px4_sem_setprotocol(&_wq_executor_sem, SEM_PRIO_NONE);
+	_wq_executor_should_exit.store(false);
+
+	// On posix system , the desired stacksize round to the nearest multiplier of the system pagesize
+	const unsigned int page_size = sysconf(_SC_PAGESIZE);
+	const size_t stacksize_adj = math::max((int)PTHREAD_STACK_MIN, PX4_STACK_ADJUSTED(CONFIG_WQ_EXECUTOR_STACKSIZE));
+	const size_t stacksize = (stacksize_adj + page_size - (stacksize_adj % page_size));
+
+	for (int i = 0; i < CONFIG_WQ_EXECUTOR_THREADS; i++) {
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		pthread_attr_setstacksize(&attr, stacksize);
+		pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+
+		sched_param param{};
+		param.sched_priority = sched_get_priority_max(SCHED_FIFO) + CONFIG_WQ_EXECUTOR_PRIORITY;
+		pthread_attr_setschedparam(&attr, &param);
+
+#if defined(__PX4_LINUX)
+		const uint32_t cpu_mask = CONFIG_WQ_EXECUTOR_CPU_MASK;
+
+		if (cpu_mask != 0) {
+			// affinity hint: the executor threads go round-robin over the CPUs in the mask
+			int n = i % __builtin_popcount(cpu_mask);
+			int cpu = 0;
+
+			while (!((cpu_mask & (1u << cpu)) && (n-- == 0))) {
+				cpu++;
+			}
+
+			cpu_set_t cpuset;
+			CPU_ZERO(&cpuset);
+			CPU_SET(cpu, &cpuset);
+			pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+		}
+
+#endif // __PX4_LINUX
+
+		const int runner = _wq_executor_num_threads + 1;
+		int ret_create = pthread_create(&_wq_executor_threads[_wq_executor_num_threads], &attr, WorkQueueExecutorRun,
+						(void *)(intptr_t)runner);
+
+		if (ret_create == 0) {
+			_wq_executor_num_threads++;
+
+		} else {
+			PX4_ERR("failed to create executor thread (%i): %s", ret_create, strerror(ret_create));
+		}
+
+		pthread_attr_destroy(&attr);
+	}
+}
+
+static void
+WorkQueueExecutorStop()
+{
+	_wq_executor_should_exit.store(true);
+
+	for (int i = 0; i < _wq_executor_num_threads; i++) {
+		px4_sem_post(&_wq_executor_sem);
+	}
+
+	for (int i = 0; i < _wq_executor_num_threads; i++) {
+		pthread_join(_wq_executor_threads[i], nullptr);
+	}
+
+	_wq_executor_num_threads = 0;
+	px4_sem_destroy(&_wq_executor_sem);
+}
+#endif // PX4_WQ_EXECUTOR
+
 static int
 WorkQueueManagerRun(int, char **)
 {
 	_wq_manager_wqs_list = new BlockingList<WorkQueue *>();
 	_wq_manager_create_queue = new BlockingQueue<const wq_config_t *, 1>();
+
+#if defined(PX4_WQ_EXECUTOR)
+	WorkQueueExecutorStart();
+#endif // PX4_WQ_EXECUTOR
+
 	_wq_manager_running.store(true);
 
 	while (!_wq_manager_should_exit.load()) {
@@ -420,6 +564,10 @@ WorkQueueManagerStop()
 			return PX4_ERROR;
 		}
 
+#if defined(PX4_WQ_EXECUTOR)
+		WorkQueueExecutorStop();
+#endif // PX4_WQ_EXECUTOR
+
 		// first ask all WQs to stop
 		if (_wq_manager_wqs_list != nullptr) {
 			{
@@ -461,6 +609,25 @@ WorkQueueManagerStop()
 	return PX4_OK;
 }
 
+bool
+WorkQueueLatency(int wq_index, int entry_index, wq_latency_t &latency)
+{
+	if (!_wq_manager_running.load()) {
+		return false;
+	}
+
+	LockGuard lg{_wq_manager_wqs_list->mutex()};
+	int i = 0;
+
+	for (WorkQueue *wq : *_wq_manager_wqs_list) {
+		if (i++ == wq_index) {
+			return wq->GetLatency(entry_index, latency);
+		}
+	}
+
+	return false;
+}
+
 int
 WorkQueueManagerStatus()
 {
@@ -487,6 +654,11 @@ WorkQueueManagerStatus()
 			wq->print_status(last_wq);
 		}
 
+#if defined(PX4_WQ_EXECUTOR)
+		PX4_INFO_RAW("\nExecutor: %d threads, stealing from work queues at or below priority %d\n",
+			     _wq_executor_num_threads, CONFIG_WQ_EXECUTOR_PRIORITY);
+#endif // PX4_WQ_EXECUTOR
+
 	} else {
 		PX4_INFO("not running");
 	}
@@ -33,6 +33,8 @@
 
 #include "wqueue_test.h"
 #include "wqueue_scheduled_test.h"
+#include "wqueue_serial_test.h"
+#include "wqueue_steal_test.h"
 
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/app.h>
@@ -51,7 +53,13 @@ int PX4_MAIN(int argc, char **argv)
 	WQueueScheduledTest wq2;
 	wq2.main();
 
+	PX4_INFO("wqueue test 3 (serialized)");
+	int ret = WQueueSerialTest::main();
+
+	PX4_INFO("wqueue test 4 (taken over by the shared executor)");
+	ret |= WQueueStealTest::main();
+
 	PX4_INFO("wqueue test complete, exiting");
 
-	return 0;
+	return ret;
 }
@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "wqueue_serial_test.h"
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
+
+using namespace px4;
+
+px4::atomic_int WQueueSerialTest::_running{0};
+px4::atomic_int WQueueSerialTest::_overlaps{0};
+px4::atomic_int WQueueSerialTest::_finished{0};
+
+void WQueueSerialTest::Run()
+{
+	if (_running.fetch_add(1) > 0) {
+		_overlaps.fetch_add(1);
+	}
+
+	// stay busy so that the other WorkItem gets queued meanwhile
+	const hrt_abstime start = hrt_absolute_time();
+
+	while (hrt_elapsed_time(&start) < 200) {}
+
+	_running.fetch_sub(1);
+
+	if (++_iter < 1000) {
+		ScheduleNow();
+
+	} else {
+		_finished.fetch_add(1);
+	}
+}
+
+int WQueueSerialTest::main()
+{
+	_running.store(0);
+	_overlaps.store(0);
+	_finished.store(0);
+
+	WQueueSerialTest first;
+	WQueueSerialTest second;
+
+	// Put work in the work queue
+	first.ScheduleNow();
+	second.ScheduleNow();
+
+	// Wait for work to finish
+	while (_finished.load() < 2) {
+		px4_usleep(10000);
+	}
+
+	// let the last Run() return before the WorkItems are destroyed
+	px4_sleep(1);
+
+	if (_overlaps.load() > 0) {
+		PX4_ERR("WQueueSerialTest failed: WorkItems of the same work queue ran concurrently %d times", _overlaps.load());
+		return 1;
+	}
+
+	PX4_INFO("WQueueSerialTest finished");
+
+	return 0;
+}
@@ -0,0 +1,69 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <px4_platform_common/app.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+
+using namespace px4;
+
+/**
+ * Two of these WorkItems keep rescheduling themselves on a work queue below the shared executor priority, so
+ * WorkItems keep queuing up behind its thread. With the shared executor enabled an executor thread has to take
+ * the work queue over, while the WorkItems still never run concurrently.
+ */
+class WQueueStealTest : public px4::WorkItem
+{
+public:
+	WQueueStealTest() : px4::WorkItem("WQueueStealTest", px4::wq_configurations::test3) {}
+	~WQueueStealTest() = default;
+
+	/**
+	 * @return 0 if the WorkItems never ran concurrently and (with the shared executor) some ran on an executor thread
+	 */
+	static int main();
+
+private:
+
+	void Run() override;
+
+	static px4::atomic_int _running;	// WorkItems currently in Run()
+	static px4::atomic_int _overlaps;	// Run() entered while the other WorkItem was running
+	static px4::atomic_int _executor_runs;	// Run() called on an executor thread
+	static px4::atomic_int _finished;	// WorkItems done iterating
+
+	int _iter{0};
+};
@@ -113,6 +113,30 @@ public:
 
 		return (Manager::orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
+
+	/**
+	 * Loan the next publication to fill it in place, saving the copy of publish().
+	 *
+	 * The struct still contains an older message and has to be filled completely.
+	 * Every successful loan has to be followed by commit(), without publishing this
+	 * topic in between.
+	 *
+	 * @return The struct to fill, nullptr if loaning is not supported on this platform: use publish() then.
+	 */
+	T *loan()
+	{
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(Manager::orb_loan(get_topic(), _handle));
+	}
+
+	/**
+	 * Publish the struct returned by loan().
+	 * @return false if there is no outstanding loan
+	 */
+	bool commit() { return (Manager::orb_commit(_handle) == PX4_OK); }
 };
 
 /**
@@ -163,6 +163,33 @@ public:
 		return false;
 	}
 
+	/**
+	 * Borrow the next update in place instead of copying it out like update().
+	 *
+	 * The message stays in the topic queue and may be overwritten by a publisher at any time:
+	 * once done reading, check release() and discard anything taken from the message if that fails.
+	 * Not available in protected builds, where nothing can be borrowed.
+	 *
+	 * @param msg The borrowed message, msg.data points to the uORB message struct.
+	 */
+	bool borrow(BorrowedMessage &msg)
+	{
+		if (subscribe()) {
+			return Manager::orb_data_borrow(_node, msg, _last_generation);
+		}
+
+		return false;
+	}
+
+	/**
+	 * Finish reading a message from borrow().
+	 * @return true if the message was not overwritten while it was read.
+	 */
+	bool release(const BorrowedMessage &msg) const
+	{
+		return valid() && Manager::orb_borrow_valid(_node, msg);
+	}
+
 	/**
 	 * Change subscription instance
 	 * @param instance The new multi-Subscription instance
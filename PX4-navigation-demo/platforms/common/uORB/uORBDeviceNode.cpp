@@ -148,6 +148,49 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	 *
 	 * Note that filp will usually be NULL.
 	 */
+	if (!allocate_data()) {
+		return -ENOMEM;
+	}
+
+	/* If write size does not match, that is an error */
+	if (_meta->o_size != buflen) {
+		return -EIO;
+	}
+
+	/* Writers are serialized, readers validate their copy against the write sequence instead of locking. */
+	ATOMIC_ENTER;
+
+	// odd sequence: write in progress
+	_sequence.fetch_add(1);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
+	unsigned generation = _generation.fetch_add(1);
+
+	memcpy(_data + (_meta->o_size * (generation % _meta->o_queue)), buffer, _meta->o_size);
+
+	/* Mark at least one data has been published */
+	_data_valid = true;
+
+	// even sequence: write complete
+	_sequence.fetch_add(1);
+
+	// callbacks
+	for (auto item : _callbacks) {
+		item->call();
+	}
+
+	ATOMIC_LEAVE;
+
+	/* notify any poll waiters */
+	poll_notify(POLLIN);
+
+	return _meta->o_size;
+}
+
+bool
+uORB::DeviceNode::allocate_data()
+{
 	if (nullptr == _data) {
 
 #ifdef __PX4_NUTTX
@@ -173,39 +216,85 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 		}
 
 #endif /* __PX4_NUTTX */
+	}
 
-		/* failed or could not allocate */
-		if (nullptr == _data) {
-			return -ENOMEM;
-		}
+	/* failed or could not allocate */
+	return (nullptr != _data);
+}
+
+void *
+uORB::DeviceNode::loan()
+{
+#if defined(__PX4_POSIX)
+
+	if (!allocate_data()) {
+		return nullptr;
 	}
 
-	/* If write size does not match, that is an error */
-	if (_meta->o_size != buflen) {
-		return -EIO;
+	/* ATOMIC_ENTER is the node lock on POSIX, held until commit() */
+	lock();
+
+	_loan_owner = pthread_self();
+	_loaned.store(true);
+
+	// odd sequence: write in progress
+	_sequence.fetch_add(1);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	return _data + (_meta->o_size * (_generation.load() % _meta->o_queue));
+#else
+	return nullptr;
+#endif /* __PX4_POSIX */
+}
+
+int
+uORB::DeviceNode::commit()
+{
+#if defined(__PX4_POSIX)
+
+	// only the thread holding the loan holds the node lock
+	if (!_loaned.load() || !pthread_equal(_loan_owner, pthread_self())) {
+		PX4_ERR("%s commit without loan", _meta->o_name);
+		return PX4_ERROR;
 	}
 
-	/* Perform an atomic copy. */
-	ATOMIC_ENTER;
-	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
-	unsigned generation = _generation.fetch_add(1);
+	_generation.fetch_add(1);
 
-	memcpy(_data + (_meta->o_size * (generation % _meta->o_queue)), buffer, _meta->o_size);
+	/* Mark at least one data has been published */
+	_data_valid = true;
+
+	// even sequence: write complete
+	_sequence.fetch_add(1);
 
 	// callbacks
 	for (auto item : _callbacks) {
 		item->call();
 	}
 
-	/* Mark at least one data has been published */
-	_data_valid = true;
+#ifdef CONFIG_ORB_COMMUNICATOR
+	/* send the data over the Multi-ORB link while the slot cannot be reused yet */
+	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
 
-	ATOMIC_LEAVE;
+	if (ch != nullptr) {
+		const unsigned generation = _generation.load() - 1;
+
+		if (ch->send_message(_meta->o_name, _meta->o_size, _data + (_meta->o_size * (generation % _meta->o_queue))) != 0) {
+			PX4_ERR("Error Sending [%s] topic data over comm_channel", _meta->o_name);
+		}
+	}
+
+#endif /* CONFIG_ORB_COMMUNICATOR */
+
+	_loaned.store(false);
+	unlock();
 
 	/* notify any poll waiters */
 	poll_notify(POLLIN);
 
-	return _meta->o_size;
+	return PX4_OK;
+#else
+	return PX4_ERROR;
+#endif /* __PX4_POSIX */
 }
 
 int
@@ -213,9 +302,7 @@ uORB::DeviceNode::ioctl(cdev::file_t *filp, int cmd, unsigned long arg)
 {
 	switch (cmd) {
 	case ORBIOCUPDATED: {
-			ATOMIC_ENTER;
 			*(bool *)arg = filp_to_subscription(filp)->updated();
-			ATOMIC_LEAVE;
 			return PX4_OK;
 		}
 
@@ -453,11 +540,22 @@ int16_t uORB::DeviceNode::process_received_message(int32_t length, uint8_t *data
 
 unsigned uORB::DeviceNode::get_initial_generation()
 {
-	ATOMIC_ENTER;
+	// generation and _data_valid only change together while the write sequence is odd
+	for (int retry = 0; retry < MAX_COPY_RETRIES; retry++) {
+		const unsigned sequence = _sequence.load();
 
-	// If there any previous publications allow the subscriber to read them
-	unsigned generation = _generation.load() - (_data_valid ? 1 : 0);
+		if ((sequence & 1) == 0) {
+			// If there any previous publications allow the subscriber to read them
+			const unsigned generation = _generation.load() - (_data_valid ? 1 : 0);
+
+			if (_sequence.load() == sequence) {
+				return generation;
+			}
+		}
+	}
 
+	ATOMIC_ENTER;
+	unsigned generation = _generation.load() - (_data_valid ? 1 : 0);
 	ATOMIC_LEAVE;
 
 	return generation;
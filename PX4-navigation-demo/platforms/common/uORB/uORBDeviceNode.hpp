@@ -43,12 +43,25 @@
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/px4_config.h>
 
+#if defined(__PX4_POSIX)
+#include <pthread.h>
+#endif /* __PX4_POSIX */
+
 namespace uORB
 {
 class DeviceNode;
 class DeviceMaster;
 class Manager;
 class SubscriptionCallback;
+
+/**
+ * A message borrowed in place from a topic queue, see DeviceNode::borrow().
+ */
+struct BorrowedMessage {
+	const void *data{nullptr};
+	unsigned sequence{0}; /**< write sequence when the message was borrowed */
+	unsigned slack{0};    /**< publications that may still start before the borrowed slot is reused */
+};
 }
 
 namespace uORBTest
@@ -215,6 +228,11 @@ public:
 	 * Copies data and the corresponding generation
 	 * from a node to the buffer provided.
 	 *
+	 * Readers do not take any lock: the copy is validated against the write sequence
+	 * and retried if a publication happened concurrently. Only if the writer keeps
+	 * interfering (e.g. it got preempted in the middle of a write) the copy falls back
+	 * to waiting for the writer.
+	 *
 	 * @param dst
 	 *   The buffer into which the data is copied.
 	 * @param generation
@@ -225,43 +243,120 @@ public:
 	bool copy(void *dst, unsigned &generation)
 	{
 		if ((dst != nullptr) && (_data != nullptr)) {
-			if (_meta->o_queue == 1) {
-				ATOMIC_ENTER;
-				memcpy(dst, _data, _meta->o_size);
-				generation = _generation.load();
-				ATOMIC_LEAVE;
-				return true;
+			for (int retry = 0; retry < MAX_COPY_RETRIES; retry++) {
+				const unsigned sequence = _sequence.load();
 
-			} else {
-				ATOMIC_ENTER;
-				const unsigned current_generation = _generation.load();
-
-				if (current_generation == generation) {
-					/* The subscriber already read the latest message, but nothing new was published yet.
-					* Return the previous message
-					*/
-					--generation;
+				if (sequence & 1) {
+					// write in progress
+					continue;
 				}
 
-				// Compatible with normal and overflow conditions
-				if (!is_in_range(current_generation - _meta->o_queue, generation, current_generation - 1)) {
-					// Reader is too far behind: some messages are lost
-					generation = current_generation - _meta->o_queue;
+				unsigned copied_generation = generation;
+				copy_unsynchronized(dst, copied_generation);
+
+				// order the data reads before re-checking the sequence
+				__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+				if (_sequence.load() == sequence) {
+					generation = copied_generation;
+					return true;
 				}
+			}
+
+			ATOMIC_ENTER;
+			copy_unsynchronized(dst, generation);
+			ATOMIC_LEAVE;
+			return true;
+		}
+
+		return false;
+
+	}
 
-				memcpy(dst, _data + (_meta->o_size * (generation % _meta->o_queue)), _meta->o_size);
-				ATOMIC_LEAVE;
+	/**
+	 * Borrow the message a subscriber at generation reads next in place, without copying it.
+	 *
+	 * The message stays in the queue and publishers are not held off, check the borrow with
+	 * borrow_valid() once done reading.
+	 *
+	 * @param msg
+	 *   The borrowed message.
+	 * @param generation
+	 *   The generation that was borrowed.
+	 * @return bool
+	 *   Returns true if there is data to borrow.
+	 */
+	bool borrow(BorrowedMessage &msg, unsigned &generation)
+	{
+		if (_data == nullptr) {
+			return false;
+		}
 
-				++generation;
+		for (int retry = 0; retry < MAX_COPY_RETRIES; retry++) {
+			const unsigned sequence = _sequence.load();
 
+			if (sequence & 1) {
+				// write in progress
+				continue;
+			}
+
+			unsigned borrowed_generation = generation;
+			const uint8_t *data = read_slot(borrowed_generation);
+			const unsigned slack = borrowed_generation + _meta->o_queue - 1 - _generation.load();
+
+			if (_sequence.load() == sequence) {
+				msg.data = data;
+				msg.sequence = sequence;
+				msg.slack = slack;
+				generation = borrowed_generation;
 				return true;
 			}
 		}
 
-		return false;
+		ATOMIC_ENTER;
+		msg.data = read_slot(generation);
+		msg.sequence = _sequence.load();
+		msg.slack = generation + _meta->o_queue - 1 - _generation.load();
+		ATOMIC_LEAVE;
+		return true;
+	}
+
+	/**
+	 * Check that a borrowed message was not overwritten while it was read.
+	 * @return bool
+	 *   Returns true if everything read from the message since borrow() is consistent.
+	 */
+	bool borrow_valid(const BorrowedMessage &msg) const
+	{
+		// order the data reads before checking the sequence
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		// publications started since the borrow, including one in progress
+		const unsigned publications = (_sequence.load() - msg.sequence + 1) / 2;
 
+		return publications <= msg.slack;
 	}
 
+	/**
+	 * Loan the queue slot of the next publication, so that the publisher can fill it in place.
+	 *
+	 * Publishing to this node is locked until commit(), which has to follow every successful
+	 * loan. The slot still contains an older message and has to be filled completely.
+	 *
+	 * Only supported on POSIX: elsewhere publications are serialized by disabling interrupts,
+	 * which cannot be held while the publisher fills the slot.
+	 *
+	 * @return the slot, nullptr if the node cannot be loaned
+	 */
+	void *loan();
+
+	/**
+	 * Publish the slot returned by loan().
+	 *
+	 * @return PX4_OK, PX4_ERROR if the calling thread has no outstanding loan
+	 */
+	int commit();
+
 	// add item to list of work items to schedule on node update
 	bool register_callback(SubscriptionCallback *callback_sub);
 
@@ -279,9 +374,12 @@ private:
 
 	const orb_metadata *_meta; /**< object metadata information */
 
+	static constexpr int MAX_COPY_RETRIES{4}; /**< lock-free copy attempts before waiting for the writer */
+
 	uint8_t *_data{nullptr};   /**< allocated object buffer */
 	bool _data_valid{false}; /**< At least one valid data */
 	px4::atomic<unsigned>  _generation{0};  /**< object generation count */
+	px4::atomic<unsigned>  _sequence{0};  /**< write sequence, odd while a write is in progress */
 	List<uORB::SubscriptionCallback *>	_callbacks;
 
 	const uint8_t _instance; /**< orb multi instance identifier */
@@ -289,6 +387,58 @@ private:
 
 	int8_t _subscriber_count{0};
 
+#if defined(__PX4_POSIX)
+	px4::atomic_bool _loaned {false}; /**< a loan is outstanding, the node lock is held by _loan_owner */
+	pthread_t _loan_owner{};
+#endif /* __PX4_POSIX */
+
+
+	/**
+	 * Allocate the queue on first use, returns false if that failed.
+	 */
+	bool allocate_data();
+
+	/**
+	 * Copy data without synchronization against writers, see copy().
+	 */
+	void copy_unsynchronized(void *dst, unsigned &generation)
+	{
+		memcpy(dst, read_slot(generation), _meta->o_size);
+	}
+
+	/**
+	 * Queue slot a subscriber at generation reads next, generation is advanced past it.
+	 * Not synchronized against writers.
+	 */
+	uint8_t *read_slot(unsigned &generation)
+	{
+		if (_meta->o_queue == 1) {
+			generation = _generation.load();
+			return _data;
+
+		} else {
+			const unsigned current_generation = _generation.load();
+
+			if (current_generation == generation) {
+				/* The subscriber already read the latest message, but nothing new was published yet.
+				* Return the previous message
+				*/
+				--generation;
+			}
+
+			// Compatible with normal and overflow conditions
+			if (!is_in_range(current_generation - _meta->o_queue, generation, current_generation - 1)) {
+				// Reader is too far behind: some messages are lost
+				generation = current_generation - _meta->o_queue;
+			}
+
+			uint8_t *slot = _data + (_meta->o_size * (generation % _meta->o_queue));
+
+			++generation;
+
+			return slot;
+		}
+	}
 
 // Determine the data range
 	static inline bool is_in_range(unsigned left, unsigned value, unsigned right)
@@ -375,6 +375,34 @@ int uORB::Manager::orb_publish(const struct orb_metadata *meta, orb_advert_t han
 	return uORB::DeviceNode::publish(meta, handle, data);
 }
 
+void *uORB::Manager::orb_loan(const struct orb_metadata *meta, orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		return nullptr; // orb_publish() pretends success
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	if ((devnode == nullptr) || (meta == nullptr) || (devnode->get_meta()->o_id != meta->o_id)) {
+		return nullptr;
+	}
+
+	return devnode->loan();
+}
+
+int uORB::Manager::orb_commit(orb_advert_t handle)
+{
+	if (handle == nullptr) {
+		return PX4_ERROR;
+	}
+
+	return static_cast<uORB::DeviceNode *>(handle)->commit();
+}
+
 int uORB::Manager::orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 {
 	int ret;
@@ -458,6 +486,24 @@ bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &genera
 	return static_cast<DeviceNode *>(node_handle)->copy(dst, generation);
 }
 
+bool uORB::Manager::orb_data_borrow(void *node_handle, BorrowedMessage &msg, unsigned &generation)
+{
+	if (!is_advertised(node_handle)) {
+		return false;
+	}
+
+	if (!static_cast<const uORB::DeviceNode *>(node_handle)->updates_available(generation)) {
+		return false;
+	}
+
+	return static_cast<DeviceNode *>(node_handle)->borrow(msg, generation);
+}
+
+bool uORB::Manager::orb_borrow_valid(const void *node_handle, const BorrowedMessage &msg)
+{
+	return static_cast<const DeviceNode *>(node_handle)->borrow_valid(msg);
+}
+
 // add item to list of work items to schedule on node update
 bool uORB::Manager::register_callback(void *node_handle, SubscriptionCallback *callback_sub)
 {
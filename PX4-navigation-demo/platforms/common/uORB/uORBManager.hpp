@@ -279,6 +279,26 @@ public:
 	 */
 	static int  orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data);
 
+	/**
+	 * Loan the queue slot of the next publication to fill it in place, instead of
+	 * publishing a copy with orb_publish(). A successful loan has to be followed by
+	 * orb_commit(), other publications of the topic are held off until then.
+	 *
+	 * @param meta    The uORB metadata (usually from the ORB_ID() macro)
+	 *      for the topic.
+	 * @handle    The handle returned from orb_advertise.
+	 * @return    The slot to fill, nullptr if loaning is not supported here: use orb_publish() then.
+	 */
+	static void *orb_loan(const struct orb_metadata *meta, orb_advert_t handle);
+
+	/**
+	 * Publish the slot returned by orb_loan().
+	 *
+	 * @handle    The handle returned from orb_advertise.
+	 * @return    OK on success, PX4_ERROR otherwise, e.g. without a preceding successful orb_loan().
+	 */
+	static int  orb_commit(orb_advert_t handle);
+
 	/**
 	 * Subscribe to a topic.
 	 *
@@ -442,6 +462,10 @@ public:
 
 	static bool orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated);
 
+	static bool orb_data_borrow(void *node_handle, BorrowedMessage &msg, unsigned &generation);
+
+	static bool orb_borrow_valid(const void *node_handle, const BorrowedMessage &msg);
+
 	static bool register_callback(void *node_handle, SubscriptionCallback *callback_sub);
 
 	static void unregister_callback(void *node_handle, SubscriptionCallback *callback_sub);
@@ -155,6 +155,17 @@ int uORB::Manager::orb_publish(const struct orb_metadata *meta, orb_advert_t han
 	return d.ret;
 }
 
+void *uORB::Manager::orb_loan(const struct orb_metadata *meta, orb_advert_t handle)
+{
+	// the queue lives in the kernel
+	return nullptr;
+}
+
+int uORB::Manager::orb_commit(orb_advert_t handle)
+{
+	return PX4_ERROR;
+}
+
 int uORB::Manager::orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 {
 	int ret;
@@ -302,6 +313,17 @@ bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &genera
 	return data.ret;
 }
 
+bool uORB::Manager::orb_data_borrow(void *node_handle, BorrowedMessage &msg, unsigned &generation)
+{
+	// the queue lives in the kernel
+	return false;
+}
+
+bool uORB::Manager::orb_borrow_valid(const void *node_handle, const BorrowedMessage &msg)
+{
+	return false;
+}
+
 bool uORB::Manager::register_callback(void *node_handle, SubscriptionCallback *callback_sub)
 {
 	orbiocdevregcallback_t data = {node_handle, callback_sub, false};
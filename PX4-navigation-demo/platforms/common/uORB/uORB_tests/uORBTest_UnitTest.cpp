@@ -39,7 +39,9 @@
 #include <errno.h>
 #include <math.h>
 #include <lib/cdev/CDev.hpp>
+#include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
+#include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionMultiArray.hpp>
 
 uORBTest::UnitTest &uORBTest::UnitTest::instance()
@@ -213,7 +215,13 @@ int uORBTest::UnitTest::test()
 		return ret;
 	}
 
-	return test_queue_poll_notify();
+	ret = test_queue_poll_notify();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	return test_loan_borrow();
 }
 
 int uORBTest::UnitTest::test_unadvertise()
@@ -1040,6 +1048,74 @@ int uORBTest::UnitTest::test_queue_poll_notify()
 	return test_note("PASS orb queuing (poll & notify), got %i messages", next_expected_val);
 }
 
+int uORBTest::UnitTest::test_loan_borrow()
+{
+	test_note("Testing loan & borrow");
+
+	uORB::Publication<orb_test_large_s> pub{ORB_ID(orb_test_large)};
+	uORB::Subscription sub{ORB_ID(orb_test_large)};
+
+	auto publish = [&pub](int32_t val) {
+		orb_test_large_s *loaned = pub.loan();
+
+		if (loaned != nullptr) {
+			*loaned = orb_test_large_s{};
+			loaned->val = val;
+			return pub.commit();
+		}
+
+		// loaning not supported here
+		orb_test_large_s t{};
+		t.val = val;
+		return pub.publish(t);
+	};
+
+	if (!publish(1)) {
+		return test_fail("publish(1) failed");
+	}
+
+	if (pub.commit()) {
+		return test_fail("commit without loan succeeded");
+	}
+
+	uORB::BorrowedMessage msg{};
+
+	if (!sub.borrow(msg)) {
+		return test_fail("borrow(1) failed");
+	}
+
+	if (static_cast<const orb_test_large_s *>(msg.data)->val != 1) {
+		return test_fail("borrow(1) mismatch: %d expected 1", static_cast<const orb_test_large_s *>(msg.data)->val);
+	}
+
+	if (!sub.release(msg)) {
+		return test_fail("release(1) failed");
+	}
+
+	if (sub.borrow(msg)) {
+		return test_fail("spurious borrow without update");
+	}
+
+	// overwrite a borrowed message (the topic is not queued)
+	publish(2);
+
+	if (!sub.borrow(msg)) {
+		return test_fail("borrow(2) failed");
+	}
+
+	publish(3);
+
+	if (sub.release(msg)) {
+		return test_fail("overwritten message released");
+	}
+
+	if (!sub.borrow(msg) || (static_cast<const orb_test_large_s *>(msg.data)->val != 3) || !sub.release(msg)) {
+		return test_fail("borrow(3) failed");
+	}
+
+	return test_note("PASS loan & borrow");
+}
+
 int uORBTest::UnitTest::latency_test(bool print)
 {
 	test_note("---------------- LATENCY TEST ------------------");
@@ -113,6 +113,8 @@ private:
 	static int pub_test_queue_entry(int argc, char *argv[]);
 	int pub_test_queue_main();
 	int test_queue_poll_notify();
+
+	int test_loan_borrow();
 	volatile int _num_messages_sent = 0;
 
 	int test_fail(const char *fmt, ...);
@@ -37,6 +37,8 @@
 
 #include <dataman_client/DatamanClient.hpp>
 
+px4::atomic<uint64_t> DatamanClient::_range_buffer_owner[UINT8_MAX + 1] {};
+
 DatamanClient::DatamanClient()
 {
 	_sync_perf = perf_alloc(PC_ELAPSED, "DatamanClient: sync");
@@ -243,6 +245,120 @@ bool DatamanClient::clearSync(dm_item_t item, hrt_abstime timeout)
 	return success;
 }
 
+bool DatamanClient::readRange(dm_item_t item, uint32_t index, uint32_t count, uint8_t *buffer, uint32_t length,
+			      hrt_abstime timeout)
+{
+	return rangeSync(DM_READ_RANGE, item, index, count, buffer, length, timeout);
+}
+
+bool DatamanClient::writeRange(dm_item_t item, uint32_t index, uint32_t count, const uint8_t *buffer, uint32_t length,
+			       hrt_abstime timeout)
+{
+	return rangeSync(DM_WRITE_RANGE, item, index, count, buffer, length, timeout);
+}
+
+bool DatamanClient::clearRange(dm_item_t item, uint32_t index, uint32_t count, hrt_abstime timeout)
+{
+	return rangeSync(DM_CLEAR_RANGE, item, index, count, nullptr, 0, timeout);
+}
+
+bool DatamanClient::beginTransaction(hrt_abstime timeout)
+{
+	return transactionSync(DM_BEGIN_TRANSACTION, timeout);
+}
+
+bool DatamanClient::commitTransaction(hrt_abstime timeout)
+{
+	return transactionSync(DM_COMMIT_TRANSACTION, timeout);
+}
+
+bool DatamanClient::transactionSync(dm_function_t request_type, hrt_abstime timeout)
+{
+	hrt_abstime timestamp = hrt_absolute_time();
+
+	dataman_request_s request{};
+	request.timestamp = timestamp;
+	request.client_id = _client_id;
+	request.request_type = request_type;
+
+	dataman_response_s response{};
+	bool success = syncHandler(request, response, timestamp, timeout);
+
+	if (success) {
+
+		if (response.status != dataman_response_s::STATUS_SUCCESS) {
+
+			success = false;
+			PX4_ERR("transaction request %" PRIu8 " failed! status=%" PRIu8, request.request_type, response.status);
+		}
+	}
+
+	return success;
+}
+
+bool DatamanClient::rangeSync(dm_function_t request_type, dm_item_t item, uint32_t index, uint32_t count,
+			      const uint8_t *buffer, uint32_t length, hrt_abstime timeout)
+{
+	if (length > g_per_item_size[item]) {
+		PX4_ERR("Length  %" PRIu32 " can't fit in data size for item  %" PRIi8, length, static_cast<uint8_t>(item));
+		return false;
+	}
+
+	if (count == 0) {
+		return true;
+	}
+
+	if ((index >= g_per_item_max_index[item]) || (count > g_per_item_max_index[item] - index)) {
+		PX4_ERR("Range index %" PRIu32 " count %" PRIu32 " exceeds item %" PRIu8, index, count, static_cast<uint8_t>(item));
+		return false;
+	}
+
+	if (_client_id == CLIENT_ID_NOT_SET) {
+		PX4_ERR("Range request without client id");
+		return false;
+	}
+
+	hrt_abstime timestamp = hrt_absolute_time();
+
+	dataman_request_s request{};
+	request.timestamp = timestamp;
+	request.index = index;
+	request.count = count;
+	request.buffer = reinterpret_cast<uintptr_t>(buffer);
+	request.data_length = length;
+	request.client_id = _client_id;
+	request.request_type = request_type;
+	request.item = static_cast<uint8_t>(item);
+
+	// offer the buffer to the dataman for this request only
+	px4::atomic<uint64_t> &owner = _range_buffer_owner[_client_id];
+	owner.store(timestamp);
+
+	dataman_response_s response{};
+	bool success = syncHandler(request, response, timestamp, timeout);
+
+	// Withdraw the offer. If the dataman claimed the buffer already, it is released before the response is sent,
+	// so this only waits after a timeout while the dataman is still accessing the buffer.
+	uint64_t expected = timestamp;
+
+	while (!owner.compare_exchange(&expected, 0) && (expected != 0)) {
+		px4_usleep(1000);
+		expected = timestamp;
+	}
+
+	if (success) {
+
+		if ((response.status != dataman_response_s::STATUS_SUCCESS) || (response.count != count)) {
+
+			success = false;
+			PX4_ERR("range request %" PRIu8 " failed! status=%" PRIu8 ", item=%" PRIu8 ", index=%" PRIu32 ", count=%" PRIu32,
+				request.request_type, response.status, static_cast<uint8_t>(item), index, count);
+		}
+	}
+
+	return success;
+}
+
 bool DatamanClient::readAsync(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length)
 {
 	if (length > g_per_item_size[item]) {
@@ -437,6 +553,17 @@ void DatamanClient::abortCurrentOperation()
 	_state = State::Idle;
 }
 
+bool DatamanClient::claimRangeBuffer(uint8_t client_id, hrt_abstime timestamp)
+{
+	uint64_t expected = timestamp;
+	return _range_buffer_owner[client_id].compare_exchange(&expected, timestamp | RANGE_BUFFER_CLAIMED);
+}
+
+void DatamanClient::releaseRangeBuffer(uint8_t client_id)
+{
+	_range_buffer_owner[client_id].store(0);
+}
+
 DatamanCache::DatamanCache(const char *cache_miss_perf_counter_name, uint32_t num_items)
 	: _cache_miss_perf(perf_alloc(PC_COUNT, cache_miss_perf_counter_name))
 {
@@ -39,6 +39,7 @@
 #include <uORB/topics/dataman_response.h>
 #include <dataman/dataman.h>
 #include <lib/perf/perf_counter.h>
+#include <px4_platform_common/atomic.h>
 
 using namespace time_literals;
 
@@ -87,6 +88,77 @@ public:
 	 */
 	bool clearSync(dm_item_t item, hrt_abstime timeout = 5000_ms);
 
+	/**
+	 * @brief Reads consecutive indexes of an item synchronously with a single dataman request.
+	 *
+	 * @param[in] item The item to read data from.
+	 * @param[in] index The first index to read.
+	 * @param[in] count The number of consecutive indexes to read.
+	 * @param[out] buffer Pointer to the buffer to store count items of length bytes each.
+	 * @param[in] length The length of the data of each item.
+	 * @param[in] timeout The timeout in microseconds for waiting for the response.
+	 *
+	 * @return true if all items were read successfully within the timeout, false otherwise.
+	 *
+	 * @note The dataman accesses the buffer directly. If the dataman is already accessing it when the timeout
+	 *       expires, this waits until it is done, so that the buffer is never used after returning.
+	 */
+	bool readRange(dm_item_t item, uint32_t index, uint32_t count, uint8_t *buffer, uint32_t length,
+		       hrt_abstime timeout = 5000_ms);
+
+	/**
+	 * @brief Writes consecutive indexes of an item synchronously with a single dataman request.
+	 *
+	 * @param[in] item The data item type to write.
+	 * @param[in] index The first index to write.
+	 * @param[in] count The number of consecutive indexes to write.
+	 * @param[in] buffer The buffer that contains count items of length bytes each.
+	 * @param[in] length The length of the data of each item.
+	 * @param[in] timeout The maximum time in microseconds to wait for the response.
+	 *
+	 * @return True if all items were written successfully, false otherwise.
+	 *
+	 * @see readRange()
+	 */
+	bool writeRange(dm_item_t item, uint32_t index, uint32_t count, const uint8_t *buffer, uint32_t length,
+			hrt_abstime timeout = 5000_ms);
+
+	/**
+	 * @brief Clears consecutive indexes of an item synchronously with a single dataman request.
+	 *
+	 * @param[in] item The dataman item to clear.
+	 * @param[in] index The first index to clear.
+	 * @param[in] count The number of consecutive indexes to clear.
+	 * @param[in] timeout The timeout for the operation.
+	 *
+	 * @return True if the operation was successful, false otherwise.
+	 *
+	 * @see readRange()
+	 */
+	bool clearRange(dm_item_t item, uint32_t index, uint32_t count, hrt_abstime timeout = 5000_ms);
+
+	/**
+	 * @brief Opens a transaction: the following writes of this client are acknowledged before they are
+	 *        persistent, so that the dataman can sync many of them to storage at once.
+	 *
+	 * @param[in] timeout The timeout for the operation.
+	 *
+	 * @return True if the operation was successful, false otherwise.
+	 *
+	 * @note Writes still become persistent in order, at the latest a second after they were made.
+	 * @see commitTransaction()
+	 */
+	bool beginTransaction(hrt_abstime timeout = 1000_ms);
+
+	/**
+	 * @brief Closes the transaction and makes all writes persistent.
+	 *
+	 * @param[in] timeout The timeout for the operation.
+	 *
+	 * @return True if all writes are persistent, false otherwise.
+	 */
+	bool commitTransaction(hrt_abstime timeout = 5000_ms);
+
 	/**
 	 * @brief Initiates an asynchronous request to read the data from dataman for a specific item and index.
 	 *
@@ -153,6 +225,24 @@ public:
 	 */
 	void abortCurrentOperation();
 
+	/**
+	 * @brief Claim the buffer of a range request, called by the dataman before it accesses the buffer.
+	 *
+	 * @param[in] client_id The client that sent the request.
+	 * @param[in] timestamp The timestamp of the request.
+	 *
+	 * @return false if the client does not offer its buffer for this request anymore, because it timed out or
+	 *         the request was already served. The buffer must not be accessed then.
+	 */
+	static bool claimRangeBuffer(uint8_t client_id, hrt_abstime timestamp);
+
+	/**
+	 * @brief Hand a buffer claimed with claimRangeBuffer() back to the client, before responding to the request.
+	 *
+	 * @param[in] client_id The client that sent the request.
+	 */
+	static void releaseRangeBuffer(uint8_t client_id);
+
 private:
 
 	enum class State {
@@ -174,6 +264,13 @@ private:
 	bool syncHandler(const dataman_request_s &request, dataman_response_s &response,
 			 const hrt_abstime &start_time, hrt_abstime timeout);
 
+	/* Synchronous transaction request handler */
+	bool transactionSync(dm_function_t request_type, hrt_abstime timeout);
+
+	/* Synchronous range request handler */
+	bool rangeSync(dm_function_t request_type, dm_item_t item, uint32_t index, uint32_t count, const uint8_t *buffer,
+		       uint32_t length, hrt_abstime timeout);
+
 	State _state{State::Idle};
 	Request _active_request{};
 	uint8_t _response_status{};
@@ -188,6 +285,12 @@ private:
 	perf_counter_t _sync_perf{nullptr};
 
 	static constexpr uint8_t CLIENT_ID_NOT_SET{0};
+
+	static constexpr uint64_t RANGE_BUFFER_CLAIMED{1ULL << 63};
+
+	/* Per client: timestamp of the range request the buffer is offered for, with RANGE_BUFFER_CLAIMED set while the
+	 * dataman accesses it, 0 if no buffer is offered */
+	static px4::atomic<uint64_t> _range_buffer_owner[UINT8_MAX + 1];
 };
 
 
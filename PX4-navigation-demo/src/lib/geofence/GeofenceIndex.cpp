@@ -0,0 +1,506 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "GeofenceIndex.hpp"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include <mathlib/mathlib.h>
+
+GeofenceIndex::~GeofenceIndex()
+{
+	delete[] _shapes;
+	delete[] _vertices;
+	delete[] _band_offsets;
+	delete[] _band_edges;
+}
+
+template<typename T>
+bool GeofenceIndex::grow(T *&array, uint32_t &capacity, uint32_t required)
+{
+	if (required <= capacity) {
+		return true;
+	}
+
+	uint32_t new_capacity = math::max(required, capacity + capacity / 2);
+	T *new_array = new T[new_capacity];
+
+	if (new_array == nullptr) {
+		return false;
+	}
+
+	if (array != nullptr) {
+		memcpy(new_array, array, sizeof(T) * capacity);
+		delete[] array;
+	}
+
+	array = new_array;
+	capacity = new_capacity;
+	return true;
+}
+
+void GeofenceIndex::reset(double ref_lat, double ref_lon)
+{
+	_projection.initReference(ref_lat, ref_lon);
+	_num_shapes = 0;
+	_num_vertices = 0;
+	_num_band_offsets = 0;
+	_num_band_edges = 0;
+	_building_polygon = false;
+}
+
+bool GeofenceIndex::reserve(int max_shapes, int max_vertices)
+{
+	return grow(_shapes, _max_shapes, max_shapes) && grow(_vertices, _max_vertices, max_vertices);
+}
+
+GeofenceIndex::Shape *GeofenceIndex::appendShape(ShapeType type)
+{
+	if (_building_polygon || !grow(_shapes, _max_shapes, _num_shapes + 1)) {
+		return nullptr;
+	}
+
+	Shape &shape = _shapes[_num_shapes];
+	shape = {};
+	shape.type = type;
+	shape.first_vertex = _num_vertices;
+	shape.first_band = _num_band_offsets;
+	return &shape;
+}
+
+bool GeofenceIndex::beginPolygon(ShapeType type)
+{
+	if (appendShape(type) == nullptr) {
+		return false;
+	}
+
+	_building_polygon = true;
+	return true;
+}
+
+bool GeofenceIndex::addVertex(double lat, double lon)
+{
+	if (!_building_polygon || _shapes[_num_shapes].vertex_count == UINT16_MAX
+	    || !grow(_vertices, _max_vertices, _num_vertices + 1)) {
+		return false;
+	}
+
+	Shape &shape = _shapes[_num_shapes];
+	Vertex &vertex = _vertices[_num_vertices++];
+	_projection.project(lat, lon, vertex.x, vertex.y);
+	++shape.vertex_count;
+	return true;
+}
+
+bool GeofenceIndex::endPolygon()
+{
+	if (!_building_polygon) {
+		return false;
+	}
+
+	_building_polygon = false;
+	Shape &shape = _shapes[_num_shapes];
+
+	if (shape.vertex_count < 3) {
+		// a polygon needs at least 3 vertices to enclose an area
+		_num_vertices = shape.first_vertex;
+		shape.vertex_count = 0;
+		shape.box = {0.f, 0.f, -1.f, -1.f};
+		++_num_shapes;
+		return true;
+	}
+
+	const Vertex *vertices = &_vertices[shape.first_vertex];
+	shape.box = {vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y};
+
+	for (int i = 1; i < shape.vertex_count; ++i) {
+		shape.box.min_x = math::min(shape.box.min_x, vertices[i].x);
+		shape.box.min_y = math::min(shape.box.min_y, vertices[i].y);
+		shape.box.max_x = math::max(shape.box.max_x, vertices[i].x);
+		shape.box.max_y = math::max(shape.box.max_y, vertices[i].y);
+	}
+
+	if (!buildBuckets(shape)) {
+		_num_vertices = shape.first_vertex;
+		return false;
+	}
+
+	++_num_shapes;
+	return true;
+}
+
+bool GeofenceIndex::addCircle(ShapeType type, double lat, double lon, float radius)
+{
+	Shape *shape_ptr = appendShape(type);
+
+	if (shape_ptr == nullptr) {
+		return false;
+	}
+
+	Shape &shape = *shape_ptr;
+	shape.radius = radius;
+	_projection.project(lat, lon, shape.center.x, shape.center.y);
+	shape.box = {shape.center.x - radius, shape.center.y - radius, shape.center.x + radius, shape.center.y + radius};
+	++_num_shapes;
+	return true;
+}
+
+void GeofenceIndex::removeLastShape()
+{
+	if (_num_shapes == 0 || _building_polygon) {
+		return;
+	}
+
+	const Shape &shape = _shapes[--_num_shapes];
+	_num_vertices = shape.first_vertex;
+
+	if (shape.band_count > 0) {
+		_num_band_edges = _band_offsets[shape.first_band];
+		_num_band_offsets = shape.first_band;
+	}
+}
+
+int GeofenceIndex::bandIndex(const Shape &shape, float y) const
+{
+	const int band = static_cast<int>((y - shape.box.min_y) * shape.band_scale);
+	return math::constrain(band, 0, shape.band_count - 1);
+}
+
+bool GeofenceIndex::buildBuckets(Shape &shape)
+{
+	const float width = shape.box.max_y - shape.box.min_y;
+	shape.band_count = (width > FLT_EPSILON) ? math::min(static_cast<int>(shape.vertex_count), kMaxBandsPerPolygon) : 1;
+	shape.band_scale = (width > FLT_EPSILON) ? shape.band_count / width : 0.f;
+	shape.first_band = _num_band_offsets;
+
+	if (!grow(_band_offsets, _max_band_offsets, _num_band_offsets + shape.band_count + 1)) {
+		shape.band_count = 0;
+		return false;
+	}
+
+	uint32_t *offsets = &_band_offsets[shape.first_band];
+	memset(offsets, 0, sizeof(uint32_t) * (shape.band_count + 1));
+
+	const Vertex *vertices = &_vertices[shape.first_vertex];
+
+	// first pass: count the edges overlapping each band
+	for (int i = 0, j = shape.vertex_count - 1; i < shape.vertex_count; j = i++) {
+		const int first = bandIndex(shape, math::min(vertices[i].y, vertices[j].y));
+		const int last = bandIndex(shape, math::max(vertices[i].y, vertices[j].y));
+
+		for (int band = first; band <= last; ++band) {
+			++offsets[band + 1];
+		}
+	}
+
+	// prefix sum: offsets[band] becomes the start of the bucket
+	offsets[0] = _num_band_edges;
+
+	for (int band = 1; band <= shape.band_count; ++band) {
+		offsets[band] += offsets[band - 1];
+	}
+
+	if (!grow(_band_edges, _max_band_edges, offsets[shape.band_count])) {
+		shape.band_count = 0;
+		return false;
+	}
+
+	// second pass: fill the buckets, using offsets[band] as write cursor
+	for (int i = 0, j = shape.vertex_count - 1; i < shape.vertex_count; j = i++) {
+		const int first = bandIndex(shape, math::min(vertices[i].y, vertices[j].y));
+		const int last = bandIndex(shape, math::max(vertices[i].y, vertices[j].y));
+
+		for (int band = first; band <= last; ++band) {
+			_band_edges[offsets[band]++] = static_cast<uint16_t>(i);
+		}
+	}
+
+	// the cursors now point to the end of each bucket, shift them back to the start
+	for (int band = shape.band_count; band > 0; --band) {
+		offsets[band] = offsets[band - 1];
+	}
+
+	offsets[0] = _num_band_edges;
+	_num_band_edges = offsets[shape.band_count];
+	_num_band_offsets += shape.band_count + 1;
+	return true;
+}
+
+bool GeofenceIndex::insideShape(int shape_index, double lat, double lon) const
+{
+	if (shape_index < 0 || shape_index >= _num_shapes) {
+		return false;
+	}
+
+	float x;
+	float y;
+	_projection.project(lat, lon, x, y);
+
+	const Shape &shape = _shapes[shape_index];
+	return shape.isCircle() ? insideCircle(shape, x, y) : insidePolygon(shape, x, y);
+}
+
+bool GeofenceIndex::checkShape(int shape_index, double lat, double lon) const
+{
+	if (shape_index < 0 || shape_index >= _num_shapes) {
+		return true;
+	}
+
+	const bool inside = insideShape(shape_index, lat, lon);
+	return _shapes[shape_index].isInclusion() ? inside : !inside;
+}
+
+bool GeofenceIndex::checkAll(double lat, double lon) const
+{
+	if (_num_shapes == 0) {
+		return true;
+	}
+
+	Vertex point;
+	_projection.project(lat, lon, point.x, point.y);
+
+	for (int i = 0; i < _num_shapes; ++i) {
+		if (!checkShape(_shapes[i], point)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool GeofenceIndex::checkShape(const Shape &shape, const Vertex &point) const
+{
+	const bool inside = shape.isCircle() ? insideCircle(shape, point.x, point.y) : insidePolygon(shape, point.x, point.y);
+	return inside == shape.isInclusion();
+}
+
+GeofenceIndex::PathBreach GeofenceIndex::firstBreachAlongPath(const matrix::Vector2d *path_lat_lon,
+		int num_points) const
+{
+	PathBreach result{};
+
+	if (_num_shapes == 0 || num_points < 1) {
+		return result;
+	}
+
+	Vertex a;
+	_projection.project(path_lat_lon[0](0), path_lat_lon[0](1), a.x, a.y);
+
+	for (int i = 0; i < _num_shapes; ++i) {
+		if (!checkShape(_shapes[i], a)) {
+			result.breach = true;
+			result.shape_index = i;
+			result.segment = 0;
+			return result;
+		}
+	}
+
+	// the start of every segment satisfies all shapes, so the first boundary crossing is a breach
+	float distance = 0.f;
+
+	for (int segment = 0; segment < num_points - 1; ++segment) {
+		Vertex b;
+		_projection.project(path_lat_lon[segment + 1](0), path_lat_lon[segment + 1](1), b.x, b.y);
+
+		result.shape_index = firstCrossedShape(a, b, result.fraction);
+		result.breach = result.shape_index >= 0;
+
+		const float length = matrix::Vector2f(b.x - a.x, b.y - a.y).norm();
+
+		if (result.breach) {
+			result.segment = segment;
+			result.distance = distance + result.fraction * length;
+			return result;
+		}
+
+		distance += length;
+		a = b;
+	}
+
+	return result;
+}
+
+GeofenceIndex::Vertex GeofenceIndex::project(double lat, double lon) const
+{
+	Vertex point;
+	_projection.project(lat, lon, point.x, point.y);
+	return point;
+}
+
+int GeofenceIndex::firstCrossedShape(const Vertex &a, const Vertex &b, float &t) const
+{
+	int shape_index = -1;
+
+	for (int i = 0; i < _num_shapes; ++i) {
+		float t_shape;
+
+		if (firstBoundaryCrossing(_shapes[i], a, b, t_shape) && (shape_index < 0 || t_shape < t)) {
+			shape_index = i;
+			t = t_shape;
+		}
+	}
+
+	return shape_index;
+}
+
+bool GeofenceIndex::firstBoundaryCrossing(const Shape &shape, const Vertex &a, const Vertex &b, float &t) const
+{
+	// reject segments that do not overlap the bounding box
+	if (math::max(a.x, b.x) < shape.box.min_x || math::min(a.x, b.x) > shape.box.max_x
+	    || math::max(a.y, b.y) < shape.box.min_y || math::min(a.y, b.y) > shape.box.max_y) {
+		return false;
+	}
+
+	return shape.isCircle() ? firstCircleCrossing(shape, a, b, t) : firstPolygonCrossing(shape, a, b, t);
+}
+
+bool GeofenceIndex::firstCircleCrossing(const Shape &shape, const Vertex &a, const Vertex &b, float &t) const
+{
+	// solve |a + t * (b - a) - center| = radius for the smallest t in [0, 1]
+	const float dx = b.x - a.x;
+	const float dy = b.y - a.y;
+	const float fx = a.x - shape.center.x;
+	const float fy = a.y - shape.center.y;
+
+	const float qa = dx * dx + dy * dy;
+	const float qb = 2.f * (fx * dx + fy * dy);
+	const float qc = fx * fx + fy * fy - shape.radius * shape.radius;
+	const float discriminant = qb * qb - 4.f * qa * qc;
+
+	if (qa < FLT_EPSILON || discriminant < 0.f || shape.radius < FLT_EPSILON) {
+		return false;
+	}
+
+	const float root = sqrtf(discriminant);
+	const float t0 = (-qb - root) / (2.f * qa);
+	const float t1 = (-qb + root) / (2.f * qa);
+
+	if (t0 >= 0.f && t0 <= 1.f) {
+		t = t0;
+		return true;
+	}
+
+	if (t1 >= 0.f && t1 <= 1.f) {
+		t = t1;
+		return true;
+	}
+
+	return false;
+}
+
+bool GeofenceIndex::firstPolygonCrossing(const Shape &shape, const Vertex &a, const Vertex &b, float &t) const
+{
+	if (shape.vertex_count == 0) {
+		return false;
+	}
+
+	const Vertex *vertices = &_vertices[shape.first_vertex];
+	const int first_band = bandIndex(shape, math::min(a.y, b.y));
+	const int last_band = bandIndex(shape, math::max(a.y, b.y));
+
+	// edges spanning several bands are listed in each of them, for long segments it is cheaper to walk all edges once
+	const bool walk_all_edges = (last_band - first_band + 1) * 2 > shape.band_count;
+	const uint32_t begin = walk_all_edges ? 0 : _band_offsets[shape.first_band + first_band];
+	const uint32_t end = walk_all_edges ? shape.vertex_count : _band_offsets[shape.first_band + last_band + 1];
+
+	const float dx = b.x - a.x;
+	const float dy = b.y - a.y;
+	bool found = false;
+
+	for (uint32_t k = begin; k < end; ++k) {
+		const int i = walk_all_edges ? static_cast<int>(k) : _band_edges[k];
+		const int j = (i == 0) ? shape.vertex_count - 1 : i - 1;
+		const Vertex &p = vertices[j];
+		const float ex = vertices[i].x - p.x;
+		const float ey = vertices[i].y - p.y;
+
+		const float denominator = dx * ey - dy * ex;
+
+		if (fabsf(denominator) < FLT_EPSILON) {
+			// parallel: a collinear overlap is crossed at the neighboring edges
+			continue;
+		}
+
+		const float px = p.x - a.x;
+		const float py = p.y - a.y;
+		const float t_segment = (px * ey - py * ex) / denominator;
+		const float u_edge = (px * dy - py * dx) / denominator;
+
+		if (t_segment >= 0.f && t_segment <= 1.f && u_edge >= 0.f && u_edge <= 1.f && (!found || t_segment < t)) {
+			t = t_segment;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+bool GeofenceIndex::insideCircle(const Shape &shape, float x, float y) const
+{
+	const float dx = x - shape.center.x;
+	const float dy = y - shape.center.y;
+	return dx * dx + dy * dy < shape.radius * shape.radius;
+}
+
+bool GeofenceIndex::insidePolygon(const Shape &shape, float x, float y) const
+{
+	if (shape.vertex_count == 0 || !shape.box.contains(x, y)) {
+		return false;
+	}
+
+	/**
+	 * PNPOLY - Point Inclusion in Polygon Test, W. Randolph Franklin (WRF),
+	 * restricted to the edges overlapping the band of the test point.
+	 * Only supports non-complex polygons (not self intersecting)
+	 */
+	const Vertex *vertices = &_vertices[shape.first_vertex];
+	const int band = bandIndex(shape, y);
+	const uint32_t begin = _band_offsets[shape.first_band + band];
+	const uint32_t end = _band_offsets[shape.first_band + band + 1];
+	bool c = false;
+
+	for (uint32_t k = begin; k < end; ++k) {
+		const int i = _band_edges[k];
+		const int j = (i == 0) ? shape.vertex_count - 1 : i - 1;
+		const Vertex &vi = vertices[i];
+		const Vertex &vj = vertices[j];
+
+		if ((vi.y >= y) != (vj.y >= y) && (x <= (vj.x - vi.x) * (y - vi.y) / (vj.y - vi.y) + vi.x)) {
+			c = !c;
+		}
+	}
+
+	return c;
+}
@@ -0,0 +1,224 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GeofenceIndex.hpp
+ *
+ * Precompiled in-RAM representation of a set of geofence polygons and circles.
+ *
+ * All vertices are projected once into a local frame (x north, y east [m]) around a fixed
+ * reference and stored in one contiguous array. Each polygon keeps its bounding box and an
+ * edge-bucket index: the east extent of the polygon is split into equally sized bands and
+ * every band lists the edges overlapping it. A point-in-polygon test then only has to look at
+ * the edges of the single band containing the point.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <lib/geo/geo.h>
+
+class GeofenceIndex
+{
+public:
+	enum class ShapeType : uint8_t {
+		PolygonInclusion,
+		PolygonExclusion,
+		CircleInclusion,
+		CircleExclusion
+	};
+
+	struct Box {
+		float min_x;
+		float min_y;
+		float max_x;
+		float max_y;
+
+		bool contains(float x, float y) const { return x >= min_x && x <= max_x && y >= min_y && y <= max_y; }
+	};
+
+	struct Vertex {
+		float x; ///< north [m]
+		float y; ///< east [m]
+	};
+
+	struct Shape {
+		ShapeType type;
+		uint16_t vertex_count;   ///< number of polygon vertices, 0 for circles and degenerate polygons
+		uint32_t first_vertex;   ///< index of the first vertex in the vertex array
+		uint32_t first_band;     ///< index of the first band offset in the band offset array
+		uint16_t band_count;     ///< number of edge buckets
+		float band_scale;        ///< inverse band width [1/m]
+		float radius;            ///< circle radius [m]
+		Vertex center;           ///< circle center
+		Box box;                 ///< local frame bounding box
+
+		bool isCircle() const { return type == ShapeType::CircleInclusion || type == ShapeType::CircleExclusion; }
+		bool isInclusion() const { return type == ShapeType::PolygonInclusion || type == ShapeType::CircleInclusion; }
+	};
+
+	/**
+	 * Result of a path query: the first point along the path where any shape is violated.
+	 * If the path is sampled at a fixed time step dt, the time to the breach is (segment + fraction) * dt.
+	 */
+	struct PathBreach {
+		bool breach{false};   ///< true if the path violates a shape
+		int shape_index{-1};  ///< shape that is violated first
+		int segment{-1};      ///< path segment containing the breach, 0 if the start point already violates
+		float fraction{0.f};  ///< position of the breach along the segment [0, 1]
+		float distance{0.f};  ///< distance along the path to the breach [m]
+	};
+
+	static constexpr int kMaxBandsPerPolygon = 256;
+
+	GeofenceIndex() = default;
+	~GeofenceIndex();
+
+	GeofenceIndex(const GeofenceIndex &) = delete;
+	GeofenceIndex &operator=(const GeofenceIndex &) = delete;
+
+	/**
+	 * Drop all shapes and set the projection reference for the next build.
+	 * Allocated storage is kept for reuse.
+	 */
+	void reset(double ref_lat, double ref_lon);
+
+	/**
+	 * Preallocate storage for the given number of shapes and vertices, so that building
+	 * the index does not need to grow the arrays.
+	 * @return false if the allocation failed
+	 */
+	bool reserve(int max_shapes, int max_vertices);
+
+	/**
+	 * Start a new polygon. Vertices are added with addVertex() and the polygon is finalized
+	 * with endPolygon(). Polygons with less than 3 vertices never contain any point.
+	 */
+	bool beginPolygon(ShapeType type);
+	bool addVertex(double lat, double lon);
+	bool endPolygon();
+
+	bool addCircle(ShapeType type, double lat, double lon, float radius);
+
+	/**
+	 * Remove the most recently added shape together with its vertices and buckets.
+	 */
+	void removeLastShape();
+
+	/**
+	 * @return true if the point is within the area of the shape (ignoring inclusion/exclusion)
+	 */
+	bool insideShape(int shape_index, double lat, double lon) const;
+
+	/**
+	 * @return true if the point satisfies the shape: inside an inclusion, outside an exclusion
+	 */
+	bool checkShape(int shape_index, double lat, double lon) const;
+
+	/**
+	 * @return true if the point satisfies all shapes (an empty index accepts all points)
+	 */
+	bool checkAll(double lat, double lon) const;
+
+	/**
+	 * Find the first breach along a horizontal polyline, testing all shapes in a single pass
+	 * over the path. Each segment is intersected exactly with the polygon edges of the bands
+	 * it crosses and with the circle boundaries, no sampling is involved.
+	 * @param path_lat_lon path points as latitude/longitude [deg]
+	 */
+	PathBreach firstBreachAlongPath(const matrix::Vector2d *path_lat_lon, int num_points) const;
+
+	/**
+	 * Project a position into the local frame of the index
+	 */
+	Vertex project(double lat, double lon) const;
+
+	/**
+	 * Exact intersection of a segment in the local frame with the shape boundaries. Only shapes
+	 * whose bounding box the segment overlaps are tested, polygons only with the edges of the
+	 * bands the segment spans. Callers checking many segments, e.g. all legs of a mission,
+	 * project each point once with project() and share it between consecutive segments.
+	 * @param t position of the first crossing along the segment [0, 1]
+	 * @return index of the shape whose boundary is crossed first, -1 if none
+	 */
+	int firstCrossedShape(const Vertex &a, const Vertex &b, float &t) const;
+
+	int numShapes() const { return _num_shapes; }
+	int numVertices() const { return static_cast<int>(_num_vertices); }
+	int numBucketEntries() const { return static_cast<int>(_num_band_edges); }
+	const Shape &shape(int shape_index) const { return _shapes[shape_index]; }
+	const Vertex *vertices() const { return _vertices; }
+	const MapProjection &projection() const { return _projection; }
+
+private:
+	bool insidePolygon(const Shape &shape, float x, float y) const;
+	bool insideCircle(const Shape &shape, float x, float y) const;
+
+	Shape *appendShape(ShapeType type);
+	bool checkShape(const Shape &shape, const Vertex &point) const;
+
+	/**
+	 * Find the first crossing of the segment a-b with the boundary of a shape
+	 * @param t position of the crossing along the segment [0, 1]
+	 * @return true if the segment crosses the boundary
+	 */
+	bool firstBoundaryCrossing(const Shape &shape, const Vertex &a, const Vertex &b, float &t) const;
+	bool firstCircleCrossing(const Shape &shape, const Vertex &a, const Vertex &b, float &t) const;
+	bool firstPolygonCrossing(const Shape &shape, const Vertex &a, const Vertex &b, float &t) const;
+
+	bool buildBuckets(Shape &shape);
+	int bandIndex(const Shape &shape, float y) const;
+
+	template<typename T>
+	static bool grow(T *&array, uint32_t &capacity, uint32_t required);
+
+	MapProjection _projection{};
+
+	Shape *_shapes{nullptr};
+	int _num_shapes{0};
+	uint32_t _max_shapes{0};
+	bool _building_polygon{false};
+
+	Vertex *_vertices{nullptr};
+	uint32_t _num_vertices{0};
+	uint32_t _max_vertices{0};
+
+	uint32_t *_band_offsets{nullptr}; ///< per polygon band_count + 1 offsets into _band_edges
+	uint32_t _num_band_offsets{0};
+	uint32_t _max_band_offsets{0};
+
+	uint16_t *_band_edges{nullptr}; ///< polygon-local edge indices (edge i connects vertex i-1 and i)
+	uint32_t _num_band_edges{0};
+	uint32_t _max_band_edges{0};
+};
@@ -0,0 +1,381 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include "GeofenceIndex.hpp"
+
+using ShapeType = GeofenceIndex::ShapeType;
+
+static constexpr double kRefLat = 47.397742;
+static constexpr double kRefLon = 8.545594;
+
+class GeofenceIndexTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_proj.initReference(kRefLat, kRefLon);
+		_index.reset(kRefLat, kRefLon);
+	}
+
+	// add a polygon given in local coordinates around the reference
+	void addPolygon(ShapeType type, const float (*points)[2], int count)
+	{
+		ASSERT_TRUE(_index.beginPolygon(type));
+
+		for (int i = 0; i < count; ++i) {
+			double lat, lon;
+			_proj.reproject(points[i][0], points[i][1], lat, lon);
+			ASSERT_TRUE(_index.addVertex(lat, lon));
+		}
+
+		ASSERT_TRUE(_index.endPolygon());
+	}
+
+	bool check(float x, float y)
+	{
+		double lat, lon;
+		_proj.reproject(x, y, lat, lon);
+		return _index.checkAll(lat, lon);
+	}
+
+protected:
+	MapProjection _proj;
+	GeofenceIndex _index;
+};
+
+TEST_F(GeofenceIndexTest, emptyIndexAcceptsAll)
+{
+	EXPECT_TRUE(check(0.f, 0.f));
+	EXPECT_TRUE(check(1e4f, -1e4f));
+}
+
+TEST_F(GeofenceIndexTest, squareInclusion)
+{
+	// GIVEN: a 200m x 200m inclusion square centered at the reference
+	const float square[][2] = {{-100.f, -100.f}, {100.f, -100.f}, {100.f, 100.f}, {-100.f, 100.f}};
+	addPolygon(ShapeType::PolygonInclusion, square, 4);
+
+	// THEN: points inside pass, points outside fail
+	EXPECT_TRUE(check(0.f, 0.f));
+	EXPECT_TRUE(check(99.f, -99.f));
+	EXPECT_FALSE(check(101.f, 0.f));
+	EXPECT_FALSE(check(0.f, -101.f));
+	EXPECT_FALSE(check(500.f, 500.f));
+}
+
+TEST_F(GeofenceIndexTest, exclusionInsideInclusion)
+{
+	// GIVEN: an inclusion square with an exclusion square and an exclusion circle inside
+	const float outer[][2] = {{-100.f, -100.f}, {100.f, -100.f}, {100.f, 100.f}, {-100.f, 100.f}};
+	const float inner[][2] = {{-10.f, -10.f}, {10.f, -10.f}, {10.f, 10.f}, {-10.f, 10.f}};
+	addPolygon(ShapeType::PolygonInclusion, outer, 4);
+	addPolygon(ShapeType::PolygonExclusion, inner, 4);
+
+	double lat, lon;
+	_proj.reproject(50.f, 50.f, lat, lon);
+	ASSERT_TRUE(_index.addCircle(ShapeType::CircleExclusion, lat, lon, 20.f));
+
+	// THEN
+	EXPECT_FALSE(check(0.f, 0.f));
+	EXPECT_TRUE(check(20.f, 0.f));
+	EXPECT_FALSE(check(55.f, 45.f));
+	EXPECT_TRUE(check(75.f, 50.f));
+	EXPECT_FALSE(check(150.f, 0.f));
+}
+
+TEST_F(GeofenceIndexTest, circleInclusion)
+{
+	// GIVEN: an inclusion circle of 50m radius
+	ASSERT_TRUE(_index.addCircle(ShapeType::CircleInclusion, kRefLat, kRefLon, 50.f));
+
+	// THEN
+	EXPECT_TRUE(check(0.f, 0.f));
+	EXPECT_TRUE(check(30.f, 30.f));
+	EXPECT_FALSE(check(40.f, 40.f));
+}
+
+TEST_F(GeofenceIndexTest, degeneratePolygonContainsNothing)
+{
+	// GIVEN: an inclusion "polygon" with 2 vertices
+	const float line[][2] = {{-100.f, 0.f}, {100.f, 0.f}};
+	addPolygon(ShapeType::PolygonInclusion, line, 2);
+
+	// THEN: no point is inside
+	EXPECT_EQ(_index.numShapes(), 1);
+	EXPECT_FALSE(check(0.f, 0.f));
+}
+
+TEST_F(GeofenceIndexTest, removeLastShape)
+{
+	// GIVEN: an inclusion square followed by an exclusion covering the center
+	const float outer[][2] = {{-100.f, -100.f}, {100.f, -100.f}, {100.f, 100.f}, {-100.f, 100.f}};
+	const float inner[][2] = {{-10.f, -10.f}, {10.f, -10.f}, {10.f, 10.f}, {-10.f, 10.f}};
+	addPolygon(ShapeType::PolygonInclusion, outer, 4);
+	const int bucket_entries = _index.numBucketEntries();
+	addPolygon(ShapeType::PolygonExclusion, inner, 4);
+	EXPECT_FALSE(check(0.f, 0.f));
+
+	// WHEN: the exclusion is removed again
+	_index.removeLastShape();
+
+	// THEN: its storage is released and the center is accepted
+	EXPECT_EQ(_index.numShapes(), 1);
+	EXPECT_EQ(_index.numVertices(), 4);
+	EXPECT_EQ(_index.numBucketEntries(), bucket_entries);
+	EXPECT_TRUE(check(0.f, 0.f));
+
+	// and a new shape can be added in its place
+	addPolygon(ShapeType::PolygonExclusion, inner, 4);
+	EXPECT_FALSE(check(0.f, 0.f));
+}
+
+TEST_F(GeofenceIndexTest, largePolygonMatchesPnpoly)
+{
+	// GIVEN: a flower shaped (non-convex) polygon with 1000 vertices
+	static constexpr int N = 1000;
+	float flower[N][2];
+
+	for (int i = 0; i < N; ++i) {
+		const float angle = 2.f * M_PI_F * i / N;
+		const float radius = 800.f + 250.f * sinf(7.f * angle);
+		flower[i][0] = radius * cosf(angle);
+		flower[i][1] = radius * sinf(angle);
+	}
+
+	addPolygon(ShapeType::PolygonInclusion, flower, N);
+
+	// the bucket index must be smaller than a full edge walk per band
+	EXPECT_LT(_index.numBucketEntries(), N * 4);
+
+	// WHEN: testing a grid of points
+	const GeofenceIndex::Vertex *vertices = _index.vertices();
+
+	for (float x = -1100.f; x <= 1100.f; x += 37.f) {
+		for (float y = -1100.f; y <= 1100.f; y += 41.f) {
+			double lat, lon;
+			_proj.reproject(x, y, lat, lon);
+
+			float px, py;
+			_index.projection().project(lat, lon, px, py);
+
+			// reference: plain PNPOLY over all edges
+			bool c = false;
+
+			for (int i = 0, j = N - 1; i < N; j = i++) {
+				if ((vertices[i].y >= py) != (vertices[j].y >= py)
+				    && (px <= (vertices[j].x - vertices[i].x) * (py - vertices[i].y) / (vertices[j].y - vertices[i].y) + vertices[i].x)) {
+					c = !c;
+				}
+			}
+
+			// THEN: the result is the same as walking all edges
+			EXPECT_EQ(_index.checkAll(lat, lon), c) << "x: " << x << " y: " << y;
+		}
+	}
+}
+
+TEST_F(GeofenceIndexTest, pathInsideHasNoBreach)
+{
+	// GIVEN: an inclusion square and a path staying inside
+	const float square[][2] = {{-100.f, -100.f}, {100.f, -100.f}, {100.f, 100.f}, {-100.f, 100.f}};
+	addPolygon(ShapeType::PolygonInclusion, square, 4);
+
+	matrix::Vector2d path[3];
+	_proj.reproject(-50.f, -50.f, path[0](0), path[0](1));
+	_proj.reproject(50.f, -50.f, path[1](0), path[1](1));
+	_proj.reproject(50.f, 50.f, path[2](0), path[2](1));
+
+	// THEN
+	EXPECT_FALSE(_index.firstBreachAlongPath(path, 3).breach);
+}
+
+TEST_F(GeofenceIndexTest, pathStartingOutsideBreachesImmediately)
+{
+	const float square[][2] = {{-100.f, -100.f}, {100.f, -100.f}, {100.f, 100.f}, {-100.f, 100.f}};
+	addPolygon(ShapeType::PolygonInclusion, square, 4);
+
+	matrix::Vector2d path[2];
+	_proj.reproject(150.f, 0.f, path[0](0), path[0](1));
+	_proj.reproject(0.f, 0.f, path[1](0), path[1](1));
+
+	const GeofenceIndex::PathBreach breach = _index.firstBreachAlongPath(path, 2);
+	EXPECT_TRUE(breach.breach);
+	EXPECT_EQ(breach.shape_index, 0);
+	EXPECT_EQ(breach.segment, 0);
+	EXPECT_FLOAT_EQ(breach.distance, 0.f);
+}
+
+TEST_F(GeofenceIndexTest, pathCrossingExclusionBetweenValidPoints)
+{
+	// GIVEN: an inclusion square with a thin exclusion strip at x in [10, 12]
+	const float outer[][2] = {{-100.f, -100.f}, {100.f, -100.f}, {100.f, 100.f}, {-100.f, 100.f}};
+	const float strip[][2] = {{10.f, -50.f}, {12.f, -50.f}, {12.f, 50.f}, {10.f, 50.f}};
+	addPolygon(ShapeType::PolygonInclusion, outer, 4);
+	addPolygon(ShapeType::PolygonExclusion, strip, 4);
+
+	// WHEN: a path goes north across the strip, both vertices are valid
+	matrix::Vector2d path[3];
+	_proj.reproject(-40.f, 0.f, path[0](0), path[0](1));
+	_proj.reproject(0.f, 0.f, path[1](0), path[1](1));
+	_proj.reproject(40.f, 0.f, path[2](0), path[2](1));
+	EXPECT_TRUE(_index.checkAll(path[1](0), path[1](1)));
+	EXPECT_TRUE(_index.checkAll(path[2](0), path[2](1)));
+
+	// THEN: the breach is found on the second segment, 50m along the path
+	const GeofenceIndex::PathBreach breach = _index.firstBreachAlongPath(path, 3);
+	EXPECT_TRUE(breach.breach);
+	EXPECT_EQ(breach.shape_index, 1);
+	EXPECT_EQ(breach.segment, 1);
+	EXPECT_NEAR(breach.fraction, 0.25f, 1e-3f);
+	EXPECT_NEAR(breach.distance, 50.f, 0.05f);
+}
+
+TEST_F(GeofenceIndexTest, pathLeavingCircle)
+{
+	// GIVEN: an inclusion circle of 50m radius and an exclusion circle of 10m radius at 30m north
+	ASSERT_TRUE(_index.addCircle(ShapeType::CircleInclusion, kRefLat, kRefLon, 50.f));
+	double lat, lon;
+	_proj.reproject(30.f, 0.f, lat, lon);
+	ASSERT_TRUE(_index.addCircle(ShapeType::CircleExclusion, lat, lon, 10.f));
+
+	// WHEN: going east from the center, the inclusion circle is left after 50m
+	matrix::Vector2d path[2];
+	path[0] = matrix::Vector2d(kRefLat, kRefLon);
+	_proj.reproject(0.f, 100.f, path[1](0), path[1](1));
+
+	GeofenceIndex::PathBreach breach = _index.firstBreachAlongPath(path, 2);
+	EXPECT_TRUE(breach.breach);
+	EXPECT_EQ(breach.shape_index, 0);
+	EXPECT_NEAR(breach.distance, 50.f, 0.05f);
+
+	// WHEN: going north, the exclusion circle is entered after 20m
+	_proj.reproject(100.f, 0.f, path[1](0), path[1](1));
+	breach = _index.firstBreachAlongPath(path, 2);
+	EXPECT_TRUE(breach.breach);
+	EXPECT_EQ(breach.shape_index, 1);
+	EXPECT_NEAR(breach.distance, 20.f, 0.05f);
+}
+
+TEST_F(GeofenceIndexTest, pathThroughLargePolygonMatchesSampling)
+{
+	// GIVEN: a flower shaped polygon with 1000 vertices
+	static constexpr int N = 1000;
+	float flower[N][2];
+
+	for (int i = 0; i < N; ++i) {
+		const float angle = 2.f * M_PI_F * i / N;
+		const float radius = 800.f + 250.f * sinf(7.f * angle);
+		flower[i][0] = radius * cosf(angle);
+		flower[i][1] = radius * sinf(angle);
+	}
+
+	addPolygon(ShapeType::PolygonInclusion, flower, N);
+
+	// WHEN: shooting rays from the center in different directions
+	for (int k = 0; k < 36; ++k) {
+		const float angle = 2.f * M_PI_F * k / 36.f + 0.01f;
+		matrix::Vector2d path[2];
+		path[0] = matrix::Vector2d(kRefLat, kRefLon);
+		_proj.reproject(1200.f * cosf(angle), 1200.f * sinf(angle), path[1](0), path[1](1));
+
+		const GeofenceIndex::PathBreach breach = _index.firstBreachAlongPath(path, 2);
+		ASSERT_TRUE(breach.breach);
+
+		// THEN: the breach distance matches sampling the ray with point checks in 0.5m steps
+		float sampled_distance = 0.f;
+
+		while (sampled_distance < 1200.f) {
+			double lat, lon;
+			_proj.reproject(sampled_distance * cosf(angle), sampled_distance * sinf(angle), lat, lon);
+
+			if (!_index.checkAll(lat, lon)) {
+				break;
+			}
+
+			sampled_distance += 0.5f;
+		}
+
+		EXPECT_NEAR(breach.distance, sampled_distance, 0.6f) << "angle: " << angle;
+	}
+}
+
+TEST_F(GeofenceIndexTest, segmentCrossingShapesBetweenOutsidePoints)
+{
+	// GIVEN: an exclusion square and an exclusion circle, no inclusion area
+	const float square[][2] = {{-10.f, -10.f}, {10.f, -10.f}, {10.f, 10.f}, {-10.f, 10.f}};
+	addPolygon(ShapeType::PolygonExclusion, square, 4);
+	double lat, lon;
+	_proj.reproject(100.f, 0.f, lat, lon);
+	ASSERT_TRUE(_index.addCircle(ShapeType::CircleExclusion, lat, lon, 20.f));
+
+	float t;
+
+	// WHEN: a segment passes through the square
+	GeofenceIndex::Vertex a{-50.f, 0.f};
+	GeofenceIndex::Vertex b{50.f, 0.f};
+
+	// THEN: the square boundary is crossed after 40m
+	EXPECT_EQ(_index.firstCrossedShape(a, b, t), 0);
+	EXPECT_NEAR(t, 0.4f, 1e-4f);
+
+	// WHEN: a segment crosses the circle as a chord, it is found from both directions
+	a = {100.f, -50.f};
+	b = {100.f, 50.f};
+	EXPECT_EQ(_index.firstCrossedShape(a, b, t), 1);
+	EXPECT_NEAR(t, 0.3f, 1e-4f);
+	EXPECT_EQ(_index.firstCrossedShape(b, a, t), 1);
+	EXPECT_NEAR(t, 0.3f, 1e-4f);
+
+	// WHEN: a segment passes between the shapes or stays short of them
+	a = {50.f, -50.f};
+	b = {50.f, 50.f};
+	EXPECT_EQ(_index.firstCrossedShape(a, b, t), -1);
+	a = {-50.f, 0.f};
+	b = {-11.f, 0.f};
+	EXPECT_EQ(_index.firstCrossedShape(a, b, t), -1);
+
+	// WHEN: the end points are given as global positions
+	_proj.reproject(-50.f, 0.f, lat, lon);
+	a = _index.project(lat, lon);
+	_proj.reproject(50.f, 0.f, lat, lon);
+	b = _index.project(lat, lon);
+
+	// THEN: they project into the frame of the index
+	EXPECT_NEAR(a.x, -50.f, 0.01f);
+	EXPECT_NEAR(a.y, 0.f, 0.01f);
+	EXPECT_EQ(_index.firstCrossedShape(a, b, t), 0);
+	EXPECT_NEAR(t, 0.4f, 1e-3f);
+}
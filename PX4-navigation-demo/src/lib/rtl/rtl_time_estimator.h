@@ -70,21 +70,6 @@ public:
 	void addWait(float time_s);
 	void setVehicleType(uint8_t vehicle_type) { _vehicle_type = vehicle_type; };
 
-private:
-	/**
-	 * @brief Get the Cruise Ground Speed
-	 *
-	 * @param direction_norm normalized direction in which to fly
-	 * @return Ground speed in cruise mode [m/s].
-	 */
-	float getCruiseGroundSpeed(const matrix::Vector2f &direction_norm);
-
-	/**
-	 * @brief Get time estimate of vertical distance
-	 *
-	 */
-	float calcVertTimeEstimate(float alt);
-
 	/**
 	 * @brief Get the climb rate
 	 *
@@ -113,6 +98,21 @@ private:
 	 */
 	matrix::Vector2f get_wind();
 
+private:
+	/**
+	 * @brief Get the Cruise Ground Speed
+	 *
+	 * @param direction_norm normalized direction in which to fly
+	 * @return Ground speed in cruise mode [m/s].
+	 */
+	float getCruiseGroundSpeed(const matrix::Vector2f &direction_norm);
+
+	/**
+	 * @brief Get time estimate of vertical distance
+	 *
+	 */
+	float calcVertTimeEstimate(float alt);
+
 	float _time_estimate{0.f}; 		/**< Accumulated time estimate [s] */
 	bool _is_valid{false};		/**< Checks if time estimate is valid */
 
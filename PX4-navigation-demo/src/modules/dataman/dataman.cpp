@@ -52,12 +52,22 @@
 #include <lib/perf/perf_counter.h>
 #include <stdlib.h>
 
+#if defined(CONFIG_DATAMAN_PERSISTENT_STORAGE) && defined(__PX4_POSIX)
+/* The file can be memory-mapped */
+#define DATAMAN_MMAP_STORAGE
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/dataman_request.h>
 #include <uORB/topics/dataman_response.h>
+#include <dataman_client/DatamanClient.hpp>
 
 #include "dataman.h"
+#include "dataman_journal.h"
+#include "dataman_mmap.h"
 
 __BEGIN_DECLS
 __EXPORT int dataman_main(int argc, char *argv[]);
@@ -70,6 +80,9 @@ static constexpr int TASK_STACK_SIZE = 1420;
 static ssize_t _file_write(dm_item_t item, unsigned index, const void *buf, size_t count);
 static ssize_t _file_read(dm_item_t item, unsigned index, void *buf, size_t count);
 static int  _file_clear(dm_item_t item);
+static ssize_t _file_write_range(dm_item_t item, unsigned index, unsigned num_items, const void *buf, size_t count);
+static ssize_t _file_read_range(dm_item_t item, unsigned index, unsigned num_items, void *buf, size_t count);
+static int _file_commit(hrt_abstime max_age);
 static int _file_initialize(unsigned max_offset);
 static void _file_shutdown();
 #endif
@@ -78,13 +91,31 @@ static void _file_shutdown();
 static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_t count);
 static ssize_t _ram_read(dm_item_t item, unsigned index, void *buf, size_t count);
 static int  _ram_clear(dm_item_t item);
+static ssize_t _ram_write_range(dm_item_t item, unsigned index, unsigned num_items, const void *buf, size_t count);
+static ssize_t _ram_read_range(dm_item_t item, unsigned index, unsigned num_items, void *buf, size_t count);
+static int _ram_commit(hrt_abstime max_age);
 static int _ram_initialize(unsigned max_offset);
 static void _ram_shutdown();
 
+#ifdef DATAMAN_MMAP_STORAGE
+/* Private memory-mapped file Operations, reads are the same as RAM */
+static ssize_t _mmap_write(dm_item_t item, unsigned index, const void *buf, size_t count);
+static int  _mmap_clear(dm_item_t item);
+static ssize_t _mmap_write_range(dm_item_t item, unsigned index, unsigned num_items, const void *buf, size_t count);
+static int _mmap_commit(hrt_abstime max_age);
+static int _mmap_initialize(unsigned max_offset);
+static void _mmap_shutdown();
+#endif
+
 typedef struct dm_operations_t {
 	ssize_t (*write)(dm_item_t item, unsigned index, const void *buf, size_t count);
 	ssize_t (*read)(dm_item_t item, unsigned index, void *buf, size_t count);
 	int (*clear)(dm_item_t item);
+	/* range operations on consecutive indexes, buf holds num_items * count bytes (nullptr to clear) */
+	ssize_t (*write_range)(dm_item_t item, unsigned index, unsigned num_items, const void *buf, size_t count);
+	ssize_t (*read_range)(dm_item_t item, unsigned index, unsigned num_items, void *buf, size_t count);
+	/* make deferred writes persistent, only if the oldest one is older than max_age (0 for all) */
+	int (*commit)(hrt_abstime max_age);
 	int (*initialize)(unsigned max_offset);
 	void (*shutdown)();
 	int (*wait)(px4_sem_t *sem);
@@ -95,6 +126,9 @@ static constexpr dm_operations_t dm_file_operations = {
 	.write   = _file_write,
 	.read    = _file_read,
 	.clear   = _file_clear,
+	.write_range = _file_write_range,
+	.read_range = _file_read_range,
+	.commit = _file_commit,
 	.initialize = _file_initialize,
 	.shutdown = _file_shutdown,
 	.wait = px4_sem_wait,
@@ -105,11 +139,28 @@ static constexpr dm_operations_t dm_ram_operations = {
 	.write   = _ram_write,
 	.read    = _ram_read,
 	.clear   = _ram_clear,
+	.write_range = _ram_write_range,
+	.read_range = _ram_read_range,
+	.commit = _ram_commit,
 	.initialize = _ram_initialize,
 	.shutdown = _ram_shutdown,
 	.wait = px4_sem_wait,
 };
 
+#ifdef DATAMAN_MMAP_STORAGE
+static constexpr dm_operations_t dm_mmap_operations = {
+	.write   = _mmap_write,
+	.read    = _ram_read,
+	.clear   = _mmap_clear,
+	.write_range = _mmap_write_range,
+	.read_range = _ram_read_range,
+	.commit = _mmap_commit,
+	.initialize = _mmap_initialize,
+	.shutdown = _mmap_shutdown,
+	.wait = px4_sem_wait,
+};
+#endif
+
 static const dm_operations_t *g_dm_ops;
 
 static struct {
@@ -130,6 +181,55 @@ static struct {
 static unsigned g_func_counts[DM_NUMBER_OF_FUNCS];
 
 #define DM_SECTOR_HDR_SIZE 4	/* data manager per item header overhead */
+#define DM_RANGE_CHUNK_SIZE 256	/* file backend range operations transfer up to this many bytes at once */
+
+/* Journal of the file backend
+ *
+ * Writes are not synced to the data manager file one by one. They are encoded as records (file offset, length,
+ * crc32 and the sectors) and coalesced in a RAM buffer, which also serves reads of the pending items. A commit
+ * appends the buffer to the journal file with a single write and fsync, and only then applies the records to
+ * the data manager file without syncing it. Once the journal grows beyond DM_JOURNAL_CHECKPOINT_SIZE the data
+ * manager file is synced and the journal emptied. At startup valid records left in the journal are replayed.
+ *
+ * Records are committed in the order they were written, so after a power loss the storage holds all
+ * acknowledged writes in order, as it did when every write was synced on its own.
+ * Clients not in a transaction get every write committed before the response.
+ */
+#define DM_JOURNAL_SUFFIX ".journal"
+#define DM_JOURNAL_BUFFER_SIZE 4096	/* RAM buffer of not yet committed records */
+#define DM_JOURNAL_CHECKPOINT_SIZE (64 * 1024)	/* sync the data manager file and empty the journal beyond this size */
+#define DM_JOURNAL_MAX_PENDING_TIME 1000000	/* [us] commit pending records of open transactions at least this often */
+
+#ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
+static struct {
+	int fd{-1};
+	char *path{nullptr};
+	uint8_t *buffer{nullptr};
+	size_t buffer_used{0};
+	hrt_abstime pending_since{0};	/* time of the oldest uncommitted record */
+	size_t size{0};			/* bytes in the journal file */
+	unsigned commits{0};
+	unsigned checkpoints{0};
+	unsigned replayed{0};
+} g_journal;
+#endif
+
+#ifdef DATAMAN_MMAP_STORAGE
+/* Memory-mapped file backend
+ *
+ * The data manager file is mapped into memory and accessed like the RAM backend. Written bytes are tracked as one
+ * dirty span, which is flushed with msync() on commit. As with the journal, a write is persistent when its response
+ * is sent unless the client opened a transaction. Within a transaction the kernel may write back pages in any order.
+ * A journal left by the file backend is applied to the mapping at startup and then emptied.
+ */
+static struct {
+	size_t size{0};			/* size of the mapping */
+	dm_dirty_span_t dirty;		/* unsynced bytes of the mapping */
+	unsigned syncs{0};
+	unsigned sync_failures{0};
+	int imported{0};		/* records applied from the journal of the file backend */
+} g_mmap;
+#endif
 
 /* Table of the len of each item type including HDR size */
 static constexpr size_t g_per_item_size_with_hdr[DM_KEY_NUM_KEYS] = {
@@ -163,6 +263,7 @@ static enum {
 	BACKEND_NONE = 0,
 	BACKEND_FILE,
 	BACKEND_RAM,
+	BACKEND_MMAP,
 	BACKEND_LAST
 } backend = BACKEND_NONE;
 
@@ -196,6 +297,58 @@ calculate_offset(dm_item_t item, unsigned index)
 	return g_key_offsets[item] + (index * g_per_item_size_with_hdr[item]);
 }
 
+/* Calculate the offset in file of the first item of a range, checking that the whole range is valid */
+static int
+calculate_range_offset(dm_item_t item, unsigned index, unsigned num_items, size_t count)
+{
+	if ((item >= DM_KEY_NUM_KEYS) || (num_items == 0) || (index >= g_per_item_max_index[item])) {
+		return -1;
+	}
+
+	/* Make sure the whole range is valid, without letting index + num_items wrap around */
+	if (num_items > g_per_item_max_index[item] - index) {
+		return -1;
+	}
+
+	/* Make sure the caller's items fit */
+	if (count > (g_per_item_size_with_hdr[item] - DM_SECTOR_HDR_SIZE)) {
+		return -E2BIG;
+	}
+
+	return calculate_offset(item, index);
+}
+
+/* Encode one item (header and data) for a range write, buf nullptr clears the item */
+static void
+encode_range_item(uint8_t *sector, unsigned i, const void *buf, size_t count)
+{
+	sector[0] = (buf != nullptr) ? count : 0;
+	sector[1] = 0;
+	sector[2] = 0;
+	sector[3] = 0;
+
+	if (buf != nullptr && count > 0) {
+		memcpy(sector + DM_SECTOR_HDR_SIZE, static_cast<const uint8_t *>(buf) + i * count, count);
+	}
+}
+
+/* Decode one item of a range read into the caller's buffer, empty items are zeroed */
+static int
+decode_range_item(const uint8_t *sector, unsigned i, void *buf, size_t count)
+{
+	uint8_t *dst = static_cast<uint8_t *>(buf) + i * count;
+
+	/* We got more than requested!!! */
+	if (sector[0] > count) {
+		return -1;
+	}
+
+	memcpy(dst, sector + DM_SECTOR_HDR_SIZE, sector[0]);
+	memset(dst + sector[0], 0, count - sector[0]);
+
+	return 0;
+}
+
 /* Each data item is stored as follows
  *
  * byte 0: Length of user data item
@@ -248,6 +401,176 @@ static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_
 }
 
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
+/* Write the records of the journal buffer to the data manager file */
+static int
+_file_journal_apply()
+{
+	int result = 0;
+	size_t pos = 0;
+
+	while (pos < g_journal.buffer_used) {
+		dm_journal_record_t record;
+		memcpy(&record, &g_journal.buffer[pos], sizeof(record));
+		pos += sizeof(record);
+
+		if ((lseek(dm_operations_data.file.fd, record.offset, SEEK_SET) != (off_t)record.offset) ||
+		    (write(dm_operations_data.file.fd, &g_journal.buffer[pos], record.length) != (ssize_t)record.length)) {
+			PX4_ERR("journal apply failed %d", errno);
+			result = -1;
+		}
+
+		pos += record.length;
+	}
+
+	return result;
+}
+
+/* Sync the data manager file, after which the content of the journal is not needed anymore */
+static int
+_file_journal_checkpoint()
+{
+	if (fsync(dm_operations_data.file.fd) != 0) {
+		/* The journal still protects the unsynced writes, keep it and retry at the next checkpoint */
+		PX4_ERR("file sync failed %d", errno);
+		return -1;
+	}
+
+	close(g_journal.fd);
+	g_journal.fd = open(g_journal.path, O_RDWR | O_CREAT | O_TRUNC | O_BINARY, PX4_O_MODE_666);
+	g_journal.size = 0;
+	g_journal.checkpoints++;
+
+	if (g_journal.fd < 0) {
+		PX4_ERR("journal reopen failed %d, syncing every write", errno);
+		return -1;
+	}
+
+	fsync(g_journal.fd);
+	return 0;
+}
+
+/* Make the pending records persistent */
+static int
+_file_commit(hrt_abstime max_age)
+{
+	if ((g_journal.buffer_used == 0) ||
+	    ((max_age > 0) && (hrt_elapsed_time(&g_journal.pending_since) < max_age))) {
+		return 0;
+	}
+
+	/* The records must be persistent in the journal before the data manager file is modified */
+	const bool journaled = (write(g_journal.fd, g_journal.buffer, g_journal.buffer_used) == (ssize_t)g_journal.buffer_used)
+			       && (fsync(g_journal.fd) == 0);
+
+	if (journaled) {
+		g_journal.size += g_journal.buffer_used;
+
+	} else {
+		/* The journal may end with a partial record, the checkpoint below syncs the data manager file instead */
+		PX4_ERR("journal write failed %d", errno);
+	}
+
+	int result = _file_journal_apply();
+
+	g_journal.buffer_used = 0;
+	g_journal.pending_since = 0;
+	g_journal.commits++;
+
+	if (!journaled || (g_journal.size > DM_JOURNAL_CHECKPOINT_SIZE)) {
+		if (_file_journal_checkpoint() < 0) {
+			result = -1;
+		}
+	}
+
+	return result;
+}
+
+/* Add sectors of the data manager file starting at offset to the journal buffer, committing it when full */
+static int
+_file_journal_append(unsigned offset, const uint8_t *data, size_t length)
+{
+	while (length > 0) {
+		const size_t max_length = DM_JOURNAL_BUFFER_SIZE - sizeof(dm_journal_record_t);
+		const size_t record_length = (length < max_length) ? length : max_length;
+
+		if (g_journal.buffer_used + sizeof(dm_journal_record_t) + record_length > DM_JOURNAL_BUFFER_SIZE) {
+			if (_file_commit(0) < 0) {
+				return -1;
+			}
+
+			if (g_journal.fd < 0) {
+				/* The commit disabled the journal, write the remaining sectors directly */
+				if ((lseek(dm_operations_data.file.fd, offset, SEEK_SET) != (off_t)offset) ||
+				    (write(dm_operations_data.file.fd, data, length) != (ssize_t)length)) {
+					return -1;
+				}
+
+				return fsync(dm_operations_data.file.fd);
+			}
+		}
+
+		g_journal.buffer_used += dm_journal_encode(&g_journal.buffer[g_journal.buffer_used], offset, data, record_length);
+
+		if (g_journal.pending_since == 0) {
+			g_journal.pending_since = hrt_absolute_time();
+		}
+
+		offset += record_length;
+		data += record_length;
+		length -= record_length;
+	}
+
+	return 0;
+}
+
+/* Copy the pending records overlapping [offset, offset + length) of the data manager file into data */
+static void
+_file_journal_overlay(unsigned offset, uint8_t *data, size_t length)
+{
+	size_t pos = 0;
+
+	while (pos < g_journal.buffer_used) {
+		dm_journal_record_t record;
+		memcpy(&record, &g_journal.buffer[pos], sizeof(record));
+		pos += sizeof(record);
+
+		const unsigned start = (offset > record.offset) ? offset : record.offset;
+		const unsigned end = (offset + length < record.offset + record.length) ? offset + length : record.offset + record.length;
+
+		if (start < end) {
+			memcpy(&data[start - offset], &g_journal.buffer[pos + start - record.offset], end - start);
+		}
+
+		pos += record.length;
+	}
+}
+
+static bool
+_file_journal_replay_record(uint32_t offset, const uint8_t *data, uint32_t length, void *arg)
+{
+	if ((lseek(dm_operations_data.file.fd, offset, SEEK_SET) != (off_t)offset) ||
+	    (write(dm_operations_data.file.fd, data, length) != (ssize_t)length)) {
+		PX4_ERR("journal replay failed %d", errno);
+		return false;
+	}
+
+	return true;
+}
+
+/* Apply the valid records left in the journal to the data manager file, then empty the journal */
+static void
+_file_journal_replay()
+{
+	g_journal.replayed = dm_journal_replay(g_journal.fd, g_journal.buffer, DM_JOURNAL_BUFFER_SIZE - sizeof(dm_journal_record_t),
+					       _file_journal_replay_record, nullptr);
+
+	if (g_journal.replayed > 0) {
+		PX4_INFO("replayed %u journal records", g_journal.replayed);
+	}
+
+	_file_journal_checkpoint();
+}
+
 /* write to the data manager file */
 static ssize_t
 _file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
@@ -283,6 +606,14 @@ _file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
 
 	count += DM_SECTOR_HDR_SIZE;
 
+	if (g_journal.fd >= 0) {
+		if (_file_journal_append(offset, buffer, count) < 0) {
+			return -1;
+		}
+
+		return count - DM_SECTOR_HDR_SIZE;
+	}
+
 	bool write_success = false;
 
 	for (int i = 0; i < 2; i++) {
@@ -434,6 +765,9 @@ _file_read(dm_item_t item, unsigned index, void *buf, size_t count)
 		buffer[0] = 0;
 	}
 
+	/* Items written but not committed yet are newer than the file content */
+	_file_journal_overlay(offset, buffer, count + DM_SECTOR_HDR_SIZE);
+
 	/* See if we got data */
 	if (buffer[0] > 0) {
 		/* We got more than requested!!! */
@@ -485,6 +819,49 @@ static int  _ram_clear(dm_item_t item)
 	return result;
 }
 
+static ssize_t _ram_write_range(dm_item_t item, unsigned index, unsigned num_items, const void *buf, size_t count)
+{
+	const int offset = calculate_range_offset(item, index, num_items, count);
+
+	if (offset < 0) {
+		return offset;
+	}
+
+	uint8_t *sector = &dm_operations_data.ram.data[offset];
+
+	for (unsigned i = 0; i < num_items; i++) {
+		if (sector > dm_operations_data.ram.data_end) {
+			return -1;
+		}
+
+		encode_range_item(sector, i, buf, count);
+		sector += g_per_item_size_with_hdr[item];
+	}
+
+	return num_items;
+}
+
+static ssize_t _ram_read_range(dm_item_t item, unsigned index, unsigned num_items, void *buf, size_t count)
+{
+	const int offset = calculate_range_offset(item, index, num_items, count);
+
+	if (offset < 0) {
+		return offset;
+	}
+
+	const uint8_t *sector = &dm_operations_data.ram.data[offset];
+
+	for (unsigned i = 0; i < num_items; i++) {
+		if ((sector > dm_operations_data.ram.data_end) || (decode_range_item(sector, i, buf, count) < 0)) {
+			return -1;
+		}
+
+		sector += g_per_item_size_with_hdr[item];
+	}
+
+	return num_items;
+}
+
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 static int
 _file_clear(dm_item_t item)
@@ -501,6 +878,13 @@ _file_clear(dm_item_t item)
 		return -1;
 	}
 
+	/* Clearing bypasses the journal, replaying older records must not bring the items back */
+	if (g_journal.fd >= 0) {
+		if ((_file_commit(0) < 0) || (_file_journal_checkpoint() < 0)) {
+			return -1;
+		}
+	}
+
 	int result = 0;
 
 	/* Clear all items of this type */
@@ -542,27 +926,110 @@ _file_clear(dm_item_t item)
 #endif
 
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
-static int
-_file_initialize(unsigned max_offset)
+/* write consecutive items to the data manager file with a single seek and sync */
+static ssize_t
+_file_write_range(dm_item_t item, unsigned index, unsigned num_items, const void *buf, size_t count)
 {
-	const bool file_existed = (access(k_data_manager_device_path, F_OK) == 0);
+	const int offset = calculate_range_offset(item, index, num_items, count);
 
-	/* Open or create the data manager file */
-	dm_operations_data.file.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+	if (offset < 0) {
+		return offset;
+	}
 
-	if (dm_operations_data.file.fd < 0) {
-		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
-		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+	const size_t sector_size = g_per_item_size_with_hdr[item];
+	const unsigned items_per_chunk = (sector_size < DM_RANGE_CHUNK_SIZE) ? DM_RANGE_CHUNK_SIZE / sector_size : 1;
+	uint8_t chunk[items_per_chunk * sector_size];
+
+	const bool journal = (g_journal.fd >= 0);
+
+	if (!journal && (lseek(dm_operations_data.file.fd, offset, SEEK_SET) != offset)) {
+		PX4_ERR("file write lseek failed %d", errno);
 		return -1;
 	}
 
-	if ((unsigned)lseek(dm_operations_data.file.fd, max_offset, SEEK_SET) != max_offset) {
-		close(dm_operations_data.file.fd);
-		PX4_WARN("Could not seek data manager file %s", k_data_manager_device_path);
-		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+	for (unsigned i = 0; i < num_items; i += items_per_chunk) {
+		const unsigned chunk_items = (num_items - i < items_per_chunk) ? num_items - i : items_per_chunk;
+
+		for (unsigned j = 0; j < chunk_items; j++) {
+			encode_range_item(&chunk[j * sector_size], i + j, buf, count);
+		}
+
+		const ssize_t len = chunk_items * sector_size;
+
+		if (journal) {
+			if (_file_journal_append(offset + i * sector_size, chunk, len) < 0) {
+				return -1;
+			}
+
+			continue;
+		}
+
+		const ssize_t ret_write = write(dm_operations_data.file.fd, chunk, len);
+
+		if (ret_write != len) {
+			PX4_ERR("file write failed, wrote %d bytes, expected %d", (int)ret_write, (int)len);
+			return -1;
+		}
+	}
+
+	/* Make sure data is written to physical media */
+	if (!journal) {
+		fsync(dm_operations_data.file.fd);
+	}
+
+	return num_items;
+}
+
+/* read consecutive items from the data manager file with a single seek */
+static ssize_t
+_file_read_range(dm_item_t item, unsigned index, unsigned num_items, void *buf, size_t count)
+{
+	const int offset = calculate_range_offset(item, index, num_items, count);
+
+	if (offset < 0) {
+		return offset;
+	}
+
+	const size_t sector_size = g_per_item_size_with_hdr[item];
+	const unsigned items_per_chunk = (sector_size < DM_RANGE_CHUNK_SIZE) ? DM_RANGE_CHUNK_SIZE / sector_size : 1;
+	uint8_t chunk[items_per_chunk * sector_size];
+
+	if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) != offset) {
+		PX4_ERR("file read lseek failed %d", errno);
 		return -1;
 	}
 
+	for (unsigned i = 0; i < num_items; i += items_per_chunk) {
+		const unsigned chunk_items = (num_items - i < items_per_chunk) ? num_items - i : items_per_chunk;
+		const ssize_t len = chunk_items * sector_size;
+		const ssize_t ret_read = read(dm_operations_data.file.fd, chunk, len);
+
+		if (ret_read < 0) {
+			PX4_ERR("file read failed %d", errno);
+			return -1;
+		}
+
+		/* A short read is past the end of the written file: treat as empty entries */
+		if (ret_read < len) {
+			memset(&chunk[ret_read], 0, len - ret_read);
+		}
+
+		_file_journal_overlay(offset + i * sector_size, chunk, len);
+
+		for (unsigned j = 0; j < chunk_items; j++) {
+			if (decode_range_item(&chunk[j * sector_size], i + j, buf, count) < 0) {
+				return -1;
+			}
+		}
+	}
+
+	return num_items;
+}
+
+/* Reset the storage if it was just created or has an incompatible layout */
+static void
+_file_check_compat(bool file_existed)
+{
 	dataman_compat_s compat_state{};
 
 	dm_operations_data.silence = true;
@@ -601,14 +1068,63 @@ _file_initialize(unsigned max_offset)
 		g_dm_ops->write(DM_KEY_MISSION_STATE, 0, reinterpret_cast<uint8_t *>(&mission), sizeof(mission_s));
 		g_dm_ops->write(DM_KEY_FENCE_POINTS_STATE, 0, reinterpret_cast<uint8_t *>(&stats), sizeof(mission_stats_entry_s));
 		g_dm_ops->write(DM_KEY_SAFE_POINTS_STATE, 0, reinterpret_cast<uint8_t *>(&stats), sizeof(mission_stats_entry_s));
+		g_dm_ops->commit(0);
+	}
+}
+
+static int
+_file_initialize(unsigned max_offset)
+{
+	const bool file_existed = (access(k_data_manager_device_path, F_OK) == 0);
+
+	/* Open or create the data manager file */
+	dm_operations_data.file.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (dm_operations_data.file.fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	if ((unsigned)lseek(dm_operations_data.file.fd, max_offset, SEEK_SET) != max_offset) {
+		close(dm_operations_data.file.fd);
+		PX4_WARN("Could not seek data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	/* Open the journal and bring the data manager file up to date with it */
+	const size_t path_len = strlen(k_data_manager_device_path) + sizeof(DM_JOURNAL_SUFFIX);
+	g_journal.path = (char *)malloc(path_len);
+	g_journal.buffer = (uint8_t *)malloc(DM_JOURNAL_BUFFER_SIZE);
+
+	if ((g_journal.path != nullptr) && (g_journal.buffer != nullptr)) {
+		snprintf(g_journal.path, path_len, "%s" DM_JOURNAL_SUFFIX, k_data_manager_device_path);
+		g_journal.fd = open(g_journal.path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+	}
+
+	if (g_journal.fd >= 0) {
+		_file_journal_replay();
+
+	} else {
+		PX4_WARN("Could not open data manager journal, syncing every write");
 	}
 
+	_file_check_compat(file_existed);
+
 	dm_operations_data.running = true;
 
 	return 0;
 }
 #endif
 
+static int
+_ram_commit(hrt_abstime max_age)
+{
+	/* RAM writes are immediate */
+	return 0;
+}
+
 static int
 _ram_initialize(unsigned max_offset)
 {
@@ -632,6 +1148,18 @@ _ram_initialize(unsigned max_offset)
 static void
 _file_shutdown()
 {
+	_file_commit(0);
+
+	if (g_journal.fd >= 0) {
+		close(g_journal.fd);
+		g_journal.fd = -1;
+	}
+
+	free(g_journal.buffer);
+	g_journal.buffer = nullptr;
+	free(g_journal.path);
+	g_journal.path = nullptr;
+
 	close(dm_operations_data.file.fd);
 	dm_operations_data.running = false;
 }
@@ -644,6 +1172,190 @@ _ram_shutdown()
 	dm_operations_data.running = false;
 }
 
+#ifdef DATAMAN_MMAP_STORAGE
+/* Remember that [offset, offset + length) of the mapping needs to be synced */
+static void
+_mmap_mark_dirty(size_t offset, size_t length)
+{
+	g_mmap.dirty.mark(offset, length, hrt_absolute_time());
+}
+
+static ssize_t
+_mmap_write(dm_item_t item, unsigned index, const void *buf, size_t count)
+{
+	const ssize_t result = _ram_write(item, index, buf, count);
+
+	if (result >= 0) {
+		_mmap_mark_dirty(calculate_offset(item, index), DM_SECTOR_HDR_SIZE + count);
+	}
+
+	return result;
+}
+
+static ssize_t
+_mmap_write_range(dm_item_t item, unsigned index, unsigned num_items, const void *buf, size_t count)
+{
+	const ssize_t result = _ram_write_range(item, index, num_items, buf, count);
+
+	if (result > 0) {
+		_mmap_mark_dirty(calculate_offset(item, index), num_items * g_per_item_size_with_hdr[item]);
+	}
+
+	return result;
+}
+
+static int
+_mmap_clear(dm_item_t item)
+{
+	const int result = _ram_clear(item);
+
+	if (result == 0) {
+		_mmap_mark_dirty(calculate_offset(item, 0), g_per_item_max_index[item] * g_per_item_size_with_hdr[item]);
+	}
+
+	/* Make sure data is actually written to physical media */
+	if (_mmap_commit(0) < 0) {
+		return -1;
+	}
+
+	return result;
+}
+
+/* Flush the dirty span of the mapping to the file */
+static int
+_mmap_commit(hrt_abstime max_age)
+{
+	if (g_mmap.dirty.empty() || ((max_age > 0) && (hrt_elapsed_time(&g_mmap.dirty.since) < max_age))) {
+		return 0;
+	}
+
+	/* The span stays dirty if msync fails, so the next commit retries it */
+	const int result = g_mmap.dirty.flush([](size_t begin, size_t end) {
+		/* msync needs a page aligned address */
+		static const size_t page_size = sysconf(_SC_PAGESIZE);
+		begin -= begin % page_size;
+		return msync(&dm_operations_data.ram.data[begin], end - begin, MS_SYNC);
+	});
+
+	if (result < 0) {
+		PX4_ERR("msync failed %d", errno);
+		g_mmap.sync_failures++;
+
+	} else {
+		g_mmap.syncs++;
+	}
+
+	return result;
+}
+
+static bool
+_mmap_import_record(uint32_t offset, const uint8_t *data, uint32_t length, void *arg)
+{
+	if (offset + length > g_mmap.size) {
+		return false;
+	}
+
+	memcpy(&dm_operations_data.ram.data[offset], data, length);
+	return true;
+}
+
+static bool
+_mmap_import_sync(void *arg)
+{
+	return msync(dm_operations_data.ram.data, g_mmap.size, MS_SYNC) == 0;
+}
+
+/* Apply and empty the journal of the file backend, after a switch from it its writes may be missing in the file */
+static int
+_mmap_import_journal()
+{
+	const size_t path_len = strlen(k_data_manager_device_path) + sizeof(DM_JOURNAL_SUFFIX);
+	char *path = (char *)malloc(path_len);
+	uint8_t *buffer = (uint8_t *)malloc(DM_JOURNAL_BUFFER_SIZE);
+	int result = -1;
+
+	if ((path != nullptr) && (buffer != nullptr)) {
+		snprintf(path, path_len, "%s" DM_JOURNAL_SUFFIX, k_data_manager_device_path);
+		result = dm_journal_import(path, buffer, DM_JOURNAL_BUFFER_SIZE - sizeof(dm_journal_record_t),
+					   _mmap_import_record, _mmap_import_sync, nullptr);
+	}
+
+	free(buffer);
+	free(path);
+
+	return result;
+}
+
+static int
+_mmap_initialize(unsigned max_offset)
+{
+	const bool file_existed = (access(k_data_manager_device_path, F_OK) == 0);
+
+	/* Open or create the data manager file */
+	const int fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	/* The whole mapping must be backed by the file, the added bytes read as empty entries */
+	struct stat file_stat;
+
+	if ((fstat(fd, &file_stat) < 0) ||
+	    (((size_t)file_stat.st_size < max_offset) && (ftruncate(fd, max_offset) < 0))) {
+		close(fd);
+		PX4_WARN("Could not resize data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	void *data = mmap(nullptr, max_offset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	/* The mapping stays valid without the file descriptor */
+	close(fd);
+
+	if (data == MAP_FAILED) {
+		PX4_WARN("Could not map data manager file %s (%d)", k_data_manager_device_path, errno);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	dm_operations_data.ram.data = (uint8_t *)data;
+	dm_operations_data.ram.data_end = &dm_operations_data.ram.data[max_offset - 1];
+	g_mmap.size = max_offset;
+
+	/* A journal which can not be emptied would be replayed over newer writes once the file backend is used again */
+	g_mmap.imported = _mmap_import_journal();
+
+	if (g_mmap.imported < 0) {
+		munmap(data, max_offset);
+		PX4_WARN("Could not apply data manager journal of %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	if (g_mmap.imported > 0) {
+		PX4_INFO("applied %d journal records", g_mmap.imported);
+	}
+
+	_file_check_compat(file_existed);
+
+	dm_operations_data.running = true;
+
+	return 0;
+}
+
+static void
+_mmap_shutdown()
+{
+	_mmap_commit(0);
+	munmap(dm_operations_data.ram.data, g_mmap.size);
+	dm_operations_data.running = false;
+}
+#endif
+
 static int
 task_main(int argc, char *argv[])
 {
@@ -655,6 +1367,12 @@ task_main(int argc, char *argv[])
 		g_dm_ops = &dm_file_operations;
 		break;
 #endif
+#ifdef DATAMAN_MMAP_STORAGE
+
+	case BACKEND_MMAP:
+		g_dm_ops = &dm_mmap_operations;
+		break;
+#endif
 
 	case BACKEND_RAM:
 		g_dm_ops = &dm_ram_operations;
@@ -706,6 +1424,12 @@ task_main(int argc, char *argv[])
 
 		break;
 #endif
+#ifdef DATAMAN_MMAP_STORAGE
+
+	case BACKEND_MMAP:
+		PX4_INFO("data manager file '%s' mapped, size is %u bytes", k_data_manager_device_path, max_offset);
+		break;
+#endif
 
 	case BACKEND_RAM:
 		PX4_INFO("data manager RAM size is %u bytes", max_offset);
@@ -719,6 +1443,16 @@ task_main(int argc, char *argv[])
 	fds.fd = dataman_request_sub;
 	fds.events = POLLIN;
 
+	/* last served range request, to detect retransmissions */
+	struct {
+		uint8_t client_id;
+		hrt_abstime timestamp;
+		uint8_t status;
+	} last_range_request{};
+
+	/* clients with an open transaction, their writes are committed on request only */
+	uint8_t transaction_clients[(UINT8_MAX + 1) / 8] {};
+
 	/* Tell startup that the worker thread has completed its initialization */
 	px4_sem_post(&g_init_sema);
 
@@ -746,6 +1480,9 @@ task_main(int argc, char *argv[])
 
 				ssize_t result;
 
+				const uint8_t transaction_mask = 1u << (request.client_id % 8);
+				uint8_t &transaction_clients_byte = transaction_clients[request.client_id / 8];
+
 				switch (request.request_type) {
 
 				case DM_GET_ID:
@@ -767,6 +1504,11 @@ task_main(int argc, char *argv[])
 					perf_begin(_dm_write_perf);
 					result = g_dm_ops->write(static_cast<dm_item_t>(request.item), request.index,
 								 &(request.data), request.data_length);
+
+					if ((result > 0) && !(transaction_clients_byte & transaction_mask) && (g_dm_ops->commit(0) < 0)) {
+						result = -1;
+					}
+
 					perf_end(_dm_write_perf);
 
 					if (result > 0) {
@@ -810,6 +1552,93 @@ task_main(int argc, char *argv[])
 
 					break;
 
+				case DM_READ_RANGE:
+				case DM_WRITE_RANGE:
+				case DM_CLEAR_RANGE:
+
+					if ((request.client_id == last_range_request.client_id) &&
+					    (request.timestamp == last_range_request.timestamp)) {
+						/* retransmission of a request that was already served, only repeat the response */
+						response.status = last_range_request.status;
+						response.count = (response.status == dataman_response_s::STATUS_SUCCESS) ? request.count : 0;
+						break;
+					}
+
+					/* range requests pass the address of the client buffer, it may only be accessed while claimed */
+					if (!DatamanClient::claimRangeBuffer(request.client_id, request.timestamp)) {
+						/* the client gave up waiting, or this is a late retransmission of a served request */
+						continue;
+					}
+
+					g_func_counts[request.request_type]++;
+
+					if (request.request_type == DM_READ_RANGE) {
+						perf_begin(_dm_read_perf);
+						result = g_dm_ops->read_range(static_cast<dm_item_t>(request.item), request.index, request.count,
+									      reinterpret_cast<void *>(request.buffer), request.data_length);
+						perf_end(_dm_read_perf);
+
+					} else {
+						const void *buffer = (request.request_type == DM_WRITE_RANGE) ? reinterpret_cast<const void *>
+								     (request.buffer) : nullptr;
+						perf_begin(_dm_write_perf);
+						result = g_dm_ops->write_range(static_cast<dm_item_t>(request.item), request.index, request.count,
+									       buffer, request.data_length);
+
+						if ((result >= 0) && !(transaction_clients_byte & transaction_mask) && (g_dm_ops->commit(0) < 0)) {
+							result = -1;
+						}
+
+						perf_end(_dm_write_perf);
+					}
+
+					DatamanClient::releaseRangeBuffer(request.client_id);
+
+					if (result == (ssize_t)request.count) {
+						response.status = dataman_response_s::STATUS_SUCCESS;
+						response.count = request.count;
+
+					} else if (request.request_type == DM_READ_RANGE) {
+						response.status = dataman_response_s::STATUS_FAILURE_READ_FAILED;
+
+					} else if (request.request_type == DM_WRITE_RANGE) {
+						response.status = dataman_response_s::STATUS_FAILURE_WRITE_FAILED;
+
+					} else {
+						response.status = dataman_response_s::STATUS_FAILURE_CLEAR_FAILED;
+					}
+
+					last_range_request.client_id = request.client_id;
+					last_range_request.timestamp = request.timestamp;
+					last_range_request.status = response.status;
+					break;
+
+				case DM_BEGIN_TRANSACTION:
+
+					g_func_counts[DM_BEGIN_TRANSACTION]++;
+					transaction_clients_byte |= transaction_mask;
+					response.status = dataman_response_s::STATUS_SUCCESS;
+					break;
+
+				case DM_COMMIT_TRANSACTION:
+
+					g_func_counts[DM_COMMIT_TRANSACTION]++;
+					transaction_clients_byte &= ~transaction_mask;
+
+					/* commits the pending writes of all clients, they are ordered */
+					perf_begin(_dm_write_perf);
+					result = g_dm_ops->commit(0);
+					perf_end(_dm_write_perf);
+
+					if (result == 0) {
+						response.status = dataman_response_s::STATUS_SUCCESS;
+
+					} else {
+						response.status = dataman_response_s::STATUS_FAILURE_WRITE_FAILED;
+					}
+
+					break;
+
 				default:
 					break;
 
@@ -820,6 +1649,9 @@ task_main(int argc, char *argv[])
 			}
 		}
 
+		/* bound the time writes of open transactions stay volatile */
+		g_dm_ops->commit(DM_JOURNAL_MAX_PENDING_TIME);
+
 		/* time to go???? */
 		if (g_task_should_exit) {
 			break;
@@ -874,6 +1706,31 @@ status()
 	PX4_INFO("Writes   %u", g_func_counts[DM_WRITE]);
 	PX4_INFO("Reads    %u", g_func_counts[DM_READ]);
 	PX4_INFO("Clears   %u", g_func_counts[DM_CLEAR]);
+	PX4_INFO("Range reads  %u", g_func_counts[DM_READ_RANGE]);
+	PX4_INFO("Range writes %u", g_func_counts[DM_WRITE_RANGE]);
+	PX4_INFO("Range clears %u", g_func_counts[DM_CLEAR_RANGE]);
+	PX4_INFO("Commits  %u", g_func_counts[DM_COMMIT_TRANSACTION]);
+
+#ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
+
+	if (backend == BACKEND_FILE) {
+		if (g_journal.fd >= 0) {
+			PX4_INFO("Journal: %u commits, %u checkpoints, %u bytes, %u records replayed at start",
+				 g_journal.commits, g_journal.checkpoints, (unsigned)g_journal.size, g_journal.replayed);
+
+		} else {
+			PX4_INFO("Journal: disabled");
+		}
+	}
+
+#endif
+#ifdef DATAMAN_MMAP_STORAGE
+
+	if (backend == BACKEND_MMAP) {
+		PX4_INFO("Mapped: %u bytes, %u syncs, %u failed syncs", (unsigned)g_mmap.size, g_mmap.syncs, g_mmap.sync_failures);
+	}
+
+#endif
 
 	perf_print_counter(_dm_read_perf);
 	perf_print_counter(_dm_write_perf);
@@ -902,6 +1759,16 @@ Each type has a specific type and a fixed maximum amount of storage items, so th
 
 ### Implementation
 Reading and writing a single item is always atomic.
+Range requests read, write or clear consecutive items of one type in a single request, directly from/to the
+client's buffer. A range is not atomic as a whole.
+
+The file backend journals writes: they are collected in RAM and synced together to a journal file next to the
+storage file, which is replayed at startup. A write is persistent when its response is sent, unless the client
+opened a transaction, in which case its writes are persistent once it commits (or at the latest after 1 second).
+Writes always become persistent in the order they were made.
+
+On POSIX the file can be memory-mapped instead (-m): accesses are as fast as with the RAM backend, and written
+items are flushed to the file with msync() on commit. The journal of the file backend is not used in this mode.
 
 )DESCR_STR");
 
@@ -912,6 +1779,7 @@ Reading and writing a single item is always atomic.
 #endif
 	PRINT_MODULE_USAGE_PARAM_FLAG('r', "Use RAM backend (NOT persistent)", true);
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
+	PRINT_MODULE_USAGE_PARAM_FLAG('m', "Memory-map the storage file (POSIX only)", true);
 	PRINT_MODULE_USAGE_PARAM_COMMENT("The options -f and -r are mutually exclusive. If nothing is specified, a file 'dataman' is used");
 #endif
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
@@ -946,10 +1814,11 @@ dataman_main(int argc, char *argv[])
 		int ch;
 		int dmoptind = 1;
 		const char *dmoptarg = nullptr;
+		bool map_file = false;
 
 		/* jump over start and look at options first */
 
-		while ((ch = px4_getopt(argc, argv, "f:r", &dmoptind, &dmoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "f:rm", &dmoptind, &dmoptarg)) != EOF) {
 			switch (ch) {
 			case 'f':
 				if (backend_check()) {
@@ -974,6 +1843,10 @@ dataman_main(int argc, char *argv[])
 				backend = BACKEND_RAM;
 				break;
 
+			case 'm':
+				map_file = true;
+				break;
+
 			//no break
 			default:
 				usage();
@@ -990,6 +1863,21 @@ dataman_main(int argc, char *argv[])
 #endif
 		}
 
+		if (map_file) {
+#ifdef DATAMAN_MMAP_STORAGE
+
+			if (backend != BACKEND_FILE) {
+				PX4_WARN("-m and -r are mutually exclusive");
+				usage();
+				return -1;
+			}
+
+			backend = BACKEND_MMAP;
+#else
+			PX4_WARN("dataman does not support memory-mapped storage. Not mapping the file.");
+#endif
+		}
+
 		start();
 
 		if (!is_running()) {
@@ -63,6 +63,11 @@ typedef enum {
 	DM_WRITE,			///< Write index for given item
 	DM_READ,			///< Read index for given item
 	DM_CLEAR,			///< Clear all index for given item
+	DM_READ_RANGE,		///< Read consecutive indexes for given item into the client buffer
+	DM_WRITE_RANGE,		///< Write consecutive indexes for given item from the client buffer
+	DM_CLEAR_RANGE,		///< Clear consecutive indexes for given item
+	DM_BEGIN_TRANSACTION,	///< Defer syncing the writes of the client to storage until it commits
+	DM_COMMIT_TRANSACTION,	///< Sync all deferred writes to storage
 	DM_NUMBER_OF_FUNCS
 } dm_function_t;
 
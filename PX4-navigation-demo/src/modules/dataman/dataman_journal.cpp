@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file dataman_journal.cpp
+ */
+
+#include "dataman_journal.h"
+
+#include <px4_platform_common/defines.h>
+#include <crc32.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+static uint32_t
+record_crc(dm_journal_record_t record, const uint8_t *data)
+{
+	record.crc = 0;
+	return crc32part(data, record.length, crc32part(reinterpret_cast<const uint8_t *>(&record), sizeof(record), 0));
+}
+
+size_t
+dm_journal_encode(uint8_t *buffer, uint32_t offset, const uint8_t *data, uint32_t length)
+{
+	dm_journal_record_t record{DM_JOURNAL_MAGIC, offset, length, 0};
+	record.crc = record_crc(record, data);
+
+	memcpy(buffer, &record, sizeof(record));
+	memcpy(&buffer[sizeof(record)], data, length);
+
+	return sizeof(record) + length;
+}
+
+unsigned
+dm_journal_replay(int fd, uint8_t *buffer, size_t max_length, dm_journal_apply_t apply, void *arg)
+{
+	unsigned replayed = 0;
+	dm_journal_record_t record;
+
+	while (read(fd, &record, sizeof(record)) == sizeof(record)) {
+		if ((record.magic != DM_JOURNAL_MAGIC) || (record.length > max_length) ||
+		    (read(fd, buffer, record.length) != (ssize_t)record.length)) {
+			break;
+		}
+
+		/* A torn record at the end belongs to a commit that never completed */
+		if (record_crc(record, buffer) != record.crc) {
+			break;
+		}
+
+		if (!apply(record.offset, buffer, record.length, arg)) {
+			break;
+		}
+
+		replayed++;
+	}
+
+	return replayed;
+}
+
+int
+dm_journal_import(const char *path, uint8_t *buffer, size_t max_length, dm_journal_apply_t apply,
+		  bool (*sync)(void *arg), void *arg)
+{
+	const int fd = open(path, O_RDWR | O_BINARY);
+
+	if (fd < 0) {
+		return (errno == ENOENT) ? 0 : -1;
+	}
+
+	const int replayed = dm_journal_replay(fd, buffer, max_length, apply, arg);
+	const bool emptied = sync(arg) && (ftruncate(fd, 0) == 0) && (fsync(fd) == 0);
+	close(fd);
+
+	return emptied ? replayed : -1;
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file dataman_journal.h
+ *
+ * Record format of the journal of the data manager file backend.
+ *
+ * A record holds bytes of the data manager file at a given offset. Records are appended to the journal in
+ * the order the writes were acknowledged, and the journal is replayed in the same order at startup.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DM_JOURNAL_MAGIC 0x4C4E524Au	/* "JRNL" */
+
+struct dm_journal_record_t {
+	uint32_t magic;
+	uint32_t offset;	/* offset in the data manager file */
+	uint32_t length;	/* number of bytes following the record header */
+	uint32_t crc;		/* crc32 of the header (with crc set to 0) and the data */
+};
+
+/**
+ * Callback applying the data of one record to the data manager storage.
+ * @return false to stop the replay
+ */
+typedef bool (*dm_journal_apply_t)(uint32_t offset, const uint8_t *data, uint32_t length, void *arg);
+
+/**
+ * Encode a record for length bytes of the data manager file at offset.
+ * @param buffer receives the header and the data, sizeof(dm_journal_record_t) + length bytes
+ * @return number of bytes written to buffer
+ */
+size_t dm_journal_encode(uint8_t *buffer, uint32_t offset, const uint8_t *data, uint32_t length);
+
+/**
+ * Apply the records of a journal file from its current position in order.
+ *
+ * The replay stops at the end of the file, at the first record that is incomplete or does not match its
+ * crc, e.g. the torn end of a commit that did not complete, or when apply returns false.
+ *
+ * @param fd journal file
+ * @param buffer receives the data of one record, max_length bytes
+ * @param max_length longest record data accepted
+ * @return number of applied records
+ */
+unsigned dm_journal_replay(int fd, uint8_t *buffer, size_t max_length, dm_journal_apply_t apply, void *arg);
+
+/**
+ * Apply the journal at path to a storage that does not use it, e.g. the memory-mapped backend, and empty it.
+ *
+ * The journal left by the file backend holds acknowledged writes which may be missing in the data manager file.
+ * It is only emptied once sync succeeded, so that it is neither lost nor replayed later over newer writes.
+ *
+ * @param sync make the applied records persistent, return false on failure
+ * @return number of applied records, -1 if the journal exists but could not be applied and emptied
+ */
+int dm_journal_import(const char *path, uint8_t *buffer, size_t max_length, dm_journal_apply_t apply,
+		      bool (*sync)(void *arg), void *arg);
@@ -0,0 +1,289 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file dataman_journal_test.cpp
+ * Tests for the replay of the data manager journal after a restart or power loss.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dataman_journal.h"
+
+static constexpr size_t kFileSize = 256;
+static constexpr size_t kMaxRecordLength = 64;
+
+class DatamanJournalTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_journal = tmpfile();
+		ASSERT_NE(_journal, nullptr);
+		memset(_file, 0, sizeof(_file));
+		memset(_expected, 0, sizeof(_expected));
+	}
+
+	void TearDown() override
+	{
+		fclose(_journal);
+	}
+
+	// encode a write of length bytes with value at offset, the expected file content follows all encoded writes
+	size_t encode(uint32_t offset, uint8_t value, uint32_t length)
+	{
+		uint8_t data[kMaxRecordLength];
+		memset(data, value, length);
+		memset(&_expected[offset], value, length);
+		_buffer_used += dm_journal_encode(&_buffer[_buffer_used], offset, data, length);
+		return _buffer_used;
+	}
+
+	// write the encoded records to the journal file, as a commit does
+	void commit(size_t length)
+	{
+		ASSERT_EQ(write(fileno(_journal), _buffer, length), (ssize_t)length);
+	}
+
+	// restart: read the journal from its start and apply it to the data manager file
+	unsigned replay()
+	{
+		lseek(fileno(_journal), 0, SEEK_SET);
+		uint8_t buffer[kMaxRecordLength];
+		return dm_journal_replay(fileno(_journal), buffer, sizeof(buffer), &DatamanJournalTest::apply, this);
+	}
+
+	static bool apply(uint32_t offset, const uint8_t *data, uint32_t length, void *arg)
+	{
+		DatamanJournalTest *test = static_cast<DatamanJournalTest *>(arg);
+
+		if ((offset + length > kFileSize) || (test->_fail_after-- == 0)) {
+			return false;
+		}
+
+		memcpy(&test->_file[offset], data, length);
+		return true;
+	}
+
+protected:
+	FILE *_journal{nullptr};
+	uint8_t _buffer[1024] {};
+	size_t _buffer_used{0};
+	uint8_t _file[kFileSize];
+	uint8_t _expected[kFileSize];
+	int _fail_after{-1};
+};
+
+TEST_F(DatamanJournalTest, emptyJournal)
+{
+	EXPECT_EQ(replay(), 0u);
+	EXPECT_EQ(memcmp(_file, _expected, kFileSize), 0);
+}
+
+TEST_F(DatamanJournalTest, replayAfterRestart)
+{
+	// GIVEN: committed records that were not yet applied to the data manager file before the restart
+	encode(0, 0x11, 16);
+	encode(64, 0x22, 32);
+	commit(encode(8, 0x33, 16));
+
+	// WHEN: the journal is replayed
+	// THEN: all records are applied in order, the later write of the overlapping bytes wins
+	EXPECT_EQ(replay(), 3u);
+	EXPECT_EQ(memcmp(_file, _expected, kFileSize), 0);
+	EXPECT_EQ(_file[7], 0x11);
+	EXPECT_EQ(_file[8], 0x33);
+}
+
+TEST_F(DatamanJournalTest, tornLastRecord)
+{
+	// GIVEN: two complete records and a commit which was cut off in the middle of its record
+	encode(0, 0x11, 16);
+	const size_t complete = encode(32, 0x22, 16);
+	const size_t torn = encode(64, 0x33, 32);
+	commit(complete + (torn - complete) / 2);
+
+	// WHEN: the journal is replayed
+	// THEN: only the complete records are applied
+	EXPECT_EQ(replay(), 2u);
+	EXPECT_EQ(_file[0], 0x11);
+	EXPECT_EQ(_file[32], 0x22);
+	EXPECT_EQ(_file[64], 0);
+}
+
+TEST_F(DatamanJournalTest, truncatedRecordHeader)
+{
+	// GIVEN: a complete record followed by part of the next record header
+	const size_t complete = encode(0, 0x11, 16);
+	encode(32, 0x22, 16);
+	commit(complete + sizeof(dm_journal_record_t) / 2);
+
+	// THEN: only the complete record is applied
+	EXPECT_EQ(replay(), 1u);
+	EXPECT_EQ(_file[0], 0x11);
+	EXPECT_EQ(_file[32], 0);
+}
+
+TEST_F(DatamanJournalTest, corruptedRecordStopsReplay)
+{
+	// GIVEN: three records, the data of the second one was not completely written to the storage
+	const size_t first = encode(0, 0x11, 16);
+	encode(32, 0x22, 16);
+	commit(encode(64, 0x33, 16));
+	lseek(fileno(_journal), first + sizeof(dm_journal_record_t) + 4, SEEK_SET);
+	const uint8_t garbage = 0xFF;
+	ASSERT_EQ(write(fileno(_journal), &garbage, 1), 1);
+
+	// THEN: the replay stops before the corrupted record, the records after it are not applied either
+	EXPECT_EQ(replay(), 1u);
+	EXPECT_EQ(_file[0], 0x11);
+	EXPECT_EQ(_file[32], 0);
+	EXPECT_EQ(_file[64], 0);
+}
+
+TEST_F(DatamanJournalTest, crashBetweenWriteAndCommit)
+{
+	// GIVEN: a committed write and a later write that was acknowledged within a transaction,
+	// but only encoded into the RAM buffer when the power was lost
+	const size_t committed = encode(0, 0x11, 16);
+	commit(committed);
+	encode(0, 0x22, 16);
+	encode(32, 0x33, 16);
+
+	// WHEN: the journal is replayed
+	// THEN: the storage holds the committed state, without any part of the uncommitted writes
+	EXPECT_EQ(replay(), 1u);
+	EXPECT_EQ(_file[0], 0x11);
+	EXPECT_EQ(_file[15], 0x11);
+	EXPECT_EQ(_file[32], 0);
+}
+
+TEST_F(DatamanJournalTest, failedApplyStopsReplay)
+{
+	// GIVEN: a file which can only be written once
+	encode(0, 0x11, 16);
+	commit(encode(32, 0x22, 16));
+	_fail_after = 1;
+
+	// THEN: the replay stops at the failed record
+	EXPECT_EQ(replay(), 1u);
+	EXPECT_EQ(_file[0], 0x11);
+	EXPECT_EQ(_file[32], 0);
+}
+
+TEST_F(DatamanJournalTest, recordLongerThanBufferIsRejected)
+{
+	// GIVEN: a record longer than the replay buffer, e.g. an unrelated file
+	uint8_t data[kMaxRecordLength + 1] {};
+	_buffer_used = dm_journal_encode(_buffer, 0, data, sizeof(data));
+	commit(_buffer_used);
+
+	// THEN: nothing is applied
+	EXPECT_EQ(replay(), 0u);
+}
+
+class DatamanJournalImportTest : public DatamanJournalTest
+{
+public:
+	void SetUp() override
+	{
+		DatamanJournalTest::SetUp();
+		_fd = mkstemp(_path);
+		ASSERT_GE(_fd, 0);
+	}
+
+	void TearDown() override
+	{
+		close(_fd);
+		unlink(_path);
+		DatamanJournalTest::TearDown();
+	}
+
+	int import()
+	{
+		uint8_t buffer[kMaxRecordLength];
+		return dm_journal_import(_path, buffer, sizeof(buffer), &DatamanJournalTest::apply, &DatamanJournalImportTest::sync,
+					 this);
+	}
+
+	static bool sync(void *arg)
+	{
+		return static_cast<DatamanJournalImportTest *>(arg)->_sync_result;
+	}
+
+protected:
+	char _path[32] {"/tmp/dm_journal_XXXXXX"};
+	int _fd{-1};
+	bool _sync_result{true};
+};
+
+TEST_F(DatamanJournalImportTest, missingJournal)
+{
+	unlink(_path);
+	EXPECT_EQ(import(), 0);
+}
+
+TEST_F(DatamanJournalImportTest, journalIsAppliedAndEmptied)
+{
+	// GIVEN: a journal left by the file backend
+	encode(0, 0x11, 16);
+	const size_t length = encode(32, 0x22, 16);
+	ASSERT_EQ(write(_fd, _buffer, length), (ssize_t)length);
+
+	// WHEN: another backend imports it
+	// THEN: the records are applied and the journal is empty, so it is not replayed again later
+	EXPECT_EQ(import(), 2);
+	EXPECT_EQ(memcmp(_file, _expected, kFileSize), 0);
+	EXPECT_EQ(lseek(_fd, 0, SEEK_END), 0);
+	EXPECT_EQ(import(), 0);
+}
+
+TEST_F(DatamanJournalImportTest, journalIsKeptIfSyncFails)
+{
+	// GIVEN: a journal and a storage that fails to sync
+	const size_t length = encode(0, 0x11, 16);
+	ASSERT_EQ(write(_fd, _buffer, length), (ssize_t)length);
+	_sync_result = false;
+
+	// THEN: the import fails and keeps the journal for the next attempt
+	EXPECT_EQ(import(), -1);
+	EXPECT_EQ(lseek(_fd, 0, SEEK_END), (off_t)length);
+
+	_sync_result = true;
+	EXPECT_EQ(import(), 1);
+	EXPECT_EQ(lseek(_fd, 0, SEEK_END), 0);
+}
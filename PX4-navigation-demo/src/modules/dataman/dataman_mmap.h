@@ -0,0 +1,86 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file dataman_mmap.h
+ *
+ * Tracking of the unsynced bytes of the memory-mapped data manager backend.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Written but not yet synced bytes of the mapping, tracked as one span [begin, end).
+ */
+struct dm_dirty_span_t {
+	size_t begin{0};
+	size_t end{0};		/* begin if nothing is dirty */
+	uint64_t since{0};	/* time of the oldest unsynced write */
+
+	bool empty() const { return end == begin; }
+
+	void mark(size_t offset, size_t length, uint64_t now)
+	{
+		if (empty()) {
+			begin = offset;
+			end = offset + length;
+			since = now;
+
+		} else {
+			begin = (offset < begin) ? offset : begin;
+			end = (offset + length > end) ? offset + length : end;
+		}
+	}
+
+	/**
+	 * Sync the span. It is only cleared if sync succeeds, so a failed sync is retried by the next flush.
+	 * @return result of sync, 0 if nothing was dirty
+	 */
+	template<typename SyncFunction>
+	int flush(SyncFunction sync)
+	{
+		if (empty()) {
+			return 0;
+		}
+
+		const int result = sync(begin, end);
+
+		if (result == 0) {
+			begin = end = 0;
+		}
+
+		return result;
+	}
+};
@@ -0,0 +1,102 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file dataman_mmap_test.cpp
+ * Tests for the dirty span of the memory-mapped data manager backend.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dataman_mmap.h"
+
+TEST(DatamanMmapTest, markGrowsSpan)
+{
+	dm_dirty_span_t dirty;
+	EXPECT_TRUE(dirty.empty());
+
+	dirty.mark(100, 10, 5);
+	dirty.mark(40, 8, 6);
+	dirty.mark(105, 20, 7);
+
+	EXPECT_FALSE(dirty.empty());
+	EXPECT_EQ(dirty.begin, 40u);
+	EXPECT_EQ(dirty.end, 125u);
+	EXPECT_EQ(dirty.since, 5u);
+}
+
+TEST(DatamanMmapTest, flushSyncsSpan)
+{
+	dm_dirty_span_t dirty;
+	size_t synced_begin = 0;
+	size_t synced_end = 0;
+	int calls = 0;
+	auto sync = [&](size_t begin, size_t end) { synced_begin = begin; synced_end = end; calls++; return 0; };
+
+	// nothing dirty, nothing synced
+	EXPECT_EQ(dirty.flush(sync), 0);
+	EXPECT_EQ(calls, 0);
+
+	dirty.mark(64, 32, 1);
+	EXPECT_EQ(dirty.flush(sync), 0);
+	EXPECT_EQ(calls, 1);
+	EXPECT_EQ(synced_begin, 64u);
+	EXPECT_EQ(synced_end, 96u);
+	EXPECT_TRUE(dirty.empty());
+}
+
+TEST(DatamanMmapTest, failedSyncIsRetried)
+{
+	// GIVEN: a dirty span and a sync that fails once
+	dm_dirty_span_t dirty;
+	dirty.mark(64, 32, 1);
+	int result = -1;
+	auto sync = [&](size_t begin, size_t end) { return result; };
+
+	// THEN: the span stays dirty after the failure
+	EXPECT_EQ(dirty.flush(sync), -1);
+	EXPECT_FALSE(dirty.empty());
+
+	// WHEN: more bytes are written before the retry
+	dirty.mark(200, 8, 2);
+
+	// THEN: the retry covers the failed span as well
+	size_t synced_begin = 0;
+	size_t synced_end = 0;
+	auto retry = [&](size_t begin, size_t end) { synced_begin = begin; synced_end = end; return 0; };
+	EXPECT_EQ(dirty.flush(retry), 0);
+	EXPECT_EQ(synced_begin, 64u);
+	EXPECT_EQ(synced_end, 208u);
+	EXPECT_EQ(dirty.since, 1u);
+	EXPECT_TRUE(dirty.empty());
+}
@@ -37,12 +37,14 @@
  * If the board supports persistent storage (i.e., the KConfig variable DATAMAN_PERSISTENT_STORAGE is set),
  * the 'Default storage' backend uses a file on persistent storage. If not supported, this backend uses
  * non-persistent storage in RAM.
+ * The 'Memory-mapped file' backend maps the same file into memory, which is only supported on POSIX.
+ * Elsewhere it behaves like 'Default storage'.
  *
  * @group System
  * @value -1 Dataman disabled
  * @value 0 Default storage
  * @value 1 RAM storage
- * @boolean
+ * @value 2 Memory-mapped file
  * @reboot_required true
  */
 PARAM_DEFINE_INT32(SYS_DM_BACKEND, 0);
@@ -42,7 +42,7 @@
  */
 
 #include "ekf.h"
-#include <ekf_derivation/generated/predict_covariance.h>
+#include "covariance_prediction.h"
 
 #include <math.h>
 #include <mathlib/mathlib.h>
@@ -133,11 +133,10 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 		}
 	}
 
-	// calculate variances and upper diagonal covariances for quaternion, velocity, position and gyro bias states
-	P = sym::PredictCovariance(_state.vector(), P,
-				   imu_delayed.delta_vel / imu_delayed.delta_vel_dt, accel_var,
-				   imu_delayed.delta_ang / imu_delayed.delta_ang_dt, gyro_var,
-				   dt);
+	// F * P * F^T + Q for the quaternion, velocity and position rows, P is kept symmetric
+	covariance_prediction::predict(P, _state.quat_nominal,
+				       imu_delayed.delta_vel / imu_delayed.delta_vel_dt - _state.accel_bias, accel_var,
+				       gyro_var, dt);
 
 	// Construct the process noise variance diagonal for those states with a stationary process model
 	// These are kinematic states and their error growth is controlled separately by the IMU noise variances
@@ -231,21 +230,13 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 
 #endif // CONFIG_EKF2_TERRAIN
 
-	// covariance matrix is symmetrical, so copy upper half to lower half
-	for (unsigned row = 0; row < State::size; row++) {
-		for (unsigned column = 0; column < row; column++) {
-			P(row, column) = P(column, row);
-		}
-	}
-
 	constrainStateVariances();
 }
 
 void Ekf::constrainStateVariances()
 {
 	// NOTE: This limiting is a last resort and should not be relied on
-	// TODO: Split covariance prediction into separate F*P*transpose(F) and Q contributions
-	// and set corresponding entries in Q to zero when states exceed 50% of the limit
+	// TODO: Set corresponding entries in Q to zero when states exceed 50% of the limit
 	// Covariance diagonal limits. Use same values for states which
 	// belong to the same group (e.g. vel_x, vel_y, vel_z)
 
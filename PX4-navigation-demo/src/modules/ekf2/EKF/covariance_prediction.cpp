@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file covariance_prediction.cpp
+ */
+
+#include "covariance_prediction.h"
+
+namespace estimator
+{
+namespace covariance_prediction
+{
+
+namespace
+{
+
+static constexpr unsigned kRot = State::quat_nominal.idx;
+static constexpr unsigned kVel = State::vel.idx;
+static constexpr unsigned kPos = State::pos.idx;
+static constexpr unsigned kGyroBias = State::gyro_bias.idx;
+static constexpr unsigned kAccelBias = State::accel_bias.idx;
+
+// Non identity rows of the error-state transition matrix
+//   rot' = rot - R*dt * gyro_bias
+//   vel' = vel + rot x (R*accel*dt) - R*dt * accel_bias
+//   pos' = pos + vel*dt
+struct Transition {
+	Dcmf R_dt;
+	Vector3f accel_dt;
+	float dt;
+
+	// y = F(0:kPropagatedStates, 0:kCoupledStates) * x
+	void apply(const float x[kCoupledStates], float y[kPropagatedStates]) const
+	{
+		const float *rot = &x[kRot];
+		const float *vel = &x[kVel];
+		const float *gb = &x[kGyroBias];
+		const float *ab = &x[kAccelBias];
+
+		for (unsigned i = 0; i < 3; i++) {
+			const unsigned i1 = (i + 1) % 3;
+			const unsigned i2 = (i + 2) % 3;
+
+			y[kRot + i] = rot[i] - (R_dt(i, 0) * gb[0] + R_dt(i, 1) * gb[1] + R_dt(i, 2) * gb[2]);
+			y[kVel + i] = vel[i] + (rot[i1] * accel_dt(i2) - rot[i2] * accel_dt(i1))
+				      - (R_dt(i, 0) * ab[0] + R_dt(i, 1) * ab[1] + R_dt(i, 2) * ab[2]);
+			y[kPos + i] = x[kPos + i] + vel[i] * dt;
+		}
+	}
+};
+
+} // namespace
+
+void predict(matrix::SquareMatrix<float, State::size> &P, const Quatf &q, const Vector3f &accel,
+	     const Vector3f &accel_var, float gyro_var, float dt)
+{
+	const Dcmf R(q);
+	const Transition F{R * dt, R * accel * dt, dt};
+
+	float x[kCoupledStates];
+	float y[kPropagatedStates];
+
+	// A = F * P restricted to the propagated rows and coupled columns
+	float A[kPropagatedStates][kCoupledStates];
+
+	for (unsigned col = 0; col < kCoupledStates; col++) {
+		for (unsigned row = 0; row < kCoupledStates; row++) {
+			x[row] = P(row, col);
+		}
+
+		F.apply(x, y);
+
+		for (unsigned row = 0; row < kPropagatedStates; row++) {
+			A[row][col] = y[row];
+		}
+	}
+
+	// remaining columns are not transformed by F^T so F * P is final there (upper triangle)
+	for (unsigned col = kCoupledStates; col < State::size; col++) {
+		bool correlated = false;
+
+		for (unsigned row = 0; row < kCoupledStates; row++) {
+			x[row] = P(row, col);
+			correlated |= (fabsf(x[row]) > 0.f);
+		}
+
+		if (!correlated) {
+			// inactive state (e.g. mag, wind or terrain while not estimated): F * P column is zero
+			continue;
+		}
+
+		F.apply(x, y);
+
+		for (unsigned row = 0; row < kPropagatedStates; row++) {
+			P(row, col) = y[row];
+		}
+	}
+
+	// F * P * F^T upper triangle of the propagated rows, bias columns are not transformed by F^T
+	for (unsigned row = 0; row < kPropagatedStates; row++) {
+		F.apply(A[row], y);
+
+		for (unsigned col = row; col < kPropagatedStates; col++) {
+			P(row, col) = y[col];
+		}
+
+		for (unsigned col = kPropagatedStates; col < kCoupledStates; col++) {
+			P(row, col) = A[row][col];
+		}
+	}
+
+	// Q = G * diag(accel_var, gyro_var) * G^T with G = -R*dt for the velocity and rotation errors
+	const float dt2 = sq(dt);
+
+	for (unsigned i = 0; i < 3; i++) {
+		P(kRot + i, kRot + i) += dt2 * gyro_var;
+
+		for (unsigned j = i; j < 3; j++) {
+			P(kVel + i, kVel + j) += dt2 * (R(i, 0) * R(j, 0) * accel_var(0)
+							+ R(i, 1) * R(j, 1) * accel_var(1)
+							+ R(i, 2) * R(j, 2) * accel_var(2));
+		}
+	}
+
+	// copy the updated rows to the lower triangle
+	for (unsigned row = 0; row < kPropagatedStates; row++) {
+		for (unsigned col = row + 1; col < State::size; col++) {
+			P(col, row) = P(row, col);
+		}
+	}
+}
+
+} // namespace covariance_prediction
+} // namespace estimator
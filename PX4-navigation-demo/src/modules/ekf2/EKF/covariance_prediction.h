@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file covariance_prediction.h
+ * Structure-aware covariance prediction P = F * P * F^T + Q
+ *
+ * Equivalent to sym::PredictCovariance (see predict_covariance in
+ * EKF/python/ekf_derivation/derivation.py) but exploits the block sparsity
+ * of the error-state transition matrix F: only the rotation, velocity and
+ * position rows of F differ from identity and they only depend on the
+ * kinematic and IMU bias states.
+ */
+
+#ifndef EKF_COVARIANCE_PREDICTION_H
+#define EKF_COVARIANCE_PREDICTION_H
+
+#include "common.h"
+
+#include <ekf_derivation/generated/state.h>
+
+namespace estimator
+{
+namespace covariance_prediction
+{
+
+// number of leading states whose rows of F differ from identity (rotation, velocity, position errors)
+static constexpr unsigned kPropagatedStates = State::pos.idx + State::pos.dof;
+
+// number of leading states referenced by those rows (adds the gyro and accel bias errors)
+static constexpr unsigned kCoupledStates = State::accel_bias.idx + State::accel_bias.dof;
+
+static_assert(State::quat_nominal.idx == 0 && State::quat_nominal.dof == 3, "unexpected state layout");
+static_assert(State::vel.idx == 3 && State::pos.idx == 6, "unexpected state layout");
+static_assert(State::gyro_bias.idx == 9 && State::accel_bias.idx == 12, "unexpected state layout");
+
+/**
+ * Predict the covariance over one IMU interval
+ *
+ * P must be symmetric on entry and is kept symmetric. Only the rows and columns
+ * of the propagated states are recomputed; states that are uncorrelated with the
+ * kinematic states (e.g. mag, wind or terrain while not being estimated) are skipped.
+ *
+ * @param P state covariance, updated in place
+ * @param q attitude quaternion
+ * @param accel bias corrected specific force (m/s^2)
+ * @param accel_var accelerometer noise variance per axis ((m/s^2)^2)
+ * @param gyro_var gyro noise variance ((rad/s)^2)
+ * @param dt prediction interval (s)
+ */
+void predict(matrix::SquareMatrix<float, State::size> &P, const matrix::Quatf &q, const matrix::Vector3f &accel,
+	     const matrix::Vector3f &accel_var, float gyro_var, float dt);
+
+} // namespace covariance_prediction
+} // namespace estimator
+
+#endif // !EKF_COVARIANCE_PREDICTION_H
@@ -261,6 +261,11 @@ public:
 	// fuse single direct state measurement (eg NED velocity, NED position, mag earth field, etc)
 	void fuseDirectStateMeasurement(const float innov, const float innov_var, const float R, const int state_index);
 
+	// fuse a block of direct measurements of consecutive states (eg NED velocity) with a single covariance update
+	template <size_t N>
+	void fuseDirectStateMeasurements(const matrix::Vector<float, N> &innov, const matrix::Vector<float, N> &R,
+					 const unsigned state_index);
+
 	bool measurementUpdate(VectorState &K, const VectorState &H, const float R, const float innovation);
 
 	// gyro bias
@@ -1086,6 +1086,76 @@ void Ekf::fuseDirectStateMeasurement(const float innov, const float innov_var, c
 	fuse(K, innov);
 }
 
+template <size_t N>
+void Ekf::fuseDirectStateMeasurements(const matrix::Vector<float, N> &innov, const matrix::Vector<float, N> &R,
+				      const unsigned state_index)
+{
+	// innovation covariance S = H * P * H.T + R where H selects the N measured states
+	matrix::SquareMatrix<float, N> S = P.slice<N, N>(state_index, state_index);
+
+	for (unsigned k = 0; k < N; k++) {
+		S(k, k) += R(k);
+	}
+
+	matrix::SquareMatrix<float, N> S_inv;
+
+	if (!matrix::inv(S, S_inv)) {
+		// fall back to sequential fusion
+		for (unsigned k = 0; k < N; k++) {
+			fuseDirectStateMeasurement(innov(k), S(k, k), R(k), state_index + k);
+		}
+
+		return;
+	}
+
+	// Kalman gain K = P * H.T * S^-1, P * H.T being the columns of the measured states
+	const matrix::Matrix<float, State::size, N> PHt = P.slice<State::size, N>(0, state_index);
+	matrix::Matrix<float, State::size, N> K = PHt * S_inv;
+
+	for (unsigned k = 0; k < N; k++) {
+		VectorState K_col = K.col(k);
+		clearInhibitedStateKalmanGains(K_col);
+		K.col(k) = K_col;
+	}
+
+	// Joseph stabilized covariance update, see fuseDirectStateMeasurement()
+	// P = (I - K * H) * P * (I - K * H).T + K * R * K.T
+
+	// Step 1: conventional update, H * P are the rows of the measured states (P is symmetric)
+	const matrix::Matrix<float, N, State::size> HP = PHt.transpose();
+
+	for (unsigned i = 0; i < State::size; i++) {
+		for (unsigned j = 0; j < State::size; j++) {
+			for (unsigned k = 0; k < N; k++) {
+				P(i, j) -= K(i, k) * HP(k, j);
+			}
+		}
+	}
+
+	// Step 2: stabilized update, P_temp is not symmetric so we must take the columns
+	const matrix::Matrix<float, State::size, N> PtempHt = P.slice<State::size, N>(0, state_index);
+
+	for (unsigned i = 0; i < State::size; i++) {
+		for (unsigned j = 0; j <= i; j++) {
+			for (unsigned k = 0; k < N; k++) {
+				P(i, j) += (K(i, k) * R(k) - PtempHt(i, k)) * K(j, k);
+			}
+
+			P(j, i) = P(i, j);
+		}
+	}
+
+	constrainStateVariances();
+
+	// apply the state corrections, fuse() subtracts K * innovation
+	fuse(VectorState(K * innov), 1.f);
+}
+
+template void Ekf::fuseDirectStateMeasurements<2>(const matrix::Vector<float, 2> &, const matrix::Vector<float, 2> &,
+		const unsigned);
+template void Ekf::fuseDirectStateMeasurements<3>(const matrix::Vector<float, 3> &, const matrix::Vector<float, 3> &,
+		const unsigned);
+
 bool Ekf::measurementUpdate(VectorState &K, const VectorState &H, const float R, const float innovation)
 {
 	clearInhibitedStateKalmanGains(K);
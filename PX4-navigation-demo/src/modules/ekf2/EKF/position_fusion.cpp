@@ -57,10 +57,7 @@ bool Ekf::fuseHorizontalPosition(estimator_aid_source2d_s &aid_src)
 {
 	// x & y
 	if (!aid_src.innovation_rejected) {
-		for (unsigned i = 0; i < 2; i++) {
-			fuseDirectStateMeasurement(aid_src.innovation[i], aid_src.innovation_variance[i], aid_src.observation_variance[i],
-						   State::pos.idx + i);
-		}
+		fuseDirectStateMeasurements(Vector2f(aid_src.innovation), Vector2f(aid_src.observation_variance), State::pos.idx);
 
 		aid_src.fused = true;
 		aid_src.time_last_fuse = _time_delayed_us;
@@ -0,0 +1,349 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "batch_replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <strings.h>
+#include <thread>
+
+#include "../sensor_simulator/sensor_simulator.h"
+#include "../sensor_simulator/ekf_wrapper.h"
+#include "../sensor_simulator/ekf_logger.h"
+
+namespace
+{
+
+struct ParameterEntry {
+	const char *name;
+	float parameters::*float_value;
+	int32_t parameters::*int_value;
+};
+
+#define FLOAT_PARAM(x) ParameterEntry{#x, &parameters::x, nullptr}
+#define INT_PARAM(x) ParameterEntry{#x, nullptr, &parameters::x}
+
+// parameters that are typically swept when tuning the estimator
+const ParameterEntry tuning_parameters[] = {
+	INT_PARAM(ekf2_imu_ctrl),
+	INT_PARAM(ekf2_hgt_ref),
+	FLOAT_PARAM(ekf2_delay_max),
+	FLOAT_PARAM(ekf2_gyr_noise),
+	FLOAT_PARAM(ekf2_acc_noise),
+	FLOAT_PARAM(ekf2_gyr_b_noise),
+	FLOAT_PARAM(ekf2_acc_b_noise),
+	FLOAT_PARAM(ekf2_gbias_init),
+	FLOAT_PARAM(ekf2_abias_init),
+	FLOAT_PARAM(ekf2_angerr_init),
+	FLOAT_PARAM(ekf2_noaid_noise),
+	FLOAT_PARAM(ekf2_hdg_gate),
+	FLOAT_PARAM(ekf2_head_noise),
+	FLOAT_PARAM(ekf2_abl_lim),
+	FLOAT_PARAM(ekf2_gyr_b_lim),
+#if defined(CONFIG_EKF2_WIND)
+	FLOAT_PARAM(ekf2_wind_nsd),
+#endif // CONFIG_EKF2_WIND
+#if defined(CONFIG_EKF2_BAROMETER)
+	INT_PARAM(ekf2_baro_ctrl),
+	FLOAT_PARAM(ekf2_baro_delay),
+	FLOAT_PARAM(ekf2_baro_noise),
+	FLOAT_PARAM(ekf2_baro_gate),
+#endif // CONFIG_EKF2_BAROMETER
+#if defined(CONFIG_EKF2_GNSS)
+	INT_PARAM(ekf2_gps_ctrl),
+	FLOAT_PARAM(ekf2_gps_delay),
+	FLOAT_PARAM(ekf2_gps_v_noise),
+	FLOAT_PARAM(ekf2_gps_p_noise),
+	FLOAT_PARAM(ekf2_gps_p_gate),
+	FLOAT_PARAM(ekf2_gps_v_gate),
+	INT_PARAM(ekf2_gps_check),
+#endif // CONFIG_EKF2_GNSS
+#if defined(CONFIG_EKF2_MAGNETOMETER)
+	FLOAT_PARAM(ekf2_mag_delay),
+	FLOAT_PARAM(ekf2_mag_e_noise),
+	FLOAT_PARAM(ekf2_mag_b_noise),
+	FLOAT_PARAM(ekf2_mag_noise),
+	FLOAT_PARAM(ekf2_mag_gate),
+	INT_PARAM(ekf2_mag_type),
+#endif // CONFIG_EKF2_MAGNETOMETER
+#if defined(CONFIG_EKF2_AIRSPEED)
+	FLOAT_PARAM(ekf2_asp_delay),
+	FLOAT_PARAM(ekf2_tas_gate),
+	FLOAT_PARAM(ekf2_eas_noise),
+#endif // CONFIG_EKF2_AIRSPEED
+#if defined(CONFIG_EKF2_RANGE_FINDER)
+	INT_PARAM(ekf2_rng_ctrl),
+	FLOAT_PARAM(ekf2_rng_delay),
+	FLOAT_PARAM(ekf2_rng_noise),
+	FLOAT_PARAM(ekf2_rng_gate),
+#endif // CONFIG_EKF2_RANGE_FINDER
+#if defined(CONFIG_EKF2_OPTICAL_FLOW)
+	FLOAT_PARAM(ekf2_of_delay),
+	FLOAT_PARAM(ekf2_of_n_min),
+	FLOAT_PARAM(ekf2_of_n_max),
+	FLOAT_PARAM(ekf2_of_gate),
+#endif // CONFIG_EKF2_OPTICAL_FLOW
+};
+
+#undef FLOAT_PARAM
+#undef INT_PARAM
+
+// call f(name, aid source status) for every aid source of the Ekf
+template<typename F>
+void forEachAidSource(const Ekf &ekf, F f)
+{
+#if defined(CONFIG_EKF2_BAROMETER)
+	f("baro_hgt", ekf.aid_src_baro_hgt());
+#endif // CONFIG_EKF2_BAROMETER
+#if defined(CONFIG_EKF2_GNSS)
+	f("gnss_hgt", ekf.aid_src_gnss_hgt());
+	f("gnss_pos", ekf.aid_src_gnss_pos());
+	f("gnss_vel", ekf.aid_src_gnss_vel());
+#endif // CONFIG_EKF2_GNSS
+#if defined(CONFIG_EKF2_MAGNETOMETER)
+	f("mag", ekf.aid_src_mag());
+#endif // CONFIG_EKF2_MAGNETOMETER
+#if defined(CONFIG_EKF2_AIRSPEED)
+	f("airspeed", ekf.aid_src_airspeed());
+#endif // CONFIG_EKF2_AIRSPEED
+#if defined(CONFIG_EKF2_RANGE_FINDER)
+	f("rng_hgt", ekf.aid_src_rng_hgt());
+#endif // CONFIG_EKF2_RANGE_FINDER
+#if defined(CONFIG_EKF2_OPTICAL_FLOW)
+	f("optical_flow", ekf.aid_src_optical_flow());
+#endif // CONFIG_EKF2_OPTICAL_FLOW
+	f("fake_hgt", ekf.aid_src_fake_hgt());
+	f("fake_pos", ekf.aid_src_fake_pos());
+}
+
+template<size_t N>
+constexpr size_t axes(const float (&)[N]) { return N; }
+constexpr size_t axes(const float &) { return 1; }
+
+class InnovationAccumulator
+{
+public:
+	template<typename T>
+	void update(const char *name, const T &aid_src)
+	{
+		_name = name;
+
+		if (aid_src.timestamp_sample == 0 || aid_src.timestamp_sample == _last_timestamp_sample) {
+			return;
+		}
+
+		_last_timestamp_sample = aid_src.timestamp_sample;
+		_samples++;
+		_fused += aid_src.fused ? 1 : 0;
+		_rejected += aid_src.innovation_rejected ? 1 : 0;
+
+		const size_t n = axes(aid_src.innovation);
+		const float *innovation = (const float *)&aid_src.innovation;
+		const float *test_ratio = (const float *)&aid_src.test_ratio;
+		float test_ratio_max = 0.f;
+
+		for (size_t i = 0; i < n; i++) {
+			_innovation_sq_sum += (double)innovation[i] * (double)innovation[i];
+			test_ratio_max = std::max(test_ratio_max, test_ratio[i]);
+		}
+
+		_innovation_count += n;
+		_test_ratio_sum += (double)test_ratio_max;
+		_test_ratio_max = std::max(_test_ratio_max, test_ratio_max);
+	}
+
+	bool hasSamples() const { return _samples > 0; }
+
+	InnovationStatistics statistics() const
+	{
+		InnovationStatistics statistics;
+		statistics.aid_source = _name;
+		statistics.samples = _samples;
+		statistics.fused = _fused;
+		statistics.rejected = _rejected;
+
+		if (_samples > 0) {
+			statistics.test_ratio_mean = (float)(_test_ratio_sum / _samples);
+			statistics.test_ratio_max = _test_ratio_max;
+			statistics.innovation_rms = (float)std::sqrt(_innovation_sq_sum / _innovation_count);
+		}
+
+		return statistics;
+	}
+
+private:
+	const char *_name{nullptr};
+	uint64_t _last_timestamp_sample{0};
+	uint32_t _samples{0};
+	uint32_t _fused{0};
+	uint32_t _rejected{0};
+	double _test_ratio_sum{0.};
+	float _test_ratio_max{0.f};
+	double _innovation_sq_sum{0.};
+	size_t _innovation_count{0};
+};
+
+} // namespace
+
+bool BatchReplay::setParameter(parameters &params, const std::string &name, float value)
+{
+	for (const ParameterEntry &entry : tuning_parameters) {
+		if (strcasecmp(entry.name, name.c_str()) == 0) {
+			if (entry.float_value) {
+				params.*entry.float_value = value;
+
+			} else {
+				params.*entry.int_value = (int32_t)value;
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+BatchReplayResult BatchReplay::replay(const BatchReplayRun &run)
+{
+	BatchReplayResult result;
+	const auto wall_time_start = std::chrono::steady_clock::now();
+
+	std::shared_ptr<Ekf> ekf = std::make_shared<Ekf>();
+	SensorSimulator sensor_simulator(ekf);
+	EkfWrapper ekf_wrapper(ekf);
+
+	sensor_simulator.loadSensorDataFromFile(run.sensor_data_file);
+
+	if (!sensor_simulator.replayDataContains(sensor_info::measurement_t::IMU)) {
+		result.error = "no IMU data in " + run.sensor_data_file;
+		return result;
+	}
+
+	// IMU, baro and mag are running by default, start the other sensors contained in the data
+	if (sensor_simulator.replayDataContains(sensor_info::measurement_t::GPS)) {
+		sensor_simulator.startGps();
+		ekf_wrapper.enableGpsFusion();
+	}
+
+	if (sensor_simulator.replayDataContains(sensor_info::measurement_t::AIRSPEED)) {
+		sensor_simulator.startAirspeedSensor();
+	}
+
+	if (sensor_simulator.replayDataContains(sensor_info::measurement_t::RANGE)) {
+		sensor_simulator.startRangeFinder();
+	}
+
+	if (sensor_simulator.replayDataContains(sensor_info::measurement_t::FLOW)) {
+		sensor_simulator.startFlow();
+		ekf_wrapper.enableFlowFusion();
+	}
+
+	// the overrides take precedence over the defaults of the wrapper
+	for (const auto &param : run.params) {
+		if (!setParameter(*ekf->getParamHandle(), param.first, param.second)) {
+			result.error = "unknown parameter " + param.first;
+			return result;
+		}
+	}
+
+	std::unique_ptr<EkfLogger> ekf_logger;
+
+	if (!run.output_file.empty()) {
+		ekf_logger = std::make_unique<EkfLogger>(ekf);
+		ekf_logger->setFilePath(run.output_file);
+	}
+
+	std::vector<InnovationAccumulator> accumulators;
+	forEachAidSource(*ekf, [&accumulators](const char *, const auto &) { accumulators.emplace_back(); });
+
+	static constexpr uint32_t step_us = 1000;
+	static constexpr uint32_t logging_interval_us = 100'000;
+	const uint64_t end_time = sensor_simulator.getReplayEndTime();
+
+	while (sensor_simulator.getTime() < end_time) {
+		sensor_simulator.runReplayMicroseconds(step_us);
+
+		size_t i = 0;
+		forEachAidSource(*ekf, [&accumulators, &i](const char *name, const auto & aid_src) {
+			accumulators[i++].update(name, aid_src);
+		});
+
+		if (ekf_logger && (sensor_simulator.getTime() % logging_interval_us == 0)) {
+			ekf_logger->writeStateToFile();
+		}
+	}
+
+	for (const InnovationAccumulator &accumulator : accumulators) {
+		if (accumulator.hasSamples()) {
+			result.innovations.push_back(accumulator.statistics());
+		}
+	}
+
+	result.success = true;
+	result.replay_duration_s = sensor_simulator.getTime() * 1e-6f;
+	result.wall_time_s = std::chrono::duration<float>(std::chrono::steady_clock::now() - wall_time_start).count();
+	return result;
+}
+
+std::vector<BatchReplayResult> BatchReplay::replayAll(const std::vector<BatchReplayRun> &runs, unsigned num_threads)
+{
+	std::vector<BatchReplayResult> results(runs.size());
+
+	if (num_threads == 0) {
+		num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	num_threads = std::min<unsigned>(num_threads, runs.size());
+
+	// every worker takes the next run until all are done
+	std::atomic<size_t> next_run{0};
+	std::vector<std::thread> workers;
+
+	for (unsigned i = 0; i < num_threads; i++) {
+		workers.emplace_back([&runs, &results, &next_run]() {
+			for (size_t run = next_run++; run < runs.size(); run = next_run++) {
+				results[run] = replay(runs[run]);
+			}
+		});
+	}
+
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+
+	return results;
+}
@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Headless batch replay of recorded sensor data. Every run uses its own Ekf instance, sensor data
+ * and parameter set, and the runs are distributed over worker threads. The Ekf is driven directly
+ * by the sensor simulator, without uORB or work queues in the loop.
+ */
+#ifndef EKF_BATCH_REPLAY_H
+#define EKF_BATCH_REPLAY_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "EKF/ekf.h"
+
+struct BatchReplayRun {
+	std::string sensor_data_file; ///< sensor data as created by convertULogToSensorData.py
+	std::vector<std::pair<std::string, float>> params; ///< parameter overrides, e.g. {"EKF2_GPS_P_GATE", 3.f}
+	std::string output_file; ///< estimator states and variances at 10 Hz, not written if empty
+};
+
+struct InnovationStatistics {
+	const char *aid_source{nullptr};
+	uint32_t samples{0};
+	uint32_t fused{0};
+	uint32_t rejected{0};
+	float test_ratio_mean{0.f};
+	float test_ratio_max{0.f};
+	float innovation_rms{0.f};
+};
+
+struct BatchReplayResult {
+	bool success{false};
+	std::string error;
+	float replay_duration_s{0.f};
+	float wall_time_s{0.f};
+	std::vector<InnovationStatistics> innovations; ///< one entry per aid source that had samples
+};
+
+class BatchReplay
+{
+public:
+	/**
+	 * Set an EKF2 tuning parameter by its name (case insensitive)
+	 * @return false if the parameter is not known
+	 */
+	static bool setParameter(parameters &params, const std::string &name, float value);
+
+	/**
+	 * Replay a single run in the calling thread
+	 */
+	static BatchReplayResult replay(const BatchReplayRun &run);
+
+	/**
+	 * Replay all runs in parallel
+	 * @param num_threads number of worker threads, 0 for one per core
+	 * @return results in the order of the runs
+	 */
+	static std::vector<BatchReplayResult> replayAll(const std::vector<BatchReplayRun> &runs, unsigned num_threads = 0);
+};
+#endif // !EKF_BATCH_REPLAY_H
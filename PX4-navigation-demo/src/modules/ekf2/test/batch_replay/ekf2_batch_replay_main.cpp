@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Command line tool to replay recorded sensor data of many logs through the EKF in parallel.
+ *
+ * Usage: ekf2_batch_replay [-j <threads>] <runs file>
+ *
+ * Every line of the runs file describes one run:
+ *   <sensor data csv> <output csv or -> [<PARAM>=<value> ...]
+ * Empty lines and lines starting with '#' are ignored. The sensor data is created from a ULog with
+ * convertULogToSensorData.py. The innovation statistics of all runs are printed as CSV.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+#include "batch_replay.h"
+
+static void usage(const char *name)
+{
+	std::cerr << "Usage: " << name << " [-j <threads>] <runs file>" << std::endl
+		  << "  runs file lines: <sensor data csv> <output csv or -> [<PARAM>=<value> ...]" << std::endl;
+}
+
+static bool readRuns(const char *file_name, std::vector<BatchReplayRun> &runs)
+{
+	std::ifstream file(file_name);
+
+	if (!file) {
+		std::cerr << "Can not open " << file_name << std::endl;
+		return false;
+	}
+
+	std::string line;
+
+	while (std::getline(file, line)) {
+		std::istringstream line_stream(line);
+		BatchReplayRun run;
+
+		if (!(line_stream >> run.sensor_data_file) || run.sensor_data_file[0] == '#') {
+			continue;
+		}
+
+		std::string output_file;
+
+		if (line_stream >> output_file && output_file != "-") {
+			run.output_file = output_file;
+		}
+
+		std::string param;
+
+		while (line_stream >> param) {
+			const size_t separator = param.find('=');
+
+			if (separator == std::string::npos) {
+				std::cerr << "Invalid parameter " << param << " (expected <PARAM>=<value>)" << std::endl;
+				return false;
+			}
+
+			run.params.emplace_back(param.substr(0, separator), std::strtof(param.c_str() + separator + 1, nullptr));
+		}
+
+		runs.push_back(run);
+	}
+
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned num_threads = 0;
+	int ch;
+
+	while ((ch = getopt(argc, argv, "j:")) != -1) {
+		switch (ch) {
+		case 'j':
+			num_threads = std::strtoul(optarg, nullptr, 10);
+			break;
+
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (optind != argc - 1) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	std::vector<BatchReplayRun> runs;
+
+	if (!readRuns(argv[optind], runs)) {
+		return 1;
+	}
+
+	const std::vector<BatchReplayResult> results = BatchReplay::replayAll(runs, num_threads);
+
+	int ret = 0;
+	std::cout << "run,sensor_data,aid_source,samples,fused,rejected,test_ratio_mean,test_ratio_max,innovation_rms"
+		  << std::endl;
+
+	for (size_t i = 0; i < results.size(); i++) {
+		const BatchReplayResult &result = results[i];
+
+		if (!result.success) {
+			std::cerr << "run " << i << " failed: " << result.error << std::endl;
+			ret = 1;
+			continue;
+		}
+
+		std::cerr << "run " << i << ": " << result.replay_duration_s << " s replayed in "
+			  << result.wall_time_s << " s" << std::endl;
+
+		for (const InnovationStatistics &statistics : result.innovations) {
+			std::cout << i << "," << runs[i].sensor_data_file << "," << statistics.aid_source << ","
+				  << statistics.samples << "," << statistics.fused << "," << statistics.rejected << ","
+				  << statistics.test_ratio_mean << "," << statistics.test_ratio_max << ","
+				  << statistics.innovation_rms << std::endl;
+		}
+	}
+
+	return ret;
+}
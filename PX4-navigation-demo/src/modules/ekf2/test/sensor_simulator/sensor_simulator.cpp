@@ -121,6 +121,17 @@ void SensorSimulator::loadSensorDataFromFile(std::string file_name)
 	_has_replay_data = true;
 }
 
+bool SensorSimulator::replayDataContains(sensor_info::measurement_t sensor_type) const
+{
+	for (const sensor_info &sample : _replay_data) {
+		if (sample.sensor_type == sensor_type) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void SensorSimulator::setSensorRateToDefault()
 {
 	_imu.setRateHz(200);
@@ -228,7 +239,7 @@ void SensorSimulator::setSensorDataFromReplayData()
 		while (sample.timestamp < _time) {
 			setSingleReplaySample(sample);
 
-			if (_current_replay_data_index < _replay_data.size()) {
+			if (_current_replay_data_index + 1 < _replay_data.size()) {
 				_current_replay_data_index ++;
 
 			} else {
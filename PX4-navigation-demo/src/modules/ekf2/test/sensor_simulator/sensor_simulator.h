@@ -118,6 +118,10 @@ public:
 	void setOrientation(const Dcmf &orientation) { _R_body_to_world = orientation; }
 
 	void loadSensorDataFromFile(std::string filename);
+	bool replayDataContains(sensor_info::measurement_t sensor_type) const;
+
+	// timestamp of the last replay sample (microseconds), 0 without replay data
+	uint64_t getReplayEndTime() const { return _replay_data.empty() ? 0 : _replay_data.back().timestamp; }
 
 	Airspeed    _airspeed;
 	Baro        _baro;
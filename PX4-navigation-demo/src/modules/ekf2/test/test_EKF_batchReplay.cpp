@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include "EKF/ekf.h"
+#include "batch_replay/batch_replay.h"
+
+static const InnovationStatistics *findStatistics(const BatchReplayResult &result, const char *aid_source)
+{
+	for (const InnovationStatistics &statistics : result.innovations) {
+		if (strcmp(statistics.aid_source, aid_source) == 0) {
+			return &statistics;
+		}
+	}
+
+	return nullptr;
+}
+
+TEST(EkfBatchReplayTest, setParameter)
+{
+	parameters params{};
+
+	EXPECT_TRUE(BatchReplay::setParameter(params, "EKF2_GPS_P_GATE", 1.5f));
+	EXPECT_FLOAT_EQ(params.ekf2_gps_p_gate, 1.5f);
+
+	EXPECT_TRUE(BatchReplay::setParameter(params, "ekf2_hgt_ref", 1.f));
+	EXPECT_EQ(params.ekf2_hgt_ref, 1);
+
+	EXPECT_FALSE(BatchReplay::setParameter(params, "EKF2_DOES_NOT_EXIST", 1.f));
+}
+
+TEST(EkfBatchReplayTest, invalidRuns)
+{
+	BatchReplayRun missing_file{TEST_DATA_PATH"/replay_data/does_not_exist.csv", {}, ""};
+	EXPECT_FALSE(BatchReplay::replay(missing_file).success);
+
+	BatchReplayRun unknown_param{TEST_DATA_PATH"/replay_data/iris_gps.csv", {{"EKF2_DOES_NOT_EXIST", 1.f}}, ""};
+	EXPECT_FALSE(BatchReplay::replay(unknown_param).success);
+}
+
+TEST(EkfBatchReplayTest, parallelMatchesSequential)
+{
+	const std::vector<BatchReplayRun> runs{
+		{TEST_DATA_PATH"/replay_data/iris_gps.csv", {}, ""},
+		{TEST_DATA_PATH"/replay_data/iris_gps.csv", {{"EKF2_GPS_P_GATE", 1.f}, {"EKF2_GPS_V_GATE", 1.f}}, ""},
+		{TEST_DATA_PATH"/replay_data/ekf_gsf_reset.csv", {}, ""},
+	};
+
+	const std::vector<BatchReplayResult> results = BatchReplay::replayAll(runs, 3);
+	ASSERT_EQ(results.size(), runs.size());
+
+	for (size_t i = 0; i < runs.size(); i++) {
+		ASSERT_TRUE(results[i].success) << results[i].error;
+		EXPECT_GT(results[i].replay_duration_s, 10.f);
+
+		// the runs are independent, so running in parallel gives the same result as running alone
+		const BatchReplayResult sequential = BatchReplay::replay(runs[i]);
+		ASSERT_EQ(sequential.innovations.size(), results[i].innovations.size());
+
+		for (size_t j = 0; j < sequential.innovations.size(); j++) {
+			EXPECT_STREQ(sequential.innovations[j].aid_source, results[i].innovations[j].aid_source);
+			EXPECT_EQ(sequential.innovations[j].samples, results[i].innovations[j].samples);
+			EXPECT_EQ(sequential.innovations[j].fused, results[i].innovations[j].fused);
+			EXPECT_EQ(sequential.innovations[j].test_ratio_mean, results[i].innovations[j].test_ratio_mean);
+		}
+	}
+
+	// GNSS is fused with the default parameters, and the tighter gates reject more samples
+	const InnovationStatistics *gnss_vel = findStatistics(results[0], "gnss_vel");
+	const InnovationStatistics *gnss_vel_tight = findStatistics(results[1], "gnss_vel");
+	ASSERT_NE(gnss_vel, nullptr);
+	ASSERT_NE(gnss_vel_tight, nullptr);
+	EXPECT_GT(gnss_vel->fused, 0u);
+	EXPECT_GE(gnss_vel_tight->rejected, gnss_vel->rejected);
+}
@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test that the block fusion of direct state measurements matches sequential scalar fusion
+ */
+
+#include <gtest/gtest.h>
+#include "EKF/ekf.h"
+#include "sensor_simulator/sensor_simulator.h"
+#include "sensor_simulator/ekf_wrapper.h"
+
+using namespace matrix;
+
+class EkfBlockFusionTest : public ::testing::Test
+{
+public:
+
+	EkfBlockFusionTest(): ::testing::Test(),
+		_ekf_block{std::make_shared<Ekf>()},
+		_ekf_sequential{std::make_shared<Ekf>()},
+		_sensor_simulator_block(_ekf_block),
+		_sensor_simulator_sequential(_ekf_sequential),
+		_ekf_wrapper_block(_ekf_block),
+		_ekf_wrapper_sequential(_ekf_sequential) {};
+
+	std::shared_ptr<Ekf> _ekf_block;
+	std::shared_ptr<Ekf> _ekf_sequential;
+	SensorSimulator _sensor_simulator_block;
+	SensorSimulator _sensor_simulator_sequential;
+	EkfWrapper _ekf_wrapper_block;
+	EkfWrapper _ekf_wrapper_sequential;
+
+	// Run both filters through the same GNSS aided initialization
+	void SetUp() override
+	{
+		init(_ekf_block, _sensor_simulator_block, _ekf_wrapper_block);
+		init(_ekf_sequential, _sensor_simulator_sequential, _ekf_wrapper_sequential);
+
+		// block and sequential fusion only differ through the correlation of the fused axes
+		for (Ekf *ekf : {_ekf_block.get(), _ekf_sequential.get()}) {
+			correlateAxes(*ekf, State::vel.idx);
+			correlateAxes(*ekf, State::pos.idx);
+		}
+	}
+
+	// fuse an accurate observation of the sum of the first two axes, which correlates their errors
+	static void correlateAxes(Ekf &ekf, unsigned state_index)
+	{
+		Ekf::VectorState H;
+		H(state_index) = 1.f;
+		H(state_index + 1) = 1.f;
+
+		const float R = 0.01f;
+		const Ekf::VectorState PH = ekf.covariances() * H;
+		Ekf::VectorState K = PH / (H.dot(PH) + R);
+		ekf.measurementUpdate(K, H, R, 0.f);
+	}
+
+	static void init(std::shared_ptr<Ekf> &ekf, SensorSimulator &sensor_simulator, EkfWrapper &ekf_wrapper)
+	{
+		ekf->init(0);
+		sensor_simulator.runSeconds(0.1);
+		ekf->set_in_air_status(false);
+		ekf->set_vehicle_at_rest(true);
+
+		sensor_simulator.runSeconds(2);
+		ekf_wrapper.enableGpsFusion();
+		sensor_simulator.startGps();
+		sensor_simulator.runSeconds(11);
+	}
+
+	// fuse the N measurements one after the other, as the aid sources did before the block fusion
+	template <size_t N>
+	static void fuseSequential(Ekf &ekf, Vector<float, N> innov, const Vector<float, N> &R, unsigned state_index)
+	{
+		for (unsigned k = 0; k < N; k++) {
+			const unsigned index = state_index + k;
+			const Ekf::SquareMatrixState P = ekf.covariances();
+			const float innov_var = P(index, index) + R(k);
+			ekf.fuseDirectStateMeasurement(innov(k), innov_var, R(k), index);
+
+			// the innovation of a later axis includes the correction of its state by this axis
+			for (unsigned m = k + 1; m < N; m++) {
+				innov(m) -= P(state_index + m, index) / innov_var * innov(k);
+			}
+		}
+	}
+
+	void expectSameResult()
+	{
+		const auto state_block = _ekf_block->state().vector();
+		const auto state_sequential = _ekf_sequential->state().vector();
+
+		for (unsigned i = 0; i < state_block.size(); i++) {
+			EXPECT_NEAR(state_block(i), state_sequential(i), 1e-5f * fmaxf(1.f, fabsf(state_sequential(i)))) << "state " << i;
+		}
+
+		const Ekf::SquareMatrixState &P_block = _ekf_block->covariances();
+		const Ekf::SquareMatrixState &P_sequential = _ekf_sequential->covariances();
+
+		for (unsigned row = 0; row < State::size; row++) {
+			for (unsigned col = 0; col < State::size; col++) {
+				EXPECT_NEAR(P_block(row, col), P_sequential(row, col), 1e-3f * fmaxf(1e-4f, fabsf(P_sequential(row, col))))
+						<< "row " << row << " col " << col;
+			}
+		}
+	}
+};
+
+TEST_F(EkfBlockFusionTest, sameInitialization)
+{
+	// both filters must start from the same state for the comparisons below to be meaningful
+	EXPECT_EQ(_ekf_block->covariances(), _ekf_sequential->covariances());
+	EXPECT_EQ(_ekf_block->state().vector(), _ekf_sequential->state().vector());
+}
+
+TEST_F(EkfBlockFusionTest, velocity3D)
+{
+	// WHEN: fusing the same 3D velocity observation as a block and sequentially
+	const Vector3f innov(0.3f, -0.2f, 0.1f);
+	const Vector3f R(0.09f, 0.09f, 0.25f);
+	_ekf_block->fuseDirectStateMeasurements(innov, R, State::vel.idx);
+	fuseSequential(*_ekf_sequential, innov, R, State::vel.idx);
+
+	// THEN: the state and covariance match
+	expectSameResult();
+}
+
+TEST_F(EkfBlockFusionTest, horizontalPosition)
+{
+	// WHEN: fusing the same horizontal position observation as a block and sequentially
+	const Vector2f innov(-1.5f, 0.8f);
+	const Vector2f R(0.5f, 0.7f);
+	_ekf_block->fuseDirectStateMeasurements(innov, R, State::pos.idx);
+	fuseSequential(*_ekf_sequential, innov, R, State::pos.idx);
+
+	// THEN: the state and covariance match
+	expectSameResult();
+}
+
+TEST_F(EkfBlockFusionTest, repeatedFusion)
+{
+	// WHEN: fusing several velocity observations in a row, errors of the block update would add up
+	for (int i = 0; i < 20; i++) {
+		const Vector2f innov(0.05f * (i % 5), -0.03f * (i % 3));
+		const Vector2f R(0.04f, 0.04f);
+		_ekf_block->fuseDirectStateMeasurements(innov, R, State::vel.idx);
+		fuseSequential(*_ekf_sequential, innov, R, State::vel.idx);
+	}
+
+	// THEN: the state and covariance still match
+	expectSameResult();
+}
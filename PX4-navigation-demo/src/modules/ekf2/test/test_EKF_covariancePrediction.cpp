@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include "EKF/ekf.h"
+#include "EKF/covariance_prediction.h"
+#include "test_helper/comparison_helper.h"
+
+#include "../EKF/python/ekf_derivation/generated/predict_covariance.h"
+
+using namespace matrix;
+
+static SquareMatrixState predictGenerated(const StateSample &state, const SquareMatrixState &P,
+		const Vector3f &accel, const Vector3f &accel_var, float gyro_var, float dt)
+{
+	SquareMatrixState P_pred = sym::PredictCovariance(state.vector(), P, accel, accel_var, Vector3f(), gyro_var, dt);
+
+	// only the upper triangle is generated
+	for (unsigned row = 0; row < State::size; row++) {
+		for (unsigned col = 0; col < row; col++) {
+			P_pred(row, col) = P_pred(col, row);
+		}
+	}
+
+	return P_pred;
+}
+
+static StateSample randomState()
+{
+	StateSample state{};
+	state.quat_nominal = Quatf(Eulerf(2.f * (randf() - 0.5f), 2.f * (randf() - 0.5f), 6.f * (randf() - 0.5f)));
+	state.accel_bias = Vector3f(randf(), randf(), randf()) * 0.1f;
+	state.gyro_bias = Vector3f(randf(), randf(), randf()) * 0.01f;
+	return state;
+}
+
+static void expectNear(const SquareMatrixState &expected, const SquareMatrixState &actual)
+{
+	for (unsigned row = 0; row < State::size; row++) {
+		for (unsigned col = 0; col < State::size; col++) {
+			EXPECT_NEAR(expected(row, col), actual(row, col), 1e-4f * fmaxf(1.f, fabsf(expected(row, col))))
+					<< "row " << row << " col " << col;
+		}
+	}
+}
+
+TEST(CovariancePrediction, matchesGenerated)
+{
+	const Vector3f accel_var(0.1f, 0.2f, 0.3f);
+	const float gyro_var = 0.015f;
+	const float dt = 0.008f;
+
+	for (int i = 0; i < 10; i++) {
+		// GIVEN: a random state, covariance and specific force
+		const StateSample state = randomState();
+		const Vector3f accel(randf() * 4.f, randf() * 4.f, -9.81f + randf());
+		SquareMatrixState P = createRandomCovarianceMatrix();
+
+		// WHEN: predicting with both implementations
+		const SquareMatrixState P_generated = predictGenerated(state, P, accel, accel_var, gyro_var, dt);
+		estimator::covariance_prediction::predict(P, state.quat_nominal, accel - state.accel_bias, accel_var, gyro_var, dt);
+
+		// THEN: the results match and are symmetric
+		expectNear(P_generated, P);
+
+		for (unsigned row = 0; row < State::size; row++) {
+			for (unsigned col = 0; col < row; col++) {
+				EXPECT_EQ(P(row, col), P(col, row));
+			}
+		}
+	}
+}
+
+TEST(CovariancePrediction, uncorrelatedStatesSkipped)
+{
+	// GIVEN: states after the IMU biases that are uncorrelated with everything else (not being estimated)
+	const StateSample state = randomState();
+	const Vector3f accel(0.5f, -0.2f, -9.81f);
+	const Vector3f accel_var(0.1f, 0.1f, 0.1f);
+	SquareMatrixState P = createRandomCovarianceMatrix();
+
+	for (unsigned i = State::accel_bias.idx + State::accel_bias.dof; i < State::size; i++) {
+		P.uncorrelateCovarianceSetVariance<1>(i, 0.5f);
+	}
+
+	// WHEN: predicting the covariance
+	const SquareMatrixState P_generated = predictGenerated(state, P, accel, accel_var, 0.01f, 0.01f);
+	const SquareMatrixState P_prior = P;
+	estimator::covariance_prediction::predict(P, state.quat_nominal, accel - state.accel_bias, accel_var, 0.01f, 0.01f);
+
+	// THEN: they stay uncorrelated and their variance is untouched by F * P * F^T
+	expectNear(P_generated, P);
+
+	for (unsigned i = State::accel_bias.idx + State::accel_bias.dof; i < State::size; i++) {
+		EXPECT_EQ(P(i, i), P_prior(i, i));
+
+		for (unsigned j = 0; j < State::size; j++) {
+			if (j != i) {
+				EXPECT_EQ(P(i, j), 0.f);
+				EXPECT_EQ(P(j, i), 0.f);
+			}
+		}
+	}
+}
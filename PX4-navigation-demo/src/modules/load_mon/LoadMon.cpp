@@ -101,6 +101,8 @@ void LoadMon::Run()
 
 	cpuload();
 
+	work_queue_latency();
+
 #if defined(__PX4_NUTTX)
 
 	if (_param_sys_stck_en.get()) {
@@ -120,6 +122,58 @@ void LoadMon::Run()
 	perf_end(_cycle_perf);
 }
 
+void LoadMon::work_queue_latency()
+{
+	px4::wq_latency_t latency{};
+
+	if ((_wq_latency_entry_index > 0) && !px4::WorkQueueLatency(_wq_latency_index, _wq_latency_entry_index, latency)) {
+		// WorkItems were detached since the last cycle, continue with the next work queue
+		_wq_latency_index++;
+		_wq_latency_entry_index = 0;
+	}
+
+	if ((_wq_latency_entry_index == 0) && !px4::WorkQueueLatency(_wq_latency_index, 0, latency)) {
+		// past the last work queue, start over
+		_wq_latency_index = 0;
+
+		if (!px4::WorkQueueLatency(_wq_latency_index, 0, latency)) {
+			return;
+		}
+	}
+
+	// as many entries as fit into the topic queue, the remaining WorkItems of the work queue follow in the next cycle
+	int num_published = 0;
+
+	do {
+		work_item_latency_s work_item_latency{};
+
+		strncpy(work_item_latency.wq_name, latency.wq_name, sizeof(work_item_latency.wq_name) - 1);
+
+		if (latency.item_name != nullptr) {
+			strncpy(work_item_latency.item_name, latency.item_name, sizeof(work_item_latency.item_name) - 1);
+		}
+
+		work_item_latency.wait_p50 = latency.wait.percentile(0.5f);
+		work_item_latency.wait_p99 = latency.wait.percentile(0.99f);
+		work_item_latency.wait_max = latency.wait.max();
+		work_item_latency.run_p50 = latency.run.percentile(0.5f);
+		work_item_latency.run_p99 = latency.run.percentile(0.99f);
+		work_item_latency.run_max = latency.run.max();
+		work_item_latency.timestamp = hrt_absolute_time();
+		_work_item_latency_pub.publish(work_item_latency);
+
+		_wq_latency_entry_index++;
+
+		if (++num_published == work_item_latency_s::ORB_QUEUE_LENGTH) {
+			return;
+		}
+
+	} while (px4::WorkQueueLatency(_wq_latency_index, _wq_latency_entry_index, latency));
+
+	_wq_latency_index++;
+	_wq_latency_entry_index = 0;
+}
+
 void LoadMon::cpuload()
 {
 #if defined(__PX4_LINUX)
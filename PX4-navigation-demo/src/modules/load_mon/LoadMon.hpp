@@ -43,10 +43,12 @@
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
 #include <px4_platform/cpuload.h>
 #include <uORB/Publication.hpp>
 #include <uORB/topics/cpuload.h>
 #include <uORB/topics/task_stack_info.h>
+#include <uORB/topics/work_item_latency.h>
 
 #if defined(__PX4_LINUX)
 #include <sys/times.h>
@@ -81,6 +83,14 @@ private:
 	/** Do a calculation of the CPU load and publish it. */
 	void cpuload();
 
+	/** Publish the scheduling latency of the next work queue and its WorkItems. */
+	void work_queue_latency();
+
+	int _wq_latency_index{0};
+	int _wq_latency_entry_index{0};	///< first entry of the work queue to publish, if it did not fit into the last cycle
+
+	uORB::Publication<work_item_latency_s> _work_item_latency_pub{ORB_ID(work_item_latency)};
+
 	/* Stack check only available on Nuttx */
 #if defined(__PX4_NUTTX)
 	/* Calculate stack usage */
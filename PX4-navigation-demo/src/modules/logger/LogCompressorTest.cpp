@@ -0,0 +1,312 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "log_compressor.h"
+
+#include <lib/heatshrink/heatshrink/heatshrink_decoder.h>
+
+using namespace px4::logger;
+
+static constexpr size_t test_data_size = 3 * LogCompressor::max_frame_size + 123;
+
+class LogCompressorTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_fd = mkstemp(_path);
+		ASSERT_GE(_fd, 0);
+	}
+
+	void TearDown() override
+	{
+		close(_fd);
+		unlink(_path);
+	}
+
+	/** deterministic pseudo-random bytes (xorshift32) */
+	static void fillRandom(uint8_t *data, size_t size)
+	{
+		uint32_t state = 0x12345678;
+
+		for (size_t i = 0; i < size; i++) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			data[i] = (uint8_t)state;
+		}
+	}
+
+	/** a short record repeated over and over, like a topic logged at a constant value */
+	static void fillRepetitive(uint8_t *data, size_t size)
+	{
+		static constexpr uint8_t record[] = {'U', 'L', 'o', 'g', 0x00, 0x01, 0x02, 0x03, 0xff, 0x7f, 0x00, 0x00};
+
+		for (size_t i = 0; i < size; i++) {
+			data[i] = record[i % sizeof(record)];
+		}
+	}
+
+	/**
+	 * Compress with a statically allocated encoder
+	 * @return compressed size, 0 if the output does not fit
+	 */
+	static size_t encode(const uint8_t *data, size_t size, uint8_t *output, size_t output_capacity)
+	{
+		heatshrink_encoder encoder;
+		heatshrink_encoder_reset(&encoder);
+		size_t input_size = 0;
+		size_t output_size = 0;
+
+		while (true) {
+			if (input_size < size) {
+				size_t sunk = 0;
+
+				if (heatshrink_encoder_sink(&encoder, const_cast<uint8_t *>(&data[input_size]), size - input_size, &sunk) < 0) {
+					return 0;
+				}
+
+				input_size += sunk;
+
+			} else if (heatshrink_encoder_finish(&encoder) == HSER_FINISH_DONE) {
+				return output_size;
+			}
+
+			HSE_poll_res res;
+
+			do {
+				size_t polled = 0;
+				res = heatshrink_encoder_poll(&encoder, &output[output_size], output_capacity - output_size, &polled);
+				output_size += polled;
+
+				if (res < 0 || (res == HSER_POLL_MORE && output_size == output_capacity)) {
+					return 0;
+				}
+
+			} while (res == HSER_POLL_MORE);
+		}
+	}
+
+	/**
+	 * Decompress with a statically allocated decoder
+	 * @return decompressed size, 0 if the output does not fit or the input is corrupt
+	 */
+	static size_t decode(const uint8_t *data, size_t size, uint8_t *output, size_t output_capacity)
+	{
+		heatshrink_decoder decoder;
+		heatshrink_decoder_reset(&decoder);
+		size_t input_size = 0;
+		size_t output_size = 0;
+
+		while (input_size < size || heatshrink_decoder_finish(&decoder) == HSDR_FINISH_MORE) {
+			size_t sunk = 0;
+
+			if (input_size < size) {
+				if (heatshrink_decoder_sink(&decoder, const_cast<uint8_t *>(&data[input_size]), size - input_size, &sunk) < 0) {
+					return 0;
+				}
+
+				input_size += sunk;
+			}
+
+			size_t polled = 0;
+			const HSD_poll_res res = heatshrink_decoder_poll(&decoder, &output[output_size], output_capacity - output_size,
+						 &polled);
+			output_size += polled;
+
+			if (res < 0 || (sunk == 0 && polled == 0)) {
+				return 0;
+			}
+		}
+
+		return output_size;
+	}
+
+	/**
+	 * Read back the file written by the compressor and decompress all frames
+	 * @return decompressed size, 0 on a malformed file
+	 */
+	size_t readLog(uint8_t *output, size_t output_capacity, size_t &compressed_frames)
+	{
+		const off_t file_size = lseek(_fd, 0, SEEK_END);
+
+		if (file_size < (off_t)sizeof(ulog_compressed_header_s) || lseek(_fd, 0, SEEK_SET) != 0) {
+			return 0;
+		}
+
+		uint8_t *file = (uint8_t *)malloc(file_size);
+
+		if (file == nullptr || read(_fd, file, file_size) != file_size) {
+			free(file);
+			return 0;
+		}
+
+		memcpy(&_header, file, sizeof(_header));
+
+		size_t offset = sizeof(_header);
+		size_t output_size = 0;
+		compressed_frames = 0;
+
+		while (offset + sizeof(ulog_compressed_frame_s) <= (size_t)file_size) {
+			ulog_compressed_frame_s frame;
+			memcpy(&frame, &file[offset], sizeof(frame));
+			offset += sizeof(frame);
+
+			if (offset + frame.compressed_size > (size_t)file_size
+			    || output_size + frame.uncompressed_size > output_capacity) {
+				output_size = 0;
+				break;
+			}
+
+			if (frame.compressed_size == frame.uncompressed_size) {
+				// stored uncompressed
+				memcpy(&output[output_size], &file[offset], frame.uncompressed_size);
+
+			} else if (decode(&file[offset], frame.compressed_size, &output[output_size],
+					  frame.uncompressed_size) != frame.uncompressed_size) {
+				output_size = 0;
+				break;
+
+			} else {
+				compressed_frames++;
+			}
+
+			offset += frame.compressed_size;
+			output_size += frame.uncompressed_size;
+		}
+
+		free(file);
+		return output_size;
+	}
+
+	int _fd{-1};
+	char _path[32] = "/tmp/log_compressor_test_XXXXXX";
+	ulog_compressed_header_s _header{};
+	LogCompressor _compressor;
+
+	uint8_t _input[test_data_size];
+	uint8_t _output[2 * test_data_size];
+};
+
+TEST_F(LogCompressorTest, StaticConfiguration)
+{
+	// THEN: the statically allocated codec uses a 256 byte window and a 16 byte lookahead
+	EXPECT_EQ(HEATSHRINK_STATIC_WINDOW_BITS, 8);
+	EXPECT_EQ(HEATSHRINK_STATIC_LOOKAHEAD_BITS, 4);
+
+	// WHEN: the log is started
+	ASSERT_TRUE(_compressor.start(_fd));
+	size_t compressed_frames = 0;
+	EXPECT_EQ(readLog(_output, sizeof(_output), compressed_frames), 0u);
+
+	// THEN: the header tells the reader the same parameters
+	EXPECT_EQ(memcmp(_header.magic, "ULogCmp", sizeof(_header.magic)), 0);
+	EXPECT_EQ(_header.window_bits, 8);
+	EXPECT_EQ(_header.lookahead_bits, 4);
+}
+
+TEST_F(LogCompressorTest, RoundTripRandom)
+{
+	// GIVEN: incompressible data
+	fillRandom(_input, sizeof(_input));
+
+	// WHEN: it is compressed and decompressed directly
+	const size_t compressed_size = encode(_input, sizeof(_input), _output, sizeof(_output));
+	ASSERT_GT(compressed_size, 0u);
+
+	uint8_t decompressed[test_data_size];
+	ASSERT_EQ(decode(_output, compressed_size, decompressed, sizeof(decompressed)), sizeof(_input));
+
+	// THEN: the data is restored although the encoder expanded it
+	EXPECT_GE(compressed_size, sizeof(_input));
+	EXPECT_EQ(memcmp(decompressed, _input, sizeof(_input)), 0);
+}
+
+TEST_F(LogCompressorTest, RoundTripRepetitive)
+{
+	// GIVEN: highly repetitive data
+	fillRepetitive(_input, sizeof(_input));
+
+	// WHEN: it is compressed and decompressed directly
+	const size_t compressed_size = encode(_input, sizeof(_input), _output, sizeof(_output));
+	ASSERT_GT(compressed_size, 0u);
+
+	uint8_t decompressed[test_data_size];
+	ASSERT_EQ(decode(_output, compressed_size, decompressed, sizeof(decompressed)), sizeof(_input));
+
+	// THEN: the data is restored and shrunk well
+	EXPECT_LT(compressed_size, sizeof(_input) / 4);
+	EXPECT_EQ(memcmp(decompressed, _input, sizeof(_input)), 0);
+}
+
+TEST_F(LogCompressorTest, LogRandom)
+{
+	// GIVEN: incompressible data
+	fillRandom(_input, sizeof(_input));
+
+	// WHEN: it is written to the log
+	ASSERT_TRUE(_compressor.start(_fd));
+	ASSERT_EQ(_compressor.write(_fd, _input, sizeof(_input)), (ssize_t)sizeof(_input));
+
+	// THEN: all frames are stored uncompressed and read back unchanged
+	size_t compressed_frames = 0;
+	ASSERT_EQ(readLog(_output, sizeof(_output), compressed_frames), sizeof(_input));
+	EXPECT_EQ(compressed_frames, 0u);
+	EXPECT_EQ(memcmp(_output, _input, sizeof(_input)), 0);
+	EXPECT_EQ(_compressor.input_bytes(), sizeof(_input));
+}
+
+TEST_F(LogCompressorTest, LogRepetitive)
+{
+	// GIVEN: highly repetitive data
+	fillRepetitive(_input, sizeof(_input));
+
+	// WHEN: it is written to the log in pieces that do not align with the frames
+	ASSERT_TRUE(_compressor.start(_fd));
+	ASSERT_EQ(_compressor.write(_fd, _input, 1000), 1000);
+	ASSERT_EQ(_compressor.write(_fd, &_input[1000], sizeof(_input) - 1000), (ssize_t)(sizeof(_input) - 1000));
+
+	// THEN: every frame is compressed and the log decompresses to the input
+	size_t compressed_frames = 0;
+	ASSERT_EQ(readLog(_output, sizeof(_output), compressed_frames), sizeof(_input));
+	EXPECT_EQ(compressed_frames, 4u);
+	EXPECT_EQ(memcmp(_output, _input, sizeof(_input)), 0);
+	EXPECT_LT(_compressor.output_bytes(), _compressor.input_bytes() / 4);
+}
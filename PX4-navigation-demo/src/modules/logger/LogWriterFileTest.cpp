@@ -0,0 +1,208 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file LogWriterFileTest.cpp
+ * Feeds the file log writer at a constant rate while the log "SD card" (a FIFO read by the test) stalls,
+ * like the logger thread does, and counts the dropouts.
+ */
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "log_writer_file.h"
+
+using namespace px4::logger;
+
+class LogWriterFileTest : public ::testing::Test
+{
+public:
+	static constexpr size_t message_size = 100;
+	static constexpr int message_interval_us = 1000; // 100 kB/s
+	static constexpr int stall_us = 100000; // every write_to_file() blocks for this long once the FIFO is full
+
+	void SetUp() override
+	{
+		ASSERT_NE(mkdtemp(_dir), nullptr);
+		snprintf(_path, sizeof(_path), "%s/log.ulg", _dir);
+		ASSERT_EQ(mkfifo(_path, 0600), 0);
+	}
+
+	void TearDown() override
+	{
+		unlink(_path);
+		rmdir(_dir);
+	}
+
+	/**
+	 * Log for duration_us at a constant rate, the same way Logger::write_message() does
+	 * @return number of dropouts
+	 */
+	int run(size_t buffer_size, int duration_us, size_t stall_every)
+	{
+		_stall_every = stall_every;
+		_bytes_read = 0;
+		_stream_ok = true;
+
+		pthread_t reader;
+		EXPECT_EQ(pthread_create(&reader, nullptr, &LogWriterFileTest::readerHelper, this), 0);
+
+		LogWriterFile writer(buffer_size);
+		EXPECT_EQ(writer.thread_start(), 0);
+		EXPECT_TRUE(writer.start_log(LogType::Full, _path));
+
+		int dropouts = 0;
+		hrt_abstime dropout_start = 0;
+		uint8_t message[message_size];
+		size_t stream_pos = 0;
+		const hrt_abstime start = hrt_absolute_time();
+
+		while (hrt_elapsed_time(&start) < (hrt_abstime)duration_us) {
+			for (size_t i = 0; i < message_size; i++) {
+				message[i] = streamByte(stream_pos + i);
+			}
+
+			writer.lock();
+
+			if (writer.write_message(LogType::Full, message, message_size, dropout_start) != -1) {
+				dropout_start = 0;
+				stream_pos += message_size;
+
+			} else if (dropout_start == 0) {
+				dropout_start = hrt_absolute_time();
+				++dropouts;
+			}
+
+			writer.unlock();
+			writer.notify();
+
+			usleep(message_interval_us);
+		}
+
+		writer.stop_log(LogType::Full);
+		writer.thread_stop();
+		pthread_join(reader, nullptr);
+
+		_bytes_logged = stream_pos;
+		return dropouts;
+	}
+
+	/** content of the logged byte stream, so that the reader can check it arrives in order */
+	static uint8_t streamByte(size_t pos) { return (uint8_t)(pos % 251); }
+
+	size_t _bytes_logged{0};
+	size_t _bytes_read{0};
+	bool _stream_ok{true};
+
+private:
+	static void *readerHelper(void *context)
+	{
+		static_cast<LogWriterFileTest *>(context)->reader();
+		return nullptr;
+	}
+
+	/** the slow SD card: stalls for stall_us after every _stall_every bytes */
+	void reader()
+	{
+		const int fd = open(_path, O_RDONLY);
+
+		if (fd < 0) {
+			_stream_ok = false;
+			return;
+		}
+
+#if defined(F_SETPIPE_SZ)
+		// keep the FIFO small, so that a stall reaches write_to_file() right away
+		fcntl(fd, F_SETPIPE_SZ, 4096);
+#endif
+
+		uint8_t data[512];
+		size_t since_stall = 0;
+		ssize_t n;
+
+		while ((n = read(fd, data, sizeof(data))) > 0) {
+			for (ssize_t i = 0; i < n; i++) {
+				if (data[i] != streamByte(_bytes_read + i)) {
+					_stream_ok = false;
+				}
+			}
+
+			_bytes_read += n;
+			since_stall += n;
+
+			if (since_stall >= _stall_every) {
+				since_stall = 0;
+				usleep(stall_us);
+			}
+		}
+
+		close(fd);
+	}
+
+	char _dir[32] {"/tmp/log_writer_test_XXXXXX"};
+	char _path[64] {};
+	size_t _stall_every{0};
+};
+
+TEST_F(LogWriterFileTest, StallAbsorbedByBuffer)
+{
+	// GIVEN: SD write stalls of 100 ms every 20 kB, while logging 100 kB/s into a 32 kB buffer
+	// WHEN: logging for 2 s
+	const int dropouts = run(32 * 1024, 2000000, 20 * 1024);
+
+	// THEN: the buffer takes up the 10 kB logged during each stall, nothing is dropped
+	EXPECT_EQ(dropouts, 0);
+
+	// THEN: the writer thread wrote everything in order
+	EXPECT_TRUE(_stream_ok);
+	EXPECT_EQ(_bytes_read, _bytes_logged);
+}
+
+TEST_F(LogWriterFileTest, StallExceedingBuffer)
+{
+	// GIVEN: the same stalls with a buffer that only holds the minimum write chunk
+	// WHEN: logging for 2 s
+	const int dropouts = run(0, 2000000, 20 * 1024);
+
+	// THEN: there are dropouts, but at most one per stall (there are about 7 stalls in 2 s)
+	EXPECT_GT(dropouts, 0);
+	EXPECT_LE(dropouts, 10);
+}
@@ -0,0 +1,131 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "log_compressor.h"
+
+#include <string.h>
+#include <unistd.h>
+
+namespace px4
+{
+namespace logger
+{
+
+bool LogCompressor::start(int fd)
+{
+	const ulog_compressed_header_s header = {
+		.magic = {'U', 'L', 'o', 'g', 'C', 'm', 'p'},
+		.hdr_ver = 1,
+		.window_bits = HEATSHRINK_STATIC_WINDOW_BITS,
+		.lookahead_bits = HEATSHRINK_STATIC_LOOKAHEAD_BITS
+	};
+
+	_input_bytes = 0;
+	_output_bytes = sizeof(header);
+	_compression_time = 0;
+
+	return ::write(fd, &header, sizeof(header)) == sizeof(header);
+}
+
+ssize_t LogCompressor::write(int fd, const uint8_t *data, size_t size)
+{
+	size_t written = 0;
+
+	while (written < size) {
+		const size_t frame_size = (size - written < max_frame_size) ? size - written : max_frame_size;
+
+		const hrt_abstime start = hrt_absolute_time();
+		size_t compressed_size = compress(&data[written], frame_size);
+		_compression_time += hrt_elapsed_time(&start);
+
+		if (compressed_size == 0) {
+			// incompressible data is stored as it is
+			memcpy(&_frame[sizeof(ulog_compressed_frame_s)], &data[written], frame_size);
+			compressed_size = frame_size;
+		}
+
+		const ulog_compressed_frame_s frame{(uint16_t)compressed_size, (uint16_t)frame_size};
+		memcpy(_frame, &frame, sizeof(frame));
+
+		const size_t length = sizeof(frame) + compressed_size;
+
+		// a partially written frame cannot be continued, frames written before it are still valid
+		if (::write(fd, _frame, length) != (ssize_t)length) {
+			return (written > 0) ? (ssize_t)written : -1;
+		}
+
+		written += frame_size;
+		_input_bytes += frame_size;
+		_output_bytes += length;
+	}
+
+	return written;
+}
+
+size_t LogCompressor::compress(const uint8_t *data, size_t size)
+{
+	uint8_t *output = &_frame[sizeof(ulog_compressed_frame_s)];
+	size_t output_size = 0;
+	size_t input_size = 0;
+
+	heatshrink_encoder_reset(&_encoder);
+
+	while (true) {
+		if (input_size < size) {
+			size_t sunk = 0;
+			heatshrink_encoder_sink(&_encoder, const_cast<uint8_t *>(&data[input_size]), size - input_size, &sunk);
+			input_size += sunk;
+
+		} else if (heatshrink_encoder_finish(&_encoder) == HSER_FINISH_DONE) {
+			break;
+		}
+
+		HSE_poll_res res;
+
+		do {
+			size_t polled = 0;
+			res = heatshrink_encoder_poll(&_encoder, &output[output_size], size - output_size, &polled);
+			output_size += polled;
+
+			if ((res < 0) || (output_size >= size)) {
+				return 0;
+			}
+
+		} while (res == HSER_POLL_MORE);
+	}
+
+	return output_size;
+}
+
+}
+}
@@ -0,0 +1,97 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <drivers/drv_hrt.h>
+
+#define HEATSHRINK_DYNAMIC_ALLOC 0
+#include <lib/heatshrink/heatshrink/heatshrink_encoder.h>
+
+#include "messages.h"
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogCompressor
+ * Compresses the ULog data of a log file into frames (@see ulog_compressed_frame_s).
+ * Used from the writer thread only, except for the statistics.
+ */
+class LogCompressor
+{
+public:
+	/** maximum number of uncompressed bytes per frame */
+	static constexpr size_t max_frame_size = 4096;
+
+	/**
+	 * Write the file header and reset the statistics
+	 * @return true on success
+	 */
+	bool start(int fd);
+
+	/**
+	 * Compress data and write it to the file as one or more frames
+	 * @return number of bytes of data written, -1 on error if nothing was written
+	 */
+	ssize_t write(int fd, const uint8_t *data, size_t size);
+
+	size_t input_bytes() const { return _input_bytes; }
+	size_t output_bytes() const { return _output_bytes; }
+
+	/** time spent compressing since start() */
+	hrt_abstime compression_time() const { return _compression_time; }
+
+private:
+	/**
+	 * Compress data into the frame buffer
+	 * @return compressed size, 0 if it is not smaller than size
+	 */
+	size_t compress(const uint8_t *data, size_t size);
+
+	heatshrink_encoder _encoder;
+	uint8_t _frame[sizeof(ulog_compressed_frame_s) + max_frame_size];
+
+	size_t _input_bytes{0};
+	size_t _output_bytes{0};
+	hrt_abstime _compression_time{0};
+};
+
+}
+}
@@ -140,6 +140,18 @@ public:
 		return 0;
 	}
 
+	const LogCompressor *get_compressor_file(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_compressor(type); }
+
+		return nullptr;
+	}
+
+	void set_compression(bool compress)
+	{
+		if (_log_writer_file) { _log_writer_file->set_compression(compress); }
+	}
+
 	pthread_t thread_id_file() const
 	{
 		if (_log_writer_file) { return _log_writer_file->thread_id(); }
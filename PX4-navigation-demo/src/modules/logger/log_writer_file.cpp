@@ -193,18 +193,6 @@ bool LogWriterFile::init_logfile_encryption(const LogType type)
 
 bool LogWriterFile::start_log(LogType type, const char *filename)
 {
-	// At this point we don't expect the file to be open, but it can happen for very fast consecutive stop & start
-	// calls. In that case we wait for the thread to close the file first.
-	lock();
-
-	while (_buffers[(int)type].fd() >= 0) {
-		unlock();
-		system_usleep(5000);
-		lock();
-	}
-
-	unlock();
-
 	if (type == LogType::Full) {
 		// register the current file with the hardfault handler: if the system crashes,
 		// the hardfault handler will append the crash log to that file on the next reboot.
@@ -217,7 +205,21 @@ bool LogWriterFile::start_log(LogType type, const char *filename)
 		}
 	}
 
-	if (_buffers[(int)type].start_log(filename)) {
+	// At this point we don't expect the file to be open, but it can happen for very fast consecutive stop & start
+	// calls. In that case we wait for the thread to close the file first.
+	lock();
+
+	while (_buffers[(int)type].fd() >= 0) {
+		unlock();
+		system_usleep(5000);
+		lock();
+	}
+
+	// the writer thread does not close the file of a stopped buffer while we hold the lock (@see close_stopped_log())
+	const bool started = _buffers[(int)type].start_log(filename, _compress && (type == LogType::Full));
+	unlock();
+
+	if (started) {
 
 #if PX4_CRYPTO
 		bool enc_init = init_logfile_encryption(type);
@@ -225,9 +227,11 @@ bool LogWriterFile::start_log(LogType type, const char *filename)
 		if (!enc_init) {
 			PX4_ERR("Failed to start encrypted logging");
 			_crypto.close();
-			_buffers[(int)type]._should_run = false;
+			lock();
+			_buffers[(int)type]._should_run.store(false);
 			_buffers[(int)type].close_file();
 			_buffers[(int)type].reset();
+			unlock();
 			return false;
 		}
 
@@ -276,7 +280,7 @@ int LogWriterFile::hardfault_store_filename(const char *log_file)
 void LogWriterFile::stop_log(LogType type)
 {
 	lock();
-	_buffers[(int)type]._should_run = false;
+	_buffers[(int)type]._should_run.store(false);
 	unlock();
 	notify();
 }
@@ -304,7 +308,8 @@ void LogWriterFile::thread_stop()
 	// this will terminate the main loop of the writer thread
 	lock();
 	_exit_thread.store(true);
-	_buffers[0]._should_run = _buffers[1]._should_run = false;
+	_buffers[0]._should_run.store(false);
+	_buffers[1]._should_run.store(false);
 	unlock();
 
 	notify();
@@ -334,7 +339,7 @@ void LogWriterFile::run()
 			bool start = false;
 			pthread_mutex_lock(&_mtx);
 			pthread_cond_wait(&_cv, &_mtx);
-			start = _buffers[0]._should_run || _buffers[1]._should_run;
+			start = _buffers[0]._should_run.load() || _buffers[1]._should_run.load();
 			pthread_mutex_unlock(&_mtx);
 
 			if (start) {
@@ -349,8 +354,6 @@ void LogWriterFile::run()
 		int poll_count = 0;
 		hrt_abstime last_fsync = hrt_absolute_time();
 
-		pthread_mutex_lock(&_mtx);
-
 		while (true) {
 
 			const hrt_abstime now = hrt_absolute_time();
@@ -369,13 +372,19 @@ void LogWriterFile::run()
 				1 // For the mission log, write as soon as there is data available
 			};
 
-			/* Check all buffers for available data. Mission log is first to avoid drops */
+			/* Check all buffers for available data. Mission log is first to avoid drops.
+			 * The buffers are accessed without holding _mtx, only resetting one after closing its file needs it,
+			 * as the logger thread holds it while writing. */
 			int i = (int)LogType::Count - 1;
+			bool wrote_data = false;
 
 			while (i >= 0) {
 				void *read_ptr;
 				bool is_part;
 				LogFileBuffer &buffer = _buffers[i];
+
+				// read before the data, so that everything written before stopping is included
+				const bool should_run = buffer._should_run.load();
 				size_t available = buffer.get_read_ptr(&read_ptr, &is_part);
 
 #if defined(PX4_CRYPTO)
@@ -384,8 +393,7 @@ void LogWriterFile::run()
 #endif // PX4_CRYPTO
 
 				/* if sufficient data available or partial read or terminating, write data */
-				if (available >= min_available[i] || is_part || (!buffer._should_run && available > 0)) {
-					pthread_mutex_unlock(&_mtx);
+				if (available >= min_available[i] || is_part || (!should_run && available > 0)) {
 
 #if defined(PX4_CRYPTO)
 					/* This makes the following assumptions:
@@ -422,41 +430,31 @@ void LogWriterFile::run()
 						written = buffer.write_to_file(read_ptr, available, call_fsync);
 					}
 
-					/* buffer.mark_read() requires _mtx to be locked */
-					pthread_mutex_lock(&_mtx);
-
 					if (written >= 0) {
 						/* subtract bytes written from number in buffer (count -= written) */
 						buffer.mark_read(written);
 
-						if (!buffer._should_run && written == static_cast<int>(available) && !is_part) {
+						if (!should_run && written == static_cast<int>(available) && !is_part) {
 							/* Stop only when all data written */
-							pthread_mutex_unlock(&_mtx);
-							buffer.close_file();
-							pthread_mutex_lock(&_mtx);
-							buffer.reset();
+							close_stopped_log(buffer);
+						}
+
+						if (written > 0) {
+							wrote_data = true;
 						}
 
 					} else {
 						PX4_ERR("write failed (%i)", errno);
 						buffer._had_write_error.store(true);
-						buffer._should_run = false;
-						pthread_mutex_unlock(&_mtx);
-						buffer.close_file();
-						pthread_mutex_lock(&_mtx);
-						buffer.reset();
+						buffer._should_run.store(false);
+						close_stopped_log(buffer);
 					}
 
-				} else if (call_fsync && buffer._should_run) {
-					pthread_mutex_unlock(&_mtx);
+				} else if (call_fsync && should_run) {
 					buffer.fsync();
-					pthread_mutex_lock(&_mtx);
 
-				} else if (available == 0 && !buffer._should_run) {
-					pthread_mutex_unlock(&_mtx);
-					buffer.close_file();
-					pthread_mutex_lock(&_mtx);
-					buffer.reset();
+				} else if (available == 0 && !should_run && buffer.fd() >= 0) {
+					close_stopped_log(buffer);
 				}
 
 				/* if split into 2 parts, write the second part immediately as well */
@@ -465,6 +463,7 @@ void LogWriterFile::run()
 				}
 			}
 
+			pthread_mutex_lock(&_mtx);
 
 			if (_buffers[0].fd() < 0 && _buffers[1].fd() < 0) {
 				// stop when both files are closed
@@ -478,14 +477,15 @@ void LogWriterFile::run()
 			}
 
 			/* Wait for a call to notify(), which indicates new data is available.
-			 * Note that at this point there could already be new data available (because of a longer write),
-			 * and calling pthread_cond_wait() will still wait for the next notify(). But this is generally
-			 * not an issue because notify() is called regularly.
+			 * After writing, check the buffers once more before waiting instead, as the data committed during
+			 * a longer write might otherwise only be picked up with the next notify().
 			 * If the logger was switched off in the meantime, do not wait for data, instead run this loop
 			 * once more to write remaining data and close the file. */
-			if (_buffers[0]._should_run || _buffers[1]._should_run) {
+			if ((_buffers[0]._should_run.load() || _buffers[1]._should_run.load()) && !wrote_data) {
 				pthread_cond_wait(&_cv, &_mtx);
 			}
+
+			pthread_mutex_unlock(&_mtx);
 		}
 
 		// go back to idle
@@ -493,6 +493,21 @@ void LogWriterFile::run()
 	}
 }
 
+void LogWriterFile::close_stopped_log(LogFileBuffer &buffer)
+{
+	// check under the lock, as start_log() may have restarted the buffer in the meantime
+	pthread_mutex_lock(&_mtx);
+	const bool stopped = !buffer._should_run.load() && buffer.fd() >= 0;
+	pthread_mutex_unlock(&_mtx);
+
+	if (stopped) {
+		buffer.close_file();
+		pthread_mutex_lock(&_mtx);
+		buffer.reset();
+		pthread_mutex_unlock(&_mtx);
+	}
+}
+
 int LogWriterFile::write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start)
 {
 	if (_need_reliable_transfer) {
@@ -558,6 +573,7 @@ int LogWriterFile::write(LogType type, void *ptr, size_t size, uint64_t dropout_
 	}
 
 	_buffers[(int)type].write_no_check(ptr, size);
+	_buffers[(int)type].commit();
 	return 0;
 }
 
@@ -590,6 +606,7 @@ LogWriterFile::LogFileBuffer::~LogFileBuffer()
 	}
 
 	free(_buffer);
+	delete _compressor;
 
 	perf_free(_perf_write);
 	perf_free(_perf_fsync);
@@ -615,28 +632,26 @@ void LogWriterFile::LogFileBuffer::write_no_check(void *ptr, size_t size)
 
 	memcpy(&(_buffer[_head]), &(buffer_c[n]), p);
 	_head = (_head + p) % _buffer_size;
-	_count += size;
+	_uncommitted += size;
 }
 
 size_t LogWriterFile::LogFileBuffer::get_read_ptr(void **ptr, bool *is_part)
 {
 	// bytes available to read
-	int read_ptr = _head - _count;
+	const size_t count = _count.load();
+	*ptr = &_buffer[_tail];
 
-	if (read_ptr < 0) {
-		read_ptr += _buffer_size;
-		*ptr = &_buffer[read_ptr];
+	if (_tail + count > _buffer_size) {
 		*is_part = true;
-		return _buffer_size - read_ptr;
+		return _buffer_size - _tail;
 
 	} else {
-		*ptr = &_buffer[read_ptr];
 		*is_part = false;
-		return _count;
+		return count;
 	}
 }
 
-bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
+bool LogWriterFile::LogFileBuffer::start_log(const char *filename, bool compress)
 {
 	_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
 	_had_write_error.store(false);
@@ -646,6 +661,18 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 		return false;
 	}
 
+	// allocated before the buffer, which may take the largest free chunk
+	if (compress && _compressor == nullptr) {
+		_compressor = new LogCompressor();
+
+		if (_compressor == nullptr) {
+			PX4_ERR("Can't create log compressor");
+			::close(_fd);
+			_fd = -1;
+			return false;
+		}
+	}
+
 	if (_buffer == nullptr) {
 		_buffer_size = math::max(_buffer_size, _buffer_size_min);
 
@@ -676,12 +703,23 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 		}
 	}
 
+	_compress = compress;
+
+	if (_compress && !_compressor->start(_fd)) {
+		PX4_ERR("Can't write compressed log header, errno: %d", errno);
+		::close(_fd);
+		_fd = -1;
+		return false;
+	}
+
 	// Clear buffer and counters
 	_head = 0;
-	_count = 0;
+	_uncommitted = 0;
+	_tail = 0;
+	_count.store(0);
 	_total_written = 0;
 
-	_should_run = true;
+	_should_run.store(true);
 
 	return true;
 }
@@ -693,10 +731,18 @@ void LogWriterFile::LogFileBuffer::fsync() const
 	perf_end(_perf_fsync);
 }
 
-ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync) const
+ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync)
 {
 	perf_begin(_perf_write);
-	ssize_t ret = ::write(_fd, buffer, size);
+	ssize_t ret;
+
+	if (_compress) {
+		ret = _compressor->write(_fd, static_cast<const uint8_t *>(buffer), size);
+
+	} else {
+		ret = ::write(_fd, buffer, size);
+	}
+
 	perf_end(_perf_write);
 
 	if (call_fsync) {
@@ -723,7 +769,9 @@ void LogWriterFile::LogFileBuffer::close_file()
 void LogWriterFile::LogFileBuffer::reset()
 {
 	_head = 0;
-	_count = 0;
+	_uncommitted = 0;
+	_tail = 0;
+	_count.store(0);
 	_fd = -1;
 }
 
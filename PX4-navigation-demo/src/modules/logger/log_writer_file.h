@@ -40,6 +40,8 @@
 #include <drivers/drv_hrt.h>
 #include <perf/perf_counter.h>
 
+#include "log_compressor.h"
+
 #if defined(PX4_CRYPTO)
 # include <px4_platform_common/crypto.h>
 #endif // PX4_CRYPTO
@@ -86,7 +88,7 @@ public:
 
 	void stop_log(LogType type);
 
-	bool is_started(LogType type) const { return _buffers[(int)type]._should_run; }
+	bool is_started(LogType type) const { return _buffers[(int)type]._should_run.load(); }
 
 	/** @see LogWriter::write_message() */
 	int write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start = 0);
@@ -121,6 +123,20 @@ public:
 		return _buffers[(int)type].count();
 	}
 
+	/**
+	 * Get the compressor of a running log
+	 * @return nullptr if the log is not compressed
+	 */
+	const LogCompressor *get_compressor(LogType type) const
+	{
+		return _buffers[(int)type].compressor();
+	}
+
+	/**
+	 * Enable compression for the next full log
+	 */
+	void set_compression(bool compress) { _compress = compress; }
+
 	void set_need_reliable_transfer(bool need_reliable)
 	{
 		if (!need_reliable && _need_reliable_transfer) {
@@ -161,6 +177,13 @@ private:
 	 */
 	int hardfault_store_filename(const char *log_file);
 
+	class LogFileBuffer;
+
+	/**
+	 * Close the file of a stopped log and reset its buffer, called from the writer thread
+	 */
+	void close_stopped_log(LogFileBuffer &buffer);
+
 	/**
 	 * write w/o waiting/blocking
 	 */
@@ -169,6 +192,11 @@ private:
 	/* 512 didn't seem to work properly, 4096 should match the FAT cluster size */
 	static constexpr size_t	_min_write_chunk = 4096;
 
+	/**
+	 * Ring buffer between the logger thread, which is the only producer, and the writer thread.
+	 * _head belongs to the producer and _tail to the writer, _count is the only index both access,
+	 * so that neither has to hold _mtx while copying data or doing file I/O.
+	 */
 	class LogFileBuffer
 	{
 	public:
@@ -177,7 +205,7 @@ private:
 
 		~LogFileBuffer();
 
-		bool start_log(const char *filename);
+		bool start_log(const char *filename, bool compress);
 
 		void close_file();
 
@@ -186,25 +214,41 @@ private:
 		size_t get_read_ptr(void **ptr, bool *is_part);
 
 		/**
-		 * Write to the buffer but assuming there is enough space
+		 * Write to the buffer but assuming there is enough space. The data is not visible to the writer
+		 * thread before commit().
 		 */
 		inline void write_no_check(void *ptr, size_t size);
 
-		size_t available() const { return _buffer_size - _count; }
+		/**
+		 * Publish the data written since the last commit to the writer thread
+		 */
+		void commit()
+		{
+			_count.fetch_add(_uncommitted);
+			_uncommitted = 0;
+		}
+
+		size_t available() const { return _buffer_size - _count.load() - _uncommitted; }
 
 		int fd() const { return _fd; }
 
-		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync) const;
+		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync);
 
 		inline void fsync() const;
 
-		void mark_read(size_t n) { _count -= n; _total_written += n; }
+		void mark_read(size_t n)
+		{
+			_tail = (_tail + n) % _buffer_size;
+			_total_written += n;
+			_count.fetch_sub(n);
+		}
 
 		size_t total_written() const { return _total_written; }
 		size_t buffer_size() const { return _buffer_size; }
-		size_t count() const { return _count; }
+		size_t count() const { return _count.load(); }
+		const LogCompressor *compressor() const { return _compress ? _compressor : nullptr; }
 
-		bool _should_run = false;
+		px4::atomic_bool _should_run{false};
 		px4::atomic_bool _had_write_error{false};
 	private:
 		size_t _buffer_size;
@@ -212,8 +256,12 @@ private:
 		int	_fd = -1;
 		uint8_t *_buffer = nullptr;
 		size_t _head = 0; ///< next position to write to
-		size_t _count = 0; ///< number of bytes in _buffer to be written
+		size_t _uncommitted = 0; ///< number of bytes written before _head, but not committed yet
+		size_t _tail = 0; ///< next position to read from
+		px4::atomic<size_t> _count{0}; ///< number of committed bytes in _buffer to be written
 		size_t _total_written = 0;
+		LogCompressor *_compressor = nullptr;
+		bool _compress = false;
 		perf_counter_t _perf_write;
 		perf_counter_t _perf_fsync;
 	};
@@ -222,6 +270,7 @@ private:
 
 	px4::atomic_bool	_exit_thread{false};
 	bool			_need_reliable_transfer{false};
+	bool			_compress{false};
 	px4::atomic_bool	_want_fsync{false};
 	pthread_mutex_t		_mtx;
 	pthread_cond_t		_cv;
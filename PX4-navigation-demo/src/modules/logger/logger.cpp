@@ -242,6 +242,17 @@ void Logger::print_statistics(LogType type)
 		PX4_INFO("Wrote %4.2f MiB (avg %5.2f KiB/s)", (double)mebibytes, (double)(kibibytes / seconds));
 	}
 
+	const LogCompressor *compressor = _writer.get_compressor_file(type);
+
+	if (compressor && compressor->input_bytes() > 0) {
+		const float compression_time = compressor->compression_time();
+		PX4_INFO("Compressed to %4.2f KiB, ratio %.2f, CPU %.2f %% (%.1f us/KiB)",
+			 (double)(compressor->output_bytes() / 1024.0f),
+			 (double)((float)compressor->input_bytes() / compressor->output_bytes()),
+			 (double)(compression_time / (seconds * 1e4f)),
+			 (double)(compression_time / (compressor->input_bytes() / 1024.0f)));
+	}
+
 	PX4_INFO("Since last status: dropouts: %zu (max len: %.3f s), max used buffer: %zu / %zu B",
 		 stats.write_dropouts, (double)stats.max_dropout_duration, stats.high_water, _writer.get_buffer_size_file(type));
 	stats.high_water = 0;
@@ -415,7 +426,8 @@ Logger::~Logger()
 	}
 
 	delete[](_msg_buffer);
-	delete[](_subscriptions);
+	delete[](_subscriptions); // unregisters the update callbacks
+	delete[](_subscription_updates);
 }
 
 void Logger::update_params()
@@ -441,37 +453,28 @@ bool Logger::request_stop_static()
 	return true;
 }
 
-bool Logger::copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe)
+bool Logger::copy_if_updated(int sub_idx, void *buffer)
 {
 	LoggerSubscription &sub = _subscriptions[sub_idx];
 
 	bool updated = false;
 
-	if (sub.valid()) {
-		if (sub.get_interval_us() == 0) {
-			// record gaps in full rate (no interval) messages
-			const unsigned last_generation = sub.get_last_generation();
-			updated = sub.update(buffer);
-
-			if (updated && (sub.get_last_generation() != last_generation + 1)) {
-				// error, missed a message
-				_message_gaps++;
-			}
+	if (sub.get_interval_us() == 0) {
+		// record gaps in full rate (no interval) messages
+		const unsigned last_generation = sub.get_last_generation();
+		updated = sub.update(buffer);
 
-		} else {
-			updated = sub.update(buffer);
+		if (updated && (sub.get_last_generation() != last_generation + 1)) {
+			// error, missed a message
+			_message_gaps++;
 		}
 
-	} else if (try_to_subscribe) {
-		if (sub.subscribe()) {
-			write_add_logged_msg(LogType::Full, sub);
-
-			if (sub_idx < _num_mission_subs) {
-				write_add_logged_msg(LogType::Mission, sub);
-			}
+	} else {
+		updated = sub.update(buffer);
 
-			// copy first data
-			updated = sub.copy(buffer);
+		if (!updated && sub.updates_pending()) {
+			// interval not yet elapsed: check again in the next cycle
+			sub.call();
 		}
 	}
 
@@ -549,11 +552,14 @@ bool Logger::initialize_topics()
 
 	delete[](_subscriptions);
 	_subscriptions = nullptr;
+	delete[](_subscription_updates);
+	_subscription_updates = nullptr;
 
 	if (logged_topics.subscriptions().count > 0) {
 		_subscriptions = new LoggerSubscription[logged_topics.subscriptions().count];
+		_subscription_updates = new px4::atomic<uint32_t>[(logged_topics.subscriptions().count + 31) / 32] {};
 
-		if (!_subscriptions) {
+		if (!_subscriptions || !_subscription_updates) {
 			PX4_ERR("alloc failed");
 			return false;
 		}
@@ -561,6 +567,7 @@ bool Logger::initialize_topics()
 		for (int i = 0; i < logged_topics.subscriptions().count; ++i) {
 			const LoggedTopics::RequestedSubscription &sub = logged_topics.subscriptions().sub[i];
 			_subscriptions[i] = LoggerSubscription(sub.id, sub.interval_ms, sub.instance);
+			_subscriptions[i].set_update_flag(&_subscription_updates[i / 32], i % 32);
 			_subscriptions[i].subscribe();
 		}
 	}
@@ -749,14 +756,47 @@ void Logger::run()
 			/* wait for lock on log buffer */
 			_writer.lock();
 
+			/* lazily subscribe to topics advertised after logging started (their first data is flagged as updated) */
+			if (next_subscribe_topic_index != -1) {
+				LoggerSubscription &sub = _subscriptions[next_subscribe_topic_index];
+
+				if (!sub.valid() && sub.subscribe()) {
+					write_add_logged_msg(LogType::Full, sub);
+
+					if (next_subscribe_topic_index < _num_mission_subs) {
+						write_add_logged_msg(LogType::Mission, sub);
+					}
+				}
+			}
+
+			/* only visit the topics published since the last cycle instead of polling all of them */
+			uint32_t updated_subscriptions = 0;
+
 			for (int sub_idx = 0; sub_idx < _num_subscriptions; ++sub_idx) {
+				if ((sub_idx % 32) == 0) {
+					updated_subscriptions = _subscription_updates[sub_idx / 32].fetch_and(0);
+				}
+
+				if (updated_subscriptions == 0) {
+					// skip to the next bitmap word
+					sub_idx |= 31;
+					continue;
+				}
+
+				const uint32_t mask = 1u << (sub_idx % 32);
+
+				if ((updated_subscriptions & mask) == 0) {
+					continue;
+				}
+
+				updated_subscriptions &= ~mask;
+
 				LoggerSubscription &sub = _subscriptions[sub_idx];
+
 				/* if this topic has been updated, copy the new data into the message buffer
 				 * and write a message to the log
 				 */
-				const bool try_to_subscribe = (sub_idx == next_subscribe_topic_index);
-
-				if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_s), try_to_subscribe)) {
+				if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_s))) {
 					// each message consists of a header followed by an orb data object
 					const size_t msg_size = sizeof(ulog_message_data_s) + sub.get_topic()->o_size_no_padding;
 					const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
@@ -1303,15 +1343,19 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		replay_suffix = "_replayed";
 	}
 
-	const char *crypto_suffix = "";
+	const char *format_suffix = "";
 #if defined(PX4_CRYPTO)
 
 	if (_param_sdlog_crypto_algorithm.get() != 0) {
-		crypto_suffix = "e";
+		format_suffix = "e";
 	}
 
 #endif // PX4_CRYPTO
 
+	if (compress_log_file(type)) {
+		format_suffix = "z";
+	}
+
 	char *log_file_name = _file_name[(int)type].log_file_name;
 
 	if (time_ok) {
@@ -1324,7 +1368,7 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		char log_file_name_time[16] = "";
 		strftime(log_file_name_time, sizeof(log_file_name_time), "%H_%M_%S", &tt);
 		snprintf(log_file_name, sizeof(LogFileName::log_file_name), "%s%s.ulg%s", log_file_name_time, replay_suffix,
-			 crypto_suffix);
+			 format_suffix);
 		snprintf(file_name + n, file_name_size - n, "/%s", log_file_name);
 
 		if (notify) {
@@ -1355,7 +1399,7 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		while (file_number <= MAX_NO_LOGFILE) {
 			/* format log file path: e.g. /fs/microsd/log/sess001/log001.ulg */
 			snprintf(log_file_name, sizeof(LogFileName::log_file_name), "log%03" PRIu16 "%s.ulg%s", file_number, replay_suffix,
-				 crypto_suffix);
+				 format_suffix);
 			snprintf(file_name + n, file_name_size - n, "/%s", log_file_name);
 
 			if (!util::file_exist(file_name)) {
@@ -1384,6 +1428,24 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 	return 0;
 }
 
+bool Logger::compress_log_file(LogType type) const
+{
+	if (type != LogType::Full || !_param_sdlog_compress.get()) {
+		return false;
+	}
+
+#if defined(PX4_CRYPTO)
+
+	// encryption works in place on the write buffer, while compression changes the size
+	if (_param_sdlog_crypto_algorithm.get() != 0) {
+		return false;
+	}
+
+#endif // PX4_CRYPTO
+
+	return true;
+}
+
 void Logger::setReplayFile(const char *file_name)
 {
 	if (_replay_file_name) {
@@ -1421,6 +1483,8 @@ void Logger::start_log_file(LogType type)
 		_param_sdlog_crypto_exchange_key.get());
 #endif // PX4_CRYPTO
 
+	_writer.set_compression(compress_log_file(type));
+
 	if (_writer.start_log_file(type, file_name)) {
 		_writer.select_write_backend(LogWriter::BackendFile);
 		_writer.set_need_reliable_transfer(true);
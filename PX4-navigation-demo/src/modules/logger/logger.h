@@ -39,6 +39,7 @@
 #include "watchdog.h"
 #include <containers/Array.hpp>
 #include "util.h"
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/defines.h>
 #include <drivers/drv_hrt.h>
 #include <version/version.h>
@@ -49,6 +50,7 @@
 
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/SubscriptionInterval.hpp>
 #include <uORB/topics/logger_status.h>
 #include <uORB/topics/log_message.h>
@@ -71,14 +73,56 @@ namespace logger
 
 static constexpr uint8_t MSG_ID_INVALID = UINT8_MAX;
 
-struct LoggerSubscription : public uORB::SubscriptionInterval {
-	LoggerSubscription() = default;
+/**
+ * Logged topic subscription. Once subscribed, every publication sets the topic's bit in the logger's update
+ * bitmap (from the publisher context), so that the logger only needs to check topics that actually changed.
+ */
+struct LoggerSubscription : public uORB::SubscriptionCallback {
+	LoggerSubscription() : uORB::SubscriptionCallback(nullptr) {}
 
 	LoggerSubscription(ORB_ID id, uint32_t interval_ms = 0, uint8_t instance = 0) :
-		uORB::SubscriptionInterval(id, interval_ms * 1000, instance)
+		uORB::SubscriptionCallback(get_orb_meta(id), interval_ms * 1000, instance)
 	{}
 
+	/**
+	 * Set the update bitmap word and bit of this topic. Must be called before subscribing.
+	 */
+	void set_update_flag(px4::atomic<uint32_t> *update_flags, int bit)
+	{
+		_update_flags = update_flags;
+		_update_mask = 1u << bit;
+	}
+
+	/**
+	 * Subscribe and register for update notifications (if an update flag is set).
+	 * The update flag is raised immediately, as the topic might already have been published.
+	 * @return true if subscribed (the topic is advertised)
+	 */
+	bool subscribe()
+	{
+		if (!_subscription.subscribe()) {
+			return false;
+		}
+
+		if (_update_flags && registerCallback()) {
+			call();
+		}
+
+		return true;
+	}
+
+	/**
+	 * Check if there is unread data, regardless of the interval
+	 */
+	bool updates_pending() { return _subscription.updated(); }
+
+	void call() override { _update_flags->fetch_or(_update_mask); }
+
 	uint8_t msg_id{MSG_ID_INVALID};
+
+private:
+	px4::atomic<uint32_t> *_update_flags{nullptr};
+	uint32_t _update_mask{0};
 };
 
 class Logger : public ModuleBase<Logger>, public ModuleParams
@@ -213,6 +257,11 @@ private:
 	 */
 	int get_log_file_name(LogType type, char *file_name, size_t file_name_size, bool notify);
 
+	/**
+	 * Check whether a log file is written compressed, which excludes encryption
+	 */
+	bool compress_log_file(LogType type) const;
+
 	void start_log_file(LogType type);
 
 	void stop_log_file(LogType type);
@@ -279,7 +328,11 @@ private:
 	void write_changed_parameters(LogType type);
 	void write_events_file(LogType type);
 
-	inline bool copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe);
+	/**
+	 * Copy the data of a subscription flagged as updated.
+	 * Rate-limited subscriptions with unread data are flagged again, so they are checked in the next cycle.
+	 */
+	inline bool copy_if_updated(int sub_idx, void *buffer);
 
 	/**
 	 * Write exactly one ulog message to the logger and handle dropouts.
@@ -355,6 +408,7 @@ private:
 
 	LoggerSubscription	 			*_subscriptions{nullptr}; ///< all subscriptions for full & mission log (in front)
 	int						_num_subscriptions{0};
+	px4::atomic<uint32_t>				*_subscription_updates{nullptr}; ///< bitmap of subscriptions updated since the last check
 	MissionSubscription 				_mission_subscriptions[MAX_MISSION_TOPICS_NUM] {}; ///< additional data for mission subscriptions
 	int						_num_mission_subs{0};
 	LoggerSubscription				_event_subscription; ///< Subscription for the event topic (handled separately)
@@ -398,6 +452,7 @@ private:
 		(ParamInt<px4::params::SDLOG_PROFILE>) _param_sdlog_profile,
 		(ParamInt<px4::params::SDLOG_MISSION>) _param_sdlog_mission,
 		(ParamBool<px4::params::SDLOG_BOOT_BAT>) _param_sdlog_boot_bat,
+		(ParamBool<px4::params::SDLOG_COMPRESS>) _param_sdlog_compress,
 		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid
 #if defined(PX4_CRYPTO)
 		, (ParamInt<px4::params::SDLOG_ALGORITHM>) _param_sdlog_crypto_algorithm,
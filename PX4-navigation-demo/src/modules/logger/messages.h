@@ -88,6 +88,28 @@ struct ulog_key_header_s {
 	uint8_t	data[0];
 };
 
+/** first bytes of a compressed log file, followed by the frames */
+struct ulog_compressed_header_s {
+	/* magic identifying the file content */
+	uint8_t magic[7];
+
+	/* version of this header */
+	uint8_t hdr_ver;
+
+	/* heatshrink window and lookahead size (bits) */
+	uint8_t window_bits;
+	uint8_t lookahead_bits;
+};
+
+/**
+ * Header of a frame of a compressed log file. Each frame is an independent heatshrink stream
+ * of the next uncompressed_size bytes of the ULog data, or the data itself if both sizes are equal.
+ */
+struct ulog_compressed_frame_s {
+	uint16_t compressed_size;
+	uint16_t uncompressed_size;
+};
+
 
 /**
  * @brief Message Header for the ULog
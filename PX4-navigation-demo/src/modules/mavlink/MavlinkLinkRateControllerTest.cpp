@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "mavlink_link_rate_controller.h"
+
+using namespace time_literals;
+using Priority = MavlinkStream::Priority;
+
+static constexpr hrt_abstime control_interval = 100_ms;
+
+class MavlinkLinkRateControllerTest : public ::testing::Test
+{
+public:
+	void step(const MavlinkLinkRateController::LinkState &state, int iterations = 1)
+	{
+		for (int i = 0; i < iterations; i++) {
+			_now += control_interval;
+			_controller.update(_now, state);
+		}
+	}
+
+	MavlinkLinkRateController _controller;
+	hrt_abstime _now{1_s};
+};
+
+static MavlinkLinkRateController::LinkState free_link()
+{
+	return {0.f, false, 0};
+}
+
+static MavlinkLinkRateController::LinkState full_tx_buffer()
+{
+	return {0.9f, false, 0};
+}
+
+TEST_F(MavlinkLinkRateControllerTest, FullRateOnFreeLink)
+{
+	// WHEN: the link is never congested
+	step(free_link(), 10);
+
+	// THEN: all streams keep their rate
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Critical), 1.f);
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 1.f);
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Bulk), 1.f);
+}
+
+TEST_F(MavlinkLinkRateControllerTest, MultiplicativeDecrease)
+{
+	// WHEN: the TX buffer is congested for two control periods
+	step(full_tx_buffer(), 2);
+
+	// THEN: the rates decrease multiplicatively, bulk transfers yield first and critical streams are not affected
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 0.7f * 0.7f);
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Bulk), 0.7f * 0.7f * 0.7f * 0.7f);
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Critical), 1.f);
+}
+
+TEST_F(MavlinkLinkRateControllerTest, MinimumMultiplier)
+{
+	// WHEN: the link stays congested
+	step(full_tx_buffer(), 50);
+
+	// THEN: the rates do not drop below the minimum
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 0.05f);
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Bulk), 0.05f * 0.05f);
+}
+
+TEST_F(MavlinkLinkRateControllerTest, AdditiveIncrease)
+{
+	// GIVEN: a congested link
+	step(full_tx_buffer(), 50);
+
+	// WHEN: the TX buffer is free again for a single control period
+	step(free_link());
+
+	// THEN: the rate increases by one step
+	EXPECT_NEAR(_controller.multiplier(Priority::Normal), 0.1f, 1e-6f);
+
+	// WHEN: the TX buffer is neither congested nor free
+	step({0.4f, false, 0}, 5);
+
+	// THEN: the rate is held
+	EXPECT_NEAR(_controller.multiplier(Priority::Normal), 0.1f, 1e-6f);
+
+	// WHEN: the TX buffer stays free
+	step(free_link(), 20);
+
+	// THEN: the full rate is restored
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 1.f);
+}
+
+TEST_F(MavlinkLinkRateControllerTest, RadioCongestion)
+{
+	// WHEN: the radio reports a low free TX buffer
+	step({0.f, true, 0});
+
+	// THEN: the rate decreases
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 0.7f);
+}
+
+TEST_F(MavlinkLinkRateControllerTest, RoundTripTime)
+{
+	// GIVEN: a round trip time baseline of 100 ms
+	step({0.f, false, 100000}, 5);
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 1.f);
+
+	// WHEN: the round trip time increases, but stays below twice the baseline plus the margin
+	step({0.f, false, 240000});
+
+	// THEN: the rate is kept
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 1.f);
+
+	// WHEN: the round trip time exceeds twice the baseline plus the margin
+	step({0.f, false, 300000});
+
+	// THEN: the rate decreases
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 0.7f);
+}
+
+TEST_F(MavlinkLinkRateControllerTest, ControlInterval)
+{
+	// GIVEN: one congested control period
+	step(full_tx_buffer());
+
+	// WHEN: updating again within the same control period
+	_controller.update(_now + control_interval / 2, full_tx_buffer());
+
+	// THEN: the rate is only decreased once
+	EXPECT_FLOAT_EQ(_controller.multiplier(Priority::Normal), 0.7f);
+}
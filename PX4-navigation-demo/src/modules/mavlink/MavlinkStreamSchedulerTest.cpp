@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "mavlink_main.h"
+#include "mavlink_stream_scheduler.h"
+
+static constexpr unsigned serial_tx_budget = 280; // get_free_tx_buf() of a Linux serial link
+static constexpr hrt_abstime poll_interval = 10_ms;
+
+class TestStream : public MavlinkStream
+{
+public:
+	TestStream(Mavlink *mavlink, unsigned size, int interval) : MavlinkStream(mavlink), _size(size)
+	{
+		set_interval(interval);
+	}
+
+	const char *get_name() const override { return "TEST"; }
+	uint16_t get_id() override { return 0; }
+	unsigned get_size() override { return _size; }
+	bool const_rate() override { return true; }
+
+	unsigned sent{0};
+
+private:
+	bool send() override
+	{
+		sent++;
+		return true;
+	}
+
+	const unsigned _size;
+};
+
+class MavlinkStreamSchedulerTest : public ::testing::Test
+{
+public:
+	void TearDown() override { _streams.clear(); }
+
+	TestStream *add(unsigned size, int interval)
+	{
+		TestStream *stream = new TestStream(&_mavlink, size, interval);
+		stream->reset_last_sent(); // due immediately
+		_streams.add(stream);
+		_scheduler.invalidate();
+		return stream;
+	}
+
+	void run(hrt_abstime duration, unsigned tx_budget)
+	{
+		const hrt_abstime end = _now + duration;
+
+		for (; _now < end; _now += poll_interval) {
+			_scheduler.update(_streams, _now, tx_budget, poll_interval);
+		}
+	}
+
+	Mavlink _mavlink;
+	List<MavlinkStream *> _streams;
+	MavlinkStreamScheduler _scheduler;
+	hrt_abstime _now{hrt_absolute_time()}; // the first message of a stream is stamped with the real time
+};
+
+TEST_F(MavlinkStreamSchedulerTest, StreamsWithinBudget)
+{
+	// GIVEN: streams which all fit the TX budget together
+	TestStream *heartbeat = add(21, 1_s);
+	TestStream *attitude = add(40, 100_ms);
+
+	// WHEN: running for 10 seconds
+	run(10_s, serial_tx_budget);
+
+	// THEN: every stream keeps its rate and nothing is deferred
+	EXPECT_NEAR(heartbeat->sent, 10, 1);
+	EXPECT_NEAR(attitude->sent, 100, 1);
+	EXPECT_EQ(_scheduler.deferred_count(), 0u);
+}
+
+TEST_F(MavlinkStreamSchedulerTest, OversizeStreamDoesNotBlockOthers)
+{
+	// GIVEN: a stream which never fits the TX budget of a serial link, due before the heartbeat
+	TestStream *oversize = add(300, 100_ms);
+	TestStream *heartbeat = add(21, 1_s);
+	TestStream *small = add(30, 100_ms);
+
+	// WHEN: running for 10 seconds
+	run(10_s, serial_tx_budget);
+
+	// THEN: the small streams are not starved and the oversize stream is still sent
+	EXPECT_NEAR(heartbeat->sent, 10, 1);
+	EXPECT_NEAR(small->sent, 100, 2);
+	EXPECT_GT(oversize->sent, 0u);
+}
+
+TEST_F(MavlinkStreamSchedulerTest, StreamsSpreadOverIterations)
+{
+	// GIVEN: two streams which do not fit the TX budget together and a small one
+	TestStream *first = add(200, 100_ms);
+	TestStream *second = add(200, 100_ms);
+	TestStream *heartbeat = add(21, 1_s);
+
+	// WHEN: running a single iteration
+	run(poll_interval, serial_tx_budget);
+
+	// THEN: one large stream is deferred while the heartbeat uses the remaining budget
+	EXPECT_EQ(first->sent + second->sent, 1u);
+	EXPECT_EQ(heartbeat->sent, 1u);
+	EXPECT_EQ(_scheduler.deferred_count(), 1u);
+
+	// WHEN: running the next iteration
+	run(poll_interval, serial_tx_budget);
+
+	// THEN: the deferred stream goes first
+	EXPECT_EQ(first->sent, 1u);
+	EXPECT_EQ(second->sent, 1u);
+
+	// WHEN: running for 10 seconds
+	run(10_s, serial_tx_budget);
+
+	// THEN: both large streams keep their rate by alternating
+	EXPECT_NEAR(first->sent, 100, 2);
+	EXPECT_NEAR(second->sent, 100, 2);
+}
+
+TEST_F(MavlinkStreamSchedulerTest, SmallBudget)
+{
+	// GIVEN: mixed stream sizes and a TX budget for only a few small messages
+	TestStream *heartbeat = add(21, 1_s);
+	TestStream *large = add(250, 50_ms);
+	TestStream *medium = add(60, 50_ms);
+	TestStream *small = add(30, 20_ms);
+
+	// WHEN: running for 10 seconds with 100 bytes per iteration
+	run(10_s, 100);
+
+	// THEN: every stream is sent, the link is shared instead of serving only the earliest deadline
+	EXPECT_NEAR(heartbeat->sent, 10, 1);
+	EXPECT_GT(large->sent, 0u);
+	EXPECT_GT(medium->sent, 0u);
+	EXPECT_GT(small->sent, 0u);
+	EXPECT_GT(_scheduler.deferred_count(), 0u);
+}
@@ -43,6 +43,7 @@
 #include <cstring>
 
 #include "mavlink_ftp.h"
+#include "mavlink_parameters_export.h"
 #include "mavlink_tests/mavlink_ftp_test.h"
 
 #include "mavlink_main.h"
@@ -54,20 +55,28 @@ constexpr const char MavlinkFTP::_root_dir[];
 MavlinkFTP::MavlinkFTP(Mavlink &mavlink) :
 	_mavlink(mavlink)
 {
-	// initialize session
-	_session_info.fd = -1;
+	// initialize sessions
+	for (SessionInfo &session : _sessions) {
+		session.fd = -1;
+	}
 }
 
 MavlinkFTP::~MavlinkFTP()
 {
 	delete[] _work_buffer1;
 	delete[] _work_buffer2;
+
+	for (SessionInfo &session : _sessions) {
+		if (session.fd != -1) {
+			_closeSession(session);
+		}
+	}
 }
 
 unsigned
 MavlinkFTP::get_size()
 {
-	if (_session_info.stream_download) {
+	if (_streaming()) {
 		return MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 
 	} else {
@@ -356,6 +365,11 @@ void MavlinkFTP::_constructPath(char *dst, int dst_len, const char *path) const
 	dst[dst_len - 1] = '\0';
 }
 
+void MavlinkFTP::_exportFilePath(char *dst, int dst_len, uint8_t session_id)
+{
+	snprintf(dst, dst_len, PX4_STORAGEDIR "/param_export%u_%u.pck", _getServerChannel(), session_id);
+}
+
 /// @brief Responds to a List command
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workList(PayloadHeader *payload)
@@ -503,12 +517,37 @@ MavlinkFTP::_workList(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 {
-	if (_session_info.fd >= 0) {
+	uint8_t session_id = 0;
+
+	while ((session_id < kMaxSessions) && (_sessions[session_id].fd >= 0)) {
+		session_id++;
+	}
+
+	if (session_id == kMaxSessions) {
 		PX4_ERR("FTP: Open failed - out of sessions");
 		return kErrNoSessionsAvailable;
 	}
 
-	_constructPath(_work_buffer1, _work_buffer1_len, _data_as_cstring(payload));
+	const char *path = _data_as_cstring(payload);
+
+	if (MavlinkParametersExport::is_export_path(path)) {
+		if (oflag != O_RDONLY) {
+			return kErrFailFileProtected;
+		}
+
+		// the export is generated into a local file which is then served like any other
+		_exportFilePath(_work_buffer1, _work_buffer1_len, session_id);
+		const int ret = MavlinkParametersExport::export_to_file(path, _work_buffer1);
+
+		if (ret < 0) {
+			_our_errno = -ret;
+			PX4_ERR("parameter export failed: %s", strerror(_our_errno));
+			return kErrFailErrno;
+		}
+
+	} else {
+		_constructPath(_work_buffer1, _work_buffer1_len, path);
+	}
 
 	PX4_DEBUG("FTP: open '%s'", _work_buffer1);
 
@@ -541,11 +580,15 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 		return kErrFailErrno;
 	}
 
-	_session_info.fd = fd;
-	_session_info.file_size = fileSize;
-	_session_info.stream_download = false;
+	SessionInfo &session = _sessions[session_id];
+	session.fd = fd;
+	session.file_size = fileSize;
+	session.stream_download = false;
+	session.write_protected = (oflag & (O_WRONLY | O_RDWR)) && !_validatePathIsWritable(_work_buffer1);
+	session.param_export = MavlinkParametersExport::is_export_path(path);
+	session.read_ahead_length = 0;
 
-	payload->session = 0;
+	payload->session = session_id;
 	payload->size = sizeof(uint32_t);
 	std::memcpy(payload->data, &fileSize, payload->size);
 
@@ -556,27 +599,21 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workRead(PayloadHeader *payload)
 {
-	if (payload->session != 0 || _session_info.fd < 0) {
+	SessionInfo *session = _getSession(payload);
+
+	if (session == nullptr) {
 		return kErrInvalidSession;
 	}
 
 	PX4_DEBUG("FTP: read offset:%ld" PRIu32, payload->offset);
 
 	// We have to test seek past EOF ourselves, lseek will allow seek past EOF
-	if (payload->offset >= _session_info.file_size) {
+	if (payload->offset >= session->file_size) {
 		PX4_WARN("request past EOF");
 		return kErrEOF;
 	}
 
-	PX4_DEBUG("lseek with offset: %ld", payload->offset);
-
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-		_our_errno = errno;
-		PX4_ERR("seek fail: %s", strerror(_our_errno));
-		return kErrFailErrno;
-	}
-
-	int bytes_read = ::read(_session_info.fd, &payload->data[0], payload->size);
+	int bytes_read = _readSession(*session, payload->offset, &payload->data[0], payload->size);
 
 	if (bytes_read < 0) {
 		// Negative return indicates error other than eof
@@ -594,19 +631,21 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t target_component_id)
 {
-	if (payload->session != 0 && _session_info.fd < 0) {
+	SessionInfo *session = _getSession(payload);
+
+	if (session == nullptr) {
 		PX4_DEBUG("_workBurst: no session or no fd");
 		return kErrInvalidSession;
 	}
 
 	PX4_DEBUG("FTP: burst offset:%" PRIu32, payload->offset);
 	// Setup for streaming sends
-	_session_info.stream_download = true;
-	_session_info.stream_offset = payload->offset;
-	_session_info.stream_chunk_transmitted = 0;
-	_session_info.stream_seq_number = payload->seq_number + 1;
-	_session_info.stream_target_system_id = target_system_id;
-	_session_info.stream_target_component_id = target_component_id;
+	session->stream_download = true;
+	session->stream_offset = payload->offset;
+	session->stream_chunk_transmitted = 0;
+	session->stream_seq_number = payload->seq_number + 1;
+	session->stream_target_system_id = target_system_id;
+	session->stream_target_component_id = target_component_id;
 
 	return kErrNone;
 }
@@ -615,23 +654,28 @@ MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workWrite(PayloadHeader *payload)
 {
-	if (payload->session != 0 && _session_info.fd < 0) {
+	SessionInfo *session = _getSession(payload);
+
+	if (session == nullptr) {
 		PX4_DEBUG("_workWrite: no session or no fd");
 		return kErrInvalidSession;
 	}
 
-	if (!_validatePathIsWritable(_work_buffer1)) {
+	if (session->write_protected) {
 		return kErrFailFileProtected;
 	}
 
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
+	// the written range is not in the read-ahead buffer anymore
+	session->read_ahead_length = 0;
+
+	if (lseek(session->fd, payload->offset, SEEK_SET) < 0) {
 		// Unable to see to the specified location
 		PX4_ERR("seek fail");
 		return kErrFailErrno;
 	}
 
 	PX4_DEBUG("write %d bytes", payload->size);
-	int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
+	int bytes_written = ::write(session->fd, &payload->data[0], payload->size);
 
 	if (bytes_written < 0) {
 		// Negative return indicates error other than eof
@@ -790,14 +834,14 @@ MavlinkFTP::_workTruncateFile(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workTerminate(PayloadHeader *payload)
 {
-	if (payload->session != 0 || _session_info.fd < 0) {
+	SessionInfo *session = _getSession(payload);
+
+	if (session == nullptr) {
 		return kErrInvalidSession;
 	}
 
 	PX4_DEBUG("work terminate: close");
-	::close(_session_info.fd);
-	_session_info.fd = -1;
-	_session_info.stream_download = false;
+	_closeSession(*session);
 
 	payload->size = 0;
 
@@ -810,10 +854,10 @@ MavlinkFTP::_workReset(PayloadHeader *payload)
 {
 	PX4_DEBUG("work reset: close");
 
-	if (_session_info.fd != -1) {
-		::close(_session_info.fd);
-		_session_info.fd = -1;
-		_session_info.stream_download = false;
+	for (SessionInfo &session : _sessions) {
+		if (session.fd != -1) {
+			_closeSession(session);
+		}
 	}
 
 	payload->size = 0;
@@ -1027,124 +1071,243 @@ void MavlinkFTP::send()
 			}
 		}
 
-	} else if (_session_info.fd != -1) {
-		// close session without activity
-		if (hrt_elapsed_time(&_last_work_buffer_access) > 10_s) {
-			::close(_session_info.fd);
-			_session_info.fd = -1;
-			_session_info.stream_download = false;
-			_last_reply_valid = false;
-			PX4_WARN("Session was closed without activity");
+	} else if (hrt_elapsed_time(&_last_work_buffer_access) > 10_s) {
+		// close sessions without activity
+		for (SessionInfo &session : _sessions) {
+			if (session.fd != -1) {
+				_closeSession(session);
+				_last_reply_valid = false;
+				PX4_WARN("Session was closed without activity");
+			}
 		}
 	}
 
 	// Anything to stream?
-	if (!_session_info.stream_download) {
+	if (!_streaming()) {
 		return;
 	}
 
 #ifndef MAVLINK_FTP_UNIT_TEST
 	// Skip send if not enough room
-	unsigned max_bytes_to_send = _mavlink.get_free_tx_buf();
-	PX4_DEBUG("MavlinkFTP::send max_bytes_to_send(%u) get_free_tx_buf(%u)", max_bytes_to_send, _mavlink.get_free_tx_buf());
+	const unsigned tx_buf_free = _mavlink.get_free_tx_buf();
 
-	if (max_bytes_to_send < get_size()) {
+	if (tx_buf_free < get_size()) {
 		return;
 	}
 
+	// a burst only uses its share of the buffer on a congested link, but always at least one message
+	const float bulk_rate_mult = _mavlink.get_rate_mult(MavlinkStream::Priority::Bulk);
+	unsigned max_bytes_to_send = (unsigned)(tx_buf_free * bulk_rate_mult);
+
+	if (max_bytes_to_send < get_size()) {
+		max_bytes_to_send = get_size();
+	}
+
+	PX4_DEBUG("MavlinkFTP::send max_bytes_to_send(%u) get_free_tx_buf(%u)", max_bytes_to_send, tx_buf_free);
+
+#else
+	unsigned max_bytes_to_send = UINT32_MAX;
 #endif
 
-	// Send stream packets until buffer is full
+	// Send stream packets of the bursting sessions in turn until the buffer is full
+	bool room_left = true;
 
-	bool more_data;
+	while (room_left && _streaming()) {
+		for (uint8_t i = 0; i < kMaxSessions; i++) {
+			const uint8_t session_id = (_next_burst_session + i) % kMaxSessions;
 
-	do {
-		more_data = false;
+			if (!_sessions[session_id].stream_download) {
+				continue;
+			}
 
-		ErrorCode error_code = kErrNone;
+			room_left = _sendBurstPacket(session_id, max_bytes_to_send);
 
-		mavlink_file_transfer_protocol_t ftp_msg;
-		PayloadHeader *payload = reinterpret_cast<PayloadHeader *>(&ftp_msg.payload[0]);
+			if (!room_left) {
+				// the next update starts with the session after this one
+				_next_burst_session = (session_id + 1) % kMaxSessions;
+				break;
+			}
+		}
+	}
+}
 
-		payload->seq_number = _session_info.stream_seq_number;
-		payload->session = 0;
-		payload->opcode = kRspAck;
-		payload->req_opcode = kCmdBurstReadFile;
-		payload->offset = _session_info.stream_offset;
-		_session_info.stream_seq_number++;
+bool MavlinkFTP::_sendBurstPacket(uint8_t session_id, unsigned &max_bytes_to_send)
+{
+	SessionInfo &session = _sessions[session_id];
+	bool room_left = true;
+
+	ErrorCode error_code = kErrNone;
+
+	mavlink_file_transfer_protocol_t ftp_msg{};
+	PayloadHeader *payload = reinterpret_cast<PayloadHeader *>(&ftp_msg.payload[0]);
+
+	payload->seq_number = session.stream_seq_number;
+	payload->session = session_id;
+	payload->opcode = kRspAck;
+	payload->req_opcode = kCmdBurstReadFile;
+	payload->offset = session.stream_offset;
+	session.stream_seq_number++;
+
+	PX4_DEBUG("stream send: offset %" PRIu32, session.stream_offset);
+
+	// We have to test seek past EOF ourselves, lseek will allow seek past EOF
+	if (session.stream_offset >= session.file_size) {
+		error_code = kErrEOF;
+		PX4_DEBUG("stream download: sending Nak EOF");
+	}
 
-		PX4_DEBUG("stream send: offset %" PRIu32, _session_info.stream_offset);
+	if (error_code == kErrNone) {
+		int bytes_read = _readSession(session, payload->offset, &payload->data[0], kMaxDataLength);
 
-		// We have to test seek past EOF ourselves, lseek will allow seek past EOF
-		if (_session_info.stream_offset >= _session_info.file_size) {
-			error_code = kErrEOF;
-			PX4_DEBUG("stream download: sending Nak EOF");
+		if (bytes_read < 0) {
+			// Negative return indicates error other than eof
+			error_code = kErrFailErrno;
+			PX4_WARN("stream download: read fail");
+
+		} else {
+			payload->size = bytes_read;
+			session.stream_offset += bytes_read;
+			session.stream_chunk_transmitted += bytes_read;
 		}
+	}
 
-		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
-				PX4_WARN("stream download: seek fail");
-			}
+	if (error_code != kErrNone) {
+		payload->opcode = kRspNak;
+		payload->size = 1;
+		uint8_t *pData = &payload->data[0];
+		*pData = error_code; // Straight reference to data[0] is causing bogus gcc array subscript error
+
+		if (error_code == kErrFailErrno) {
+			payload->size = 2;
+			payload->data[1] = _our_errno;
 		}
 
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+		session.stream_download = false;
 
-			if (bytes_read < 0) {
-				// Negative return indicates error other than eof
-				error_code = kErrFailErrno;
-				PX4_WARN("stream download: read fail");
+	} else if (max_bytes_to_send < (get_size() * 2)) {
+		room_left = false;
 
-			} else {
-				payload->size = bytes_read;
-				_session_info.stream_offset += bytes_read;
-				_session_info.stream_chunk_transmitted += bytes_read;
-			}
+		/* perform transfers in 35K chunks - this is determined empirical */
+		if (session.stream_chunk_transmitted > 35000) {
+			payload->burst_complete = true;
+			session.stream_download = false;
+			session.stream_chunk_transmitted = 0;
 		}
 
-		if (error_code != kErrNone) {
-			payload->opcode = kRspNak;
-			payload->size = 1;
-			uint8_t *pData = &payload->data[0];
-			*pData = error_code; // Straight reference to data[0] is causing bogus gcc array subscript error
+	} else {
+		payload->burst_complete = false;
+		max_bytes_to_send -= get_size();
+	}
+
+	ftp_msg.target_system = session.stream_target_system_id;
+	ftp_msg.target_network = 0;
+	ftp_msg.target_component = session.stream_target_component_id;
+	_reply(&ftp_msg);
 
-			if (error_code == kErrFailErrno) {
-				payload->size = 2;
-				payload->data[1] = _our_errno;
-			}
+	return room_left;
+}
 
-			_session_info.stream_download = false;
+bool MavlinkFTP::_streaming() const
+{
+	for (const SessionInfo &session : _sessions) {
+		if (session.stream_download) {
+			return true;
+		}
+	}
 
-		} else {
-#ifndef MAVLINK_FTP_UNIT_TEST
+	return false;
+}
+
+MavlinkFTP::SessionInfo *MavlinkFTP::_getSession(const PayloadHeader *payload)
+{
+	if ((payload->session >= kMaxSessions) || (_sessions[payload->session].fd < 0)) {
+		return nullptr;
+	}
+
+	return &_sessions[payload->session];
+}
 
-			if (max_bytes_to_send < (get_size() * 2)) {
-				more_data = false;
+void MavlinkFTP::_closeSession(SessionInfo &session)
+{
+	::close(session.fd);
+	session.fd = -1;
+	session.stream_download = false;
+
+	if (session.param_export) {
+		char export_path[64];
+		_exportFilePath(export_path, sizeof(export_path), &session - _sessions);
+		unlink(export_path);
+		session.param_export = false;
+	}
+
+	delete[] session.read_ahead;
+	session.read_ahead = nullptr;
+	session.read_ahead_length = 0;
+}
+
+int MavlinkFTP::_readSession(SessionInfo &session, uint32_t offset, uint8_t *data, unsigned length)
+{
+	if (session.read_ahead == nullptr) {
+		session.read_ahead = new uint8_t[kReadAheadLength];
+		session.read_ahead_length = 0;
+	}
 
-				/* perform transfers in 35K chunks - this is determined empirical */
-				if (_session_info.stream_chunk_transmitted > 35000) {
-					payload->burst_complete = true;
-					_session_info.stream_download = false;
-					_session_info.stream_chunk_transmitted = 0;
+	unsigned bytes_read = 0;
+
+	while (bytes_read < length) {
+		const uint32_t position = offset + bytes_read;
+
+		if ((position < session.read_ahead_offset) ||
+		    (position >= session.read_ahead_offset + session.read_ahead_length)) {
+
+			if (session.read_ahead == nullptr) {
+				// out of memory, read the remaining data directly
+				if (lseek(session.fd, position, SEEK_SET) < 0) {
+					_our_errno = errno;
+					return -1;
 				}
 
-			} else {
-#endif
-				more_data = true;
-				payload->burst_complete = false;
-#ifndef MAVLINK_FTP_UNIT_TEST
-				max_bytes_to_send -= get_size();
+				const int result = ::read(session.fd, &data[bytes_read], length - bytes_read);
+
+				if (result < 0) {
+					_our_errno = errno;
+					return -1;
+				}
+
+				return bytes_read + result;
 			}
 
-#endif
+			// refill the read-ahead buffer with the chunk containing the position
+			session.read_ahead_offset = position - (position % kReadAheadAlignment);
+			session.read_ahead_length = 0;
+
+			if (lseek(session.fd, session.read_ahead_offset, SEEK_SET) < 0) {
+				_our_errno = errno;
+				return -1;
+			}
+
+			const int result = ::read(session.fd, session.read_ahead, kReadAheadLength);
+
+			if (result < 0) {
+				_our_errno = errno;
+				return -1;
+			}
+
+			session.read_ahead_length = result;
+
+			if (position >= session.read_ahead_offset + session.read_ahead_length) {
+				// end of file
+				break;
+			}
 		}
 
-		ftp_msg.target_system = _session_info.stream_target_system_id;
-		ftp_msg.target_network = 0;
-		ftp_msg.target_component = _session_info.stream_target_component_id;
-		_reply(&ftp_msg);
-	} while (more_data);
+		const unsigned available = session.read_ahead_offset + session.read_ahead_length - position;
+		const unsigned copy_length = (available < length - bytes_read) ? available : length - bytes_read;
+		memcpy(&data[bytes_read], &session.read_ahead[position - session.read_ahead_offset], copy_length);
+		bytes_read += copy_length;
+	}
+
+	return bytes_read;
 }
 
 bool MavlinkFTP::_validatePathIsWritable(const char *path)
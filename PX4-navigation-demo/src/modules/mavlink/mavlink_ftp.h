@@ -156,8 +156,41 @@ private:
 	 */
 	void _constructPath(char *dst, int dst_len, const char *path) const;
 
+	/**
+	 * Construct the path of the local file a parameter export of a session is generated into.
+	 * Each link and session has its own file, so concurrent exports do not overwrite each other.
+	 */
+	void _exportFilePath(char *dst, int dst_len, uint8_t session_id);
+
 	bool _validatePathIsWritable(const char *path);
 
+	struct SessionInfo;
+
+	/**
+	 * @return the open session addressed by the request, nullptr if it is invalid
+	 */
+	SessionInfo *_getSession(const PayloadHeader *payload);
+
+	void _closeSession(SessionInfo &session);
+
+	/**
+	 * Read file data of a session through its read-ahead buffer
+	 * @return number of bytes read, less than length at the end of the file, -1 on error
+	 */
+	int _readSession(SessionInfo &session, uint32_t offset, uint8_t *data, unsigned length);
+
+	/**
+	 * Send the next burst packet of a session
+	 * @param max_bytes_to_send remaining TX buffer, reduced by the sent packet
+	 * @return true if there is room for more burst packets
+	 */
+	bool _sendBurstPacket(uint8_t session_id, unsigned &max_bytes_to_send);
+
+	/**
+	 * @return true if a burst download of any session is in progress
+	 */
+	bool _streaming() const;
+
 	/**
 	 * make sure that the working buffers _work_buffer* are allocated
 	 * @return true if buffers exist, false if allocation failed
@@ -171,17 +204,33 @@ private:
 	/// @brief Maximum data size in RequestHeader::data
 	static const uint8_t	kMaxDataLength = MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN - sizeof(PayloadHeader);
 
+	static constexpr uint8_t kMaxSessions = 2;	///< Maximum number of concurrently open files
+
+	/// @brief Size of the read-ahead buffer of a session, file data is read from storage in chunks of this size
+#if defined(__PX4_POSIX)
+	static constexpr uint32_t kReadAheadLength = 16384;
+#else
+	static constexpr uint32_t kReadAheadLength = 1024;
+#endif
+	static constexpr uint32_t kReadAheadAlignment = 512;	///< Chunks start at multiples of the storage block size
+
 	struct SessionInfo {
 		int		fd;
 		uint32_t	file_size;
 		bool		stream_download;
+		bool		write_protected;
+		bool		param_export;		///< The session serves a generated parameter export file
 		uint32_t	stream_offset;
 		uint16_t	stream_seq_number;
 		uint8_t		stream_target_system_id;
 		uint8_t         stream_target_component_id;
 		unsigned	stream_chunk_transmitted;
+		uint8_t		*read_ahead;		///< Read-ahead buffer, allocated by the first read of the session
+		uint32_t	read_ahead_offset;	///< File offset of the data in the read-ahead buffer
+		uint32_t	read_ahead_length;	///< Number of valid bytes in the read-ahead buffer
 	};
-	struct SessionInfo _session_info {};	///< Session info, fd=-1 for no active session
+	SessionInfo _sessions[kMaxSessions] {};	///< Session info, fd=-1 for no active session
+	uint8_t _next_burst_session{0};		///< Session which sends the first burst packet of the next update
 
 	ReceiveMessageFunc_t	_utRcvMsgFunc{};	///< Unit test override for mavlink message sending
 	void			*_worker_data{nullptr};	///< Additional parameter to _utRcvMsgFunc;
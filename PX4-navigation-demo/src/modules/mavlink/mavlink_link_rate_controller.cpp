@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_link_rate_controller.cpp
+ * Closed-loop stream rate control from the measured congestion of a link.
+ */
+
+#include "mavlink_link_rate_controller.h"
+
+#include <px4_platform_common/log.h>
+
+void
+MavlinkLinkRateController::update(const hrt_abstime &t, const LinkState &state)
+{
+	if (!_control_limiter.check(t)) {
+		return;
+	}
+
+	_tx_buffer_fill = state.tx_buffer_fill;
+	_rtt = state.round_trip_time;
+
+	bool rtt_congested = false;
+
+	if (_rtt > 0) {
+		if ((_rtt_baseline == 0) || (_rtt < _rtt_baseline)) {
+			_rtt_baseline = _rtt;
+
+		} else {
+			// slowly follow an increasing latency, e.g. after a route change of a cellular link
+			_rtt_baseline += (_rtt - _rtt_baseline) / 100;
+		}
+
+		rtt_congested = _rtt > 2 * _rtt_baseline + RTT_MARGIN;
+	}
+
+	if (state.radio_congested || rtt_congested || (_tx_buffer_fill > TX_BUFFER_CONGESTED)) {
+		_multiplier *= DECREASE_FACTOR;
+		_congested_count++;
+
+	} else if (_tx_buffer_fill < TX_BUFFER_FREE) {
+		_multiplier += INCREASE_STEP;
+	}
+
+	if (_multiplier < MIN_MULTIPLIER) {
+		_multiplier = MIN_MULTIPLIER;
+
+	} else if (_multiplier > 1.f) {
+		_multiplier = 1.f;
+	}
+}
+
+float
+MavlinkLinkRateController::multiplier(MavlinkStream::Priority priority) const
+{
+	switch (priority) {
+	case MavlinkStream::Priority::Critical:
+		return 1.f;
+
+	case MavlinkStream::Priority::Bulk:
+		// bulk transfers yield first and recover last
+		return _multiplier * _multiplier;
+
+	default:
+		return _multiplier;
+	}
+}
+
+void
+MavlinkLinkRateController::print_status() const
+{
+	printf("\t  adaptive rate: %.3f (bulk %.3f), TX buffer fill: %.2f\n", (double)_multiplier,
+	       (double)multiplier(MavlinkStream::Priority::Bulk), (double)_tx_buffer_fill);
+	printf("\t  RTT: %.1f ms (baseline %.1f ms), congested: %" PRIu32 "\n", (double)(_rtt * 1e-3f),
+	       (double)(_rtt_baseline * 1e-3f), _congested_count);
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_link_rate_controller.h
+ * Closed-loop stream rate control from the measured congestion of a link.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+
+#include "mavlink_rate_limiter.h"
+#include "mavlink_stream.h"
+
+class MavlinkLinkRateController
+{
+public:
+	/**
+	 * Measured state of the link
+	 */
+	struct LinkState {
+		float tx_buffer_fill;		///< used fraction of the TX buffer [0, 1]
+		bool radio_congested;		///< the radio reported a low free TX buffer via RADIO_STATUS
+		uint32_t round_trip_time;	///< latest round trip time in us, 0 if unknown
+	};
+
+	MavlinkLinkRateController() = default;
+	~MavlinkLinkRateController() = default;
+
+	/**
+	 * Update the rate multipliers, decreasing them multiplicatively on congestion and
+	 * increasing them additively otherwise
+	 */
+	void update(const hrt_abstime &t, const LinkState &state);
+
+	/**
+	 * @return multiplier for the stream rates of the given priority class
+	 */
+	float multiplier(MavlinkStream::Priority priority) const;
+
+	void print_status() const;
+
+private:
+	static constexpr hrt_abstime CONTROL_INTERVAL = 100000;	///< control period in us
+	static constexpr float DECREASE_FACTOR = 0.7f;
+	static constexpr float INCREASE_STEP = 0.05f;
+	static constexpr float MIN_MULTIPLIER = 0.05f;
+	static constexpr float TX_BUFFER_CONGESTED = 0.5f;	///< TX buffer fill considered congested
+	static constexpr float TX_BUFFER_FREE = 0.25f;		///< TX buffer fill below which the rate may increase
+	static constexpr uint32_t RTT_MARGIN = 50000;		///< margin in us above twice the baseline RTT
+
+	MavlinkRateLimiter _control_limiter{CONTROL_INTERVAL};
+
+	float _multiplier{1.f};
+	uint32_t _rtt_baseline{0};	///< lowest recent round trip time, an estimate of the unloaded latency
+	uint32_t _rtt{0};
+	float _tx_buffer_fill{0.f};
+	uint32_t _congested_count{0};
+};
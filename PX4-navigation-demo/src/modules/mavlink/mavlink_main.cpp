@@ -1177,6 +1177,9 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 		interval = -1;
 	}
 
+	// the stream list or a stream interval changes, the schedule must not refer to deleted streams
+	_stream_scheduler.invalidate();
+
 	for (const auto &stream : _streams) {
 		if (strcmp(stream_name, stream->get_name()) == 0) {
 			if (interval != 0) {
@@ -1298,7 +1301,7 @@ Mavlink::update_rate_mult()
 
 	/* scale down rates if their theoretical bandwidth is exceeding the link bandwidth */
 	for (const auto &stream : _streams) {
-		if (stream->const_rate()) {
+		if (stream->priority() == MavlinkStream::Priority::Critical) {
 			const_rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
 
 		} else {
@@ -1330,6 +1333,8 @@ Mavlink::update_rate_mult()
 
 	pthread_mutex_lock(&_radio_status_mutex);
 
+	const bool radio_congested = _radio_status_available && (_rstatus.txbuf < RADIO_BUFFER_LOW_PERCENTAGE);
+
 	// scale down if we have a TX err rate suggesting link congestion
 	if ((_tstatus.tx_error_rate_avg > 0.f) && !_radio_status_critical) {
 		hardware_mult = _tstatus.tx_rate_avg / (_tstatus.tx_rate_avg + _tstatus.tx_error_rate_avg);
@@ -1359,8 +1364,37 @@ Mavlink::update_rate_mult()
 	/* pick the minimum from bandwidth mult and hardware mult as limit */
 	_rate_mult = fminf(bandwidth_mult, hardware_mult);
 
+	// bulk transfers only yield to the rate controller, they already fill just the free TX buffer
+	_bulk_rate_mult = 1.0f;
+
+	/* closed-loop control from the measured congestion: critical streams keep their rate, bulk transfers yield first */
+	if (_adaptive_rate) {
+		const unsigned tx_buf_free = get_free_tx_buf();
+		_tx_buf_capacity = math::max(_tx_buf_capacity, tx_buf_free);
+
+		MavlinkLinkRateController::LinkState link_state{};
+		link_state.tx_buffer_fill = (_tx_buf_capacity > 0) ? 1.0f - (float)tx_buf_free / _tx_buf_capacity : 0.0f;
+		link_state.radio_congested = radio_congested;
+		link_state.round_trip_time = _receiver.timesync_round_trip_time();
+
+		_link_rate_controller.update(hrt_absolute_time(), link_state);
+
+		_rate_mult = fminf(_rate_mult, _link_rate_controller.multiplier(MavlinkStream::Priority::Normal));
+		_bulk_rate_mult = fminf(_rate_mult, _link_rate_controller.multiplier(MavlinkStream::Priority::Bulk));
+	}
+
 	/* ensure the rate multiplier never drops below 5% so that something is always sent */
 	_rate_mult = math::constrain(_rate_mult, 0.05f, 1.0f);
+
+	if (_adaptive_rate) {
+		_bulk_rate_mult = math::constrain(_bulk_rate_mult, 0.01f, _rate_mult);
+	}
+
+	/* the deadlines of the streams scale with the multiplier, reschedule them on a significant change */
+	if (fabsf(_rate_mult - _scheduled_rate_mult) > 0.1f * _scheduled_rate_mult) {
+		_scheduled_rate_mult = _rate_mult;
+		_stream_scheduler.invalidate();
+	}
 }
 
 void
@@ -1957,7 +1991,7 @@ Mavlink::task_main(int argc, char *argv[])
 	int temp_int_arg;
 #endif
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:n:u:o:m:t:c:F:fswxzZp", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:n:u:o:m:t:c:F:fswxzZpa", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			if (px4_get_parameter_value(myoptarg, _baudrate) != 0) {
@@ -2175,6 +2209,10 @@ Mavlink::task_main(int argc, char *argv[])
 			_use_software_mav_throttling = true;
 			break;
 
+		case 'a':
+			_adaptive_rate = true;
+			break;
+
 		case 'w':
 			_wait_to_transmit = true;
 			break;
@@ -2380,9 +2418,12 @@ Mavlink::task_main(int argc, char *argv[])
 
 	_task_running.store(true);
 
+	unsigned loop_delay = _main_loop_delay;
+
 	while (!should_exit()) {
 		/* main loop */
-		px4_usleep(_main_loop_delay);
+		px4_usleep(loop_delay);
+		loop_delay = _main_loop_delay;
 
 		if (!should_transmit()) {
 			check_requested_subscriptions();
@@ -2418,11 +2459,11 @@ Mavlink::task_main(int argc, char *argv[])
 
 		check_requested_subscriptions();
 
-		/* update streams */
-		for (const auto &stream : _streams) {
-			stream->update(t);
+		/* update the streams which are due, within the free TX buffer */
+		const hrt_abstime next_stream_update = _stream_scheduler.update(_streams, t, get_free_tx_buf(), _main_loop_delay);
 
-			if (!_first_heartbeat_sent) {
+		if (!_first_heartbeat_sent) {
+			for (const auto &stream : _streams) {
 				if (_mode == MAVLINK_MODE_IRIDIUM) {
 					if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
 						_first_heartbeat_sent = stream->first_message_sent();
@@ -2438,7 +2479,7 @@ Mavlink::task_main(int argc, char *argv[])
 
 		/* check for ulog streaming messages */
 		if (_mavlink_ulog) {
-			const int ret = _mavlink_ulog->handle_update(get_channel());
+			const int ret = _mavlink_ulog->handle_update(get_channel(), get_rate_mult(MavlinkStream::Priority::Bulk));
 
 			if (ret < 0) { // abort the streaming on error
 				if (ret != -1) {
@@ -2519,6 +2560,13 @@ Mavlink::task_main(int argc, char *argv[])
 			publish_telemetry_status();
 		}
 
+		/* wake up at the next stream deadline if it is earlier than the regular loop delay */
+		const hrt_abstime now = hrt_absolute_time();
+
+		if (next_stream_update < now + _main_loop_delay) {
+			loop_delay = (next_stream_update > now + MAVLINK_MIN_INTERVAL) ? next_stream_update - now : MAVLINK_MIN_INTERVAL;
+		}
+
 		perf_end(_loop_perf);
 	}
 
@@ -3049,6 +3097,10 @@ Mavlink::display_status()
 	printf("\t  tx: %.1f B/s\n", (double)_tstatus.tx_rate_avg);
 	printf("\t  txerr: %.1f B/s\n", (double)_tstatus.tx_error_rate_avg);
 	printf("\t  tx rate mult: %.3f\n", (double)_rate_mult);
+
+	if (_adaptive_rate) {
+		_link_rate_controller.print_status();
+	}
 	printf("\t  tx rate max: %i B/s\n", _datarate);
 	printf("\t  rx: %.1f B/s\n", (double)_tstatus.rx_rate_avg);
 	printf("\t  rx loss: %.1f%%\n", (double)_tstatus.rx_message_lost_rate);
@@ -3115,9 +3167,8 @@ Mavlink::display_status()
 void
 Mavlink::display_status_streams()
 {
-	printf("\t%-20s%-16s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]");
-
-	const float rate_mult = _rate_mult;
+	printf("\t%-20s%-16s %-14s %s\n", "Name", "Rate Config (current) [Hz]", "Achieved [Hz]",
+	       "Message Size (if active) [B]");
 
 	for (const auto &stream : _streams) {
 		const int interval = stream->get_interval();
@@ -3131,11 +3182,11 @@ Mavlink::display_status_streams()
 			float rate = 1000000.0f / (float)interval;
 			// Note that the actual current rate can be lower if the associated uORB topic updates at a
 			// lower rate.
-			float rate_current = stream->const_rate() ? rate : rate * rate_mult;
+			float rate_current = rate * get_rate_mult(stream->priority());
 			snprintf(rate_str, sizeof(rate_str), "%6.2f (%.3f)", (double)rate, (double)rate_current);
 		}
 
-		printf("\t%-30s%-16s", stream->get_name(), rate_str);
+		printf("\t%-30s%-16s %8.2f      ", stream->get_name(), rate_str, (double)stream->get_achieved_rate());
 
 		if (size > 0) {
 			printf(" %3u\n", size);
@@ -3144,6 +3195,8 @@ Mavlink::display_status_streams()
 			printf("\n");
 		}
 	}
+
+	printf("\tsends deferred by full TX buffer: %" PRIu32 "\n", _stream_scheduler.deferred_count());
 }
 
 int
@@ -3455,6 +3508,7 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_FLOAT('F', 0.015, 0.0, 50.0, "Sets the transmission frequency for iridium mode", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('f', "Enable message forwarding to other Mavlink instances", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('w', "Wait to send, until first message received", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('a', "Adapt stream rates to the measured link congestion", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('x', "Enable FTP", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('z', "Force hardware flow control always on", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('Z', "Force hardware flow control always off", true);
@@ -81,9 +81,11 @@
 
 #include "mavlink_command_sender.h"
 #include "mavlink_events.h"
+#include "mavlink_link_rate_controller.h"
 #include "mavlink_messages.h"
 #include "mavlink_receiver.h"
 #include "mavlink_shell.h"
+#include "mavlink_stream_scheduler.h"
 #include "mavlink_ulog.h"
 
 #define DEFAULT_BAUD_RATE       57600
@@ -378,8 +380,27 @@ public:
 
 	List<MavlinkStream *> &get_streams() { return _streams; }
 
+	/**
+	 * Rebuild the stream schedule, required when the deadline of a stream changed other than by sending.
+	 */
+	void			invalidate_stream_schedule() { _stream_scheduler.invalidate(); }
+
 	float			get_rate_mult() const { return _rate_mult; }
 
+	/**
+	 * @return rate multiplier for the streams and transfers of a priority class
+	 */
+	float			get_rate_mult(MavlinkStream::Priority priority) const
+	{
+		switch (priority) {
+		case MavlinkStream::Priority::Critical: return 1.0f;
+
+		case MavlinkStream::Priority::Bulk: return _bulk_rate_mult;
+
+		default: return _rate_mult;
+		}
+	}
+
 	float			get_baudrate() { return _baudrate; }
 
 	/* Functions for waiting to start transmission until message received. */
@@ -536,6 +557,7 @@ private:
 	unsigned		_main_loop_delay{1000};	/**< mainloop delay, depends on data rate */
 
 	List<MavlinkStream *>		_streams;
+	MavlinkStreamScheduler		_stream_scheduler;
 
 	MavlinkShell		*_mavlink_shell{nullptr};
 	pthread_mutex_t		_mavlink_shell_mutex{};
@@ -550,12 +572,18 @@ private:
 	bool			_forwarding_on{false};
 	bool			_ftp_on{false};
 	bool			_use_software_mav_throttling{false};
+	bool			_adaptive_rate{false};		///< closed-loop rate control from the measured link congestion
+
+	MavlinkLinkRateController	_link_rate_controller{};
+	unsigned		_tx_buf_capacity{0};		///< largest free TX buffer seen, the capacity of the buffer
 
 	int			_uart_fd{-1};
 
 	int			_baudrate{57600};
 	int			_datarate{1000};		///< data rate for normal streams (attitude, position, etc.)
 	float			_rate_mult{1.0f};
+	float			_bulk_rate_mult{1.0f};		///< rate multiplier of bulk streams and transfers
+	float			_scheduled_rate_mult{1.0f};	///< rate multiplier the stream schedule was built with
 	float			_high_latency_freq{0.015f};	///< frequency of HIGH_LATENCY2 stream
 
 	bool			_radio_status_available{false};
@@ -993,6 +993,8 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_state = MAVLINK_WPM_STATE_GETLIST;
 			_transfer_seq = 0;
 			_transfer_count = wpc.count;
+			_transfer_buffer_count = 0;
+			_transfer_transaction = _dataman_client.beginTransaction();
 			_transfer_current_seq = -1;
 			_transfer_land_start_marker = -1;
 			_transfer_land_marker = -1;
@@ -1040,6 +1042,32 @@ void
 MavlinkMissionManager::switch_to_idle_state()
 {
 	_state = MAVLINK_WPM_STATE_IDLE;
+
+	if (_transfer_transaction) {
+		_dataman_client.commitTransaction();
+		_transfer_transaction = false;
+	}
+}
+
+bool
+MavlinkMissionManager::transfer_buffer_item(uint16_t seq, const void *item, size_t item_size)
+{
+	if (_transfer_buffer_count == 0) {
+		_transfer_buffer_seq = seq;
+	}
+
+	memcpy(&_transfer_buffer[_transfer_buffer_count * item_size], item, item_size);
+	_transfer_buffer_count++;
+
+	if (_transfer_buffer_count < TRANSFER_BUFFER_ITEMS && seq + 1 < _transfer_count) {
+		return true;
+	}
+
+	const bool success = _dataman_client.writeRange(_transfer_dataman_id, _transfer_buffer_seq, _transfer_buffer_count,
+			     _transfer_buffer, item_size);
+	_transfer_buffer_count = 0;
+
+	return success;
 }
 
 
@@ -1156,9 +1184,7 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 
 					} else {
 
-						write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-								reinterpret_cast<uint8_t *>(&mission_item),
-								sizeof(struct mission_item_s));
+						write_failed = !transfer_buffer_item(wp.seq, &mission_item, sizeof(struct mission_item_s));
 
 						// Check for land start marker
 						if ((mission_item.nav_cmd == MAV_CMD_DO_LAND_START) && (_transfer_land_start_marker == -1)) {
@@ -1208,16 +1234,14 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 					mission_fence_point.frame = mission_item.frame;
 
 					if (!check_failed) {
-						write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-								reinterpret_cast<uint8_t *>(&mission_fence_point), sizeof(mission_fence_point_s));
+						write_failed = !transfer_buffer_item(wp.seq, &mission_fence_point, sizeof(mission_fence_point_s));
 					}
 
 				}
 				break;
 
 			case MAV_MISSION_TYPE_RALLY: { // Write a safe point / rally point
-					write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-							reinterpret_cast<uint8_t *>(&mission_item), sizeof(mission_item_s), 2_s);
+					write_failed = !transfer_buffer_item(wp.seq, &mission_item, sizeof(mission_item_s));
 				}
 				break;
 
@@ -1295,6 +1319,15 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 					break;
 				}
 
+				// Sync all received items to storage at once before accepting the transfer
+				if (_transfer_transaction) {
+					if (!_dataman_client.commitTransaction() && (ret == PX4_OK)) {
+						ret = PX4_ERROR;
+					}
+
+					_transfer_transaction = false;
+				}
+
 				// Note: the switch to idle needs to happen after update_geofence_count is called, for proper unlocking order
 				switch_to_idle_state();
 
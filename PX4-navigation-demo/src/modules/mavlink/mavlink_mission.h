@@ -148,6 +148,12 @@ private:
 
 	static bool		_transfer_in_progress;			///< Global variable checking for current transmission
 
+	static constexpr uint16_t	TRANSFER_BUFFER_ITEMS = 8;	///< Number of received items written to dataman with a single request
+	uint8_t			_transfer_buffer[TRANSFER_BUFFER_ITEMS * sizeof(mission_item_s)]; ///< Received items not yet written to dataman
+	uint16_t		_transfer_buffer_seq{0};		///< Sequence of the first item in _transfer_buffer
+	uint16_t		_transfer_buffer_count{0};		///< Number of items in _transfer_buffer
+	bool			_transfer_transaction{false};		///< Dataman syncs the received items once the transmission is complete
+
 	uORB::SubscriptionData<mission_result_s>	_mission_result_sub{ORB_ID(mission_result)};
 	uORB::SubscriptionData<mission_s> 	_mission_sub{ORB_ID(mission)};
 	uORB::Subscription	_vehicle_status_sub{ORB_ID(vehicle_status)};	///< vehicle status subscription
@@ -274,6 +280,17 @@ private:
 	 */
 	void switch_to_idle_state();
 
+	/**
+	 * Buffer a received item of the current transmission. The buffered items are written to dataman
+	 * with a single range request once the buffer is full or the last item was received.
+	 *
+	 * @param seq sequence of the item, consecutive to the previously buffered one
+	 * @param item item data (mission_item_s or mission_fence_point_s)
+	 * @param item_size size of the item data
+	 * @return false if writing to dataman failed
+	 */
+	bool transfer_buffer_item(uint16_t seq, const void *item, size_t item_size);
+
 	/**
 	 * Copies the specified range [1, 7] of param of MAVLink mission to params[] array of
 	 * the Mission item struct (Very useful for mission items for non-navigation
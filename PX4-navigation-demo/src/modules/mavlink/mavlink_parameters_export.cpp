@@ -0,0 +1,358 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_parameters_export.cpp
+ * Bulk parameter export served as a virtual file through MAVLink FTP.
+ */
+
+#include "mavlink_parameters_export.h"
+#include "mavlink_bridge_header.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <parameters/param.h>
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/log.h>
+
+#define HEATSHRINK_DYNAMIC_ALLOC 0
+#include <lib/heatshrink/heatshrink/heatshrink_encoder.h>
+
+static const char kExportPath[] = "@PARAM/param.pck";
+static const char kSinceQuery[] = "?since=";
+static const char *kSnapshotPath = PX4_STORAGEDIR "/param_export.bin";
+static const char *kSnapshotPathTemp = PX4_STORAGEDIR "/$param_export$.bin";
+
+/* exports of all instances share the snapshot */
+static pthread_mutex_t export_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+namespace
+{
+
+static constexpr size_t kNameLength = MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN;
+
+/** Values of the last export, the base of the next delta */
+struct SnapshotHeader {
+	uint32_t magic;
+	uint32_t hash;
+	uint32_t count;
+};
+
+struct SnapshotEntry {
+	char name[kNameLength]; ///< not nul terminated if all characters are used
+	uint8_t value[4];
+};
+
+class Exporter
+{
+public:
+	int run(const char *file, const uint32_t *since);
+
+private:
+	bool open_base(uint32_t since);
+	const SnapshotEntry *find_base(const char *name);
+	void close_base();
+
+	bool compress(const void *data, size_t length);
+	bool drain();
+	bool flush();
+	bool finish();
+
+	heatshrink_encoder _encoder;
+
+	int _fd{-1};
+	uint8_t _output[256];
+	size_t _output_length{0};
+
+	int _base_fd{-1};
+	SnapshotEntry _base[16];
+	unsigned _base_index{0};
+	unsigned _base_length{0};
+	uint32_t _base_remaining{0};
+};
+
+int Exporter::run(const char *file, const uint32_t *since)
+{
+	MavlinkParametersExport::Header header{};
+	header.magic = MavlinkParametersExport::kMagic;
+	header.version = MavlinkParametersExport::kVersion;
+	header.window_bits = HEATSHRINK_STATIC_WINDOW_BITS;
+	header.lookahead_bits = HEATSHRINK_STATIC_LOOKAHEAD_BITS;
+	header.hash = param_hash_check();
+	header.param_count = param_count_used();
+
+	if (since && open_base(*since)) {
+		header.flags |= MavlinkParametersExport::kFlagDelta;
+		header.base_hash = *since;
+	}
+
+	_fd = ::open(file, O_CREAT | O_TRUNC | O_WRONLY, PX4_O_MODE_666);
+
+	if (_fd < 0) {
+		const int ret = -errno;
+		close_base();
+		return ret;
+	}
+
+	// without a snapshot the next request gets a full export, which is not worth failing this one for
+	int snapshot_fd = ::open(kSnapshotPathTemp, O_CREAT | O_TRUNC | O_WRONLY, PX4_O_MODE_666);
+	SnapshotHeader snapshot{MavlinkParametersExport::kMagic, header.hash, header.param_count};
+
+	if ((snapshot_fd >= 0) && (::write(snapshot_fd, &snapshot, sizeof(snapshot)) != sizeof(snapshot))) {
+		::close(snapshot_fd);
+		snapshot_fd = -1;
+	}
+
+	bool success = (::write(_fd, &header, sizeof(header)) == sizeof(header));
+	heatshrink_encoder_reset(&_encoder);
+
+	for (unsigned i = 0; success && (i < header.param_count); i++) {
+		const param_t param = param_for_used_index(i);
+		const char *name = param_name(param);
+
+		SnapshotEntry entry{};
+		strncpy(entry.name, name, sizeof(entry.name));
+
+		uint8_t type;
+
+		if (param_type(param) == PARAM_TYPE_INT32) {
+			type = MAV_PARAM_TYPE_INT32;
+			int32_t value = 0;
+			param_get(param, &value);
+			memcpy(entry.value, &value, sizeof(entry.value));
+
+		} else {
+			type = MAV_PARAM_TYPE_REAL32;
+			float value = 0.f;
+			param_get(param, &value);
+			memcpy(entry.value, &value, sizeof(entry.value));
+		}
+
+		if ((snapshot_fd >= 0) && (::write(snapshot_fd, &entry, sizeof(entry)) != sizeof(entry))) {
+			::close(snapshot_fd);
+			snapshot_fd = -1;
+		}
+
+		if (header.flags & MavlinkParametersExport::kFlagDelta) {
+			// volatile parameters are not covered by the hash, the GCS may have any value of them
+			const SnapshotEntry *base = find_base(name);
+
+			if (base && !param_is_volatile(param) && (memcmp(base->value, entry.value, sizeof(entry.value)) == 0)) {
+				continue;
+			}
+		}
+
+		const uint16_t index = i;
+		const uint8_t name_length = strnlen(entry.name, sizeof(entry.name));
+
+		success = compress(&index, sizeof(index)) && compress(&type, sizeof(type)) &&
+			  compress(&name_length, sizeof(name_length)) && compress(entry.name, name_length) &&
+			  compress(entry.value, sizeof(entry.value));
+
+		header.entry_count++;
+	}
+
+	success = success && finish() && (::lseek(_fd, 0, SEEK_SET) == 0) &&
+		  (::write(_fd, &header, sizeof(header)) == sizeof(header));
+
+	const int ret = success ? 0 : -((errno != 0) ? errno : EIO);
+	::close(_fd);
+	close_base();
+
+	if (snapshot_fd >= 0) {
+		::close(snapshot_fd);
+
+		if (success) {
+			::rename(kSnapshotPathTemp, kSnapshotPath);
+
+		} else {
+			::unlink(kSnapshotPathTemp);
+		}
+	}
+
+	PX4_DEBUG("exported %u of %u parameters%s", header.entry_count, header.param_count,
+		  (header.flags & MavlinkParametersExport::kFlagDelta) ? " (delta)" : "");
+
+	return ret;
+}
+
+bool Exporter::open_base(uint32_t since)
+{
+	SnapshotHeader snapshot;
+	_base_fd = ::open(kSnapshotPath, O_RDONLY);
+
+	if ((_base_fd >= 0) && (::read(_base_fd, &snapshot, sizeof(snapshot)) == sizeof(snapshot)) &&
+	    (snapshot.magic == MavlinkParametersExport::kMagic) && (snapshot.hash == since)) {
+		_base_remaining = snapshot.count;
+		return true;
+	}
+
+	close_base();
+	return false;
+}
+
+void Exporter::close_base()
+{
+	if (_base_fd >= 0) {
+		::close(_base_fd);
+		_base_fd = -1;
+	}
+}
+
+const SnapshotEntry *Exporter::find_base(const char *name)
+{
+	// parameters are ordered by name, so the snapshot is read alongside them once
+	for (;;) {
+		if (_base_index == _base_length) {
+			const unsigned count = (_base_remaining < sizeof(_base) / sizeof(_base[0])) ? _base_remaining :
+					       sizeof(_base) / sizeof(_base[0]);
+
+			if ((count == 0) || (::read(_base_fd, _base, count * sizeof(_base[0])) != (ssize_t)(count * sizeof(_base[0])))) {
+				// an unreadable snapshot only costs entries
+				_base_remaining = 0;
+				return nullptr;
+			}
+
+			_base_index = 0;
+			_base_length = count;
+			_base_remaining -= count;
+		}
+
+		const int order = strncmp(_base[_base_index].name, name, kNameLength);
+
+		if (order > 0) {
+			return nullptr;
+		}
+
+		_base_index++;
+
+		if (order == 0) {
+			return &_base[_base_index - 1];
+		}
+	}
+}
+
+bool Exporter::compress(const void *data, size_t length)
+{
+	uint8_t *input = (uint8_t *)data;
+
+	while (length > 0) {
+		size_t sunk = 0;
+
+		if (heatshrink_encoder_sink(&_encoder, input, length, &sunk) < 0 || !drain()) {
+			return false;
+		}
+
+		input += sunk;
+		length -= sunk;
+	}
+
+	return true;
+}
+
+bool Exporter::drain()
+{
+	HSE_poll_res res;
+
+	do {
+		size_t polled = 0;
+		res = heatshrink_encoder_poll(&_encoder, &_output[_output_length], sizeof(_output) - _output_length, &polled);
+		_output_length += polled;
+
+		if ((res < 0) || ((_output_length == sizeof(_output)) && !flush())) {
+			return false;
+		}
+	} while (res == HSER_POLL_MORE);
+
+	return true;
+}
+
+bool Exporter::flush()
+{
+	const bool success = (::write(_fd, _output, _output_length) == (ssize_t)_output_length);
+	_output_length = 0;
+	return success;
+}
+
+bool Exporter::finish()
+{
+	HSE_finish_res res;
+
+	while ((res = heatshrink_encoder_finish(&_encoder)) == HSER_FINISH_MORE) {
+		if (!drain()) {
+			return false;
+		}
+	}
+
+	return (res == HSER_FINISH_DONE) && flush();
+}
+
+} // namespace
+
+bool MavlinkParametersExport::is_export_path(const char *path)
+{
+	return (strncmp(path, kExportPath, sizeof(kExportPath) - 1) == 0) &&
+	       ((path[sizeof(kExportPath) - 1] == '\0') || (path[sizeof(kExportPath) - 1] == '?'));
+}
+
+int MavlinkParametersExport::export_to_file(const char *path, const char *file)
+{
+	const char *query = path + sizeof(kExportPath) - 1;
+	uint32_t since = 0;
+	bool delta = false;
+
+	if (strncmp(query, kSinceQuery, sizeof(kSinceQuery) - 1) == 0) {
+		char *end = nullptr;
+		since = strtoul(query + sizeof(kSinceQuery) - 1, &end, 16);
+		delta = (end != query + sizeof(kSinceQuery) - 1) && (*end == '\0');
+	}
+
+	Exporter *exporter = new Exporter();
+
+	if (exporter == nullptr) {
+		return -ENOMEM;
+	}
+
+	pthread_mutex_lock(&export_mutex);
+	const int ret = exporter->run(file, delta ? &since : nullptr);
+	pthread_mutex_unlock(&export_mutex);
+
+	delete exporter;
+	return ret;
+}
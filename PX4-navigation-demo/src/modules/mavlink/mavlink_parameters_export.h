@@ -0,0 +1,88 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_parameters_export.h
+ * Bulk parameter export served as a virtual file through MAVLink FTP.
+ *
+ * Reading "@PARAM/param.pck" returns all used parameters in one compressed file. A GCS that cached the parameters
+ * together with the _HASH_CHECK value of an earlier sync reads "@PARAM/param.pck?since=<hash>" (hash in hex)
+ * instead, which only contains the parameters that changed since the export that produced that hash. The vehicle
+ * keeps the values of the last export for this, if the hash does not match them the full set is returned.
+ *
+ * The file is a Header followed by the heatshrink compressed entries, all little endian:
+ *
+ *   uint16_t index        used parameter index, as param_index in PARAM_VALUE
+ *   uint8_t  type         MAV_PARAM_TYPE
+ *   uint8_t  name_length
+ *   char     name[name_length]
+ *   uint8_t  value[4]     bytewise as in PARAM_VALUE
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class MavlinkParametersExport
+{
+public:
+	static constexpr uint32_t kMagic = 0x50345850; ///< "PX4P"
+	static constexpr uint8_t kVersion = 1;
+	static constexpr uint8_t kFlagDelta = 1 << 0; ///< only the parameters changed since base_hash are included
+
+	struct __attribute__((__packed__)) Header {
+		uint32_t magic;
+		uint8_t version;
+		uint8_t flags;
+		uint8_t window_bits;    ///< heatshrink window size
+		uint8_t lookahead_bits; ///< heatshrink lookahead size
+		uint32_t hash;          ///< _HASH_CHECK of the exported values
+		uint32_t base_hash;     ///< hash the delta was taken against, 0 for a full export
+		uint16_t param_count;   ///< number of used parameters
+		uint16_t entry_count;   ///< number of entries in the file
+	};
+
+	/**
+	 * Check whether the FTP path refers to the parameter export.
+	 */
+	static bool is_export_path(const char *path);
+
+	/**
+	 * Write the export requested by path to the local file, and remember the exported values as the base for deltas.
+	 * @return 0 on success, negative errno otherwise
+	 */
+	static int export_to_file(const char *path, const char *file);
+
+private:
+	MavlinkParametersExport() = delete;
+};
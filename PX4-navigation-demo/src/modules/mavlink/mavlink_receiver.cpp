@@ -1947,7 +1947,16 @@ MavlinkReceiver::handle_message_obstacle_distance(mavlink_message_t *msg)
 	mavlink_obstacle_distance_t mavlink_obstacle_distance;
 	mavlink_msg_obstacle_distance_decode(msg, &mavlink_obstacle_distance);
 
-	obstacle_distance_s obstacle_distance{};
+	// build the message in the queue slot, if loaning is not supported (NuttX) publish() copies it instead.
+	// The slot still holds an older message, every field is set below.
+	obstacle_distance_s obstacle_distance_stack;
+	obstacle_distance_s *loaned = _obstacle_distance_pub.loan();
+
+	if (loaned == nullptr) {
+		obstacle_distance_stack = {};
+	}
+
+	obstacle_distance_s &obstacle_distance = (loaned != nullptr) ? *loaned : obstacle_distance_stack;
 
 	obstacle_distance.timestamp = hrt_absolute_time();
 	obstacle_distance.sensor_type = mavlink_obstacle_distance.sensor_type;
@@ -1965,7 +1974,12 @@ MavlinkReceiver::handle_message_obstacle_distance(mavlink_message_t *msg)
 	obstacle_distance.angle_offset = mavlink_obstacle_distance.angle_offset;
 	obstacle_distance.frame = mavlink_obstacle_distance.frame;
 
-	_obstacle_distance_pub.publish(obstacle_distance);
+	if (loaned != nullptr) {
+		_obstacle_distance_pub.commit();
+
+	} else {
+		_obstacle_distance_pub.publish(obstacle_distance);
+	}
 }
 
 void
@@ -138,6 +138,11 @@ public:
 
 	void request_stop() { _should_exit.store(true); }
 
+	/**
+	 * @return round trip time of the latest timesync exchange in us, 0 if unknown
+	 */
+	uint32_t timesync_round_trip_time() const { return _mavlink_timesync.round_trip_time(); }
+
 private:
 	static void *start_trampoline(void *context);
 	void run();
@@ -66,6 +66,7 @@ MavlinkStream::update(const hrt_abstime &t)
 		// on the link scheduling
 		if (send()) {
 			_last_sent = hrt_absolute_time();
+			count_sent(_last_sent);
 
 			if (!_first_message_sent) {
 				_first_message_sent = true;
@@ -82,11 +83,7 @@ MavlinkStream::update(const hrt_abstime &t)
 	}
 
 	int64_t dt = t - _last_sent;
-	int interval = _interval;
-
-	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
-	}
+	const int interval = effective_interval();
 
 	// We don't need to send anything if the inverval is 0. send() will be called manually.
 	if (interval == 0) {
@@ -114,6 +111,7 @@ MavlinkStream::update(const hrt_abstime &t)
 		// long time not sending anything, sending multiple messages in a short time is avoided.
 		if (send()) {
 			_last_sent = ((interval > 0) && ((int64_t)(1.5f * interval) > dt)) ? _last_sent + interval : t;
+			count_sent(t);
 
 			if (!_first_message_sent) {
 				_first_message_sent = true;
@@ -128,3 +126,76 @@ MavlinkStream::update(const hrt_abstime &t)
 
 	return -1;
 }
+
+hrt_abstime
+MavlinkStream::next_update()
+{
+	if (_last_sent == 0) {
+		return 0;
+	}
+
+	const int interval = effective_interval();
+
+	if (interval == 0) {
+		return UINT64_MAX;
+
+	} else if (interval < 0) {
+		return _last_sent;
+	}
+
+	// first time at which update() sends, it requires dt to exceed the interval minus the early send margin
+	const int margin = (_mavlink->get_main_loop_delay() / 10) * 3;
+
+	return (interval > margin) ? _last_sent + (interval - margin) + 1 : _last_sent + 1;
+}
+
+void
+MavlinkStream::reset_last_sent()
+{
+	_last_sent = 0;
+	_mavlink->invalidate_stream_schedule();
+}
+
+int
+MavlinkStream::effective_interval()
+{
+	int interval = _interval;
+	const Priority stream_priority = priority();
+
+	if (stream_priority != Priority::Critical) {
+		interval /= _mavlink->get_rate_mult(stream_priority);
+	}
+
+	return interval;
+}
+
+float
+MavlinkStream::get_achieved_rate()
+{
+	// a stream that stopped sending does not complete its measurement window anymore
+	const int interval = effective_interval();
+	const hrt_abstime timeout = 2_s + ((interval > 0) ? 2 * (hrt_abstime)interval : 0);
+
+	if ((_rate_window_start == 0) || (hrt_elapsed_time(&_rate_window_start) > timeout)) {
+		return 0.f;
+	}
+
+	return _achieved_rate;
+}
+
+void
+MavlinkStream::count_sent(const hrt_abstime &t)
+{
+	if (_rate_window_start == 0) {
+		_rate_window_start = t;
+		return;
+	}
+
+	_rate_window_count++;
+
+	if (t >= _rate_window_start + 1_s) {
+		_achieved_rate = _rate_window_count * 1e6f / (t - _rate_window_start);
+		_rate_window_start = t;
+		_rate_window_count = 0;
+	}
+}
@@ -52,6 +52,15 @@ class MavlinkStream : public ListNode<MavlinkStream *>
 
 public:
 
+	/**
+	 * Priority class of a stream when the link is congested
+	 */
+	enum class Priority : uint8_t {
+		Critical,	///< keeps the configured rate
+		Normal,		///< scaled with the link rate multiplier
+		Bulk		///< yields first
+	};
+
 	MavlinkStream(Mavlink *mavlink);
 	virtual ~MavlinkStream() = default;
 
@@ -87,6 +96,29 @@ public:
 	 */
 	virtual bool const_rate() { return false; }
 
+	/**
+	 * @return priority class of the stream, streams with a constant rate are critical
+	 */
+	virtual Priority priority() { return const_rate() ? Priority::Critical : Priority::Normal; }
+
+	/**
+	 * @return true if update() must be called at every iteration of the mavlink module,
+	 * e.g. because update_data() collects data at a high rate
+	 */
+	virtual bool continuous_update() { return false; }
+
+	/**
+	 * Get the earliest time at which update() may send the next message
+	 *
+	 * @return 0 if the stream is due immediately, UINT64_MAX if send() is only called manually
+	 */
+	hrt_abstime next_update();
+
+	/**
+	 * @return the rate in Hz at which messages were actually sent during the last measurement window
+	 */
+	float get_achieved_rate();
+
 	/**
 	 * Get maximal total messages size on update
 	 */
@@ -120,7 +152,7 @@ public:
 	 * Reset the time of last sent to 0. Can be used if a message over this
 	 * stream needs to be sent immediately.
 	 */
-	void reset_last_sent() { _last_sent = 0; }
+	void reset_last_sent();
 
 protected:
 	Mavlink      *const _mavlink;
@@ -137,8 +169,19 @@ protected:
 	virtual void update_data() { }
 
 private:
+	/**
+	 * @return the interval scaled by the link rate multiplier, 0 if disabled, negative if unlimited
+	 */
+	int effective_interval();
+
+	void count_sent(const hrt_abstime &t);
+
 	hrt_abstime _last_sent{0};
 	bool _first_message_sent{false};
+
+	hrt_abstime _rate_window_start{0};	///< start of the achieved rate measurement window
+	uint16_t _rate_window_count{0};		///< messages sent during the current window
+	float _achieved_rate{0.f};
 };
 
 
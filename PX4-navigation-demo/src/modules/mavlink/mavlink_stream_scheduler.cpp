@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_stream_scheduler.cpp
+ * Deadline ordered scheduling of the MAVLink streams of one instance.
+ */
+
+#include "mavlink_stream_scheduler.h"
+
+MavlinkStreamScheduler::~MavlinkStreamScheduler()
+{
+	delete[] _heap;
+	delete[] _continuous;
+}
+
+hrt_abstime
+MavlinkStreamScheduler::update(List<MavlinkStream *> &streams, const hrt_abstime &now, unsigned tx_budget,
+			       hrt_abstime poll_interval)
+{
+	if (_invalid.load()) {
+		// clear before rebuilding so that an invalidation during the rebuild is not lost
+		_invalid.store(false);
+
+		if (!rebuild(streams)) {
+			// out of memory, fall back to updating every stream
+			_invalid.store(true);
+
+			for (const auto &stream : streams) {
+				stream->update(now);
+			}
+
+			return now + poll_interval;
+		}
+	}
+
+	// streams collecting data at a high rate need every iteration, regardless of the link budget
+	for (unsigned i = 0; i < _continuous_size; i++) {
+		const unsigned size = _continuous[i]->get_size();
+
+		if ((_continuous[i]->update(now) == 0) && (size > 0)) {
+			tx_budget = (size < tx_budget) ? tx_budget - size : 0;
+		}
+	}
+
+	// due streams are moved past now, otherwise they would be popped again within this call
+	const hrt_abstime retry = now + ((poll_interval > 0) ? poll_interval : 1);
+	bool first = true;
+
+	while ((_heap_size > 0) && (_heap[0].due <= now)) {
+		MavlinkStream *stream = _heap[0].stream;
+		const unsigned size = stream->get_size();
+
+		pop();
+
+		if ((size > tx_budget) && !first) {
+			// retry at the next iteration and let the smaller due streams use the remaining budget,
+			// the retried stream then has the earliest deadline and goes first
+			_deferred_count++;
+			push({retry, stream});
+			continue;
+		}
+
+		// the first due stream is always updated, even if it exceeds the budget (e.g. the fixed
+		// size reported for a serial link without FIONSPACE), as it would never fit otherwise
+		first = false;
+
+		if ((stream->update(now) == 0) && (size > 0)) {
+			tx_budget = (size < tx_budget) ? tx_budget - size : 0;
+		}
+
+		hrt_abstime due = stream->next_update();
+
+		if (due <= now) {
+			// nothing was sent, e.g. no new data: poll again like every other stream
+			due = retry;
+		}
+
+		push({due, stream});
+	}
+
+	return (_heap_size > 0) ? _heap[0].due : UINT64_MAX;
+}
+
+bool
+MavlinkStreamScheduler::rebuild(List<MavlinkStream *> &streams)
+{
+	const unsigned count = streams.size();
+
+	if (count > _capacity) {
+		delete[] _heap;
+		delete[] _continuous;
+		_heap = new Entry[count];
+		_continuous = new MavlinkStream *[count];
+
+		if ((_heap == nullptr) || (_continuous == nullptr)) {
+			delete[] _heap;
+			delete[] _continuous;
+			_heap = nullptr;
+			_continuous = nullptr;
+			_capacity = 0;
+			_heap_size = 0;
+			_continuous_size = 0;
+			return false;
+		}
+
+		_capacity = count;
+	}
+
+	_heap_size = 0;
+	_continuous_size = 0;
+
+	for (const auto &stream : streams) {
+		if (stream->continuous_update() || (stream->get_interval() < 0)) {
+			_continuous[_continuous_size++] = stream;
+
+		} else {
+			push({stream->next_update(), stream});
+		}
+	}
+
+	return true;
+}
+
+void
+MavlinkStreamScheduler::push(const Entry &entry)
+{
+	unsigned i = _heap_size++;
+
+	while (i > 0) {
+		const unsigned parent = (i - 1) / 2;
+
+		if (_heap[parent].due <= entry.due) {
+			break;
+		}
+
+		_heap[i] = _heap[parent];
+		i = parent;
+	}
+
+	_heap[i] = entry;
+}
+
+void
+MavlinkStreamScheduler::pop()
+{
+	const Entry last = _heap[--_heap_size];
+	unsigned i = 0;
+
+	while (true) {
+		unsigned child = 2 * i + 1;
+
+		if (child >= _heap_size) {
+			break;
+		}
+
+		if ((child + 1 < _heap_size) && (_heap[child + 1].due < _heap[child].due)) {
+			child++;
+		}
+
+		if (last.due <= _heap[child].due) {
+			break;
+		}
+
+		_heap[i] = _heap[child];
+		i = child;
+	}
+
+	_heap[i] = last;
+}
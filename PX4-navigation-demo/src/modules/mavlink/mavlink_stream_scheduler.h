@@ -0,0 +1,103 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_stream_scheduler.h
+ * Deadline ordered scheduling of the MAVLink streams of one instance.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <containers/List.hpp>
+#include <px4_platform_common/atomic.h>
+
+#include "mavlink_stream.h"
+
+class MavlinkStreamScheduler
+{
+public:
+	MavlinkStreamScheduler() = default;
+	~MavlinkStreamScheduler();
+
+	// no copy, assignment, move, move assignment
+	MavlinkStreamScheduler(const MavlinkStreamScheduler &) = delete;
+	MavlinkStreamScheduler &operator=(const MavlinkStreamScheduler &) = delete;
+	MavlinkStreamScheduler(MavlinkStreamScheduler &&) = delete;
+	MavlinkStreamScheduler &operator=(MavlinkStreamScheduler &&) = delete;
+
+	/**
+	 * Rebuild the schedule before the next update, required whenever streams are added,
+	 * removed or their deadlines change other than by sending. Can be called from any thread.
+	 */
+	void invalidate() { _invalid.store(true); }
+
+	/**
+	 * Update the streams which are due, in deadline order
+	 *
+	 * @param streams all streams of the instance, must be the same list on every call
+	 * @param now current time
+	 * @param tx_budget number of bytes which can be sent without overflowing the link. Due streams which
+	 *                  do not fit are retried at the next update, except for the first one
+	 * @param poll_interval interval at which due streams without new data are updated again
+	 * @return time of the next deadline, UINT64_MAX if there is none
+	 */
+	hrt_abstime update(List<MavlinkStream *> &streams, const hrt_abstime &now, unsigned tx_budget,
+			   hrt_abstime poll_interval);
+
+	/**
+	 * @return number of times sending a due stream was postponed because it did not fit the TX budget
+	 */
+	uint32_t deferred_count() const { return _deferred_count; }
+
+private:
+	struct Entry {
+		hrt_abstime due;
+		MavlinkStream *stream;
+	};
+
+	bool rebuild(List<MavlinkStream *> &streams);
+
+	void push(const Entry &entry);
+	void pop();
+
+	Entry *_heap{nullptr};			///< min-heap of the streams ordered by deadline
+	unsigned _heap_size{0};
+	MavlinkStream **_continuous{nullptr};	///< streams updated on every call
+	unsigned _continuous_size{0};
+	unsigned _capacity{0};
+
+	uint32_t _deferred_count{0};
+
+	px4::atomic_bool _invalid{true};
+};
@@ -41,6 +41,7 @@
 
 #include "mavlink_ftp_test.h"
 #include "../mavlink_ftp.h"
+#include "../mavlink_parameters_export.h"
 
 #ifdef __PX4_NUTTX
 #define PX4_MAVLINK_TEST_DATA_DIR CONFIG_BOARD_ROOT_PATH "/ftp_unit_test_data"
@@ -54,6 +55,15 @@ static const char *_test_files[] = {
 	PX4_MAVLINK_TEST_DATA_DIR  "/" "test_240.data"
 };
 
+// Kept out of the test data dir to not change the List results
+static const char _large_test_file[] = PX4_MAVLINK_TEST_DATA_DIR "_large.data";
+
+/// Content of the large test file, does not repeat every 256 bytes to catch reads at a wrong offset
+static uint8_t _large_test_file_byte(uint32_t offset)
+{
+	return static_cast<uint8_t>(offset + offset / 251);
+}
+
 constexpr uint32_t MAX_DATA_LEN = MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN - sizeof(
 		MavlinkFTP::PayloadHeader);
 
@@ -137,6 +147,8 @@ bool MavlinkFtpTest::_remove_test_files()
 		::unlink(_test_files[i]);
 	}
 
+	::unlink(_large_test_file);
+
 	::rmdir(PX4_MAVLINK_TEST_DATA_DIR "/empty_dir");
 	::rmdir(PX4_MAVLINK_TEST_DATA_DIR);
 
@@ -686,6 +698,226 @@ bool MavlinkFtpTest::_read_badsession_test()
 	return true;
 }
 
+bool MavlinkFtpTest::_create_large_test_file()
+{
+	int fd = ::open(_large_test_file, O_CREAT | O_TRUNC | O_WRONLY, S_IRWXU | S_IRWXG | S_IRWXO);
+	ut_assert("Open failed", fd != -1);
+
+	uint8_t block[MavlinkFTP::kReadAheadAlignment];
+	bool failed = false;
+
+	for (uint32_t offset = 0; offset < _large_test_file_size; offset += sizeof(block)) {
+		const uint32_t length = _large_test_file_size - offset > sizeof(block) ? sizeof(block) : _large_test_file_size - offset;
+
+		for (uint32_t i = 0; i < length; i++) {
+			block[i] = _large_test_file_byte(offset + i);
+		}
+
+		if (::write(fd, block, length) != static_cast<ssize_t>(length)) {
+			failed = true;
+		}
+	}
+
+	close(fd);
+
+	ut_assert("Could not write large test file", !failed);
+
+	return true;
+}
+
+bool MavlinkFtpTest::_open_large_test_file(uint8_t &session)
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+
+	payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+	payload.offset = 0;
+	payload.size = strlen(_large_test_file) + 1;
+
+	bool success = _send_receive_msg(&payload,			// FTP payload header
+					 (uint8_t *)_large_test_file,	// Data to start into FTP message payload
+					 payload.size,			// size in bytes of data
+					 &reply);			// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	ut_compare("File size incorrect", *((uint32_t *)&reply->data[0]), _large_test_file_size);
+
+	session = reply->session;
+
+	return true;
+}
+
+bool MavlinkFtpTest::_read_large_test_file(uint8_t session, uint32_t offset, uint8_t size)
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+
+	payload.opcode = MavlinkFTP::kCmdReadFile;
+	payload.session = session;
+	payload.offset = offset;
+	payload.size = size;
+
+	bool success = _send_receive_msg(&payload,	// FTP payload header
+					 nullptr,	// Data to start into FTP message payload
+					 0,		// size in bytes of data
+					 &reply);	// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	// Reads stop at the end of the file
+	const uint32_t expected_size = _large_test_file_size - offset > size ? size : _large_test_file_size - offset;
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	ut_compare("Session incorrect", reply->session, session);
+	ut_compare("Offset incorrect", reply->offset, offset);
+	ut_compare("Payload size incorrect", reply->size, expected_size);
+
+	for (uint32_t i = 0; i < expected_size; i++) {
+		ut_compare("Payload content differs", reply->data[i], _large_test_file_byte(offset + i));
+	}
+
+	return true;
+}
+
+bool MavlinkFtpTest::_terminate_session(uint8_t session)
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+
+	payload.opcode = MavlinkFTP::kCmdTerminateSession;
+	payload.session = session;
+	payload.size = 0;
+
+	bool success = _send_receive_msg(&payload,	// FTP payload header
+					 nullptr,	// Data to start into FTP message payload
+					 0,		// size in bytes of data
+					 &reply);	// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	return true;
+}
+
+/// @brief Tests interleaved reads on all sessions open at once, each session keeps its own read-ahead buffer.
+bool MavlinkFtpTest::_read_concurrent_sessions_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+	uint8_t					sessions[MavlinkFTP::kMaxSessions];
+
+	if (!_create_large_test_file()) {
+		return false;
+	}
+
+	for (uint8_t i = 0; i < MavlinkFTP::kMaxSessions; i++) {
+		if (!_open_large_test_file(sessions[i])) {
+			return false;
+		}
+
+		for (uint8_t j = 0; j < i; j++) {
+			ut_assert("Session id used twice", sessions[i] != sessions[j]);
+		}
+	}
+
+	// No more sessions available
+	payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+	payload.offset = 0;
+	payload.size = strlen(_large_test_file) + 1;
+
+	bool success = _send_receive_msg(&payload,			// FTP payload header
+					 (uint8_t *)_large_test_file,	// Data to start into FTP message payload
+					 payload.size,			// size in bytes of data
+					 &reply);			// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Nak back", reply->opcode, MavlinkFTP::kRspNak);
+	ut_compare("Incorrect error code", reply->data[0], MavlinkFTP::kErrNoSessionsAvailable);
+
+	// Every session reads from another part of the file, the reads alternate between the sessions
+	for (uint32_t offset = 0; offset < _large_test_file_size; offset += MAX_DATA_LEN) {
+		for (uint8_t i = 0; i < MavlinkFTP::kMaxSessions; i++) {
+			const uint32_t session_offset = (offset + i * MavlinkFTP::kReadAheadLength / 2) % _large_test_file_size;
+
+			if (!_read_large_test_file(sessions[i], session_offset, MAX_DATA_LEN)) {
+				return false;
+			}
+		}
+	}
+
+	for (uint8_t i = 0; i < MavlinkFTP::kMaxSessions; i++) {
+		if (!_terminate_session(sessions[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// @brief Tests reads straddling the end of the read-ahead buffer and the end of the file.
+bool MavlinkFtpTest::_read_buffer_boundary_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+	uint8_t					session;
+
+	if (!_create_large_test_file() || !_open_large_test_file(session)) {
+		return false;
+	}
+
+	struct _testCase {
+		uint32_t	offset;	///< Read offset
+		uint8_t		size;	///< Requested read size
+	};
+	const struct _testCase rgTestCases[] = {
+		{ 0,								MAX_DATA_LEN },	// fills the read-ahead buffer
+		{ MavlinkFTP::kReadAheadLength - MAX_DATA_LEN / 2,		MAX_DATA_LEN },	// across the end of the buffer
+		{ MavlinkFTP::kReadAheadAlignment - 1,				MAX_DATA_LEN },	// back to the start of the file
+		{ MavlinkFTP::kReadAheadLength - 1,				2 },		// last byte of the buffer and one more
+		{ MavlinkFTP::kReadAheadLength,					MAX_DATA_LEN },	// exactly after the buffer
+		{ _large_test_file_size - MAX_DATA_LEN / 2,			MAX_DATA_LEN },	// across the end of the file
+		{ _large_test_file_size - 1,					MAX_DATA_LEN },	// last byte of the file
+	};
+
+	for (size_t i = 0; i < sizeof(rgTestCases) / sizeof(rgTestCases[0]); i++) {
+		if (!_read_large_test_file(session, rgTestCases[i].offset, rgTestCases[i].size)) {
+			return false;
+		}
+	}
+
+	// Reading at the end of the file
+	payload.opcode = MavlinkFTP::kCmdReadFile;
+	payload.session = session;
+	payload.offset = _large_test_file_size;
+	payload.size = MAX_DATA_LEN;
+
+	bool success = _send_receive_msg(&payload,	// FTP payload header
+					 nullptr,	// Data to start into FTP message payload
+					 0,		// size in bytes of data
+					 &reply);	// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Nak back", reply->opcode, MavlinkFTP::kRspNak);
+	ut_compare("Incorrect error code", reply->data[0], MavlinkFTP::kErrEOF);
+
+	return _terminate_session(session);
+}
+
 bool MavlinkFtpTest::_removedirectory_test()
 {
 	MavlinkFTP::PayloadHeader		payload {};
@@ -856,6 +1088,190 @@ bool MavlinkFtpTest::_removefile_test()
 	return true;
 }
 
+bool MavlinkFtpTest::_param_export_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+	MavlinkParametersExport::Header		header[2] {};
+	char					path[32];
+
+	// a full export first, then a delta against the hash it returned
+	for (size_t i = 0; i < 2; i++) {
+		if (i == 0) {
+			strncpy(path, "@PARAM/param.pck", sizeof(path));
+
+		} else {
+			snprintf(path, sizeof(path), "@PARAM/param.pck?since=%08x", (unsigned)header[0].hash);
+		}
+
+		payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+		payload.offset = 0;
+		payload.size = strlen(path) + 1;
+
+		bool success = _send_receive_msg(&payload,	// FTP payload header
+						 (uint8_t *)path,	// Data to start into FTP message payload
+						 payload.size,	// size in bytes of data
+						 &reply);	// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+		ut_assert("Export smaller than its header", *((uint32_t *)&reply->data[0]) >= sizeof(header[i]));
+
+		payload.opcode = MavlinkFTP::kCmdReadFile;
+		payload.session = reply->session;
+		payload.offset = 0;
+		payload.size = sizeof(header[i]);
+
+		success = _send_receive_msg(&payload,	// FTP payload header
+					    nullptr,	// Data to start into FTP message payload
+					    0,		// size in bytes of data
+					    &reply);	// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+		ut_compare("Payload size incorrect", reply->size, sizeof(header[i]));
+		memcpy(&header[i], reply->data, sizeof(header[i]));
+
+		ut_compare("Magic incorrect", header[i].magic, MavlinkParametersExport::kMagic);
+		ut_compare("Version incorrect", header[i].version, MavlinkParametersExport::kVersion);
+		ut_compare("Parameter count incorrect", header[i].param_count, param_count_used());
+		ut_assert("More entries than parameters", header[i].entry_count <= header[i].param_count);
+
+		payload.opcode = MavlinkFTP::kCmdTerminateSession;
+		payload.size = 0;
+
+		success = _send_receive_msg(&payload,	// FTP payload header
+					    nullptr,	// Data to start into FTP message payload
+					    0,		// size in bytes of data
+					    &reply);	// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	}
+
+	ut_compare("Full export flagged as delta", header[0].flags & MavlinkParametersExport::kFlagDelta, 0);
+	ut_compare("Full export contains all parameters", header[0].entry_count, header[0].param_count);
+	ut_assert("Delta export not flagged", header[1].flags & MavlinkParametersExport::kFlagDelta);
+	ut_compare("Delta base incorrect", header[1].base_hash, header[0].hash);
+
+	return true;
+}
+
+/// @brief Tests that a second export on the same link does not overwrite the file the first session serves.
+bool MavlinkFtpTest::_param_export_concurrent_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+	MavlinkParametersExport::Header		header {};
+	uint8_t					sessions[2];
+	uint32_t				full_size = 0;
+	char					path[32];
+
+	// a full export to take a delta against, then a full and a delta export open at the same time.
+	// Nothing is read from the full export before the delta is generated, so its read-ahead buffer holds no data yet.
+	for (size_t i = 0; i < 3; i++) {
+		if (i < 2) {
+			strncpy(path, "@PARAM/param.pck", sizeof(path));
+
+		} else {
+			snprintf(path, sizeof(path), "@PARAM/param.pck?since=%08x", (unsigned)header.hash);
+		}
+
+		payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+		payload.offset = 0;
+		payload.size = strlen(path) + 1;
+
+		bool success = _send_receive_msg(&payload,	// FTP payload header
+						 (uint8_t *)path,	// Data to start into FTP message payload
+						 payload.size,	// size in bytes of data
+						 &reply);	// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+		if (i == 0) {
+			payload.opcode = MavlinkFTP::kCmdReadFile;
+			payload.session = reply->session;
+			payload.offset = 0;
+			payload.size = sizeof(header);
+
+			success = _send_receive_msg(&payload,	// FTP payload header
+						    nullptr,	// Data to start into FTP message payload
+						    0,		// size in bytes of data
+						    &reply);	// Payload inside FTP message response
+
+			if (!success) {
+				return false;
+			}
+
+			ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+			ut_compare("Payload size incorrect", reply->size, sizeof(header));
+			memcpy(&header, reply->data, sizeof(header));
+
+			if (!_terminate_session(payload.session)) {
+				return false;
+			}
+
+		} else {
+			sessions[i - 1] = reply->session;
+
+			if (i == 1) {
+				full_size = *((uint32_t *)&reply->data[0]);
+			}
+		}
+	}
+
+	ut_assert("Sessions not distinct", sessions[0] != sessions[1]);
+	ut_assert("Export smaller than its header", full_size >= sizeof(header));
+
+	// the full export is still intact: a full header and data up to its last byte
+	const uint32_t offsets[] = {0, full_size - 1};
+
+	for (uint32_t offset : offsets) {
+		payload.opcode = MavlinkFTP::kCmdReadFile;
+		payload.session = sessions[0];
+		payload.offset = offset;
+		payload.size = offset == 0 ? sizeof(header) : 1;
+
+		bool success = _send_receive_msg(&payload,	// FTP payload header
+						 nullptr,	// Data to start into FTP message payload
+						 0,		// size in bytes of data
+						 &reply);	// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+		ut_compare("Payload size incorrect", reply->size, payload.size);
+
+		if (offset == 0) {
+			memcpy(&header, reply->data, sizeof(header));
+			ut_compare("Full export overwritten by delta", header.flags & MavlinkParametersExport::kFlagDelta, 0);
+		}
+	}
+
+	for (size_t i = 0; i < 2; i++) {
+		if (!_terminate_session(sessions[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /// Static method used as callback from MavlinkFTP for generic use. This method will be called by MavlinkFTP when
 /// it needs to send a message out on Mavlink.
 void MavlinkFtpTest::receive_message_handler_generic(const mavlink_file_transfer_protocol_t *ftp_req, void *worker_data)
@@ -1016,10 +1432,14 @@ bool MavlinkFtpTest::run_tests()
 	ut_run_test(_terminate_badsession_test);
 	ut_run_test(_read_test);
 	ut_run_test(_read_badsession_test);
+	ut_run_test(_read_concurrent_sessions_test);
+	ut_run_test(_read_buffer_boundary_test);
 	ut_run_test(_burst_test);
 	ut_run_test(_removedirectory_test);
 	ut_run_test(_createdirectory_test);
 	ut_run_test(_removefile_test);
+	ut_run_test(_param_export_test);
+	ut_run_test(_param_export_concurrent_test);
 
 	return (_tests_failed == 0);
 
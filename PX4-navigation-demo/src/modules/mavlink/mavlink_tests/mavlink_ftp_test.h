@@ -89,10 +89,14 @@ private:
 	bool _terminate_badsession_test(void);
 	bool _read_test(void);
 	bool _read_badsession_test(void);
+	bool _read_concurrent_sessions_test(void);
+	bool _read_buffer_boundary_test(void);
 	bool _burst_test(void);
 	bool _removedirectory_test(void);
 	bool _createdirectory_test(void);
 	bool _removefile_test(void);
+	bool _param_export_test(void);
+	bool _param_export_concurrent_test(void);
 
 	void _receive_message_handler_generic(const mavlink_file_transfer_protocol_t *ftp_req);
 	bool _setup_ftp_msg(const MavlinkFTP::PayloadHeader *payload_header,
@@ -105,6 +109,11 @@ private:
 			       const MavlinkFTP::PayloadHeader	**payload_reply);
 	void _cleanup_microsd(void);
 
+	bool _create_large_test_file(void);
+	bool _open_large_test_file(uint8_t &session);
+	bool _read_large_test_file(uint8_t session, uint32_t offset, uint8_t size);
+	bool _terminate_session(uint8_t session);
+
 	/// A single download test case
 	struct DownloadTestCase {
 		const char	*file;
@@ -132,6 +141,9 @@ private:
 
 	mavlink_file_transfer_protocol_t _reply_msg;
 
+	/// Size of the large test file, larger than the read-ahead buffer of a session
+	static constexpr uint32_t _large_test_file_size{MavlinkFTP::kReadAheadLength + MavlinkFTP::kReadAheadAlignment + 100};
+
 	static const char _unittest_microsd_dir[];
 	static const char _unittest_microsd_file[];
 };
@@ -75,6 +75,11 @@ MavlinkTimesync::handle_message(const mavlink_message_t *msg)
 			} else if (tsync.tc1 > 0) {		// Message originating from this system, compute time offset from it
 
 				_timesync.update(now, tsync.tc1, tsync.ts1);
+
+				if ((tsync.ts1 > 0) && (now > (uint64_t)tsync.ts1 / 1000ULL)) {
+					_round_trip_time.store((uint32_t)(now - tsync.ts1 / 1000ULL));
+					_round_trip_time_timestamp.store(now);
+				}
 			}
 
 			break;
@@ -111,3 +116,15 @@ MavlinkTimesync::handle_message(const mavlink_message_t *msg)
 		break;
 	}
 }
+
+uint32_t
+MavlinkTimesync::round_trip_time() const
+{
+	const hrt_abstime timestamp = _round_trip_time_timestamp.load();
+
+	if ((timestamp == 0) || (hrt_elapsed_time(&timestamp) > ROUND_TRIP_TIME_TIMEOUT)) {
+		return 0;
+	}
+
+	return _round_trip_time.load();
+}
@@ -43,6 +43,7 @@
 #include "mavlink_bridge_header.h"
 
 #include <lib/timesync/Timesync.hpp>
+#include <px4_platform_common/atomic.h>
 
 class Mavlink;
 
@@ -60,7 +61,19 @@ public:
 	 */
 	uint64_t sync_stamp(uint64_t usec) { return _timesync.sync_stamp(usec); }
 
+	/**
+	 * @return round trip time of the latest timesync exchange in us, 0 if there was none recently.
+	 * Can be called from any thread.
+	 */
+	uint32_t round_trip_time() const;
+
 private:
+	static constexpr hrt_abstime ROUND_TRIP_TIME_TIMEOUT = 5_s;
+
 	Mavlink &_mavlink;
 	Timesync _timesync{};
+
+	// written by the receive thread, read by the send thread
+	px4::atomic<uint32_t> _round_trip_time{0};
+	px4::atomic<hrt_abstime> _round_trip_time_timestamp{0};
 };
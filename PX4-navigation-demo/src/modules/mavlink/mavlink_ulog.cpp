@@ -79,7 +79,7 @@ void MavlinkULog::start_ack_received()
 	}
 }
 
-int MavlinkULog::handle_update(mavlink_channel_t channel)
+int MavlinkULog::handle_update(mavlink_channel_t channel, float rate_mult)
 {
 	static_assert(sizeof(ulog_stream_s::data) == MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN,
 		      "Invalid uorb ulog_stream.data length");
@@ -133,7 +133,9 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 	}
 
 
-	while ((_current_num_msgs < _max_num_messages) && _ulog_stream_sub.updated()) {
+	const int max_num_messages = math::max(1, (int)(_max_num_messages * rate_mult));
+
+	while ((_current_num_msgs < max_num_messages) && _ulog_stream_sub.updated()) {
 		const unsigned last_generation = _ulog_stream_sub.get_last_generation();
 		_ulog_stream_sub.update();
 
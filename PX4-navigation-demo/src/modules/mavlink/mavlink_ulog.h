@@ -88,9 +88,10 @@ public:
 
 	/**
 	 * periodic update method: check for ulog stream messages and handle retransmission.
+	 * @param rate_mult scales the maximum data rate down, e.g. on a congested link
 	 * @return 0 on success, <0 otherwise
 	 */
-	int handle_update(mavlink_channel_t channel);
+	int handle_update(mavlink_channel_t channel, float rate_mult = 1.f);
 
 	/** ack from mavlink for a data message */
 	void handle_ack(mavlink_logging_ack_t ack);
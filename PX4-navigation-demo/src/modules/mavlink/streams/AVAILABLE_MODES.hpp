@@ -58,6 +58,9 @@ public:
 		return _had_dynamic_update ? MAVLINK_MSG_ID_AVAILABLE_MODES_MONITOR_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	// update_data() collects data at every iteration
+	bool continuous_update() override { return true; }
+
 private:
 	/* Max 2.5 seconds delay for all possible modes to avoid ACK timeout in ground station */
 	static constexpr uint32_t MAX_DELAY_US = 2500000 / vehicle_status_s::NAVIGATION_STATE_MAX;
@@ -52,6 +52,8 @@ public:
 		return _debug_value_sub.advertised() ? MAVLINK_MSG_ID_DEBUG_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	Priority priority() override { return Priority::Bulk; }
+
 private:
 	explicit MavlinkStreamDebug(Mavlink *mavlink) : MavlinkStream(mavlink) {}
 
@@ -55,6 +55,9 @@ public:
 		return _esc_status_subs.advertised_count() * message_size;
 	}
 
+	// update_data() collects data at every iteration
+	bool continuous_update() override { return true; }
+
 private:
 	explicit MavlinkStreamESCStatus(Mavlink *mavlink) : MavlinkStream(mavlink) {}
 
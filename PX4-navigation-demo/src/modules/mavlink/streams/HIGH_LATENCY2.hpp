@@ -79,6 +79,9 @@ public:
 
 	bool const_rate() override { return true; }
 
+	// update_data() collects data at every iteration
+	bool continuous_update() override { return true; }
+
 private:
 	explicit MavlinkStreamHighLatency2(Mavlink *mavlink) :
 		MavlinkStream(mavlink),
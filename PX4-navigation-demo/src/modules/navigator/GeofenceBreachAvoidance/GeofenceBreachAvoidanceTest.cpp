@@ -183,6 +183,20 @@ TEST_F(GeofenceBreachAvoidanceTest, generateLoiterPointForMultirotor)
 
 	EXPECT_LE(error, 0.0f);
 
+	// vehicle is outside the altitude limits, the fence is violated at the current position
+	geo.setAltitudeLimitsViolated(true);
+
+	loiter_point = gf_avoidance.generateLoiterPointForMultirotor(gf_violation, &geo);
+	loiter_point_predicted = gf_avoidance.waypointFromBearingAndDistance(home_global, 0.0f,
+				 -gf_avoidance.getMinHorDistToFenceMulticopter());
+
+	error = get_distance_to_next_waypoint(loiter_point(0), loiter_point(1), loiter_point_predicted(0),
+					      loiter_point_predicted(1));
+
+	EXPECT_LE(error, 0.5f);
+
+	geo.setAltitudeLimitsViolated(false);
+
 	gf_violation.flags.fence_violation = false;
 	loiter_point = gf_avoidance.generateLoiterPointForMultirotor(gf_violation, &geo);
 
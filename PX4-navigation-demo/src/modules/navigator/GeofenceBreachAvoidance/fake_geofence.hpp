@@ -47,17 +47,15 @@ class FakeGeofence : public Geofence
 public:
 	FakeGeofence() :
 		Geofence(nullptr)
-	{};
+	{
+		setProbeFunctionBehavior(ProbeFunction::ALL_POINTS_OUTSIDE);
+	};
 
 	virtual ~FakeGeofence() {};
 
 	bool isInsidePolygonOrCircle(double lat, double lon, float altitude) override
 	{
 		switch (_probe_function_behavior) {
-		case ProbeFunction::ALL_POINTS_OUTSIDE: {
-				return _allPointsOutside(lat, lon, altitude);
-			}
-
 		case ProbeFunction::LEFT_INSIDE_RIGHT_OUTSIDE: {
 				return _left_inside_right_outside(lat, lon, altitude);
 			}
@@ -66,13 +64,26 @@ public:
 				return _right_inside_left_outside(lat, lon, altitude);
 			}
 
-		case ProbeFunction::GF_BOUNDARY_20M_AHEAD: {
-				return _gf_boundary_is_20m_north(lat, lon, altitude);
-			}
-
 		default:
-			return _allPointsOutside(lat, lon, altitude);
+			return isInsideAltitudeLimits(altitude) && _fence.checkAll(lat, lon);
+		}
+	}
+
+	bool isInsideAltitudeLimits(float altitude) override
+	{
+		return !_altitude_limits_violated;
+	}
+
+	bool getFirstBreachAlongPath(const matrix::Vector2<double> *path_lat_lon, int num_points,
+				     float &breach_distance) override
+	{
+		const GeofenceIndex::PathBreach breach = _fence.firstBreachAlongPath(path_lat_lon, num_points);
+
+		if (breach.breach) {
+			breach_distance = breach.distance;
 		}
+
+		return breach.breach;
 	}
 
 	enum class ProbeFunction {
@@ -82,19 +93,49 @@ public:
 		GF_BOUNDARY_20M_AHEAD
 	};
 
-	void setProbeFunctionBehavior(ProbeFunction func) {_probe_function_behavior = func;}
+	void setProbeFunctionBehavior(ProbeFunction func)
+	{
+		_probe_function_behavior = func;
+
+		// the fence is a real index, so that point and path queries agree
+		if (func == ProbeFunction::GF_BOUNDARY_20M_AHEAD) {
+			_setInclusionBox(-1000.f, -1000.f, 20.f, 1000.f);
+
+		} else {
+			// far away from the test positions
+			_setInclusionBox(5000.f, 5000.f, 5100.f, 5100.f);
+		}
+	}
+
+	void setAltitudeLimitsViolated(bool violated) { _altitude_limits_violated = violated; }
 
 
 private:
 
 	ProbeFunction _probe_function_behavior = ProbeFunction::ALL_POINTS_OUTSIDE;
 
+	GeofenceIndex _fence;
+	bool _altitude_limits_violated{false};
+
 	bool _flag_on_left = true;
 	bool _flag_on_right = false;
 
-	bool _allPointsOutside(double lat, double lon, float alt)
+	void _setInclusionBox(float min_north, float min_east, float max_north, float max_east)
 	{
-		return false;
+		const matrix::Vector2<double> home_global(42.1, 8.2);
+		const MapProjection projection{home_global(0), home_global(1)};
+		const float corners[4][2] {{min_north, min_east}, {max_north, min_east}, {max_north, max_east}, {min_north, max_east}};
+
+		_fence.reset(home_global(0), home_global(1));
+		_fence.beginPolygon(GeofenceIndex::ShapeType::PolygonInclusion);
+
+		for (const auto &corner : corners) {
+			double lat, lon;
+			projection.reproject(corner[0], corner[1], lat, lon);
+			_fence.addVertex(lat, lon);
+		}
+
+		_fence.endPolygon();
 	}
 
 	bool _left_inside_right_outside(double lat, double lon, float alt)
@@ -119,18 +160,4 @@ private:
 			return false;
 		}
 	}
-
-	bool _gf_boundary_is_20m_north(double lat, double lon, float alt)
-	{
-		matrix::Vector2<double> home_global(42.1, 8.2);
-
-		MapProjection projection{home_global(0), home_global(1)};
-		matrix::Vector2f waypoint_local = projection.project(lat, lon);
-
-		if (waypoint_local(0) >= 20.0f) {
-			return false;
-		}
-
-		return true;
-	}
 };
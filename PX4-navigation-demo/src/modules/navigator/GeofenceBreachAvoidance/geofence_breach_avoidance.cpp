@@ -152,25 +152,17 @@ GeofenceBreachAvoidance::generateLoiterPointForMultirotor(geofence_violation_typ
 {
 
 	if (violation_type.flags.fence_violation) {
-		float current_distance = _test_point_distance * 0.5f;
-		float current_min = 0.0f;
-		float current_max = _test_point_distance;
-		Vector2d test_point;
-
-		// binary search for the distance from the drone to the geofence in the given direction
-		while (fabsf(current_max - current_min) > 0.5f) {
-			test_point = waypointFromBearingAndDistance(_current_pos_lat_lon, _test_point_bearing, current_distance);
-
-			if (!geofence->isInsidePolygonOrCircle(test_point(0), test_point(1), _current_alt_amsl)) {
-				current_max = current_distance;
-
-			} else {
-				current_min = current_distance;
-			}
-
-			current_distance = (current_max + current_min) * 0.5f;
+		// distance from the drone to the geofence in the given direction
+		float current_distance = 0.f;
+
+		// the path query is horizontal only, outside the altitude limits the whole path violates the fence
+		if (geofence->isInsideAltitudeLimits(_current_alt_amsl)) {
+			const Vector2d path[2] {_current_pos_lat_lon, getFenceViolationTestPoint()};
+			current_distance = _test_point_distance;
+			geofence->getFirstBreachAlongPath(path, 2, current_distance);
 		}
 
+		Vector2d test_point;
 		test_point = waypointFromBearingAndDistance(_current_pos_lat_lon, _test_point_bearing, current_distance);
 
 		if (_multirotor_braking_distance > current_distance - _min_hor_dist_to_fence_mc) {
@@ -0,0 +1,210 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file MissionCostTable.cpp
+ */
+
+#include "MissionCostTable.hpp"
+
+#include <float.h>
+
+#include <mathlib/mathlib.h>
+#include <px4_platform_common/defines.h>
+
+MissionCostTable::~MissionCostTable()
+{
+	delete[] _prefix;
+}
+
+void MissionCostTable::update(const MissionModel &model, const mission_s &mission, float home_alt,
+			      const VehicleRates &rates, const matrix::Vector2f &wind)
+{
+	if (!model.isValidFor(mission) || model.numJumpItems() > 0) {
+		_valid = false;
+		return;
+	}
+
+	if (_valid && !inputsChanged(model, home_alt, rates, wind)) {
+		return;
+	}
+
+	_valid = false;
+	_rates = rates;
+	_wind = wind;
+	_home_alt = home_alt;
+	_generation = model.generation();
+
+	if (_max_size < model.numPositionItems()) {
+		delete[] _prefix;
+		_prefix = new Prefix[model.numPositionItems()];
+		_max_size = (_prefix != nullptr) ? model.numPositionItems() : 0;
+
+		if (_prefix == nullptr) {
+			return;
+		}
+	}
+
+	compute(model);
+	_valid = true;
+}
+
+bool MissionCostTable::inputsChanged(const MissionModel &model, float home_alt, const VehicleRates &rates,
+				     const matrix::Vector2f &wind) const
+{
+	const bool rates_changed = fabsf(rates.cruise_speed - _rates.cruise_speed) > FLT_EPSILON
+				   || fabsf(rates.climb_rate - _rates.climb_rate) > FLT_EPSILON
+				   || fabsf(rates.descend_rate - _rates.descend_rate) > FLT_EPSILON
+				   || fabsf(rates.land_descend_rate - _rates.land_descend_rate) > FLT_EPSILON
+				   || rates.fixed_wing != _rates.fixed_wing
+				   || rates.land_horizontal_first != _rates.land_horizontal_first;
+
+	// the wind only affects the ground speed of fixed-wing vehicles
+	const bool wind_changed = rates.fixed_wing && (wind - _wind).norm() > WIND_REFRESH_THRESHOLD;
+
+	return model.generation() != _generation || rates_changed || wind_changed || fabsf(home_alt - _home_alt) > FLT_EPSILON;
+}
+
+void MissionCostTable::compute(const MissionModel &model)
+{
+	_size = model.numPositionItems();
+
+	for (int i = 0; i < _size; ++i) {
+		const MissionModel::PositionItem &item = model.positionItemAt(i);
+		Prefix &prefix = _prefix[i];
+
+		if (i == 0) {
+			prefix.forward = 0.f;
+			prefix.reverse = 0.f;
+			prefix.wait = 0.f;
+			prefix.forward_infeasible = 0u;
+			prefix.reverse_infeasible = 0u;
+			prefix.unlimited_loiters = 0u;
+
+		} else {
+			const MissionModel::PositionItem &previous = model.positionItemAt(i - 1);
+			const float vert_dist = item.absoluteAltitude(_home_alt) - previous.absoluteAltitude(_home_alt);
+			const float leg_distance = model.legDistance(i);
+			const float leg_bearing = model.legBearing(i);
+
+			const float forward = legTime(item.nav_cmd, item.loiter_radius, leg_distance, leg_bearing, vert_dist);
+
+			// flying back, every item is a plain waypoint
+			const float reverse = legTime(NAV_CMD_WAYPOINT, 0.f, leg_distance, matrix::wrap_pi(leg_bearing + M_PI_F), -vert_dist);
+
+			// an infeasible leg is counted instead of summed, a NAN would spoil all later entries
+			prefix = _prefix[i - 1];
+			addLegTime(forward, prefix.forward, prefix.forward_infeasible);
+			addLegTime(reverse, prefix.reverse, prefix.reverse_infeasible);
+		}
+
+		if (item.nav_cmd == NAV_CMD_LOITER_TIME_LIMIT && item.time_inside > FLT_EPSILON) {
+			prefix.wait += item.time_inside;
+
+		} else if (item.nav_cmd == NAV_CMD_LOITER_UNLIMITED) {
+			++prefix.unlimited_loiters;
+		}
+	}
+}
+
+void MissionCostTable::addLegTime(float leg_time, float &sum, uint16_t &infeasible)
+{
+	if (PX4_ISFINITE(leg_time)) {
+		sum += leg_time;
+
+	} else {
+		++infeasible;
+	}
+}
+
+float MissionCostTable::legTime(uint16_t nav_cmd, float loiter_radius, float hor_dist, float bearing,
+				float vert_dist) const
+{
+	if (_rates.fixed_wing && (nav_cmd == NAV_CMD_LOITER_TIME_LIMIT || nav_cmd == NAV_CMD_LOITER_TO_ALT)) {
+		// the loiter circle is entered at its radius
+		hor_dist = math::max(0.f, hor_dist - loiter_radius);
+	}
+
+	const float hor_time = (hor_dist > FLT_EPSILON) ? hor_dist / groundSpeed(bearing) : 0.f;
+
+	if (!PX4_ISFINITE(hor_time)) {
+		// math::max() would drop the NAN
+		return NAN;
+	}
+
+	switch (nav_cmd) {
+	case NAV_CMD_LOITER_TIME_LIMIT:
+		// the altitude is changed while loitering
+		return hor_time;
+
+	case NAV_CMD_LOITER_TO_ALT:
+		return hor_time + vertTime(vert_dist, _rates.descend_rate);
+
+	case NAV_CMD_LAND:
+	case NAV_CMD_VTOL_LAND:
+		if (_rates.land_horizontal_first) {
+			return hor_time + vertTime(vert_dist, _rates.land_descend_rate);
+		}
+
+		return math::max(hor_time, vertTime(vert_dist, _rates.descend_rate));
+
+	default:
+		return math::max(hor_time, vertTime(vert_dist, _rates.descend_rate));
+	}
+}
+
+float MissionCostTable::groundSpeed(float bearing) const
+{
+	if (!_rates.fixed_wing) {
+		return _rates.cruise_speed;
+	}
+
+	const matrix::Vector2f direction{cosf(bearing), sinf(bearing)};
+	const float wind_along_dir = _wind.dot(direction);
+	const float wind_across_dir = matrix::Vector2f(_wind - direction * wind_along_dir).norm();
+
+	// like RtlTimeEstimator, don't rely on tailwind
+	const float ground_speed = sqrtf(_rates.cruise_speed * _rates.cruise_speed - wind_across_dir * wind_across_dir)
+				   + fminf(0.f, wind_along_dir);
+
+	// no progress against the wind
+	return (ground_speed > FLT_EPSILON) ? ground_speed : NAN;
+}
+
+float MissionCostTable::vertTime(float vert_dist, float descend_rate) const
+{
+	if (fabsf(vert_dist) <= FLT_EPSILON) {
+		return 0.f;
+	}
+
+	return fabsf(vert_dist) / ((vert_dist > 0.f) ? _rates.climb_rate : descend_rate);
+}
@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file MissionCostTable.hpp
+ *
+ * Prefix sums of the flight time along the legs of a mission model.
+ *
+ * The time of every leg between consecutive position items is computed once from the vehicle
+ * rates and the wind, for both flight directions, and accumulated along the mission. The time to
+ * fly from one position item to another is then the difference of two table entries, so the RTL
+ * time estimate of the mission based RTL types does not depend on the mission length. The table
+ * is only recomputed when the mission model, the rates or the home altitude change, or when the
+ * wind changed by more than WIND_REFRESH_THRESHOLD.
+ *
+ * Legs follow the mission order, missions with DO_JUMP items are not supported.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include <matrix/math.hpp>
+
+#include "../MissionModel/MissionModel.hpp"
+
+class MissionCostTable
+{
+public:
+	/**
+	 * Wind change [m/s] above which the leg times are recomputed
+	 */
+	static constexpr float WIND_REFRESH_THRESHOLD{0.5f};
+
+	struct VehicleRates {
+		float cruise_speed{NAN};		///< horizontal cruise speed [m/s], airspeed for fixed-wing
+		float climb_rate{NAN};			///< [m/s]
+		float descend_rate{NAN};		///< [m/s]
+		float land_descend_rate{NAN};		///< descend rate of landing legs [m/s]
+		bool fixed_wing{false};			///< apply the wind and the loiter radius
+		bool land_horizontal_first{false};	///< landing legs are flown horizontally, then vertically
+	};
+
+	MissionCostTable() = default;
+	~MissionCostTable();
+
+	MissionCostTable(const MissionCostTable &) = delete;
+	MissionCostTable &operator=(const MissionCostTable &) = delete;
+
+	/**
+	 * Recompute the table if any of the inputs changed.
+	 * @param wind horizontal wind (north, east) [m/s]
+	 */
+	void update(const MissionModel &model, const mission_s &mission, float home_alt, const VehicleRates &rates,
+		    const matrix::Vector2f &wind);
+
+	/**
+	 * @return true if the table matches the model of the last update
+	 */
+	bool isValid() const { return _valid; }
+
+	/**
+	 * Time of a single leg with the rules of the target item, used for legs starting off the mission.
+	 * Loiter times are not included (see waitTime()).
+	 * @param nav_cmd navigation command of the target item
+	 * @param loiter_radius loiter radius of the target item [m]
+	 * @param hor_dist horizontal distance [m]
+	 * @param bearing bearing towards the target [rad]
+	 * @param vert_dist altitude change, positive up [m]
+	 * @return leg time [s], NAN if the target cannot be reached against the wind
+	 */
+	float legTime(uint16_t nav_cmd, float loiter_radius, float hor_dist, float bearing, float vert_dist) const;
+
+	/**
+	 * @return time to fly the legs from position item from_index to position item to_index (from_index <= to_index) [s],
+	 * NAN if one of these legs cannot be flown against the wind
+	 */
+	float forwardTime(int from_index, int to_index) const
+	{
+		if (_prefix[to_index].forward_infeasible > _prefix[from_index].forward_infeasible) {
+			return NAN;
+		}
+
+		return _prefix[to_index].forward - _prefix[from_index].forward;
+	}
+
+	/**
+	 * @return time to fly the legs backwards from position item from_index to position item to_index (from_index >= to_index) [s],
+	 * NAN if one of these legs cannot be flown against the wind
+	 */
+	float reverseTime(int from_index, int to_index) const
+	{
+		if (_prefix[from_index].reverse_infeasible > _prefix[to_index].reverse_infeasible) {
+			return NAN;
+		}
+
+		return _prefix[from_index].reverse - _prefix[to_index].reverse;
+	}
+
+	/**
+	 * @return sum of the loiter times of the position items from_index to to_index, both included [s]
+	 */
+	float waitTime(int from_index, int to_index) const
+	{
+		return _prefix[to_index].wait - (from_index > 0 ? _prefix[from_index - 1].wait : 0.f);
+	}
+
+	/**
+	 * @return true if one of the position items from_index to to_index (both included) is an unlimited loiter
+	 */
+	bool containsUnlimitedLoiter(int from_index, int to_index) const
+	{
+		return _prefix[to_index].unlimited_loiters > (from_index > 0 ? _prefix[from_index - 1].unlimited_loiters : 0u);
+	}
+
+	int size() const { return _size; }
+
+private:
+	struct Prefix {
+		float forward;			///< time of the feasible legs up to this item, flown in mission order [s]
+		float reverse;			///< time of the feasible legs up to this item, flown backwards [s]
+		float wait;			///< loiter time of the items up to this one [s]
+		uint16_t forward_infeasible;	///< number of legs up to this item without a finite time in mission order
+		uint16_t reverse_infeasible;	///< number of legs up to this item without a finite time flown backwards
+		uint16_t unlimited_loiters;	///< number of unlimited loiters up to this item
+	};
+
+	bool inputsChanged(const MissionModel &model, float home_alt, const VehicleRates &rates,
+			   const matrix::Vector2f &wind) const;
+
+	void compute(const MissionModel &model);
+
+	static void addLegTime(float leg_time, float &sum, uint16_t &infeasible);
+
+	float groundSpeed(float bearing) const;
+	float vertTime(float vert_dist, float descend_rate) const;
+
+	Prefix *_prefix{nullptr};
+	int _size{0};
+	int _max_size{0};
+
+	VehicleRates _rates{};
+	matrix::Vector2f _wind{};
+	float _home_alt{NAN};
+	uint32_t _generation{0};
+	bool _valid{false};
+};
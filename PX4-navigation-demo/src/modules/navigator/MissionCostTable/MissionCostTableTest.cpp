@@ -0,0 +1,295 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include <lib/geo/geo.h>
+
+#include "MissionCostTable.hpp"
+
+static constexpr double kRefLat = 47.397742;
+static constexpr double kRefLon = 8.545594;
+static constexpr float kHomeAlt = 400.f;
+
+class MissionCostTableTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_proj.initReference(kRefLat, kRefLon);
+		_num_items = 0;
+
+		_rates.cruise_speed = 10.f;
+		_rates.climb_rate = 2.f;
+		_rates.descend_rate = 1.f;
+		_rates.land_descend_rate = 0.5f;
+	}
+
+	// add a position item given in local coordinates around the reference
+	mission_item_s &addItem(float x, float y, float altitude, uint16_t nav_cmd = NAV_CMD_WAYPOINT)
+	{
+		mission_item_s &item = _items[_num_items++];
+		item = {};
+		item.nav_cmd = nav_cmd;
+		_proj.reproject(x, y, item.lat, item.lon);
+		item.altitude = altitude;
+		item.altitude_is_relative = true;
+		return item;
+	}
+
+	bool build()
+	{
+		_mission = {};
+		_mission.count = _num_items;
+		_mission.mission_id = 42;
+
+		_model.beginBuild(_mission);
+
+		for (int i = 0; i < _num_items; ++i) {
+			if (!_model.addItem(_items[i], _items[i].nav_cmd != NAV_CMD_DO_JUMP)) {
+				return false;
+			}
+		}
+
+		return _model.endBuild();
+	}
+
+	void update(const matrix::Vector2f &wind = {})
+	{
+		_table.update(_model, _mission, kHomeAlt, _rates, wind);
+	}
+
+	// time of the legs from item from to item to, summed leg by leg
+	float sumLegs(int from, int to, bool reverse)
+	{
+		float sum = 0.f;
+
+		for (int i = from + 1; i <= to; ++i) {
+			const MissionModel::PositionItem &item = _model.positionItemAt(i);
+			const float vert_dist = item.absoluteAltitude(kHomeAlt) - _model.positionItemAt(i - 1).absoluteAltitude(kHomeAlt);
+
+			if (reverse) {
+				sum += _table.legTime(NAV_CMD_WAYPOINT, 0.f, _model.legDistance(i), matrix::wrap_pi(_model.legBearing(i) + M_PI_F),
+						      -vert_dist);
+
+			} else {
+				sum += _table.legTime(item.nav_cmd, item.loiter_radius, _model.legDistance(i), _model.legBearing(i), vert_dist);
+			}
+		}
+
+		return sum;
+	}
+
+	MapProjection _proj;
+	mission_item_s _items[32];
+	int _num_items{0};
+	mission_s _mission{};
+	MissionModel _model;
+	MissionCostTable::VehicleRates _rates{};
+	MissionCostTable _table;
+};
+
+TEST_F(MissionCostTableTest, invalidModel)
+{
+	addItem(0.f, 0.f, 50.f);
+	addItem(100.f, 0.f, 50.f);
+	ASSERT_TRUE(build());
+
+	mission_s other_mission = _mission;
+	other_mission.mission_id = 43;
+	_table.update(_model, other_mission, kHomeAlt, _rates, {});
+	EXPECT_FALSE(_table.isValid());
+
+	// jumps are not unrolled
+	mission_item_s &jump = _items[_num_items++];
+	jump = {};
+	jump.nav_cmd = NAV_CMD_DO_JUMP;
+	jump.do_jump_mission_index = 0;
+	jump.do_jump_repeat_count = 2;
+	ASSERT_TRUE(build());
+	update();
+	EXPECT_FALSE(_table.isValid());
+}
+
+TEST_F(MissionCostTableTest, legRules)
+{
+	addItem(0.f, 0.f, 50.f);
+	ASSERT_TRUE(build());
+	update();
+	ASSERT_TRUE(_table.isValid());
+
+	// the slower of horizontal and vertical motion
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_WAYPOINT, 0.f, 100.f, 0.f, 10.f), 10.f);
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_WAYPOINT, 0.f, 100.f, 0.f, -20.f), 20.f);
+	// horizontal and vertical motion in sequence
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_LOITER_TO_ALT, 30.f, 100.f, 0.f, 10.f), 15.f);
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_LOITER_TIME_LIMIT, 30.f, 100.f, 0.f, 10.f), 10.f);
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_LOITER_UNLIMITED, 0.f, 100.f, 0.f, 0.f), 10.f);
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_LAND, 0.f, 100.f, 0.f, -20.f), 20.f);
+
+	_rates.fixed_wing = true;
+	_rates.land_horizontal_first = true;
+	update();
+	ASSERT_TRUE(_table.isValid());
+
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_LAND, 0.f, 100.f, 0.f, -20.f), 50.f);
+	// fixed-wing enters the loiter circle at its radius
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_LOITER_TO_ALT, 30.f, 100.f, 0.f, 10.f), 12.f);
+}
+
+TEST_F(MissionCostTableTest, wind)
+{
+	addItem(0.f, 0.f, 50.f);
+	ASSERT_TRUE(build());
+
+	_rates.fixed_wing = true;
+	update(matrix::Vector2f{-5.f, 0.f});
+	ASSERT_TRUE(_table.isValid());
+
+	// headwind slows down, tailwind is not relied on
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_WAYPOINT, 0.f, 100.f, 0.f, 0.f), 20.f);
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_WAYPOINT, 0.f, 100.f, M_PI_F, 0.f), 10.f);
+
+	// crosswind
+	update(matrix::Vector2f{0.f, 6.f});
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_WAYPOINT, 0.f, 100.f, 0.f, 0.f), 12.5f);
+
+	// small changes of the wind are ignored
+	update(matrix::Vector2f{0.f, 6.3f});
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_WAYPOINT, 0.f, 100.f, 0.f, 0.f), 12.5f);
+
+	// no progress against the wind
+	update(matrix::Vector2f{-12.f, 0.f});
+	EXPECT_FALSE(PX4_ISFINITE(_table.legTime(NAV_CMD_WAYPOINT, 0.f, 100.f, 0.f, 0.f)));
+
+	// the wind is ignored for other vehicles
+	_rates.fixed_wing = false;
+	update(matrix::Vector2f{-5.f, 0.f});
+	EXPECT_FLOAT_EQ(_table.legTime(NAV_CMD_WAYPOINT, 0.f, 100.f, 0.f, 0.f), 10.f);
+}
+
+TEST_F(MissionCostTableTest, prefixSums)
+{
+	addItem(0.f, 0.f, 50.f, NAV_CMD_TAKEOFF);
+	addItem(300.f, 0.f, 80.f);
+	addItem(300.f, 400.f, 80.f, NAV_CMD_LOITER_TIME_LIMIT).time_inside = 30.f;
+	addItem(-200.f, 250.f, 40.f, NAV_CMD_LOITER_TO_ALT).loiter_radius = 60.f;
+	addItem(-100.f, -200.f, 120.f);
+	addItem(0.f, 0.f, 0.f, NAV_CMD_LAND);
+	ASSERT_TRUE(build());
+
+	_rates.fixed_wing = true;
+	_rates.land_horizontal_first = true;
+
+	const matrix::Vector2f winds[] {{0.f, 0.f}, {3.f, -4.f}, {-6.f, 2.f}};
+
+	for (const matrix::Vector2f &wind : winds) {
+		update(wind);
+		ASSERT_TRUE(_table.isValid());
+		ASSERT_EQ(_table.size(), 6);
+
+		for (int from = 0; from < _table.size(); ++from) {
+			for (int to = from; to < _table.size(); ++to) {
+				EXPECT_NEAR(_table.forwardTime(from, to), sumLegs(from, to, false), 1e-3f);
+				EXPECT_NEAR(_table.reverseTime(to, from), sumLegs(from, to, true), 1e-3f);
+			}
+		}
+	}
+
+	EXPECT_FLOAT_EQ(_table.waitTime(0, 5), 30.f);
+	EXPECT_FLOAT_EQ(_table.waitTime(2, 2), 30.f);
+	EXPECT_FLOAT_EQ(_table.waitTime(3, 5), 0.f);
+	EXPECT_FALSE(_table.containsUnlimitedLoiter(0, 5));
+}
+
+TEST_F(MissionCostTableTest, infeasibleLeg)
+{
+	// GIVEN: a mission flying south, north and south again
+	addItem(0.f, 0.f, 50.f);
+	addItem(-100.f, 0.f, 50.f);
+	addItem(0.f, 0.f, 50.f);
+	addItem(-100.f, 0.f, 50.f);
+	ASSERT_TRUE(build());
+
+	// WHEN: a fixed-wing can't make progress against the northerly wind
+	_rates.fixed_wing = true;
+	update(matrix::Vector2f{-12.f, 0.f});
+	ASSERT_TRUE(_table.isValid());
+
+	// THEN: only the ranges containing a leg north have no time
+	EXPECT_NEAR(_table.forwardTime(0, 1), 10.f, 1e-2f);
+	EXPECT_NEAR(_table.forwardTime(2, 3), 10.f, 1e-2f);
+	EXPECT_FALSE(PX4_ISFINITE(_table.forwardTime(1, 2)));
+	EXPECT_FALSE(PX4_ISFINITE(_table.forwardTime(0, 3)));
+
+	EXPECT_NEAR(_table.reverseTime(2, 1), 10.f, 1e-2f);
+	EXPECT_FALSE(PX4_ISFINITE(_table.reverseTime(1, 0)));
+	EXPECT_FALSE(PX4_ISFINITE(_table.reverseTime(3, 2)));
+	EXPECT_FLOAT_EQ(_table.reverseTime(3, 3), 0.f);
+}
+
+TEST_F(MissionCostTableTest, unlimitedLoiter)
+{
+	addItem(0.f, 0.f, 50.f);
+	addItem(100.f, 0.f, 50.f, NAV_CMD_LOITER_UNLIMITED);
+	addItem(200.f, 0.f, 50.f);
+	addItem(300.f, 0.f, 50.f);
+	ASSERT_TRUE(build());
+	update();
+	ASSERT_TRUE(_table.isValid());
+
+	// the loiter only counts as a wait, flying through it is fine
+	EXPECT_TRUE(PX4_ISFINITE(_table.forwardTime(0, 3)));
+	EXPECT_TRUE(_table.containsUnlimitedLoiter(0, 3));
+	EXPECT_TRUE(_table.containsUnlimitedLoiter(1, 1));
+	EXPECT_FALSE(_table.containsUnlimitedLoiter(2, 3));
+	EXPECT_FALSE(_table.containsUnlimitedLoiter(0, 0));
+}
+
+TEST_F(MissionCostTableTest, rebuild)
+{
+	addItem(0.f, 0.f, 50.f);
+	addItem(100.f, 0.f, 50.f);
+	ASSERT_TRUE(build());
+	update();
+	ASSERT_TRUE(_table.isValid());
+	EXPECT_NEAR(_table.forwardTime(0, 1), 10.f, 1e-2f);
+
+	addItem(100.f, 200.f, 50.f);
+	ASSERT_TRUE(build());
+	update();
+	ASSERT_TRUE(_table.isValid());
+	ASSERT_EQ(_table.size(), 3);
+	EXPECT_NEAR(_table.forwardTime(0, 2), 30.f, 1e-2f);
+}
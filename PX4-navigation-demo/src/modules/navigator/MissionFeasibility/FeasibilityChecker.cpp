@@ -62,6 +62,8 @@ void FeasibilityChecker::reset()
 	_last_lat = (double)NAN;
 	_last_lon = (double)NAN;
 	_last_cmd = -1;
+
+	_has_previous_leg_vertex = false;
 }
 
 void FeasibilityChecker::updateData()
@@ -148,6 +150,7 @@ bool FeasibilityChecker::processNextItem(mission_item_s &mission_item, const int
 	if (current_index == 0) {
 		reset();
 		updateData();
+		beginLegCheck(total_count);
 	}
 
 	if (!_checks_failed.flags.mission_validity_failed) {
@@ -173,6 +176,10 @@ bool FeasibilityChecker::processNextItem(mission_item_s &mission_item, const int
 
 	if (current_index == total_count - 1) {
 		_checks_failed.flags.takeoff_land_available_failed = !checkTakeoffLandAvailable();
+
+		if (!_checks_failed.flags.geofence_leg_failed) {
+			_checks_failed.flags.geofence_leg_failed = !checkJumpLegsAgainstGeofence();
+		}
 	}
 
 	_mission_item_previous = mission_item;
@@ -191,6 +198,10 @@ void FeasibilityChecker::doCommonChecks(mission_item_s &mission_item, const int
 		checkHorizontalDistanceToFirstWaypoint(mission_item);
 	}
 
+	if (!_checks_failed.flags.geofence_leg_failed) {
+		_checks_failed.flags.geofence_leg_failed = !checkLegAgainstGeofence(mission_item, current_index);
+	}
+
 	if (!_checks_failed.flags.takeoff_failed) {
 		_checks_failed.flags.takeoff_failed = !checkTakeoff(mission_item);
 	}
@@ -697,6 +708,107 @@ bool FeasibilityChecker::checkDistancesBetweenWaypoints(const mission_item_s &mi
 	return true;
 }
 
+void FeasibilityChecker::beginLegCheck(const int total_count)
+{
+	if (_geofence_index == nullptr) {
+		return;
+	}
+
+	mission_s mission{};
+	mission.count = total_count;
+	_leg_model.beginBuild(mission);
+
+	// the first leg is flown from home (where the takeoff starts) to the first position item
+	if (_home_lat_lon.isAllFinite()) {
+		_previous_leg_vertex = _geofence_index->project(_home_lat_lon(0), _home_lat_lon(1));
+		_has_previous_leg_vertex = true;
+	}
+}
+
+bool FeasibilityChecker::checkLegAgainstGeofence(const mission_item_s &mission_item, const int current_index)
+{
+	if (_geofence_index == nullptr) {
+		return true;
+	}
+
+	// a failed add lets endBuild() fail, the jump legs are not checked then
+	const bool contains_position = MissionBlock::item_contains_position(mission_item);
+	_leg_model.addItem(mission_item, contains_position);
+
+	if (!contains_position) {
+		return true;
+	}
+
+	// every position is projected once and shared by the legs before and after it
+	const GeofenceIndex::Vertex vertex = _geofence_index->project(mission_item.lat, mission_item.lon);
+
+	if (_has_previous_leg_vertex) {
+		float fraction;
+
+		if (_geofence_index->firstCrossedShape(_previous_leg_vertex, vertex, fraction) >= 0) {
+			mavlink_log_critical(_mavlink_log_pub, "Geofence violation on the way to waypoint %d\t", current_index + 1);
+			events::send<int16_t>(events::ID("navigator_mis_geofence_leg_violation"), {events::Log::Error, events::LogInternal::Info},
+					      "Geofence violation on the way to waypoint {1}", current_index + 1);
+			return false;
+		}
+	}
+
+	_previous_leg_vertex = vertex;
+	_has_previous_leg_vertex = true;
+
+	return true;
+}
+
+bool FeasibilityChecker::checkJumpLegsAgainstGeofence()
+{
+	if ((_geofence_index == nullptr) || (_leg_model.numJumpItems() == 0) || !_leg_model.endBuild()) {
+		return true;
+	}
+
+	for (int i = 0; i < _leg_model.numJumpItems(); ++i) {
+		const MissionModel::JumpItem &jump = _leg_model.jumpItemAt(i);
+
+		if ((jump.target < 0) || (jump.current_count >= jump.repeat_count)) {
+			// the mission continues after the jump, that leg was already checked
+			continue;
+		}
+
+		int32_t target_index;
+
+		if (_leg_model.nextPositionItems(jump.target, &target_index, 1) == 0) {
+			continue;
+		}
+
+		const int previous_position = _leg_model.lowerBoundPosition(jump.mission_index) - 1;
+		GeofenceIndex::Vertex from;
+
+		if (previous_position >= 0) {
+			const MissionModel::PositionItem &position = _leg_model.positionItemAt(previous_position);
+			from = _geofence_index->project(position.latitude(), position.longitude());
+
+		} else if (_home_lat_lon.isAllFinite()) {
+			from = _geofence_index->project(_home_lat_lon(0), _home_lat_lon(1));
+
+		} else {
+			continue;
+		}
+
+		const MissionModel::PositionItem *target = _leg_model.positionItem(target_index);
+		const GeofenceIndex::Vertex to = _geofence_index->project(target->latitude(), target->longitude());
+		float fraction;
+
+		if (_geofence_index->firstCrossedShape(from, to, fraction) >= 0) {
+			mavlink_log_critical(_mavlink_log_pub, "Geofence violation on the jump from item %d to waypoint %d\t",
+					     jump.mission_index + 1, target_index + 1);
+			events::send<int16_t, int16_t>(events::ID("navigator_mis_geofence_jump_leg_violation"), {events::Log::Error, events::LogInternal::Info},
+						       "Geofence violation on the jump from item {1} to waypoint {2}", jump.mission_index + 1, target_index + 1);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool FeasibilityChecker::checkItemsFitToVehicleType(const mission_item_s &mission_item)
 {
 	if (_vehicle_type != VehicleType::Vtol &&
@@ -34,6 +34,8 @@
 #pragma once
 
 #include "../navigation.h"
+#include "../MissionModel/MissionModel.hpp"
+#include <lib/geofence/GeofenceIndex.hpp>
 #include <mathlib/mathlib.h>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/rtl_status.h>
@@ -72,6 +74,21 @@ public:
 		_mavlink_log_pub = mavlink_log_pub;
 	}
 
+	/**
+	 * @brief Set the geofence the mission legs are checked against
+	 *
+	 * The legs are formed in flight order: from home to the first position item, between
+	 * consecutive position items and from the position before a DO_JUMP to its target. Each
+	 * leg is intersected exactly with the polygon and circle boundaries of the fence. The
+	 * index has to stay unchanged until the last item of the mission was processed.
+	 *
+	 * @param geofence_index The compiled geofence, nullptr disables the leg check
+	*/
+	void setGeofence(const GeofenceIndex *geofence_index)
+	{
+		_geofence_index = geofence_index;
+	}
+
 	/**
 	 * @return True At least one check failed.
 	*/
@@ -114,6 +131,7 @@ private:
 			bool fixed_wing_land_approach_failed : 1;
 			bool takeoff_land_available_failed : 1;
 			bool items_fit_to_vehicle_type_failed : 1;
+			bool geofence_leg_failed : 1;
 		} flags;
 		uint16_t value {0};
 	} _checks_failed{};
@@ -137,6 +155,12 @@ private:
 	double _last_lon{(double)NAN};
 	int _last_cmd{-1};
 
+	// internal checkLegAgainstGeofence variables
+	const GeofenceIndex *_geofence_index{nullptr};
+	GeofenceIndex::Vertex _previous_leg_vertex{};
+	bool _has_previous_leg_vertex{false};
+	MissionModel _leg_model; ///< position and jump items, the jump legs are checked once all items are known
+
 	/**
 	 * @brief Update data from external topics, e.g home position
 	*/
@@ -194,6 +218,32 @@ private:
 	*/
 	bool checkDistancesBetweenWaypoints(const mission_item_s &mission_item);
 
+	/**
+	 * @brief Start the leg check of a mission at the home position
+	 *
+	 * @param total_count The total number of mission items in the mission
+	*/
+	void beginLegCheck(const int total_count);
+
+	/**
+	 * @brief Check that the leg from the previous position item does not cross a geofence boundary
+	 *
+	 * @param mission_item The current mission item
+	 * @param current_index The current mission index
+	 * @return False if the check failed.
+	*/
+	bool checkLegAgainstGeofence(const mission_item_s &mission_item, const int current_index);
+
+	/**
+	 * @brief Check the legs of the DO_JUMP items against the geofence, once all items were processed
+	 *
+	 * A jump leg starts at the last position item before the jump (or home) and ends at the first
+	 * position item the jump resolves to, following chained jumps like the mission does.
+	 *
+	 * @return False if the check failed.
+	*/
+	bool checkJumpLegsAgainstGeofence();
+
 	/**
 	 * @brief Check fixed wing land approach (fixed wing only)
 	 *
@@ -211,6 +211,143 @@ TEST_F(FeasibilityCheckerTest, check_below_home)
 	ASSERT_EQ(checker.someCheckFailed(), true);
 }
 
+TEST_F(FeasibilityCheckerTest, check_leg_against_geofence)
+{
+	// GIVEN: an exclusion square of 20m x 20m, 100m north of home
+	TestFeasibilityChecker checker;
+	checker.publishLanded(true);
+	checker.publishHomePosition(0, 0, 0.f);
+
+	GeofenceIndex geofence_index;
+	geofence_index.reset(0., 0.);
+	MapProjection projection(0., 0.);
+	const float square[][2] = {{90.f, -10.f}, {110.f, -10.f}, {110.f, 10.f}, {90.f, 10.f}};
+	ASSERT_TRUE(geofence_index.beginPolygon(GeofenceIndex::ShapeType::PolygonExclusion));
+
+	for (const auto &point : square) {
+		double lat, lon;
+		projection.reproject(point[0], point[1], lat, lon);
+		ASSERT_TRUE(geofence_index.addVertex(lat, lon));
+	}
+
+	ASSERT_TRUE(geofence_index.endPolygon());
+
+	mission_item_s mission_item = {};
+	mission_item.nav_cmd = NAV_CMD_WAYPOINT;
+	mission_item.altitude = 10.f;
+	double lat_new, lon_new;
+
+	// WHEN: the leg between two waypoints passes east of the square
+	checker.setGeofence(&geofence_index);
+	projection.reproject(50.f, 20.f, lat_new, lon_new);
+	mission_item.lat = lat_new;
+	mission_item.lon = lon_new;
+	checker.processNextItem(mission_item, 0, 2);
+	projection.reproject(150.f, 20.f, lat_new, lon_new);
+	mission_item.lat = lat_new;
+	mission_item.lon = lon_new;
+	checker.processNextItem(mission_item, 1, 2);
+
+	// THEN: pass
+	ASSERT_EQ(checker.someCheckFailed(), false);
+
+	// BUT WHEN: the leg cuts through the square, both waypoints being outside of it
+	checker.publishLanded(true);
+	projection.reproject(50.f, 0.f, lat_new, lon_new);
+	mission_item.lat = lat_new;
+	mission_item.lon = lon_new;
+	checker.processNextItem(mission_item, 0, 2);
+	projection.reproject(150.f, 0.f, lat_new, lon_new);
+	mission_item.lat = lat_new;
+	mission_item.lon = lon_new;
+	checker.processNextItem(mission_item, 1, 2);
+
+	// THEN: fail
+	ASSERT_EQ(checker.someCheckFailed(), true);
+
+	// BUT WHEN: the same mission is checked without geofence
+	checker.setGeofence(nullptr);
+	checker.publishLanded(true);
+	projection.reproject(50.f, 0.f, lat_new, lon_new);
+	mission_item.lat = lat_new;
+	mission_item.lon = lon_new;
+	checker.processNextItem(mission_item, 0, 2);
+	projection.reproject(150.f, 0.f, lat_new, lon_new);
+	mission_item.lat = lat_new;
+	mission_item.lon = lon_new;
+	checker.processNextItem(mission_item, 1, 2);
+
+	// THEN: pass
+	ASSERT_EQ(checker.someCheckFailed(), false);
+}
+
+TEST_F(FeasibilityCheckerTest, check_legs_in_flight_order_against_geofence)
+{
+	// GIVEN: an exclusion square of 20m x 20m, 100m north of home
+	TestFeasibilityChecker checker;
+	checker.publishLanded(true);
+	checker.publishHomePosition(0, 0, 0.f);
+
+	GeofenceIndex geofence_index;
+	geofence_index.reset(0., 0.);
+	MapProjection projection(0., 0.);
+	const float square[][2] = {{90.f, -10.f}, {110.f, -10.f}, {110.f, 10.f}, {90.f, 10.f}};
+	ASSERT_TRUE(geofence_index.beginPolygon(GeofenceIndex::ShapeType::PolygonExclusion));
+
+	for (const auto &point : square) {
+		double lat, lon;
+		projection.reproject(point[0], point[1], lat, lon);
+		ASSERT_TRUE(geofence_index.addVertex(lat, lon));
+	}
+
+	ASSERT_TRUE(geofence_index.endPolygon());
+	checker.setGeofence(&geofence_index);
+
+	// waypoints south of, east of and north of the square, the legs between them pass east of it
+	const float waypoints[][2] = {{50.f, 0.f}, {150.f, 30.f}, {150.f, 0.f}};
+	mission_item_s items[4] {};
+
+	for (int i = 0; i < 3; i++) {
+		items[i].nav_cmd = NAV_CMD_WAYPOINT;
+		items[i].altitude = 10.f;
+		projection.reproject(waypoints[i][0], waypoints[i][1], items[i].lat, items[i].lon);
+	}
+
+	// WHEN: the last waypoint is followed by a jump back to the first one, which is never executed
+	items[3].nav_cmd = NAV_CMD_DO_JUMP;
+	items[3].do_jump_mission_index = 0;
+	items[3].do_jump_repeat_count = 0;
+
+	for (int i = 0; i < 4; i++) {
+		checker.processNextItem(items[i], i, 4);
+	}
+
+	// THEN: pass
+	ASSERT_EQ(checker.someCheckFailed(), false);
+
+	// BUT WHEN: the jump is executed, flying from north of the square straight through it back to the first waypoint
+	items[3].do_jump_repeat_count = 1;
+
+	for (int i = 0; i < 4; i++) {
+		checker.processNextItem(items[i], i, 4);
+	}
+
+	// THEN: fail
+	ASSERT_EQ(checker.someCheckFailed(), true);
+
+	// BUT WHEN: the mission starts with the waypoint north of the square, the first leg from home crossing it
+	checker.processNextItem(items[2], 0, 1);
+
+	// THEN: fail
+	ASSERT_EQ(checker.someCheckFailed(), true);
+
+	// BUT WHEN: the mission starts with the waypoint south of the square
+	checker.processNextItem(items[0], 0, 1);
+
+	// THEN: pass
+	ASSERT_EQ(checker.someCheckFailed(), false);
+}
+
 TEST_F(FeasibilityCheckerTest, check_takeoff)
 {
 	TestFeasibilityChecker checker;
@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file MissionItemChunkReader.hpp
+ *
+ * Reads consecutive mission items in chunks, with a single dataman range request per chunk.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "../navigation.h"
+
+class MissionItemChunkReader
+{
+public:
+	/**
+	 * @brief Number of mission items read with a single range request
+	 */
+	static constexpr uint16_t CHUNK_ITEMS{8u};
+
+	MissionItemChunkReader() = default;
+	~MissionItemChunkReader() = default;
+
+	MissionItemChunkReader(const MissionItemChunkReader &) = delete;
+	MissionItemChunkReader &operator=(const MissionItemChunkReader &) = delete;
+
+	/**
+	 * @brief Visit the mission items [first_index, first_index + count) in order
+	 *
+	 * The items are read into the chunk buffer of the reader, so a reader which is not on the stack keeps
+	 * the buffer off the stack of the calling task. Not reentrant: visit must not use the same reader.
+	 *
+	 * @param first_index Mission index of the first item
+	 * @param count Number of items
+	 * @param read bool(uint16_t first_index, uint16_t num_items, mission_item_s *items), reads a chunk
+	 * @param visit bool(mission_item_s &item, uint16_t index), returns false to stop before the next item
+	 * @return False if a chunk could not be read
+	 */
+	template<typename ReadChunk, typename VisitItem>
+	bool forEach(uint16_t first_index, uint16_t count, ReadChunk read, VisitItem visit)
+	{
+		for (uint32_t offset = 0u; offset < count; offset += CHUNK_ITEMS) {
+			const uint16_t chunk_start = static_cast<uint16_t>(first_index + offset);
+			const uint16_t chunk_count = static_cast<uint16_t>((count - offset < CHUNK_ITEMS) ? count - offset : CHUNK_ITEMS);
+
+			if (!read(chunk_start, chunk_count, _items)) {
+				return false;
+			}
+
+			for (uint16_t i = 0u; i < chunk_count; i++) {
+				if (!visit(_items[i], static_cast<uint16_t>(chunk_start + i))) {
+					return true;
+				}
+			}
+		}
+
+		return true;
+	}
+
+private:
+	mission_item_s _items[CHUNK_ITEMS];
+};
@@ -0,0 +1,173 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "MissionItemChunkReader.hpp"
+
+// to run: make tests TESTFILTER=MissionItemChunkReader
+class MissionItemChunkReaderTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		for (uint16_t i = 0u; i < kMaxItems; i++) {
+			_mission[i] = {};
+			_mission[i].nav_cmd = NAV_CMD_WAYPOINT;
+			_mission[i].lat = i; // tags the item with its index
+		}
+
+		_num_reads = 0;
+		_num_visited = 0;
+		_fail_read = -1;
+	}
+
+	// reads a chunk from the fake mission storage, like a dataman range request
+	bool read(uint16_t first_index, uint16_t num_items, mission_item_s *items)
+	{
+		EXPECT_GT(num_items, 0u);
+		EXPECT_LE(num_items, MissionItemChunkReader::CHUNK_ITEMS);
+		EXPECT_LE(first_index + num_items, kMaxItems);
+
+		if (_num_reads++ == _fail_read) {
+			return false;
+		}
+
+		for (uint16_t i = 0u; i < num_items; i++) {
+			items[i] = _mission[first_index + i];
+		}
+
+		return true;
+	}
+
+	// checks that the items are visited once, in order and with their own content
+	bool visit(const mission_item_s &item, uint16_t index, uint16_t first_index)
+	{
+		EXPECT_EQ(index, first_index + _num_visited);
+		EXPECT_EQ(item.lat, static_cast<double>(index));
+		_num_visited++;
+		return true;
+	}
+
+	bool forEach(uint16_t first_index, uint16_t count)
+	{
+		return _reader.forEach(first_index, count,
+		[this](uint16_t chunk_start, uint16_t num_items, mission_item_s * items) { return read(chunk_start, num_items, items); },
+		[this, first_index](mission_item_s & item, uint16_t index) { return visit(item, index, first_index); });
+	}
+
+	static constexpr uint16_t kMaxItems{40u};
+
+	MissionItemChunkReader _reader;
+	mission_item_s _mission[kMaxItems];
+	int _num_reads;
+	int _num_visited;
+	int _fail_read;
+};
+
+TEST_F(MissionItemChunkReaderTest, emptyRange)
+{
+	EXPECT_TRUE(forEach(0u, 0u));
+	EXPECT_EQ(_num_reads, 0);
+	EXPECT_EQ(_num_visited, 0);
+}
+
+TEST_F(MissionItemChunkReaderTest, partialChunk)
+{
+	// WHEN: reading less items than a chunk holds
+	EXPECT_TRUE(forEach(0u, 5u));
+
+	// THEN: a single range request reads all of them
+	EXPECT_EQ(_num_reads, 1);
+	EXPECT_EQ(_num_visited, 5);
+}
+
+TEST_F(MissionItemChunkReaderTest, fullChunks)
+{
+	// WHEN: reading exactly two chunks
+	EXPECT_TRUE(forEach(0u, 2u * MissionItemChunkReader::CHUNK_ITEMS));
+
+	// THEN: no empty range is requested after the last chunk
+	EXPECT_EQ(_num_reads, 2);
+	EXPECT_EQ(_num_visited, 2 * MissionItemChunkReader::CHUNK_ITEMS);
+}
+
+TEST_F(MissionItemChunkReaderTest, lastChunkPartial)
+{
+	// WHEN: reading a range which does not end at a chunk boundary
+	EXPECT_TRUE(forEach(0u, 2u * MissionItemChunkReader::CHUNK_ITEMS + 3u));
+
+	// THEN: the last range request only reads the remaining items
+	EXPECT_EQ(_num_reads, 3);
+	EXPECT_EQ(_num_visited, 2 * MissionItemChunkReader::CHUNK_ITEMS + 3);
+}
+
+TEST_F(MissionItemChunkReaderTest, rangeNotAtStart)
+{
+	// WHEN: reading a range which starts in the middle of the mission
+	EXPECT_TRUE(forEach(5u, 20u));
+
+	// THEN: the items keep their mission index
+	EXPECT_EQ(_num_reads, 3);
+	EXPECT_EQ(_num_visited, 20);
+}
+
+TEST_F(MissionItemChunkReaderTest, readFailure)
+{
+	// GIVEN: the second range request fails
+	_fail_read = 1;
+
+	// WHEN: reading three chunks
+	EXPECT_FALSE(forEach(0u, 3u * MissionItemChunkReader::CHUNK_ITEMS));
+
+	// THEN: only the items of the first chunk were visited
+	EXPECT_EQ(_num_reads, 2);
+	EXPECT_EQ(_num_visited, MissionItemChunkReader::CHUNK_ITEMS);
+}
+
+TEST_F(MissionItemChunkReaderTest, stopEarly)
+{
+	// WHEN: the visitor stops at the second item of the second chunk
+	int visited = 0;
+	const bool success = _reader.forEach(0u, 3u * MissionItemChunkReader::CHUNK_ITEMS,
+	[this](uint16_t chunk_start, uint16_t num_items, mission_item_s * items) { return read(chunk_start, num_items, items); },
+	[&visited](mission_item_s & item, uint16_t index) {
+		visited++;
+		return index != MissionItemChunkReader::CHUNK_ITEMS + 1;
+	});
+
+	// THEN: no further chunk is read and stopping is no failure
+	EXPECT_TRUE(success);
+	EXPECT_EQ(_num_reads, 2);
+	EXPECT_EQ(visited, MissionItemChunkReader::CHUNK_ITEMS + 2);
+}
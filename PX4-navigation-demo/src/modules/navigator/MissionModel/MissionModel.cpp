@@ -0,0 +1,373 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "MissionModel.hpp"
+
+#include <float.h>
+
+#include <lib/geo/geo.h>
+#include <mathlib/mathlib.h>
+
+MissionModel::~MissionModel()
+{
+	delete[] _positions;
+	delete[] _jumps;
+}
+
+void MissionModel::beginBuild(const mission_s &mission)
+{
+	_built = true;
+	_valid = false;
+	++_generation;
+	_mission_id = mission.mission_id;
+	_mission_dataman_id = mission.mission_dataman_id;
+	_mission_count = mission.count;
+	_num_items = 0;
+	_num_positions = 0;
+	_num_jumps = 0;
+}
+
+bool MissionModel::addItem(const mission_item_s &item, bool contains_position)
+{
+	if (!_built || _num_items >= _mission_count) {
+		return false;
+	}
+
+	if (contains_position) {
+		if (item.nav_cmd > UINT8_MAX) {
+			return false;
+		}
+
+		if (_num_positions >= _max_positions) {
+			// only allocate for the position items, most missions have few other items
+			const int new_max_positions = math::max(_max_positions * 2, 16);
+			PositionItem *new_positions = new PositionItem[new_max_positions];
+
+			if (new_positions == nullptr) {
+				return false;
+			}
+
+			for (int i = 0; i < _num_positions; ++i) {
+				new_positions[i] = _positions[i];
+			}
+
+			delete[] _positions;
+			_positions = new_positions;
+			_max_positions = new_max_positions;
+		}
+
+		PositionItem &position = _positions[_num_positions++];
+		position.lat = static_cast<int32_t>(lround(item.lat * 1e7));
+		position.lon = static_cast<int32_t>(lround(item.lon * 1e7));
+		position.altitude = item.altitude;
+		position.loiter_radius = item.loiter_radius;
+		position.time_inside = item.time_inside;
+		position.mission_index = static_cast<uint16_t>(_num_items);
+		position.nav_cmd = static_cast<uint8_t>(item.nav_cmd);
+		position.altitude_is_relative = item.altitude_is_relative;
+
+	} else if (item.nav_cmd == NAV_CMD_DO_JUMP) {
+		if (_num_jumps >= _max_jumps) {
+			// jump items are rare, grow on demand
+			const int new_max_jumps = math::max(_max_jumps * 2, 4);
+			JumpItem *new_jumps = new JumpItem[new_max_jumps];
+
+			if (new_jumps == nullptr) {
+				return false;
+			}
+
+			for (int i = 0; i < _num_jumps; ++i) {
+				new_jumps[i] = _jumps[i];
+			}
+
+			delete[] _jumps;
+			_jumps = new_jumps;
+			_max_jumps = new_max_jumps;
+		}
+
+		const bool target_valid = item.do_jump_mission_index >= 0 && item.do_jump_mission_index < _mission_count;
+
+		JumpItem &jump = _jumps[_num_jumps++];
+		jump.mission_index = static_cast<uint16_t>(_num_items);
+		jump.target = target_valid ? item.do_jump_mission_index : -1;
+		jump.repeat_count = item.do_jump_repeat_count;
+		jump.current_count = item.do_jump_current_count;
+	}
+
+	++_num_items;
+	return true;
+}
+
+bool MissionModel::endBuild()
+{
+	if (!_built || _num_items != _mission_count) {
+		_valid = false;
+		return false;
+	}
+
+	float along_track = 0.f;
+
+	for (int i = 0; i < _num_positions; ++i) {
+		PositionItem &position = _positions[i];
+
+		if (i > 0) {
+			const PositionItem &previous = _positions[i - 1];
+			along_track += get_distance_to_next_waypoint(previous.latitude(), previous.longitude(),
+					position.latitude(), position.longitude());
+		}
+
+		position.along_track = along_track;
+	}
+
+	_valid = true;
+	return true;
+}
+
+bool MissionModel::isBuiltFor(const mission_s &mission) const
+{
+	return _built && _mission_id == mission.mission_id && _mission_dataman_id == mission.mission_dataman_id
+	       && _mission_count == mission.count;
+}
+
+float MissionModel::legBearing(int position_index) const
+{
+	if (position_index <= 0) {
+		return NAN;
+	}
+
+	const PositionItem &previous = _positions[position_index - 1];
+	const PositionItem &position = _positions[position_index];
+	return get_bearing_to_next_waypoint(previous.latitude(), previous.longitude(), position.latitude(),
+					    position.longitude());
+}
+
+int MissionModel::lowerBoundPosition(int32_t mission_index) const
+{
+	int low = 0;
+	int high = _num_positions;
+
+	while (low < high) {
+		const int mid = (low + high) / 2;
+
+		if (_positions[mid].mission_index < mission_index) {
+			low = mid + 1;
+
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+const MissionModel::JumpItem *MissionModel::findJump(int32_t mission_index) const
+{
+	int low = 0;
+	int high = _num_jumps;
+
+	while (low < high) {
+		const int mid = (low + high) / 2;
+
+		if (_jumps[mid].mission_index < mission_index) {
+			low = mid + 1;
+
+		} else {
+			high = mid;
+		}
+	}
+
+	return (low < _num_jumps && _jumps[low].mission_index == mission_index) ? &_jumps[low] : nullptr;
+}
+
+MissionModel::JumpItem *MissionModel::findJump(int32_t mission_index)
+{
+	return const_cast<JumpItem *>(static_cast<const MissionModel *>(this)->findJump(mission_index));
+}
+
+const MissionModel::PositionItem *MissionModel::positionItem(int32_t mission_index) const
+{
+	const int position_index = lowerBoundPosition(mission_index);
+
+	if (position_index < _num_positions && _positions[position_index].mission_index == mission_index) {
+		return &_positions[position_index];
+	}
+
+	return nullptr;
+}
+
+bool MissionModel::resolveJumps(int32_t &mission_index, bool mission_direction_backward) const
+{
+	int32_t index = mission_index;
+
+	for (uint16_t jump_count = 0u; jump_count < MAX_JUMP_ITERATION; jump_count++) {
+		if (index < 0 || index >= _mission_count) {
+			return false;
+		}
+
+		const JumpItem *jump = findJump(index);
+
+		if (jump == nullptr) {
+			break;
+		}
+
+		if (jump->target < 0) {
+			return false;
+		}
+
+		if (jump->current_count < jump->repeat_count) {
+			index = jump->target;
+
+		} else {
+			index += mission_direction_backward ? -1 : 1;
+		}
+	}
+
+	mission_index = index;
+	return true;
+}
+
+size_t MissionModel::nextPositionItems(int32_t start_index, int32_t items_index[], uint8_t max_num_items) const
+{
+	size_t num_found_items = 0u;
+	int32_t index = start_index;
+
+	// bound the search, jump loops without position items would never terminate
+	for (int32_t steps = 0; steps < _mission_count * (max_num_items + 1) && num_found_items < max_num_items; ++steps) {
+		if (!resolveJumps(index, false)) {
+			break;
+		}
+
+		if (positionItem(index) != nullptr) {
+			items_index[num_found_items++] = index;
+		}
+
+		++index;
+	}
+
+	return num_found_items;
+}
+
+size_t MissionModel::previousPositionItems(int32_t start_index, int32_t items_index[], uint8_t max_num_items) const
+{
+	size_t num_found_items = 0u;
+	int32_t index = start_index;
+
+	for (int32_t steps = 0; steps < _mission_count * (max_num_items + 1) && num_found_items < max_num_items; ++steps) {
+		--index;
+
+		if (!resolveJumps(index, true)) {
+			break;
+		}
+
+		if (positionItem(index) != nullptr) {
+			items_index[num_found_items++] = index;
+		}
+	}
+
+	return num_found_items;
+}
+
+float MissionModel::remainingDistance(int32_t mission_index) const
+{
+	const int position_index = lowerBoundPosition(mission_index);
+
+	if (position_index >= _num_positions) {
+		return 0.f;
+	}
+
+	return totalDistance() - _positions[position_index].along_track;
+}
+
+MissionModel::LegDistance MissionModel::closestLeg(double lat, double lon) const
+{
+	LegDistance result{};
+
+	if (_num_positions < 2) {
+		return result;
+	}
+
+	// local frame around the query position, legs are short compared to the earth radius
+	MapProjection projection{lat, lon};
+	float previous_x;
+	float previous_y;
+	projection.project(_positions[0].latitude(), _positions[0].longitude(), previous_x, previous_y);
+	float min_distance_squared = FLT_MAX;
+
+	for (int i = 1; i < _num_positions; ++i) {
+		float x;
+		float y;
+		projection.project(_positions[i].latitude(), _positions[i].longitude(), x, y);
+
+		// closest point on the segment to the origin
+		const float dx = x - previous_x;
+		const float dy = y - previous_y;
+		const float length_squared = dx * dx + dy * dy;
+		float t = 0.f;
+
+		if (length_squared > FLT_EPSILON) {
+			t = math::constrain(-(previous_x * dx + previous_y * dy) / length_squared, 0.f, 1.f);
+		}
+
+		const float closest_x = previous_x + t * dx;
+		const float closest_y = previous_y + t * dy;
+		const float distance_squared = closest_x * closest_x + closest_y * closest_y;
+
+		if (distance_squared < min_distance_squared) {
+			min_distance_squared = distance_squared;
+			result.position_index = i;
+			result.along_track = _positions[i - 1].along_track + t * legDistance(i);
+		}
+
+		previous_x = x;
+		previous_y = y;
+	}
+
+	result.distance = sqrtf(min_distance_squared);
+	return result;
+}
+
+void MissionModel::setJumpCurrentCount(int32_t mission_index, uint16_t current_count)
+{
+	JumpItem *jump = findJump(mission_index);
+
+	if (jump != nullptr) {
+		jump->current_count = current_count;
+	}
+}
+
+void MissionModel::resetJumpCounts()
+{
+	for (int i = 0; i < _num_jumps; ++i) {
+		_jumps[i].current_count = 0u;
+	}
+}
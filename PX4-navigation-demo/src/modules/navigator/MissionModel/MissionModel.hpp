@@ -0,0 +1,226 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file MissionModel.hpp
+ *
+ * Compact in-RAM model of a mission, built once per mission update.
+ *
+ * The model keeps the position items with their leg geometry (distance and bearing from the
+ * previous position item, cumulative along-track distance) and the DO_JUMP items with their
+ * resolved targets, both sorted by mission index. Queries that would otherwise read mission
+ * items one by one from dataman become binary searches over these tables.
+ *
+ * Legs connect consecutive position items in mission order, DO_JUMP repetitions are not unrolled.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include "../navigation.h"
+
+class MissionModel
+{
+public:
+	/**
+	 * @brief Maximum number of consecutive jump items followed to resolve a mission index
+	 */
+	static constexpr uint16_t MAX_JUMP_ITERATION{10u};
+
+	struct PositionItem {
+		int32_t lat;			///< latitude [1e-7 deg], the resolution of MISSION_ITEM_INT
+		int32_t lon;			///< longitude [1e-7 deg]
+		float altitude;			///< altitude [m], AMSL or relative to home
+		float loiter_radius;		///< loiter radius [m]
+		float time_inside;		///< time to stay inside the acceptance radius [s]
+		float along_track;		///< sum of the leg distances up to this item [m]
+		uint16_t mission_index;		///< index of the item in the mission
+		uint8_t nav_cmd;		///< navigation command, all position commands are below 256
+		bool altitude_is_relative;	///< true if altitude is relative to home
+
+		double latitude() const { return lat * 1e-7; }
+		double longitude() const { return lon * 1e-7; }
+		float absoluteAltitude(float home_alt) const { return altitude_is_relative ? altitude + home_alt : altitude; }
+	};
+
+	static_assert(sizeof(PositionItem) == 28, "PositionItem is expected to be packed to 28 bytes");
+
+	struct JumpItem {
+		uint16_t mission_index;		///< index of the DO_JUMP item in the mission
+		int16_t target;			///< resolved jump target, -1 if out of bounds
+		uint16_t repeat_count;		///< number of times the jump is executed
+		uint16_t current_count;		///< number of times the jump has been executed
+	};
+
+	/**
+	 * Result of a closest leg query
+	 */
+	struct LegDistance {
+		int position_index{-1};		///< index (see positionItemAt()) of the position item ending the closest leg, -1 if none
+		float distance{NAN};		///< horizontal distance to the leg [m]
+		float along_track{NAN};		///< along-track distance of the closest point on the leg [m]
+	};
+
+	MissionModel() = default;
+	~MissionModel();
+
+	MissionModel(const MissionModel &) = delete;
+	MissionModel &operator=(const MissionModel &) = delete;
+
+	/**
+	 * Start building the model of a mission. Items are added with addItem() in mission order and the
+	 * model is finalized with endBuild(). Storage for the position items grows while adding them and
+	 * is kept for reuse.
+	 */
+	void beginBuild(const mission_s &mission);
+
+	/**
+	 * Add the next mission item.
+	 * @param contains_position true if the item is a position item (MissionBlock::item_contains_position())
+	 * @return false if the item could not be stored, the model stays invalid
+	 */
+	bool addItem(const mission_item_s &item, bool contains_position);
+
+	/**
+	 * Compute the leg geometry. The model is valid if all items of the mission have been added.
+	 */
+	bool endBuild();
+
+	/**
+	 * Invalidate the model, it stays associated with the mission of the last build
+	 */
+	void invalidate() { _valid = false; }
+
+	/**
+	 * @return true if the last build was started for the given mission (regardless of its success)
+	 */
+	bool isBuiltFor(const mission_s &mission) const;
+
+	/**
+	 * @return true if the model is complete and matches the given mission
+	 */
+	bool isValidFor(const mission_s &mission) const { return _valid && isBuiltFor(mission); }
+
+	/**
+	 * Resolve DO_JUMP items starting at a mission index, like MissionBase::getNonJumpItem() without writing jumps.
+	 * @param[in,out] mission_index index to start at, set to the first non-jump item
+	 * @return false if the index is out of bounds
+	 */
+	bool resolveJumps(int32_t &mission_index, bool mission_direction_backward) const;
+
+	/**
+	 * Find the next position items following jumps, starting at start_index (first possible return index)
+	 * @return number of found items
+	 */
+	size_t nextPositionItems(int32_t start_index, int32_t items_index[], uint8_t max_num_items) const;
+
+	/**
+	 * Find the previous position items following jumps backwards, starting before start_index
+	 * @return number of found items
+	 */
+	size_t previousPositionItems(int32_t start_index, int32_t items_index[], uint8_t max_num_items) const;
+
+	/**
+	 * @return index (see positionItemAt()) of the first position item at or after a mission index,
+	 * numPositionItems() if there is none
+	 */
+	int lowerBoundPosition(int32_t mission_index) const;
+
+	/**
+	 * @return position item at a mission index or nullptr if the item is no position item
+	 */
+	const PositionItem *positionItem(int32_t mission_index) const;
+
+	/**
+	 * @return along-track distance from the first position item at or after a mission index
+	 * to the last position item [m], 0 if there is none
+	 */
+	float remainingDistance(int32_t mission_index) const;
+
+	/**
+	 * Find the leg closest to a position
+	 */
+	LegDistance closestLeg(double lat, double lon) const;
+
+	/**
+	 * Mirror a jump counter update written to dataman
+	 */
+	void setJumpCurrentCount(int32_t mission_index, uint16_t current_count);
+	void resetJumpCounts();
+
+	int numPositionItems() const { return _num_positions; }
+	const PositionItem &positionItemAt(int position_index) const { return _positions[position_index]; }
+
+	/**
+	 * @return horizontal distance from the previous position item [m], 0 for the first one
+	 */
+	float legDistance(int position_index) const
+	{
+		return (position_index > 0) ? _positions[position_index].along_track - _positions[position_index - 1].along_track : 0.f;
+	}
+
+	/**
+	 * @return bearing from the previous position item [rad], NAN for the first one
+	 */
+	float legBearing(int position_index) const;
+
+	int numJumpItems() const { return _num_jumps; }
+	const JumpItem &jumpItemAt(int jump_index) const { return _jumps[jump_index]; }
+	float totalDistance() const { return _num_positions > 0 ? _positions[_num_positions - 1].along_track : 0.f; }
+
+	/**
+	 * @return counter incremented by every build, lets derived tables detect a rebuilt model
+	 */
+	uint32_t generation() const { return _generation; }
+
+private:
+	JumpItem *findJump(int32_t mission_index);
+	const JumpItem *findJump(int32_t mission_index) const;
+
+	PositionItem *_positions{nullptr};
+	int _num_positions{0};
+	int _max_positions{0};
+
+	JumpItem *_jumps{nullptr};
+	int _num_jumps{0};
+	int _max_jumps{0};
+
+	int32_t _num_items{0};			///< number of mission items added
+	int32_t _mission_count{0};		///< number of items of the mission being modeled
+	uint32_t _mission_id{0};
+	uint8_t _mission_dataman_id{0};
+	uint32_t _generation{0};
+	bool _built{false};			///< true if a build has been started
+	bool _valid{false};
+};
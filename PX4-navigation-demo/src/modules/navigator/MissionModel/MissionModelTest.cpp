@@ -0,0 +1,311 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include <lib/geo/geo.h>
+
+#include "MissionModel.hpp"
+
+static constexpr double kRefLat = 47.397742;
+static constexpr double kRefLon = 8.545594;
+
+class MissionModelTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_proj.initReference(kRefLat, kRefLon);
+		_num_items = 0;
+	}
+
+	// add a waypoint given in local coordinates around the reference
+	void addWaypoint(float x, float y, float altitude = 50.f)
+	{
+		mission_item_s &item = _items[_num_items++];
+		item = {};
+		item.nav_cmd = NAV_CMD_WAYPOINT;
+		_proj.reproject(x, y, item.lat, item.lon);
+		item.altitude = altitude;
+		item.altitude_is_relative = true;
+	}
+
+	void addCommand(uint16_t nav_cmd)
+	{
+		mission_item_s &item = _items[_num_items++];
+		item = {};
+		item.nav_cmd = nav_cmd;
+	}
+
+	void addJump(int16_t target, uint16_t repeat_count)
+	{
+		mission_item_s &item = _items[_num_items++];
+		item = {};
+		item.nav_cmd = NAV_CMD_DO_JUMP;
+		item.do_jump_mission_index = target;
+		item.do_jump_repeat_count = repeat_count;
+	}
+
+	bool build()
+	{
+		_mission = {};
+		_mission.count = _num_items;
+		_mission.mission_id = 42;
+
+		_model.beginBuild(_mission);
+
+		for (int i = 0; i < _num_items; ++i) {
+			if (!_model.addItem(_items[i], _items[i].nav_cmd == NAV_CMD_WAYPOINT)) {
+				return false;
+			}
+		}
+
+		return _model.endBuild();
+	}
+
+	MapProjection _proj;
+	mission_item_s _items[64];
+	int _num_items{0};
+	mission_s _mission{};
+	MissionModel _model;
+};
+
+TEST_F(MissionModelTest, empty)
+{
+	ASSERT_TRUE(build());
+	EXPECT_TRUE(_model.isValidFor(_mission));
+	EXPECT_EQ(_model.numPositionItems(), 0);
+	EXPECT_EQ(_model.remainingDistance(0), 0.f);
+	EXPECT_EQ(_model.closestLeg(kRefLat, kRefLon).position_index, -1);
+
+	int32_t items_index[2];
+	EXPECT_EQ(_model.nextPositionItems(0, items_index, 2), 0u);
+}
+
+TEST_F(MissionModelTest, incompleteBuild)
+{
+	addWaypoint(0.f, 0.f);
+	addWaypoint(100.f, 0.f);
+
+	_mission = {};
+	_mission.count = 2;
+	_mission.mission_id = 42;
+	_model.beginBuild(_mission);
+	ASSERT_TRUE(_model.addItem(_items[0], true));
+	EXPECT_FALSE(_model.endBuild());
+	EXPECT_TRUE(_model.isBuiltFor(_mission));
+	EXPECT_FALSE(_model.isValidFor(_mission));
+
+	// a different mission needs a new build
+	_mission.mission_id = 43;
+	EXPECT_FALSE(_model.isBuiltFor(_mission));
+}
+
+TEST_F(MissionModelTest, legGeometry)
+{
+	addWaypoint(0.f, 0.f);
+	addCommand(NAV_CMD_DO_CHANGE_SPEED);
+	addWaypoint(100.f, 0.f);
+	addWaypoint(100.f, 200.f);
+	ASSERT_TRUE(build());
+
+	ASSERT_EQ(_model.numPositionItems(), 3);
+	EXPECT_EQ(_model.positionItem(1), nullptr);
+	ASSERT_NE(_model.positionItem(2), nullptr);
+	EXPECT_EQ(_model.positionItem(2)->mission_index, 2);
+	EXPECT_FLOAT_EQ(_model.positionItem(2)->absoluteAltitude(400.f), 450.f);
+
+	const MissionModel::PositionItem &first = _model.positionItemAt(0);
+	const MissionModel::PositionItem &second = _model.positionItemAt(1);
+	const MissionModel::PositionItem &third = _model.positionItemAt(2);
+
+	EXPECT_FLOAT_EQ(_model.legDistance(0), 0.f);
+	EXPECT_TRUE(std::isnan(_model.legBearing(0)));
+	EXPECT_NEAR(_model.legDistance(1), 100.f, 0.5f);
+	EXPECT_NEAR(_model.legBearing(1), 0.f, 0.01f);
+	EXPECT_NEAR(_model.legDistance(2), 200.f, 0.5f);
+	EXPECT_NEAR(_model.legBearing(2), M_PI_2_F, 0.01f);
+	EXPECT_FLOAT_EQ(first.along_track, 0.f);
+	EXPECT_NEAR(second.along_track, 100.f, 0.5f);
+	EXPECT_NEAR(third.along_track, 300.f, 1.f);
+
+	EXPECT_NEAR(_model.totalDistance(), 300.f, 1.f);
+	EXPECT_NEAR(_model.remainingDistance(0), 300.f, 1.f);
+	EXPECT_NEAR(_model.remainingDistance(1), 200.f, 1.f); // the next position item is at index 2
+	EXPECT_NEAR(_model.remainingDistance(3), 0.f, 1e-3f);
+	EXPECT_EQ(_model.remainingDistance(4), 0.f);
+}
+
+TEST_F(MissionModelTest, closestLeg)
+{
+	addWaypoint(0.f, 0.f);
+	addWaypoint(100.f, 0.f);
+	addWaypoint(100.f, 200.f);
+	ASSERT_TRUE(build());
+
+	double lat, lon;
+	_proj.reproject(120.f, 50.f, lat, lon);
+	MissionModel::LegDistance leg = _model.closestLeg(lat, lon);
+	EXPECT_EQ(leg.position_index, 2);
+	EXPECT_NEAR(leg.distance, 20.f, 0.5f);
+	EXPECT_NEAR(leg.along_track, 150.f, 1.f);
+
+	_proj.reproject(30.f, -10.f, lat, lon);
+	leg = _model.closestLeg(lat, lon);
+	EXPECT_EQ(leg.position_index, 1);
+	EXPECT_NEAR(leg.distance, 10.f, 0.5f);
+	EXPECT_NEAR(leg.along_track, 30.f, 1.f);
+}
+
+TEST_F(MissionModelTest, nextAndPreviousPositionItems)
+{
+	addWaypoint(0.f, 0.f);			// 0
+	addCommand(NAV_CMD_DO_CHANGE_SPEED);	// 1
+	addWaypoint(100.f, 0.f);		// 2
+	addCommand(NAV_CMD_DO_SET_ROI);		// 3
+	addWaypoint(200.f, 0.f);		// 4
+	ASSERT_TRUE(build());
+
+	int32_t items_index[4];
+	ASSERT_EQ(_model.nextPositionItems(1, items_index, 4), 2u);
+	EXPECT_EQ(items_index[0], 2);
+	EXPECT_EQ(items_index[1], 4);
+
+	ASSERT_EQ(_model.nextPositionItems(0, items_index, 1), 1u);
+	EXPECT_EQ(items_index[0], 0);
+
+	EXPECT_EQ(_model.nextPositionItems(5, items_index, 1), 0u);
+	EXPECT_EQ(_model.nextPositionItems(-1, items_index, 1), 0u);
+
+	ASSERT_EQ(_model.previousPositionItems(4, items_index, 4), 2u);
+	EXPECT_EQ(items_index[0], 2);
+	EXPECT_EQ(items_index[1], 0);
+
+	EXPECT_EQ(_model.previousPositionItems(0, items_index, 1), 0u);
+}
+
+TEST_F(MissionModelTest, jumps)
+{
+	addWaypoint(0.f, 0.f);		// 0
+	addWaypoint(100.f, 0.f);	// 1
+	addJump(0, 1);			// 2
+	addWaypoint(200.f, 0.f);	// 3
+	ASSERT_TRUE(build());
+	EXPECT_EQ(_model.numJumpItems(), 1);
+
+	// the jump is pending: the mission continues at the jump target
+	int32_t items_index[4];
+	ASSERT_EQ(_model.nextPositionItems(1, items_index, 3), 3u);
+	EXPECT_EQ(items_index[0], 1);
+	EXPECT_EQ(items_index[1], 0);
+	EXPECT_EQ(items_index[2], 1);
+
+	int32_t index = 2;
+	ASSERT_TRUE(_model.resolveJumps(index, false));
+	EXPECT_EQ(index, 0);
+
+	// jump executed: skip the jump item
+	_model.setJumpCurrentCount(2, 1);
+	ASSERT_EQ(_model.nextPositionItems(2, items_index, 2), 1u);
+	EXPECT_EQ(items_index[0], 3);
+
+	ASSERT_EQ(_model.previousPositionItems(3, items_index, 1), 1u);
+	EXPECT_EQ(items_index[0], 1);
+
+	_model.resetJumpCounts();
+	index = 2;
+	ASSERT_TRUE(_model.resolveJumps(index, false));
+	EXPECT_EQ(index, 0);
+}
+
+TEST_F(MissionModelTest, invalidJumpTarget)
+{
+	addWaypoint(0.f, 0.f);
+	addJump(10, 1);
+	addWaypoint(100.f, 0.f);
+	ASSERT_TRUE(build());
+
+	int32_t index = 1;
+	EXPECT_FALSE(_model.resolveJumps(index, false));
+
+	int32_t items_index[2];
+	ASSERT_EQ(_model.nextPositionItems(0, items_index, 2), 1u);
+	EXPECT_EQ(items_index[0], 0);
+}
+
+TEST_F(MissionModelTest, jumpLoopWithoutPositionItems)
+{
+	addWaypoint(0.f, 0.f);				// 0
+	addCommand(NAV_CMD_DO_CHANGE_SPEED);		// 1
+	addJump(1, 5);					// 2
+	ASSERT_TRUE(build());
+
+	// must terminate
+	int32_t items_index[2];
+	EXPECT_EQ(_model.nextPositionItems(1, items_index, 2), 0u);
+}
+
+TEST_F(MissionModelTest, positionStorageGrows)
+{
+	// GIVEN: more position items than the initial storage holds, mixed with other items
+	for (int i = 0; i < 40; ++i) {
+		addWaypoint(100.f * i, 0.f);
+
+		if (i % 2 == 0) {
+			addCommand(NAV_CMD_DO_CHANGE_SPEED);
+		}
+	}
+
+	ASSERT_TRUE(build());
+
+	// THEN: all position items are kept in mission order with their leg geometry
+	ASSERT_EQ(_model.numPositionItems(), 40);
+
+	for (int i = 0; i < _model.numPositionItems(); ++i) {
+		const int mission_index = i + (i + 1) / 2;
+		EXPECT_EQ(_model.positionItemAt(i).mission_index, mission_index);
+		EXPECT_EQ(_model.positionItem(mission_index), &_model.positionItemAt(i));
+		EXPECT_NEAR(_model.positionItemAt(i).along_track, 100.f * i, 0.5f * (i + 1));
+	}
+
+	// WHEN: rebuilding for a smaller mission
+	_num_items = 0;
+	addWaypoint(0.f, 0.f);
+	addWaypoint(0.f, 100.f);
+	ASSERT_TRUE(build());
+
+	// THEN: the storage is reused
+	ASSERT_EQ(_model.numPositionItems(), 2);
+	EXPECT_NEAR(_model.totalDistance(), 100.f, 0.5f);
+}
@@ -0,0 +1,246 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "SafePointIndex.hpp"
+
+#include <string.h>
+
+SafePointIndex::~SafePointIndex()
+{
+	delete[] _points;
+	delete[] _approaches;
+	delete[] _cell_start;
+	delete[] _cell_points;
+}
+
+template<typename T>
+bool SafePointIndex::grow(T *&array, int &capacity, int required)
+{
+	if (required <= capacity) {
+		return true;
+	}
+
+	const int new_capacity = math::max(required, capacity + capacity / 2);
+	T *new_array = new T[new_capacity];
+
+	if (new_array == nullptr) {
+		return false;
+	}
+
+	if (array != nullptr) {
+		memcpy(new_array, array, sizeof(T) * capacity);
+		delete[] array;
+	}
+
+	array = new_array;
+	capacity = new_capacity;
+	return true;
+}
+
+void SafePointIndex::reset()
+{
+	_num_points = 0;
+	_num_approaches = 0;
+	_num_items = 0;
+	_last_rally_point = -1;
+	_grid_width = 0;
+	_grid_height = 0;
+}
+
+bool SafePointIndex::addItem(const mission_item_s &item)
+{
+	if (item.nav_cmd == NAV_CMD_RALLY_POINT) {
+		if (_num_points >= UINT16_MAX || !grow(_points, _max_points, _num_points + 1)) {
+			return false;
+		}
+
+		RallyPoint &point = _points[_num_points];
+		point.lat = item.lat;
+		point.lon = item.lon;
+		point.altitude = item.altitude;
+		point.seq = static_cast<uint16_t>(_num_items);
+		point.first_approach = static_cast<uint16_t>(_num_approaches);
+		point.num_approaches = 0;
+		point.frame = item.frame;
+		point.approach_owner = -1;
+		_last_rally_point = _num_points++;
+
+	} else if (item.nav_cmd == NAV_CMD_LOITER_TO_ALT && _last_rally_point >= 0
+		   && _points[_last_rally_point].num_approaches < MAX_APPROACHES_PER_POINT) {
+		if (_num_approaches >= UINT16_MAX || !grow(_approaches, _max_approaches, _num_approaches + 1)) {
+			return false;
+		}
+
+		Approach &approach = _approaches[_num_approaches++];
+		approach.lat = item.lat;
+		approach.lon = item.lon;
+		approach.altitude = item.altitude;
+		approach.loiter_radius = item.loiter_radius;
+		approach.altitude_is_relative = item.altitude_is_relative;
+		_points[_last_rally_point].num_approaches++;
+	}
+
+	++_num_items;
+	return true;
+}
+
+bool SafePointIndex::build(float approach_radius)
+{
+	_approach_radius = approach_radius;
+	_grid_width = 0;
+	_grid_height = 0;
+
+	if (_num_points == 0) {
+		return true;
+	}
+
+	// project around the center of the bounding box
+	double min_lat = _points[0].lat;
+	double max_lat = min_lat;
+	double min_lon = _points[0].lon;
+	double max_lon = min_lon;
+
+	for (int i = 1; i < _num_points; ++i) {
+		min_lat = math::min(min_lat, _points[i].lat);
+		max_lat = math::max(max_lat, _points[i].lat);
+		min_lon = math::min(min_lon, _points[i].lon);
+		max_lon = math::max(max_lon, _points[i].lon);
+	}
+
+	_projection.initReference((min_lat + max_lat) / 2., (min_lon + max_lon) / 2.);
+
+	_min_x = FLT_MAX;
+	_min_y = FLT_MAX;
+	float max_x = -FLT_MAX;
+	float max_y = -FLT_MAX;
+
+	for (int i = 0; i < _num_points; ++i) {
+		RallyPoint &point = _points[i];
+		_projection.project(point.lat, point.lon, point.x, point.y);
+		_min_x = math::min(_min_x, point.x);
+		_min_y = math::min(_min_y, point.y);
+		max_x = math::max(max_x, point.x);
+		max_y = math::max(max_y, point.y);
+	}
+
+	// aim for about two points per cell, limited by the cell size and the grid dimensions
+	const float extent_x = max_x - _min_x;
+	const float extent_y = max_y - _min_y;
+	_cell_size = sqrtf(2.f * math::max(extent_x * extent_y, 1.f) / _num_points);
+	_cell_size = math::max(_cell_size, math::max(extent_x, extent_y) / MAX_GRID_SIDE, MIN_CELL_SIZE);
+	_grid_width = math::min(cellX(max_x) + 1, MAX_GRID_SIDE);
+	_grid_height = math::min(cellY(max_y) + 1, MAX_GRID_SIDE);
+
+	const int num_cells = _grid_width * _grid_height;
+
+	if (!grow(_cell_start, _max_cell_start, num_cells + 1) || !grow(_cell_points, _max_cell_points, _num_points)) {
+		_grid_width = 0;
+		_grid_height = 0;
+		return false;
+	}
+
+	// counting sort of the points into the cells, points stay in storage order within a cell
+	memset(_cell_start, 0, sizeof(uint16_t) * (num_cells + 1));
+
+	for (int i = 0; i < _num_points; ++i) {
+		const int cell = math::min(cellY(_points[i].y), _grid_height - 1) * _grid_width
+				 + math::min(cellX(_points[i].x), _grid_width - 1);
+		_cell_start[cell + 1]++;
+	}
+
+	for (int cell = 0; cell < num_cells; ++cell) {
+		_cell_start[cell + 1] += _cell_start[cell];
+	}
+
+	for (int i = 0; i < _num_points; ++i) {
+		const int cell = math::min(cellY(_points[i].y), _grid_height - 1) * _grid_width
+				 + math::min(cellX(_points[i].x), _grid_width - 1);
+		// _cell_start[cell] temporarily serves as insert position and ends up at the start of the next cell
+		_cell_points[_cell_start[cell]++] = static_cast<uint16_t>(i);
+	}
+
+	for (int cell = num_cells; cell > 0; --cell) {
+		_cell_start[cell] = _cell_start[cell - 1];
+	}
+
+	_cell_start[0] = 0;
+
+	for (int i = 0; i < _num_points; ++i) {
+		_points[i].approach_owner = static_cast<int16_t>(landApproachOwner(_points[i].lat, _points[i].lon));
+	}
+
+	return true;
+}
+
+int SafePointIndex::landApproachOwner(double lat, double lon) const
+{
+	if (_grid_width == 0) {
+		return -1;
+	}
+
+	float x;
+	float y;
+	_projection.project(lat, lon, x, y);
+
+	// all cells overlapping the approach radius, with some margin for the projection error
+	const float margin = _approach_radius * 1.01f + 1.f;
+	const int x_begin = math::max(cellX(x - margin), 0);
+	const int x_end = math::min(cellX(x + margin), _grid_width - 1);
+	const int y_begin = math::max(cellY(y - margin), 0);
+	const int y_end = math::min(cellY(y + margin), _grid_height - 1);
+
+	int owner = -1;
+
+	for (int cy = y_begin; cy <= y_end; ++cy) {
+		for (int cx = x_begin; cx <= x_end; ++cx) {
+			const int cell = cy * _grid_width + cx;
+
+			for (int entry = _cell_start[cell]; entry < _cell_start[cell + 1]; ++entry) {
+				const int index = _cell_points[entry];
+
+				if (owner >= 0 && index > owner) {
+					// entries are ascending within a cell
+					break;
+				}
+
+				const RallyPoint &point = _points[index];
+
+				if (get_distance_to_next_waypoint(point.lat, point.lon, lat, lon) < _approach_radius) {
+					owner = index;
+				}
+			}
+		}
+	}
+
+	return owner;
+}
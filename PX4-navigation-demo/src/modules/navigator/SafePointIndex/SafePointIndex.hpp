@@ -0,0 +1,259 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file SafePointIndex.hpp
+ *
+ * Spatial index over the rally points and their VTOL land approaches.
+ *
+ * The rally points are projected into a local frame and sorted into a uniform grid (cells in
+ * compressed row storage), sized for a few points per cell. Nearest neighbour queries search the
+ * grid in rings of cells around the query position and stop as soon as no closer point can exist.
+ * The land approaches (NAV_CMD_LOITER_TO_ALT items following a rally point) are stored per rally
+ * point, and the rally point whose approaches apply at each rally point location is resolved once
+ * when the index is built.
+ */
+
+#pragma once
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#include <lib/geo/geo.h>
+#include <mathlib/mathlib.h>
+
+#include "../navigation.h"
+#include "../safe_point_land.hpp"
+
+class SafePointIndex
+{
+public:
+	struct RallyPoint {
+		double lat;			///< latitude [deg]
+		double lon;			///< longitude [deg]
+		float altitude;			///< altitude [m], interpretation depends on frame
+		float x;			///< north in the local frame of the index [m]
+		float y;			///< east in the local frame of the index [m]
+		uint16_t seq;			///< index of the item in the safe point storage
+		uint16_t first_approach;	///< index of the first land approach
+		uint8_t num_approaches;		///< number of land approaches following this rally point
+		uint8_t frame;			///< MAV_FRAME of the item
+		int16_t approach_owner;		///< rally point whose land approaches apply at this location, -1 if none
+	};
+
+	struct Approach {
+		double lat;			///< latitude [deg]
+		double lon;			///< longitude [deg]
+		float altitude;			///< altitude [m], AMSL or relative to home
+		float loiter_radius;		///< loiter radius [m]
+		bool altitude_is_relative;	///< true if altitude is relative to home
+
+		float absoluteAltitude(float home_alt) const { return altitude_is_relative ? altitude + home_alt : altitude; }
+	};
+
+	static constexpr uint8_t MAX_APPROACHES_PER_POINT{land_approaches_s::num_approaches_max};
+	static constexpr int MAX_GRID_SIDE{64};
+	static constexpr float MIN_CELL_SIZE{50.f}; ///< [m]
+
+	SafePointIndex() = default;
+	~SafePointIndex();
+
+	SafePointIndex(const SafePointIndex &) = delete;
+	SafePointIndex &operator=(const SafePointIndex &) = delete;
+
+	/**
+	 * Drop all points. Allocated storage is kept for reuse.
+	 */
+	void reset();
+
+	/**
+	 * Add the next item of the safe point storage (items must be added in storage order).
+	 * Land approaches exceeding MAX_APPROACHES_PER_POINT are ignored.
+	 * @return false if the allocation failed
+	 */
+	bool addItem(const mission_item_s &item);
+
+	/**
+	 * Sort the rally points into the grid and resolve the land approaches of every rally point.
+	 * @param approach_radius maximum distance between a location and the rally point providing its land approaches [m]
+	 * @return false if the allocation failed
+	 */
+	bool build(float approach_radius);
+
+	/**
+	 * Find the closest rally point accepted by a filter
+	 * @param accept callable bool(const RallyPoint &), only called for candidates that could be the closest
+	 * @param[out] distance distance to the closest accepted rally point [m]
+	 * @return index of the closest accepted rally point (ties resolved by storage order), -1 if none
+	 */
+	template<typename Accept>
+	int findNearest(double lat, double lon, float &distance, Accept accept) const;
+
+	/**
+	 * @return index of the first rally point in storage order within the approach radius of a location, -1 if none
+	 */
+	int landApproachOwner(double lat, double lon) const;
+
+	/**
+	 * @return true if land approaches apply at the location of a rally point
+	 */
+	bool hasLandApproach(const RallyPoint &point) const
+	{
+		return point.approach_owner >= 0 && _points[point.approach_owner].num_approaches > 0;
+	}
+
+	int numRallyPoints() const { return _num_points; }
+	int numItems() const { return _num_items; }
+	const RallyPoint &rallyPoint(int index) const { return _points[index]; }
+	const Approach &approach(int index) const { return _approaches[index]; }
+
+private:
+	template<typename T>
+	static bool grow(T *&array, int &capacity, int required);
+
+	/**
+	 * Call visit(cell_index) for all cells of the grid at Chebyshev distance r from cell (cx, cy)
+	 */
+	template<typename Visit>
+	void visitRing(int cx, int cy, int r, Visit visit) const;
+
+	int cellX(float x) const { return static_cast<int>(floorf((x - _min_x) / _cell_size)); }
+	int cellY(float y) const { return static_cast<int>(floorf((y - _min_y) / _cell_size)); }
+
+	RallyPoint *_points{nullptr};
+	int _num_points{0};
+	int _max_points{0};
+
+	Approach *_approaches{nullptr};
+	int _num_approaches{0};
+	int _max_approaches{0};
+
+	uint16_t *_cell_start{nullptr};		///< first entry of each cell in _cell_points, one extra entry at the end
+	int _max_cell_start{0};
+	uint16_t *_cell_points{nullptr};	///< rally point indices sorted by cell, ascending within a cell
+	int _max_cell_points{0};
+
+	MapProjection _projection{};
+	float _min_x{0.f};
+	float _min_y{0.f};
+	float _cell_size{MIN_CELL_SIZE};
+	int _grid_width{0};
+	int _grid_height{0};
+	float _approach_radius{0.f};
+
+	int _num_items{0};
+	int _last_rally_point{-1};		///< rally point the following land approaches belong to
+};
+
+template<typename Visit>
+void SafePointIndex::visitRing(int cx, int cy, int r, Visit visit) const
+{
+	if (r == 0) {
+		if (cx >= 0 && cx < _grid_width && cy >= 0 && cy < _grid_height) {
+			visit(cy * _grid_width + cx);
+		}
+
+		return;
+	}
+
+	// top and bottom rows, clipped to the grid
+	const int x_begin = math::max(cx - r, 0);
+	const int x_end = math::min(cx + r, _grid_width - 1);
+
+	const int rows[2] {cy - r, cy + r};
+
+	for (int y : rows) {
+		if (y >= 0 && y < _grid_height) {
+			for (int x = x_begin; x <= x_end; ++x) {
+				visit(y * _grid_width + x);
+			}
+		}
+	}
+
+	// left and right columns without the corners
+	const int y_begin = math::max(cy - r + 1, 0);
+	const int y_end = math::min(cy + r - 1, _grid_height - 1);
+
+	const int columns[2] {cx - r, cx + r};
+
+	for (int x : columns) {
+		if (x >= 0 && x < _grid_width) {
+			for (int y = y_begin; y <= y_end; ++y) {
+				visit(y * _grid_width + x);
+			}
+		}
+	}
+}
+
+template<typename Accept>
+int SafePointIndex::findNearest(double lat, double lon, float &distance, Accept accept) const
+{
+	int nearest = -1;
+	distance = FLT_MAX;
+
+	if (_num_points == 0) {
+		return nearest;
+	}
+
+	float x;
+	float y;
+	_projection.project(lat, lon, x, y);
+	const int cx = cellX(x);
+	const int cy = cellY(y);
+
+	// rings closer than the grid are empty, rings further than r_end do not intersect the grid
+	const int r_begin = math::max(math::max(-cx, cx - (_grid_width - 1)), math::max(math::max(-cy, cy - (_grid_height - 1)), 0));
+	const int r_end = math::max(math::max(cx, _grid_width - 1 - cx), math::max(cy, _grid_height - 1 - cy));
+
+	for (int r = r_begin; r <= r_end; ++r) {
+		// points in ring r are at least (r - 1) cells away, the margin covers the projection error
+		if (nearest >= 0 && (r - 1) * _cell_size * 0.99f > distance) {
+			break;
+		}
+
+		visitRing(cx, cy, r, [&](int cell) {
+			for (int entry = _cell_start[cell]; entry < _cell_start[cell + 1]; ++entry) {
+				const int index = _cell_points[entry];
+				const RallyPoint &point = _points[index];
+				const float dist = get_distance_to_next_waypoint(lat, lon, point.lat, point.lon);
+
+				if ((dist < distance || (dist <= distance && index < nearest)) && accept(point)) {
+					distance = dist;
+					nearest = index;
+				}
+			}
+		});
+	}
+
+	return nearest;
+}
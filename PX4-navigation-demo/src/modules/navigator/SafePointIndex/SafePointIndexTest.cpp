@@ -0,0 +1,202 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "SafePointIndex.hpp"
+
+static constexpr double kRefLat = 47.397742;
+static constexpr double kRefLon = 8.545594;
+static constexpr float kApproachRadius = 10.f;
+
+class SafePointIndexTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_proj.initReference(kRefLat, kRefLon);
+		_index.reset();
+		_num_items = 0;
+		srand(1);
+	}
+
+	// add an item given in local coordinates around the reference
+	void addItem(uint16_t nav_cmd, float x, float y)
+	{
+		mission_item_s &item = _items[_num_items++];
+		item = {};
+		item.nav_cmd = nav_cmd;
+		_proj.reproject(x, y, item.lat, item.lon);
+		item.altitude = 20.f;
+		item.altitude_is_relative = true;
+		item.loiter_radius = 80.f;
+		ASSERT_TRUE(_index.addItem(item));
+	}
+
+	void addRandomRallyPoints(int count, float extent)
+	{
+		for (int i = 0; i < count; ++i) {
+			addItem(NAV_CMD_RALLY_POINT, random(extent), random(extent));
+		}
+	}
+
+	static float random(float extent) { return (rand() / (float)RAND_MAX - 0.5f) * extent; }
+
+	// reference implementation: linear scan in storage order
+	int bruteForceNearest(double lat, double lon, float &distance, bool (*accept)(const SafePointIndex::RallyPoint &))
+	{
+		int nearest = -1;
+		distance = FLT_MAX;
+
+		for (int i = 0; i < _index.numRallyPoints(); ++i) {
+			const SafePointIndex::RallyPoint &point = _index.rallyPoint(i);
+			const float dist = get_distance_to_next_waypoint(lat, lon, point.lat, point.lon);
+
+			if (dist < distance && accept(point)) {
+				distance = dist;
+				nearest = i;
+			}
+		}
+
+		return nearest;
+	}
+
+	MapProjection _proj;
+	mission_item_s _items[600];
+	int _num_items{0};
+	SafePointIndex _index;
+};
+
+TEST_F(SafePointIndexTest, empty)
+{
+	ASSERT_TRUE(_index.build(kApproachRadius));
+	float distance;
+	EXPECT_EQ(_index.findNearest(kRefLat, kRefLon, distance, [](const SafePointIndex::RallyPoint &) { return true; }), -1);
+	EXPECT_EQ(_index.landApproachOwner(kRefLat, kRefLon), -1);
+}
+
+TEST_F(SafePointIndexTest, nearestMatchesLinearScan)
+{
+	addRandomRallyPoints(500, 20000.f);
+	ASSERT_TRUE(_index.build(kApproachRadius));
+	ASSERT_EQ(_index.numRallyPoints(), 500);
+
+	auto accept_all = [](const SafePointIndex::RallyPoint &) { return true; };
+	auto accept_even = [](const SafePointIndex::RallyPoint & point) { return (point.seq % 2) == 0; };
+
+	for (int i = 0; i < 200; ++i) {
+		// queries inside and far outside of the grid
+		const float extent = (i % 4 == 0) ? 200000.f : 25000.f;
+		double lat, lon;
+		_proj.reproject(random(extent), random(extent), lat, lon);
+
+		float distance, expected_distance;
+		EXPECT_EQ(_index.findNearest(lat, lon, distance, accept_all), bruteForceNearest(lat, lon, expected_distance,
+				accept_all));
+		EXPECT_FLOAT_EQ(distance, expected_distance);
+
+		EXPECT_EQ(_index.findNearest(lat, lon, distance, accept_even), bruteForceNearest(lat, lon, expected_distance,
+				accept_even));
+		EXPECT_FLOAT_EQ(distance, expected_distance);
+	}
+}
+
+TEST_F(SafePointIndexTest, singlePoint)
+{
+	addItem(NAV_CMD_RALLY_POINT, 100.f, 200.f);
+	ASSERT_TRUE(_index.build(kApproachRadius));
+
+	double lat, lon;
+	_proj.reproject(100.f, 100.f, lat, lon);
+	float distance;
+	EXPECT_EQ(_index.findNearest(lat, lon, distance, [](const SafePointIndex::RallyPoint &) { return true; }), 0);
+	EXPECT_NEAR(distance, 100.f, 0.5f);
+	EXPECT_EQ(_index.findNearest(lat, lon, distance, [](const SafePointIndex::RallyPoint &) { return false; }), -1);
+}
+
+TEST_F(SafePointIndexTest, landApproaches)
+{
+	addItem(NAV_CMD_LOITER_TO_ALT, 0.f, 0.f);		// ignored: no rally point before
+	addItem(NAV_CMD_RALLY_POINT, 0.f, 0.f);			// 0: two approaches
+	addItem(NAV_CMD_LOITER_TO_ALT, 200.f, 0.f);
+	addItem(NAV_CMD_LOITER_TO_ALT, 0.f, 200.f);
+	addItem(NAV_CMD_RALLY_POINT, 5.f, 0.f);			// 1: within the radius of 0
+	addItem(NAV_CMD_RALLY_POINT, 1000.f, 0.f);		// 2: no approaches
+	addItem(NAV_CMD_RALLY_POINT, 2000.f, 0.f);		// 3: approaches limited to the maximum
+
+	for (int i = 0; i < 10; ++i) {
+		addItem(NAV_CMD_LOITER_TO_ALT, 2000.f, 100.f + i);
+	}
+
+	ASSERT_TRUE(_index.build(kApproachRadius));
+	ASSERT_EQ(_index.numRallyPoints(), 4);
+	EXPECT_EQ(_index.numItems(), 17);
+
+	const SafePointIndex::RallyPoint &first = _index.rallyPoint(0);
+	EXPECT_EQ(first.seq, 1);
+	ASSERT_EQ(first.num_approaches, 2);
+	EXPECT_NEAR(_index.approach(first.first_approach).absoluteAltitude(400.f), 420.f, 1e-3f);
+	EXPECT_FLOAT_EQ(_index.approach(first.first_approach).loiter_radius, 80.f);
+
+	EXPECT_TRUE(_index.hasLandApproach(_index.rallyPoint(0)));
+	EXPECT_EQ(_index.rallyPoint(1).approach_owner, 0); // the first rally point in storage order wins
+	EXPECT_TRUE(_index.hasLandApproach(_index.rallyPoint(1)));
+	EXPECT_FALSE(_index.hasLandApproach(_index.rallyPoint(2)));
+	EXPECT_TRUE(_index.hasLandApproach(_index.rallyPoint(3)));
+	EXPECT_EQ(_index.rallyPoint(3).num_approaches, SafePointIndex::MAX_APPROACHES_PER_POINT);
+
+	double lat, lon;
+	_proj.reproject(3.f, 0.f, lat, lon);
+	EXPECT_EQ(_index.landApproachOwner(lat, lon), 0);
+	_proj.reproject(1008.f, 0.f, lat, lon);
+	EXPECT_EQ(_index.landApproachOwner(lat, lon), 2);
+	_proj.reproject(1020.f, 0.f, lat, lon);
+	EXPECT_EQ(_index.landApproachOwner(lat, lon), -1);
+}
+
+TEST_F(SafePointIndexTest, rebuild)
+{
+	addRandomRallyPoints(100, 5000.f);
+	ASSERT_TRUE(_index.build(kApproachRadius));
+
+	_index.reset();
+	addItem(NAV_CMD_RALLY_POINT, 0.f, 0.f);
+	ASSERT_TRUE(_index.build(kApproachRadius));
+	EXPECT_EQ(_index.numRallyPoints(), 1);
+
+	float distance;
+	EXPECT_EQ(_index.findNearest(kRefLat, kRefLon, distance, [](const SafePointIndex::RallyPoint &) { return true; }), 0);
+	EXPECT_NEAR(distance, 0.f, 0.01f);
+}
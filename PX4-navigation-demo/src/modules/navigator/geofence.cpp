@@ -85,13 +85,6 @@ Geofence::Geofence(Navigator *navigator) :
 	_geofence_status_pub.advertise();
 }
 
-Geofence::~Geofence()
-{
-	if (_polygons) {
-		delete[](_polygons);
-	}
-}
-
 void Geofence::run()
 {
 	bool success;
@@ -208,15 +201,28 @@ void Geofence::updateFence()
 void Geofence::_updateFence()
 {
 	mission_fence_point_s mission_fence_point;
-	bool is_circle_area = false;
+	const dm_item_t fence_dataman_id{static_cast<dm_item_t>(_stats.dataman_id)};
+
+	// compile all polygons and circles into the in-RAM index, projected around the first fence item.
+	// This is the only place the fence items are read, checks do not access dataman.
+	if ((_dataman_cache.size() > 0) && _dataman_cache.loadWait(fence_dataman_id, 0,
+			reinterpret_cast<uint8_t *>(&mission_fence_point), sizeof(mission_fence_point_s))) {
+		_index.reset(mission_fence_point.lat, mission_fence_point.lon);
+
+	} else {
+		_index.reset(0.0, 0.0);
+	}
+
+	if (!_index.reserve(_dataman_cache.size(), _dataman_cache.size())) {
+		PX4_ERR("alloc failed");
+		return;
+	}
 
-	// iterate over all polygons and store their starting vertices
-	_num_polygons = 0;
 	int current_seq = 0;
 
 	while (current_seq < _dataman_cache.size()) {
 
-		bool success = _dataman_cache.loadWait(static_cast<dm_item_t>(_stats.dataman_id), current_seq,
+		bool success = _dataman_cache.loadWait(fence_dataman_id, current_seq,
 						       reinterpret_cast<uint8_t *>(&mission_fence_point),
 						       sizeof(mission_fence_point_s));
 
@@ -233,61 +239,57 @@ void Geofence::_updateFence()
 
 		case NAV_CMD_FENCE_CIRCLE_INCLUSION:
 		case NAV_CMD_FENCE_CIRCLE_EXCLUSION:
-			is_circle_area = true;
+			// a circle in an unsupported frame does not contain any point
+			success = _index.addCircle(mission_fence_point.nav_cmd == NAV_CMD_FENCE_CIRCLE_INCLUSION ?
+						   GeofenceIndex::ShapeType::CircleInclusion : GeofenceIndex::ShapeType::CircleExclusion,
+						   mission_fence_point.lat, mission_fence_point.lon,
+						   isFrameSupported(mission_fence_point.frame) ? mission_fence_point.circle_radius : 0.f);
+			++current_seq;
+
+			if (!success) {
+				PX4_ERR("alloc failed");
+				return;
+			}
+
+			checkFenceRequirements();
+			break;
 
-		/* FALLTHROUGH */
 		case NAV_CMD_FENCE_POLYGON_VERTEX_EXCLUSION:
 		case NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION:
-			if (!is_circle_area && mission_fence_point.vertex_count == 0) {
+			if (mission_fence_point.vertex_count == 0) {
 				++current_seq; // avoid endless loop
 				PX4_ERR("Polygon with 0 vertices. Skipping");
 
 			} else {
-				if (_polygons) {
-					// resize: this is somewhat inefficient, but we do not expect there to be many polygons
-					PolygonInfo *new_polygons = new PolygonInfo[_num_polygons + 1];
-
-					if (new_polygons) {
-						memcpy(new_polygons, _polygons, sizeof(PolygonInfo) * _num_polygons);
-					}
+				const int first_seq = current_seq;
+				const int vertex_count = mission_fence_point.vertex_count;
+				current_seq += vertex_count;
 
-					delete[](_polygons);
-					_polygons = new_polygons;
+				success = _index.beginPolygon(mission_fence_point.nav_cmd == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION ?
+							      GeofenceIndex::ShapeType::PolygonInclusion : GeofenceIndex::ShapeType::PolygonExclusion);
 
-				} else {
-					_polygons = new PolygonInfo[1];
-				}
-
-				if (!_polygons) {
-					_num_polygons = 0;
-					PX4_ERR("alloc failed");
-					return;
-				}
+				// a polygon in an unsupported frame is left empty and does not contain any point
+				const bool frame_supported = isFrameSupported(mission_fence_point.frame);
 
-				PolygonInfo &polygon = _polygons[_num_polygons];
-				polygon.dataman_index = current_seq;
-				polygon.fence_type = mission_fence_point.nav_cmd;
+				for (int seq = first_seq; success && frame_supported && seq < first_seq + vertex_count; ++seq) {
+					mission_fence_point_s vertex;
+					success = _dataman_cache.loadWait(fence_dataman_id, seq, reinterpret_cast<uint8_t *>(&vertex),
+									  sizeof(mission_fence_point_s));
 
-				if (is_circle_area) {
-					polygon.circle_radius = mission_fence_point.circle_radius;
-					current_seq += 1;
+					if (!success) {
+						PX4_ERR("loadWait failed, seq: %i", seq);
+						break;
+					}
 
-				} else {
-					polygon.vertex_count = mission_fence_point.vertex_count;
-					current_seq += mission_fence_point.vertex_count;
+					success = _index.addVertex(vertex.lat, vertex.lon);
 				}
 
-				// check if requiremetns for Home location are met
-				const bool home_check_okay = checkHomeRequirementsForGeofence(polygon);
-
-				// check if current position is inside the fence and vehicle is armed
-				const bool current_position_check_okay = checkCurrentPositionRequirementsForGeofence(polygon);
-
-				// discard the polygon if at least one check fails by not incrementing the counter in that case
-				if (home_check_okay && current_position_check_okay) {
-					++_num_polygons;
-
+				if (!(success && _index.endPolygon())) {
+					PX4_ERR("Geofence polygon at seq %i could not be compiled", first_seq);
+					return;
 				}
+
+				checkFenceRequirements();
 			}
 
 			break;
@@ -300,14 +302,45 @@ void Geofence::_updateFence()
 	}
 }
 
-bool Geofence::checkHomeRequirementsForGeofence(const PolygonInfo &polygon)
+bool Geofence::isFrameSupported(uint8_t frame)
+{
+	switch (frame) {
+	case NAV_FRAME_GLOBAL:
+	case NAV_FRAME_GLOBAL_INT:
+	case NAV_FRAME_GLOBAL_RELATIVE_ALT:
+	case NAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
+		return true;
+
+	default:
+		// TODO: handle different frames
+		PX4_ERR("Frame type %i not supported", (int)frame);
+		return false;
+	}
+}
+
+void Geofence::checkFenceRequirements()
+{
+	const int shape_index = _index.numShapes() - 1;
+
+	// check if requiremetns for Home location are met
+	const bool home_check_okay = checkHomeRequirementsForGeofence(shape_index);
+
+	// check if current position is inside the fence and vehicle is armed
+	const bool current_position_check_okay = checkCurrentPositionRequirementsForGeofence(shape_index);
+
+	// discard the polygon if at least one check fails
+	if (!home_check_okay || !current_position_check_okay) {
+		_index.removeLastShape();
+	}
+}
+
+bool Geofence::checkHomeRequirementsForGeofence(int shape_index)
 {
 	bool checks_pass = true;
 
 	if (_navigator->home_global_position_valid()) {
-		checks_pass = checkPointAgainstPolygonCircle(polygon, _navigator->get_home_position()->lat,
-				_navigator->get_home_position()->lon,
-				_navigator->get_home_position()->alt);
+		checks_pass = _index.checkShape(shape_index, _navigator->get_home_position()->lat,
+				_navigator->get_home_position()->lon);
 	}
 
 
@@ -320,14 +353,14 @@ bool Geofence::checkHomeRequirementsForGeofence(const PolygonInfo &polygon)
 	return checks_pass;
 }
 
-bool Geofence::checkCurrentPositionRequirementsForGeofence(const PolygonInfo &polygon)
+bool Geofence::checkCurrentPositionRequirementsForGeofence(int shape_index)
 {
 	bool checks_pass = true;
 
 	// do not allow upload of geofence if vehicle is flying and current geofence would be immediately violated
 	if (getGeofenceAction() != geofence_result_s::GF_ACTION_NONE && !_navigator->get_land_detected()->landed) {
-		checks_pass = checkPointAgainstPolygonCircle(polygon, _navigator->get_global_position()->lat,
-				_navigator->get_global_position()->lon, _navigator->get_global_position()->alt);
+		checks_pass = _index.checkShape(shape_index, _navigator->get_global_position()->lat,
+						_navigator->get_global_position()->lon);
 	}
 
 	if (!checks_pass) {
@@ -386,139 +419,44 @@ bool Geofence::isInsidePolygonOrCircle(double lat, double lon, float altitude)
 	}
 
 	/* Vertical check */
-	if (_altitude_max > _altitude_min) { // only enable vertical check if configured properly
-		if (altitude > _altitude_max || altitude < _altitude_min) {
-			return false;
-		}
-	}
-
-	/* Horizontal check: iterate all polygons & circles */
-	bool checksPass = true;
-
-	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
-		checksPass &= checkPointAgainstPolygonCircle(_polygons[polygon_index], lat, lon, altitude);
+	if (!isInsideAltitudeLimits(altitude)) {
+		return false;
 	}
 
-	return checksPass;
+	/* Horizontal check: all polygons & circles */
+	return _index.checkAll(lat, lon);
 }
 
-bool Geofence::checkPointAgainstPolygonCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
+bool Geofence::isInsideAltitudeLimits(float altitude)
 {
-	bool checksPass = true;
-
-	switch (polygon.fence_type) {
-	case NAV_CMD_FENCE_CIRCLE_INCLUSION:
-		checksPass &= insideCircle(polygon, lat, lon, altitude);
-		break;
-
-	case NAV_CMD_FENCE_CIRCLE_EXCLUSION:
-		checksPass &= !insideCircle(polygon, lat, lon, altitude);
-		break;
-
-	case NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION:
-		checksPass &= insidePolygon(polygon, lat, lon, altitude);
-		break;
-
-	case NAV_CMD_FENCE_POLYGON_VERTEX_EXCLUSION:
-		checksPass &= !insidePolygon(polygon, lat, lon, altitude);
-		break;
-
-	default:  // unknown fence type
-		break;
+	if (isEmpty()) {
+		/* Empty fence -> accept all altitudes */
+		return true;
 	}
 
-	return checksPass;
-}
-
-bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude)
-{
-	/**
-	 * Adaptation of algorithm originally presented as
-	 * PNPOLY - Point Inclusion in Polygon Test
-	 * W. Randolph Franklin (WRF)
-	 * Only supports non-complex polygons (not self intersecting)
-	 */
-
-	mission_fence_point_s temp_vertex_i{};
-	mission_fence_point_s temp_vertex_j{};
-	bool c = false;
-
-	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
-
-		dm_item_t fence_dataman_id{static_cast<dm_item_t>(_stats.dataman_id)};
-		bool success = _dataman_cache.loadWait(fence_dataman_id, polygon.dataman_index + i,
-						       reinterpret_cast<uint8_t *>(&temp_vertex_i), sizeof(mission_fence_point_s));
-
-		if (!success) {
-			break;
-		}
-
-		success = _dataman_cache.loadWait(fence_dataman_id, polygon.dataman_index + j,
-						  reinterpret_cast<uint8_t *>(&temp_vertex_j), sizeof(mission_fence_point_s));
-
-		if (!success) {
-			break;
-		}
-
-		switch (temp_vertex_i.frame) {
-		case NAV_FRAME_GLOBAL:
-		case NAV_FRAME_GLOBAL_INT:
-		case NAV_FRAME_GLOBAL_RELATIVE_ALT:
-		case NAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
-			break;
-
-		default:
-			// TODO: handle different frames
-			PX4_ERR("Frame type %i not supported", (int)temp_vertex_i.frame);
-			return c;
-
-		}
-
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
-			c = !c;
+	if (_altitude_max > _altitude_min) { // only enable vertical check if configured properly
+		if (altitude > _altitude_max || altitude < _altitude_min) {
+			return false;
 		}
 	}
 
-	return c;
+	return true;
 }
 
-bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
+bool Geofence::getFirstBreachAlongPath(const matrix::Vector2<double> *path_lat_lon, int num_points,
+				       float &breach_distance)
 {
-
-	mission_fence_point_s circle_point{};
-	bool success = _dataman_cache.loadWait(static_cast<dm_item_t>(_stats.dataman_id), polygon.dataman_index,
-					       reinterpret_cast<uint8_t *>(&circle_point), sizeof(mission_fence_point_s));
-
-	if (!success) {
-		PX4_ERR("dm_read failed");
+	if (isEmpty()) {
 		return false;
 	}
 
-	switch (circle_point.frame) {
-	case NAV_FRAME_GLOBAL:
-	case NAV_FRAME_GLOBAL_INT:
-	case NAV_FRAME_GLOBAL_RELATIVE_ALT:
-	case NAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
-		break;
-
-	default:
-		// TODO: handle different frames
-		PX4_ERR("Frame type %i not supported", (int)circle_point.frame);
-		return false;
+	const GeofenceIndex::PathBreach breach = _index.firstBreachAlongPath(path_lat_lon, num_points);
 
+	if (breach.breach) {
+		breach_distance = breach.distance;
 	}
 
-	if (!_projection_reference.isInitialized()) {
-		_projection_reference.initReference(lat, lon, hrt_absolute_time());
-	}
-
-	float x1, y1, x2, y2;
-	_projection_reference.project(lat, lon, x1, y1);
-	_projection_reference.project(circle_point.lat, circle_point.lon, x2, y2);
-	float dx = x1 - x2, dy = y1 - y2;
-	return dx * dx + dy * dy < circle_point.circle_radius * circle_point.circle_radius;
+	return breach.breach;
 }
 
 bool
@@ -689,36 +627,31 @@ bool Geofence::isHomeRequired()
 
 void Geofence::printStatus()
 {
-	int num_inclusion_polygons = 0, num_exclusion_polygons = 0, total_num_vertices = 0;
+	int num_inclusion_polygons = 0, num_exclusion_polygons = 0;
 	int num_inclusion_circles = 0, num_exclusion_circles = 0;
 
-	for (int i = 0; i < _num_polygons; ++i) {
-		total_num_vertices += _polygons[i].vertex_count;
-
-		switch (_polygons[i].fence_type) {
-		case NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION:
+	for (int i = 0; i < _index.numShapes(); ++i) {
+		switch (_index.shape(i).type) {
+		case GeofenceIndex::ShapeType::PolygonInclusion:
 			++num_inclusion_polygons;
 			break;
 
-		case NAV_CMD_FENCE_POLYGON_VERTEX_EXCLUSION:
+		case GeofenceIndex::ShapeType::PolygonExclusion:
 			++num_exclusion_polygons;
 			break;
 
-		case NAV_CMD_FENCE_CIRCLE_INCLUSION:
+		case GeofenceIndex::ShapeType::CircleInclusion:
 			++num_inclusion_circles;
 			break;
 
-		case NAV_CMD_FENCE_CIRCLE_EXCLUSION:
+		case GeofenceIndex::ShapeType::CircleExclusion:
 			++num_exclusion_circles;
 			break;
-
-		default:  // unknown fence type
-			break;
-
 		}
 	}
 
 	PX4_INFO("Geofence: %i inclusion, %i exclusion polygons, %i inclusion circles, %i exclusion circles, %i total vertices",
 		 num_inclusion_polygons, num_exclusion_polygons, num_inclusion_circles, num_exclusion_circles,
-		 total_num_vertices);
+		 _index.numVertices());
+	PX4_INFO("Geofence index: %i edge bucket entries", _index.numBucketEntries());
 }
@@ -47,6 +47,7 @@
 #include <px4_platform_common/module_params.h>
 #include <drivers/drv_hrt.h>
 #include <lib/geo/geo.h>
+#include <lib/geofence/GeofenceIndex.hpp>
 #include <px4_platform_common/defines.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/geofence_status.h>
@@ -64,7 +65,7 @@ public:
 	Geofence(Navigator *navigator);
 	Geofence(const Geofence &) = delete;
 	Geofence &operator=(const Geofence &) = delete;
-	virtual ~Geofence();
+	virtual ~Geofence() = default;
 
 	/* Source, corresponding to the param GF_SOURCE */
 	enum {
@@ -109,6 +110,25 @@ public:
 
 	virtual bool isInsidePolygonOrCircle(double lat, double lon, float altitude);
 
+	/**
+	 * @brief check the altitude against the minimum and maximum altitude of the polygons and circles
+	 *
+	 * @return true if the altitude is within the limits or no limits are configured
+	 */
+	virtual bool isInsideAltitudeLimits(float altitude);
+
+	/**
+	 * Find the first point along a horizontal path where a polygon or circle is violated.
+	 * All polygons and circles are tested in a single pass over the path, e.g. the predicted
+	 * track of the vehicle. Altitude limits are not considered, see isInsideAltitudeLimits().
+	 *
+	 * @param path_lat_lon path points as latitude/longitude [deg]
+	 * @param breach_distance distance along the path to the first breach [m], only set if a breach is found
+	 * @return true if the path breaches a polygon or circle
+	 */
+	virtual bool getFirstBreachAlongPath(const matrix::Vector2<double> *path_lat_lon, int num_points,
+					     float &breach_distance);
+
 	bool valid();
 
 	/**
@@ -132,7 +152,12 @@ public:
 	 */
 	int loadFromFile(const char *filename);
 
-	bool isEmpty() { return (!_fence_updated || (_num_polygons == 0)); }
+	bool isEmpty() { return (!_fence_updated || (_index.numShapes() == 0)); }
+
+	/**
+	 * @return the compiled polygons and circles, e.g. for exact path checks in the local frame of the fence
+	 */
+	const GeofenceIndex &getIndex() const { return _index; }
 
 	int getSource() { return _param_gf_source.get(); }
 	int getGeofenceAction() { return _param_gf_action.get(); }
@@ -157,17 +182,9 @@ private:
 		Error
 	};
 
-	struct PolygonInfo {
-		uint16_t fence_type; ///< one of MAV_CMD_NAV_FENCE_* (can also be a circular region)
-		uint16_t dataman_index;
-		union {
-			uint16_t vertex_count;
-			float circle_radius;
-		};
-	};
-
 	Navigator   *_navigator{nullptr};
-	PolygonInfo *_polygons{nullptr};
+
+	GeofenceIndex _index{}; ///< compiled polygons and circles, built once per fence update
 
 	mission_stats_entry_s _stats;
 	DatamanState _dataman_state{DatamanState::UpdateRequestWait};
@@ -178,10 +195,6 @@ private:
 	float _altitude_min{0.0f};
 	float _altitude_max{0.0f};
 
-	int _num_polygons{0};
-
-	MapProjection _projection_reference{}; ///< class to convert (lon, lat) to local [m]
-
 	uint32_t _opaque_id{0}; ///< dataman geofence id: if it does not match, the polygon data was updated
 	bool _fence_updated{true};  ///< flag indicating if fence are updated to dataman cache
 	bool _initiate_fence_updated{true}; ///< flag indicating if fence updated is needed
@@ -195,36 +208,27 @@ private:
 
 
 	/**
-	 * Check if a single point is within a polygon
-	 * @return true if within polygon
+	 * @return true if fence items in the given frame can be handled
 	 */
-	bool insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude);
+	bool isFrameSupported(uint8_t frame);
 
 	/**
-	 * Check if a single point is within a circle
-	 * @param polygon must be a circle!
-	 * @return true if within polygon the circle
+	 * Check the requirements relative to Home and the current vehicle position for the
+	 * last compiled polygon or circle, and discard it from the index if they are not met.
 	 */
-	bool insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude);
-
-	/**
-	 * Check if a single point is within a polygon or circle
-	 * @return true if within polygon or circle
-	 */
-
-	bool checkPointAgainstPolygonCircle(const PolygonInfo &polygon, double lat, double lon, float altitude);
+	void checkFenceRequirements();
 
 	/**
 	 * Check polygon or circle geofence fullfills the requirements relative to Home.
 	 * @return true if checks pass
 	 */
-	bool checkHomeRequirementsForGeofence(const PolygonInfo &polygon);
+	bool checkHomeRequirementsForGeofence(int shape_index);
 
 	/**
 	 * Check polygon or circle geofence fullfills the requirements relative to the current vehicle position.
 	 * @return true if checks pass
 	 */
-	bool checkCurrentPositionRequirementsForGeofence(const PolygonInfo &polygon);
+	bool checkCurrentPositionRequirementsForGeofence(int shape_index);
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::GF_ACTION>)         _param_gf_action,
@@ -49,7 +49,8 @@
 MissionBase::MissionBase(Navigator *navigator, int32_t dataman_cache_size_signed, uint8_t navigator_state_id) :
 	MissionBlock(navigator, navigator_state_id),
 	ModuleParams(navigator),
-	_dataman_cache_size_signed(dataman_cache_size_signed)
+	_dataman_cache_size_signed(dataman_cache_size_signed),
+	_mission_model(navigator->get_mission_model())
 {
 	_dataman_cache.resize(abs(dataman_cache_size_signed));
 
@@ -109,6 +110,10 @@ void MissionBase::updateMavlinkMission()
 
 		_mission = new_mission;
 
+		if (!_mission_model.isBuiltFor(_mission)) {
+			buildMissionModel();
+		}
+
 		/* Relevant mission items updated externally*/
 		if (mission_data_changed) {
 
@@ -290,9 +295,22 @@ MissionBase::on_active()
 
 		if (num_found_items == 1U && !PX4_ISFINITE(_mission_item.yaw)) {
 			mission_item_s next_position_mission_item;
-			const dm_item_t mission_dataman_id = static_cast<dm_item_t>(_mission.mission_dataman_id);
-			bool success = _dataman_cache.loadWait(mission_dataman_id, next_mission_item_index,
-							       reinterpret_cast<uint8_t *>(&next_position_mission_item), sizeof(next_position_mission_item), MAX_DATAMAN_LOAD_WAIT);
+			bool success{false};
+
+			if (_mission_model.isValidFor(_mission)) {
+				const MissionModel::PositionItem *position_item = _mission_model.positionItem(next_mission_item_index);
+				success = position_item != nullptr;
+
+				if (success) {
+					next_position_mission_item.lat = position_item->latitude();
+					next_position_mission_item.lon = position_item->longitude();
+				}
+
+			} else {
+				const dm_item_t mission_dataman_id = static_cast<dm_item_t>(_mission.mission_dataman_id);
+				success = _dataman_cache.loadWait(mission_dataman_id, next_mission_item_index,
+								  reinterpret_cast<uint8_t *>(&next_position_mission_item), sizeof(next_position_mission_item), MAX_DATAMAN_LOAD_WAIT);
+			}
 
 			if (success) {
 				_mission_item.yaw = matrix::wrap_pi(get_bearing_to_next_waypoint(_mission_item.lat, _mission_item.lon,
@@ -1007,7 +1025,10 @@ int MissionBase::getNonJumpItem(int32_t &mission_index, mission_item_s &mission,
 					success = _dataman_cache.writeWait(mission_dataman_id, new_mission_index, reinterpret_cast<uint8_t *>(&new_mission),
 									   sizeof(struct mission_item_s));
 
-					if (!success) {
+					if (success) {
+						_mission_model.setJumpCurrentCount(new_mission_index, new_mission.do_jump_current_count);
+
+					} else {
 						/* not supposed to happen unless the datamanager can't access the dataman */
 						mavlink_log_critical(_navigator->get_mavlink_log_pub(), "DO JUMP waypoint could not be written.\t");
 						events::send(events::ID("mission_failed_to_write_do_jump"), events::Log::Error,
@@ -1065,6 +1086,11 @@ void MissionBase::setMissionIndex(int32_t index)
 void MissionBase::getPreviousPositionItems(int32_t start_index, int32_t items_index[],
 		size_t &num_found_items, uint8_t max_num_items)
 {
+	if (_mission_model.isValidFor(_mission)) {
+		num_found_items = _mission_model.previousPositionItems(start_index, items_index, max_num_items);
+		return;
+	}
+
 	num_found_items = 0u;
 
 	int32_t next_mission_index{start_index};
@@ -1095,6 +1121,11 @@ void MissionBase::getPreviousPositionItems(int32_t start_index, int32_t items_in
 void MissionBase::getNextPositionItems(int32_t start_index, int32_t items_index[],
 				       size_t &num_found_items, uint8_t max_num_items)
 {
+	if (_mission_model.isValidFor(_mission)) {
+		num_found_items = _mission_model.nextPositionItems(start_index, items_index, max_num_items);
+		return;
+	}
+
 	// Make sure vector does not contain any preexisting elements.
 	num_found_items = 0u;
 
@@ -1177,6 +1208,34 @@ int MissionBase::setMissionToClosestItem(double lat, double lon, float alt, floa
 {
 	int32_t min_dist_index(-1);
 	float min_dist(FLT_MAX), dist_xy(FLT_MAX), dist_z(FLT_MAX);
+
+	if (_mission_model.isValidFor(_mission)) {
+		for (int i = 0; i < _mission_model.numPositionItems(); i++) {
+			const MissionModel::PositionItem &position_item = _mission_model.positionItemAt(i);
+
+			// do not consider land waypoints for a fw
+			if (!((position_item.nav_cmd == NAV_CMD_LAND) &&
+			      (vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING) &&
+			      (!vehicle_status.is_vtol))) {
+				float dist = get_distance_to_point_global_wgs84(position_item.latitude(), position_item.longitude(),
+						position_item.absoluteAltitude(home_alt),
+						lat,
+						lon,
+						alt,
+						&dist_xy, &dist_z);
+
+				if (dist < min_dist) {
+					min_dist = dist;
+					min_dist_index = position_item.mission_index;
+				}
+			}
+		}
+
+		setMissionIndex(min_dist_index);
+
+		return PX4_OK;
+	}
+
 	const dm_item_t mission_dataman_id = static_cast<dm_item_t>(_mission.mission_dataman_id);
 
 	for (int32_t mission_item_index = 0; mission_item_index < _mission.count; mission_item_index++) {
@@ -1251,32 +1310,57 @@ void MissionBase::resetMissionJumpCounter()
 {
 	const dm_item_t mission_dataman_id = static_cast<dm_item_t>(_mission.mission_dataman_id);
 
-	for (size_t mission_index = 0u; mission_index < _mission.count; mission_index++) {
-		mission_item_s mission_item;
-
-		bool success = _dataman_client.readSync(mission_dataman_id, mission_index, reinterpret_cast<uint8_t *>(&mission_item),
-							sizeof(mission_item_s), MAX_DATAMAN_LOAD_WAIT);
-
-		if (!success) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission could not reset jump count.\t");
-			events::send(events::ID("mission_failed_set_jump_count"), events::Log::Error,
-				     "Mission could not reset jump count");
-			break;
-		}
-
+	// a failed write stops reading, it is reported on its own
+	const bool read_success = _navigator->get_mission_item_reader().forEach(0u, _mission.count,
+	[this, mission_dataman_id](uint16_t first_index, uint16_t num_items, mission_item_s * mission_items) {
+		return _dataman_client.readRange(mission_dataman_id, first_index, num_items, reinterpret_cast<uint8_t *>(mission_items),
+						 sizeof(mission_item_s));
+	},
+	[this, mission_dataman_id](mission_item_s & mission_item, uint16_t index) {
 		if (mission_item.nav_cmd == NAV_CMD_DO_JUMP) {
 			mission_item.do_jump_current_count = 0u;
 
-			bool write_success = _dataman_cache.writeWait(mission_dataman_id, mission_index,
-					     reinterpret_cast<uint8_t *>(&mission_item),
-					     sizeof(struct mission_item_s));
+			const bool write_success = _dataman_cache.writeWait(mission_dataman_id, index, reinterpret_cast<uint8_t *>(&mission_item),
+					sizeof(struct mission_item_s));
 
 			if (!write_success) {
 				PX4_ERR("Could not write mission item for jump count reset.");
-				break;
+				return false;
 			}
+
+			_mission_model.setJumpCurrentCount(index, 0u);
 		}
+
+		return true;
+	});
+
+	if (!read_success) {
+		/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission could not reset jump count.\t");
+		events::send(events::ID("mission_failed_set_jump_count"), events::Log::Error,
+			     "Mission could not reset jump count");
+	}
+}
+
+void MissionBase::buildMissionModel()
+{
+	_mission_model.beginBuild(_mission);
+
+	const dm_item_t mission_dataman_id = static_cast<dm_item_t>(_mission.mission_dataman_id);
+
+	const bool success = _navigator->get_mission_item_reader().forEach(0u, _mission.count,
+	[this, mission_dataman_id](uint16_t first_index, uint16_t num_items, mission_item_s * mission_items) {
+		return _dataman_client.readRange(mission_dataman_id, first_index, num_items, reinterpret_cast<uint8_t *>(mission_items),
+						 sizeof(mission_item_s));
+	},
+	[this](mission_item_s & mission_item, uint16_t index) {
+		return _mission_model.addItem(mission_item, MissionBlock::item_contains_position(mission_item));
+	});
+
+	if (!success || !_mission_model.endBuild()) {
+		// queries fall back to reading the mission items from dataman
+		PX4_WARN("Mission model could not be built");
+		_mission_model.invalidate();
 	}
 }
 
@@ -1383,16 +1467,21 @@ bool MissionBase::cameraWasTriggering()
 
 void MissionBase::updateCachedItemsUpToIndex(const int end_index)
 {
-	for (int i = 0; i <= end_index; i++) {
-		mission_item_s mission_item;
-		const dm_item_t dm_current = (dm_item_t)_mission.mission_dataman_id;
-		bool success = _dataman_client.readSync(dm_current, i, reinterpret_cast<uint8_t *>(&mission_item),
-							sizeof(mission_item), 500_ms);
-
-		if (success) {
-			cacheItem(mission_item);
-		}
+	if (end_index < 0) {
+		return;
 	}
+
+	const dm_item_t dm_current = (dm_item_t)_mission.mission_dataman_id;
+
+	_navigator->get_mission_item_reader().forEach(0u, end_index + 1,
+	[this, dm_current](uint16_t first_index, uint16_t num_items, mission_item_s * mission_items) {
+		return _dataman_client.readRange(dm_current, first_index, num_items, reinterpret_cast<uint8_t *>(mission_items),
+						 sizeof(mission_item_s));
+	},
+	[this](mission_item_s & mission_item, uint16_t index) {
+		cacheItem(mission_item);
+		return true;
+	});
 }
 
 void MissionBase::parameters_update()
@@ -1419,9 +1508,21 @@ void MissionBase::checkClimbRequired(int32_t mission_item_index)
 		mission_item_s mission;
 		_mission_init_climb_altitude_amsl = NAN; // default to NAN, overwrite below if applicable
 
-		const bool success = _dataman_cache.loadWait(mission_dataman_id, next_mission_item_index,
-				     reinterpret_cast<uint8_t *>(&mission),
-				     sizeof(mission), MAX_DATAMAN_LOAD_WAIT);
+		bool success{false};
+		const MissionModel::PositionItem *position_item = _mission_model.isValidFor(_mission) ?
+				_mission_model.positionItem(next_mission_item_index) : nullptr;
+
+		if (position_item != nullptr) {
+			mission.nav_cmd = position_item->nav_cmd;
+			mission.altitude = position_item->altitude;
+			mission.altitude_is_relative = position_item->altitude_is_relative;
+			success = true;
+
+		} else {
+			success = _dataman_cache.loadWait(mission_dataman_id, next_mission_item_index,
+							  reinterpret_cast<uint8_t *>(&mission),
+							  sizeof(mission), MAX_DATAMAN_LOAD_WAIT);
+		}
 
 		const bool is_fw_and_takeoff = mission.nav_cmd == NAV_CMD_TAKEOFF
 					       && _vehicle_status_sub.get().vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING;
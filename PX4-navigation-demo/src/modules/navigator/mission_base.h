@@ -57,6 +57,7 @@
 
 #include "mission_block.h"
 #include "navigation.h"
+#include "MissionModel/MissionModel.hpp"
 
 using namespace time_literals;
 
@@ -337,6 +338,8 @@ protected:
 	int32_t _load_mission_index{-1}; /**< Mission inted of loaded mission items in dataman cache*/
 	int32_t _dataman_cache_size_signed; /**< Size of the dataman cache. A negativ value indicates that previous mission items should be loaded, a positiv value the next mission items*/
 
+	MissionModel &_mission_model; /**< In-RAM model of the position and jump items owned by the navigator, built once per mission update*/
+
 	DatamanCache _dataman_cache{"mission_dm_cache_miss", 10}; /**< Dataman cache of mission items*/
 	DatamanClient	&_dataman_client = _dataman_cache.client(); /**< Dataman client*/
 
@@ -351,12 +354,18 @@ private:
 	 * @brief Maximum number of jump mission items iterations
 	 *
 	 */
-	static constexpr uint16_t MAX_JUMP_ITERATION{10u};
+	static constexpr uint16_t MAX_JUMP_ITERATION{MissionModel::MAX_JUMP_ITERATION};
 	/**
 	 * @brief Update Dataman cache
 	 *
 	 */
 	virtual void updateDatamanCache();
+	/**
+	 * @brief Build the mission model from the mission items in dataman
+	 *
+	 * If the items cannot be read, the model stays invalid and queries read the items from dataman instead.
+	 */
+	void buildMissionModel();
 	/**
 	 * @brief Update mission subscription
 	 *
@@ -73,31 +73,22 @@ MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission)
 		return false;
 	}
 
-	bool failed = false;
+	// Legs between the items are intersected with the fence boundaries while the items are processed
+	Geofence &geofence = _navigator->get_geofence();
+	_feasibility_checker.setGeofence((geofence.valid() && !geofence.isEmpty()) ? &geofence.getIndex() : nullptr);
 
-	for (size_t i = 0; i < mission.count; i++) {
-		struct mission_item_s missionitem = {};
-
-		bool success = _dataman_client.readSync((dm_item_t)mission.mission_dataman_id, i,
-							reinterpret_cast<uint8_t *>(&missionitem),
-							sizeof(mission_item_s));
-
-		if (!success) {
-			_navigator->get_mission_result()->warning = true;
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
-
-		if (!_feasibility_checker.processNextItem(missionitem, i, mission.count)) {
-			failed = true;
-			break;
-		}
+	GeofenceViolation geofence_violation{};
+	const bool items_read = checkItems(mission, _navigator->get_home_position()->alt, home_valid, geofence_violation);
 
+	if (!items_read) {
+		_navigator->get_mission_result()->warning = true;
+		/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+		return false;
 	}
 
-	failed |= _feasibility_checker.someCheckFailed();
+	bool failed = _feasibility_checker.someCheckFailed();
 
-	failed |= !checkMissionAgainstGeofence(mission, _navigator->get_home_position()->alt, home_valid);
+	failed |= !checkMissionAgainstGeofence(home_valid, geofence_violation);
 
 	_navigator->get_mission_result()->warning = failed;
 
@@ -105,7 +96,35 @@ MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission)
 }
 
 bool
-MissionFeasibilityChecker::checkMissionAgainstGeofence(const mission_s &mission, float home_alt, bool home_valid)
+MissionFeasibilityChecker::checkItems(const mission_s &mission, float home_alt, bool home_valid,
+				      GeofenceViolation &geofence_violation)
+{
+	const bool check_geofence = _navigator->get_geofence().valid();
+	bool checks_done = false;
+
+	// single pass over the items, each chunk is read from dataman with one request
+	return _navigator->get_mission_item_reader().forEach(0u, mission.count,
+	[this, &mission](uint16_t first_index, uint16_t num_items, mission_item_s * mission_items) {
+		return _dataman_client.readRange((dm_item_t)mission.mission_dataman_id, first_index, num_items,
+						 reinterpret_cast<uint8_t *>(mission_items), sizeof(mission_item_s));
+	},
+	[&](mission_item_s & mission_item, uint16_t index) {
+		if (check_geofence && (geofence_violation.type == GeofenceViolation::Type::None)) {
+			geofence_violation = checkItemAgainstGeofence(mission_item, index, home_alt, home_valid);
+		}
+
+		if (!checks_done) {
+			// a fatal error ends the checks, the failed check is reported by someCheckFailed()
+			checks_done = !_feasibility_checker.processNextItem(mission_item, index, mission.count);
+		}
+
+		// keep reading while the geofence check still needs the remaining items
+		return !checks_done || (check_geofence && (geofence_violation.type == GeofenceViolation::Type::None));
+	});
+}
+
+bool
+MissionFeasibilityChecker::checkMissionAgainstGeofence(bool home_valid, const GeofenceViolation &violation)
 {
 	if (_navigator->get_geofence().isHomeRequired() && !home_valid) {
 		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
@@ -114,41 +133,51 @@ MissionFeasibilityChecker::checkMissionAgainstGeofence(const mission_s &mission,
 		return false;
 	}
 
-	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
-	if (_navigator->get_geofence().valid()) {
-		for (size_t i = 0; i < mission.count; i++) {
-			struct mission_item_s missionitem = {};
-
-			bool success = _dataman_client.readSync((dm_item_t)mission.mission_dataman_id, i,
-								reinterpret_cast<uint8_t *>(&missionitem),
-								sizeof(mission_item_s));
-
-			if (!success) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-				return false;
-			}
-
-			if (missionitem.altitude_is_relative && !home_valid) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
-				events::send(events::ID("navigator_mis_geofence_no_home2"), {events::Log::Error, events::LogInternal::Info},
-					     "Geofence requires a valid home position");
-				return false;
-			}
-
-			// Geofence function checks against home altitude amsl
-			missionitem.altitude = missionitem.altitude_is_relative ? missionitem.altitude + home_alt : missionitem.altitude;
-
-			if (MissionBlock::item_contains_position(missionitem) && !_navigator->get_geofence().checkPointAgainstAllGeofences(
-				    missionitem.lat, missionitem.lon, missionitem.altitude)) {
-
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu\t", i + 1);
-				events::send<int16_t>(events::ID("navigator_mis_geofence_violation"), {events::Log::Error, events::LogInternal::Info},
-						      "Geofence violation for waypoint {1}",
-						      i + 1);
-				return false;
-			}
-		}
+	if (!_navigator->get_geofence().valid()) {
+		return true;
+	}
+
+	/* Report the first mission item outside of the geofence (if we have a valid geofence) */
+	switch (violation.type) {
+	case GeofenceViolation::Type::HomeRequired:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
+		events::send(events::ID("navigator_mis_geofence_no_home2"), {events::Log::Error, events::LogInternal::Info},
+			     "Geofence requires a valid home position");
+		return false;
+
+	case GeofenceViolation::Type::Waypoint:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %d\t", violation.index + 1);
+		events::send<int16_t>(events::ID("navigator_mis_geofence_violation"), {events::Log::Error, events::LogInternal::Info},
+				      "Geofence violation for waypoint {1}",
+				      violation.index + 1);
+		return false;
+
+	case GeofenceViolation::Type::None:
+		break;
 	}
 
 	return true;
 }
+
+MissionFeasibilityChecker::GeofenceViolation
+MissionFeasibilityChecker::checkItemAgainstGeofence(const mission_item_s &mission_item, int index, float home_alt,
+		bool home_valid)
+{
+	GeofenceViolation violation{};
+
+	if (mission_item.altitude_is_relative && !home_valid) {
+		violation.type = GeofenceViolation::Type::HomeRequired;
+		violation.index = index;
+
+	} else if (MissionBlock::item_contains_position(mission_item)) {
+		// Geofence function checks against home altitude amsl
+		const float altitude = mission_item.altitude_is_relative ? mission_item.altitude + home_alt : mission_item.altitude;
+
+		if (!_navigator->get_geofence().checkPointAgainstAllGeofences(mission_item.lat, mission_item.lon, altitude)) {
+			violation.type = GeofenceViolation::Type::Waypoint;
+			violation.index = index;
+		}
+	}
+
+	return violation;
+}
@@ -52,11 +52,39 @@ class Navigator;
 class MissionFeasibilityChecker: public ModuleParams
 {
 private:
+	/**
+	 * Result of the geofence check of the mission items
+	 */
+	struct GeofenceViolation {
+		enum class Type {
+			None,
+			HomeRequired,	///< relative altitude without valid home
+			Waypoint	///< position item outside of the geofence
+		};
+
+		Type type{Type::None};
+		int index{-1};		///< mission index of the position item
+	};
+
 	Navigator *_navigator{nullptr};
 	DatamanClient &_dataman_client;
 	FeasibilityChecker _feasibility_checker;
 
-	bool checkMissionAgainstGeofence(const mission_s &mission, float home_alt, bool home_valid);
+	/**
+	 * Read the mission items from dataman in chunks and run them through the feasibility checker and
+	 * the geofence check in a single pass
+	 * @param geofence_violation set to the first item violating the geofence
+	 * @return false if an item could not be read
+	 */
+	bool checkItems(const mission_s &mission, float home_alt, bool home_valid, GeofenceViolation &geofence_violation);
+
+	bool checkMissionAgainstGeofence(bool home_valid, const GeofenceViolation &violation);
+
+	/**
+	 * Check a mission item against the geofence, the legs between the items are checked by the feasibility checker
+	 */
+	GeofenceViolation checkItemAgainstGeofence(const mission_item_s &mission_item, int index, float home_alt,
+			bool home_valid);
 
 public:
 	MissionFeasibilityChecker(Navigator *navigator, DatamanClient &dataman_client) :
@@ -56,6 +56,7 @@
 #include "navigation.h"
 
 #include "GeofenceBreachAvoidance/geofence_breach_avoidance.h"
+#include "MissionModel/MissionItemChunkReader.hpp"
 
 #if CONFIG_NAVIGATOR_ADSB
 #include <lib/adsb/AdsbConflict.h>
@@ -179,6 +180,16 @@ public:
 
 	Geofence &get_geofence() { return _geofence; }
 
+	/**
+	 * Reader for the mission items, its chunk buffer is kept off the navigator stack
+	 */
+	MissionItemChunkReader &get_mission_item_reader() { return _mission_item_reader; }
+
+	/**
+	 * In-RAM model of the current mission, shared by the mission and the mission based RTL types
+	 */
+	MissionModel &get_mission_model() { return _mission_model; }
+
 	float get_default_loiter_rad() { return fabsf(_param_nav_loiter_rad.get()); }
 	bool get_default_loiter_CCW() { return _param_nav_loiter_rad.get() < -FLT_EPSILON; }
 
@@ -356,6 +367,9 @@ private:
 	GeofenceBreachAvoidance _gf_breach_avoidance;
 	hrt_abstime _last_geofence_check{0};
 
+	MissionItemChunkReader _mission_item_reader;
+	MissionModel _mission_model;			/**< constructed before the navigation modes which keep a reference */
+
 	bool _navigator_status_updated{false};
 	hrt_abstime _last_navigator_status_publication{0};
 
@@ -1005,11 +1005,18 @@ void Navigator::geofence_breach_check()
 		double test_point_longitude = current_longitude;
 		float test_point_altitude = current_altitude;
 
+		bool predicted_fence_breach = false;
+
 		if (_geofence.getPredict()) {
 			matrix::Vector2<double>fence_violation_test_point = _gf_breach_avoidance.getFenceViolationTestPoint();
 			test_point_latitude = fence_violation_test_point(0);
 			test_point_longitude = fence_violation_test_point(1);
 			test_point_altitude = current_altitude + vertical_test_point_distance;
+
+			// check the whole predicted track, not only its end point, to catch fences in between
+			const matrix::Vector2<double> predicted_track[2] {{current_latitude, current_longitude}, fence_violation_test_point};
+			float breach_distance;
+			predicted_fence_breach = _geofence.getFirstBreachAlongPath(predicted_track, 2, breach_distance);
 		}
 
 		if (_time_loitering_after_gf_breach > 0) {
@@ -1018,14 +1025,14 @@ void Navigator::geofence_breach_check()
 					test_point_longitude, test_point_altitude);
 			_geofence_result.geofence_max_alt_triggered |= !_geofence.isBelowMaxAltitude(test_point_altitude);
 			_geofence_result.geofence_custom_fence_triggered |= !_geofence.isInsidePolygonOrCircle(test_point_latitude,
-					test_point_longitude, test_point_altitude);
+					test_point_longitude, test_point_altitude) || predicted_fence_breach;
 
 		} else {
 			_geofence_result.geofence_max_dist_triggered = !_geofence.isCloserThanMaxDistToHome(test_point_latitude,
 					test_point_longitude, test_point_altitude);
 			_geofence_result.geofence_max_alt_triggered = !_geofence.isBelowMaxAltitude(test_point_altitude);
 			_geofence_result.geofence_custom_fence_triggered = !_geofence.isInsidePolygonOrCircle(test_point_latitude,
-					test_point_longitude, test_point_altitude);
+					test_point_longitude, test_point_altitude) || predicted_fence_breach;
 		}
 
 		_last_geofence_check = hrt_absolute_time();
@@ -130,6 +130,7 @@ void RTL::updateDatamanCache()
 
 		if (!_dataman_cache_safepoint.isLoading()) {
 			_dataman_state = DatamanState::UpdateRequestWait;
+			buildSafePointIndex();
 			_safe_points_updated = true;
 		}
 
@@ -404,49 +405,78 @@ void RTL::setRtlTypeAndDestination()
 	_rtl_status_pub.publish(rtl_status);
 }
 
-PositionYawSetpoint RTL::findClosestSafePoint(float min_dist, uint8_t &safe_point_index)
+void RTL::buildSafePointIndex()
 {
-	const bool vtol_in_fw_mode = _vehicle_status_sub.get().is_vtol
-				     && (_vehicle_status_sub.get().vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING);
+	_safe_point_index.reset();
 
-	PositionYawSetpoint safe_point{(double)NAN, (double)NAN, NAN, NAN};
+	for (int current_seq = 0; current_seq < _dataman_cache_safepoint.size(); ++current_seq) {
+		mission_item_s mission_safe_point{};
 
-	if (_safe_points_updated) {
-		_one_rally_point_has_land_approach = false;
+		// the items are already in the cache, this does not wait
+		const bool success = _dataman_cache_safepoint.loadWait(static_cast<dm_item_t>(_stats.dataman_id), current_seq,
+				     reinterpret_cast<uint8_t *>(&mission_safe_point),
+				     sizeof(mission_item_s), 500_ms);
 
-		for (int current_seq = 0; current_seq < _dataman_cache_safepoint.size(); ++current_seq) {
-			mission_item_s mission_safe_point;
+		if (!success) {
+			PX4_ERR("dm_read failed");
+			mission_safe_point = {}; // keep the storage order of the following items
+		}
 
-			const bool success = _dataman_cache_safepoint.loadWait(static_cast<dm_item_t>(_stats.dataman_id), current_seq,
-					     reinterpret_cast<uint8_t *>(&mission_safe_point),
-					     sizeof(mission_item_s), 500_ms);
+		if (!_safe_point_index.addItem(mission_safe_point)) {
+			break;
+		}
+	}
 
-			if (!success) {
-				PX4_ERR("dm_read failed");
-				continue;
-			}
+	if (!_safe_point_index.build(MAX_DIST_FROM_HOME_FOR_LAND_APPROACHES)) {
+		PX4_ERR("safe point index allocation failed");
+	}
 
-			// Ignore safepoints which are too close to the homepoint (only if home is an option to return to)
-			const bool far_from_home = get_distance_to_next_waypoint(_home_pos_sub.get().lat, _home_pos_sub.get().lon,
-						   mission_safe_point.lat, mission_safe_point.lon) > MAX_DIST_FROM_HOME_FOR_LAND_APPROACHES;
+	updateRallyPointLandApproach();
+}
+
+void RTL::updateRallyPointLandApproach()
+{
+	_land_approach_home_update_count = _home_pos_sub.get().update_count;
+	_one_rally_point_has_land_approach = false;
+
+	for (int i = 0; i < _safe_point_index.numRallyPoints() && !_one_rally_point_has_land_approach; ++i) {
+		const SafePointIndex::RallyPoint &point = _safe_point_index.rallyPoint(i);
+		_one_rally_point_has_land_approach = _safe_point_index.hasLandApproach(point) && isFarFromHome(point);
+	}
+}
+
+bool RTL::isFarFromHome(const SafePointIndex::RallyPoint &point) const
+{
+	return (_param_rtl_type.get() == 5)
+	       || get_distance_to_next_waypoint(_home_pos_sub.get().lat, _home_pos_sub.get().lon,
+			       point.lat, point.lon) > MAX_DIST_FROM_HOME_FOR_LAND_APPROACHES;
+}
+
+PositionYawSetpoint RTL::findClosestSafePoint(float min_dist, uint8_t &safe_point_index)
+{
+	const bool vtol_in_fw_mode = _vehicle_status_sub.get().is_vtol
+				     && (_vehicle_status_sub.get().vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING);
 
-			if (mission_safe_point.nav_cmd == NAV_CMD_RALLY_POINT && (far_from_home || (_param_rtl_type.get() == 5))) {
-				const float dist{get_distance_to_next_waypoint(_global_pos_sub.get().lat, _global_pos_sub.get().lon, mission_safe_point.lat, mission_safe_point.lon)};
+	PositionYawSetpoint safe_point{(double)NAN, (double)NAN, NAN, NAN};
 
-				PositionYawSetpoint safepoint_position;
-				setSafepointAsDestination(safepoint_position, mission_safe_point);
+	if (_safe_points_updated) {
+		if (_home_pos_sub.get().update_count != _land_approach_home_update_count) {
+			updateRallyPointLandApproach();
+		}
 
-				const bool current_safe_point_has_approaches{hasVtolLandApproach(safepoint_position)};
+		const bool approach_required = vtol_in_fw_mode && (_param_rtl_appr_force.get() != 0);
 
-				_one_rally_point_has_land_approach |= current_safe_point_has_approaches;
+		float dist{FLT_MAX};
+		const int index = _safe_point_index.findNearest(_global_pos_sub.get().lat, _global_pos_sub.get().lon, dist,
+		[&](const SafePointIndex::RallyPoint & point) {
+			// Ignore safepoints which are too close to the homepoint (only if home is an option to return to)
+			return isFarFromHome(point) && (!approach_required || _safe_point_index.hasLandApproach(point));
+		});
 
-				if (((dist + MIN_DIST_THRESHOLD) < min_dist)
-				    && (!vtol_in_fw_mode || (_param_rtl_appr_force.get() == 0) || current_safe_point_has_approaches)) {
-					min_dist = dist;
-					safe_point = safepoint_position;
-					safe_point_index = current_seq;
-				}
-			}
+		if ((index >= 0) && ((dist + MIN_DIST_THRESHOLD) < min_dist)) {
+			const SafePointIndex::RallyPoint &point = _safe_point_index.rallyPoint(index);
+			setSafepointAsDestination(safe_point, point);
+			safe_point_index = point.seq;
 		}
 	}
 
@@ -553,27 +583,27 @@ void RTL::setLandPosAsDestination(PositionYawSetpoint &rtl_position, mission_ite
 	rtl_position.lon = land_mission_item.lon;
 }
 
-void RTL::setSafepointAsDestination(PositionYawSetpoint &rtl_position, const mission_item_s &mission_safe_point) const
+void RTL::setSafepointAsDestination(PositionYawSetpoint &rtl_position, const SafePointIndex::RallyPoint &safe_point) const
 {
 	// There is a safe point closer than home/mission landing
-	// TODO: handle all possible mission_safe_point.frame cases
-	switch (mission_safe_point.frame) {
+	// TODO: handle all possible safe_point.frame cases
+	switch (safe_point.frame) {
 	case 0: // MAV_FRAME_GLOBAL
-		rtl_position.lat = mission_safe_point.lat;
-		rtl_position.lon = mission_safe_point.lon;
-		rtl_position.alt = mission_safe_point.altitude;
+		rtl_position.lat = safe_point.lat;
+		rtl_position.lon = safe_point.lon;
+		rtl_position.alt = safe_point.altitude;
 		break;
 
 	case 3: // MAV_FRAME_GLOBAL_RELATIVE_ALT
-		rtl_position.lat = mission_safe_point.lat;
-		rtl_position.lon = mission_safe_point.lon;
-		rtl_position.alt = mission_safe_point.altitude + _home_pos_sub.get().alt; // alt of safe point is rel to home
+		rtl_position.lat = safe_point.lat;
+		rtl_position.lon = safe_point.lon;
+		rtl_position.alt = safe_point.altitude + _home_pos_sub.get().alt; // alt of safe point is rel to home
 		break;
 
 	default:
 		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "RTL: unsupported MAV_FRAME\t");
 		events::send<uint8_t>(events::ID("rtl_unsupported_mav_frame"), events::Log::Error, "RTL: unsupported MAV_FRAME ({1})",
-				      mission_safe_point.frame);
+				      safe_point.frame);
 		break;
 	}
 }
@@ -678,6 +708,7 @@ void RTL::parameters_update()
 		// If any parameter updated, call updateParams() to check if
 		// this class attributes need updating (and do so).
 		updateParams();
+		updateRallyPointLandApproach();
 
 		if (!isActive()) {
 			setRtlTypeAndDestination();
@@ -734,55 +765,26 @@ loiter_point_s RTL::chooseBestLandingApproach(const land_approaches_s &vtol_land
 
 land_approaches_s RTL::readVtolLandApproaches(PositionYawSetpoint rtl_position) const
 {
-
-	// go through all mission items in the rally point storage. If we find a mission item of type NAV_CMD_RALLY_POINT
-	// which is within MAX_DIST_FROM_HOME_FOR_LAND_APPROACHES of our current home position then treat ALL following mission items of type NAV_CMD_LOITER_TO_ALT which come
-	// BEFORE the next mission item of type NAV_CMD_RALLY_POINT as land approaches for the home position
+	// The land approaches of a location are the mission items of type NAV_CMD_LOITER_TO_ALT following the first rally point
+	// (in storage order) within MAX_DIST_FROM_HOME_FOR_LAND_APPROACHES of the location, up to the next NAV_CMD_RALLY_POINT.
 	land_approaches_s vtol_land_approaches{};
 
 	if (!_safe_points_updated) {
 		return vtol_land_approaches;
 	}
 
-	bool foundHomeLandApproaches = false;
-	uint8_t sector_counter = 0;
-
-	for (int current_seq = 0; current_seq < _stats.num_items; ++current_seq) {
-		mission_item_s mission_item{};
+	const int owner = _safe_point_index.landApproachOwner(rtl_position.lat, rtl_position.lon);
 
-		bool success_mission_item = _dataman_cache_safepoint.loadWait(static_cast<dm_item_t>(_stats.dataman_id), current_seq,
-					    reinterpret_cast<uint8_t *>(&mission_item),
-					    sizeof(mission_item_s));
-
-		if (!success_mission_item) {
-			PX4_ERR("dm_read failed");
-			break;
-		}
-
-		if (mission_item.nav_cmd == NAV_CMD_RALLY_POINT) {
-
-			if (foundHomeLandApproaches) {
-				break;
-			}
-
-			const float dist_to_safepoint = get_distance_to_next_waypoint(mission_item.lat, mission_item.lon, rtl_position.lat,
-							rtl_position.lon);
-
-			if (dist_to_safepoint < MAX_DIST_FROM_HOME_FOR_LAND_APPROACHES) {
-				foundHomeLandApproaches = true;
-				vtol_land_approaches.land_location_lat_lon = matrix::Vector2d(mission_item.lat, mission_item.lon);
-			}
-
-			sector_counter = 0;
-		}
+	if (owner >= 0) {
+		const SafePointIndex::RallyPoint &safe_point = _safe_point_index.rallyPoint(owner);
+		vtol_land_approaches.land_location_lat_lon = matrix::Vector2d(safe_point.lat, safe_point.lon);
 
-		if (foundHomeLandApproaches && mission_item.nav_cmd == NAV_CMD_LOITER_TO_ALT) {
-			vtol_land_approaches.approaches[sector_counter].lat = mission_item.lat;
-			vtol_land_approaches.approaches[sector_counter].lon = mission_item.lon;
-			vtol_land_approaches.approaches[sector_counter].height_m = MissionBlock::get_absolute_altitude_for_item(mission_item,
-					_home_pos_sub.get().alt);
-			vtol_land_approaches.approaches[sector_counter].loiter_radius_m = mission_item.loiter_radius;
-			sector_counter++;
+		for (int i = 0; i < safe_point.num_approaches; i++) {
+			const SafePointIndex::Approach &approach = _safe_point_index.approach(safe_point.first_approach + i);
+			vtol_land_approaches.approaches[i].lat = approach.lat;
+			vtol_land_approaches.approaches[i].lon = approach.lon;
+			vtol_land_approaches.approaches[i].height_m = approach.absoluteAltitude(_home_pos_sub.get().alt);
+			vtol_land_approaches.approaches[i].loiter_radius_m = approach.loiter_radius;
 		}
 	}
 
@@ -51,6 +51,7 @@
 #include "rtl_direct_mission_land.h"
 #include "rtl_mission_fast.h"
 #include "rtl_mission_fast_reverse.h"
+#include "SafePointIndex/SafePointIndex.hpp"
 
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
@@ -121,6 +122,21 @@ private:
 	 */
 	void updateDatamanCache();
 
+	/**
+	 * @brief Build the rally point index from the loaded safe points
+	 */
+	void buildSafePointIndex();
+
+	/**
+	 * @brief Update whether a rally point has a land approach, after the rally points, home or RTL_TYPE changed
+	 */
+	void updateRallyPointLandApproach();
+
+	/**
+	 * @return true if the rally point is far enough from home to be used, or home is not an option to return to
+	 */
+	bool isFarFromHome(const SafePointIndex::RallyPoint &point) const;
+
 	void setRtlTypeAndDestination();
 
 	/**
@@ -150,9 +166,9 @@ private:
 	/**
 	 * @brief Set the safepoint as destination.
 	 *
-	 * @param mission_safe_point is the mission safe point/rally point to set as destination.
+	 * @param safe_point is the rally point to set as destination.
 	 */
-	void setSafepointAsDestination(PositionYawSetpoint &rtl_position, const mission_item_s &mission_safe_point) const;
+	void setSafepointAsDestination(PositionYawSetpoint &rtl_position, const SafePointIndex::RallyPoint &safe_point) const;
 
 	/**
 	 * @brief calculate return altitude from return altitude parameter, current altitude and cone angle
@@ -218,11 +234,13 @@ private:
 
 	bool _home_has_land_approach;			///< Flag if the home position has a land approach defined
 	bool _one_rally_point_has_land_approach;	///< Flag if a rally point has a land approach defined
+	uint32_t _land_approach_home_update_count{0};	///< Home position update the rally point flag was computed for
 
 	DatamanState _dataman_state{DatamanState::UpdateRequestWait};
 	DatamanState _error_state{DatamanState::UpdateRequestWait};
 	uint32_t _opaque_id{0}; ///< dataman safepoint id: if it does not match, safe points data was updated
 	bool _safe_points_updated{false}; ///< flag indicating if safe points are updated to dataman cache
+	SafePointIndex _safe_point_index; ///< spatial index of the rally points, built once the safe points are loaded
 	mutable DatamanCache _dataman_cache_safepoint{"rtl_dm_cache_miss_geo", 4};
 	DatamanClient	&_dataman_client_safepoint = _dataman_cache_safepoint.client();
 	bool _initiate_safe_points_updated{true}; ///< flag indicating if safe points update is needed
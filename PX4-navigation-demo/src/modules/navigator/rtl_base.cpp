@@ -0,0 +1,116 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file rtl_base.cpp
+ *
+ * Helper class for RTL modes using the mission
+ *
+ */
+
+#include "rtl_base.h"
+
+#include <lib/geo/geo.h>
+
+bool RtlBase::updateMissionCostTable(float home_alt)
+{
+	const vehicle_status_s &vehicle_status = _vehicle_status_sub.get();
+
+	_rtl_time_estimator.update();
+	_rtl_time_estimator.setVehicleType(vehicle_status.vehicle_type);
+
+	MissionCostTable::VehicleRates rates{};
+	rates.cruise_speed = _rtl_time_estimator.getCruiseSpeed();
+	rates.climb_rate = _rtl_time_estimator.getClimbRate();
+	rates.descend_rate = _rtl_time_estimator.getDescendRate();
+	rates.land_descend_rate = rates.descend_rate;
+	rates.fixed_wing = vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING;
+
+	// Fixed-wing and VTOL reach the land position first and then descend, VTOL as multicopter
+	rates.land_horizontal_first = rates.fixed_wing || vehicle_status.is_vtol;
+
+	if (vehicle_status.is_vtol) {
+		_rtl_time_estimator.setVehicleType(vehicle_status_s::VEHICLE_TYPE_ROTARY_WING);
+		rates.land_descend_rate = _rtl_time_estimator.getDescendRate();
+		_rtl_time_estimator.setVehicleType(vehicle_status.vehicle_type);
+	}
+
+	_mission_cost_table.update(_mission_model, _mission, home_alt, rates, _rtl_time_estimator.get_wind());
+
+	return _mission_cost_table.isValid();
+}
+
+float RtlBase::timeToMissionEnd(double lat, double lon, float alt, float home_alt, int position_index,
+				bool include_waits) const
+{
+	const int last_index = _mission_cost_table.size() - 1;
+
+	if (position_index < 0 || position_index > last_index) {
+		return NAN;
+	}
+
+	if (include_waits && _mission_cost_table.containsUnlimitedLoiter(position_index, last_index)) {
+		return NAN;
+	}
+
+	const MissionModel::PositionItem &item = _mission_model.positionItemAt(position_index);
+
+	float time = _mission_cost_table.legTime(item.nav_cmd, item.loiter_radius,
+			get_distance_to_next_waypoint(lat, lon, item.latitude(), item.longitude()),
+			get_bearing_to_next_waypoint(lat, lon, item.latitude(), item.longitude()),
+			item.absoluteAltitude(home_alt) - alt);
+
+	time += _mission_cost_table.forwardTime(position_index, last_index);
+
+	if (include_waits) {
+		time += _mission_cost_table.waitTime(position_index, last_index);
+	}
+
+	return time;
+}
+
+float RtlBase::timeToMissionStart(double lat, double lon, float alt, float home_alt, int position_index) const
+{
+	if (position_index < 0 || position_index >= _mission_cost_table.size()) {
+		return NAN;
+	}
+
+	const MissionModel::PositionItem &item = _mission_model.positionItemAt(position_index);
+
+	// flying back, every item is a plain waypoint
+	const float time = _mission_cost_table.legTime(NAV_CMD_WAYPOINT, 0.f,
+			   get_distance_to_next_waypoint(lat, lon, item.latitude(), item.longitude()),
+			   get_bearing_to_next_waypoint(lat, lon, item.latitude(), item.longitude()),
+			   item.absoluteAltitude(home_alt) - alt);
+
+	return time + _mission_cost_table.reverseTime(position_index, 0);
+}
@@ -40,6 +40,9 @@
 #pragma once
 
 #include "mission_base.h"
+#include "MissionCostTable/MissionCostTable.hpp"
+
+#include <lib/rtl/rtl_time_estimator.h>
 #include <uORB/topics/rtl_time_estimate.h>
 
 class RtlBase : public MissionBase
@@ -54,4 +57,40 @@ public:
 	virtual void setReturnAltMin(bool min) { (void)min;};
 
 	virtual void setRtlAlt(float alt) { (void)alt;};
+
+protected:
+	/**
+	 * @brief Update the leg time table of the mission with the current vehicle rates and wind
+	 *
+	 * @param home_alt AMSL altitude of home [m]
+	 * @return true if the table is valid for the mission
+	 */
+	bool updateMissionCostTable(float home_alt);
+
+	/**
+	 * @brief Time to fly from a position to a position item and along the mission to its last position item
+	 *
+	 * Requires a valid mission cost table.
+	 *
+	 * @param lat latitude of the start position [deg]
+	 * @param lon longitude of the start position [deg]
+	 * @param alt AMSL altitude of the start position [m]
+	 * @param home_alt AMSL altitude of home [m]
+	 * @param position_index index of the first position item in the mission model
+	 * @param include_waits true to add the loiter times of the items
+	 * @return time [s], NAN if the index is out of range, an unlimited loiter is included or a leg cannot be flown against the wind
+	 */
+	float timeToMissionEnd(double lat, double lon, float alt, float home_alt, int position_index, bool include_waits) const;
+
+	/**
+	 * @brief Time to fly from a position to a position item and backwards along the mission to its first position item
+	 *
+	 * Requires a valid mission cost table.
+	 *
+	 * @return time [s], NAN if the index is out of range or a leg cannot be flown against the wind
+	 */
+	float timeToMissionStart(double lat, double lon, float alt, float home_alt, int position_index) const;
+
+	RtlTimeEstimator _rtl_time_estimator;
+	MissionCostTable _mission_cost_table; /**< Prefix sums of the mission leg times, updated when the mission or the wind changes */
 };
@@ -287,6 +287,28 @@ rtl_time_estimate_s RtlDirectMissionLand::calc_rtl_time_estimate()
 				altitude_at_calculation_point = _global_pos_sub.get().alt;
 			}
 
+			const float home_alt = _navigator->get_home_position()->alt;
+
+			if (updateMissionCostTable(home_alt)) {
+				const int position_index = _mission_model.lowerBoundPosition(start_item_index);
+
+				if (position_index < _mission_cost_table.size()) {
+					const float mission_time = timeToMissionEnd(hor_position_at_calculation_point(0),
+								   hor_position_at_calculation_point(1), altitude_at_calculation_point, home_alt, position_index, true);
+
+					if (PX4_ISFINITE(mission_time)) {
+						_rtl_time_estimator.addWait(mission_time);
+
+					} else {
+						// Unlimited loiter or no progress against the wind, mark time estimate as invalid.
+						_rtl_time_estimator.reset();
+					}
+				}
+
+				return _rtl_time_estimator.getEstimate();
+			}
+
+			// No leg time table for this mission (e.g. it contains jumps), walk the mission items
 			while (start_item_index < _mission.count && start_item_index >= 0) {
 				int32_t next_mission_item_index;
 				size_t num_found_items{0U};
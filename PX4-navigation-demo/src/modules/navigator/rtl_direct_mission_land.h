@@ -43,8 +43,6 @@
 
 #include "rtl_base.h"
 
-#include <lib/rtl/rtl_time_estimator.h>
-
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/rtl_time_estimate.h>
@@ -74,6 +72,4 @@ private:
 	bool _needs_climbing{false}; 	//< Flag if climbing is required at the start
 	bool _enforce_rtl_alt{false};
 	float _rtl_alt{0.0f};	///< AMSL altitude at which the vehicle should return to the land position
-
-	RtlTimeEstimator _rtl_time_estimator;
 };
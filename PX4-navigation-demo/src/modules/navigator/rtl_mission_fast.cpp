@@ -219,9 +219,31 @@ void RtlMissionFast::setActiveMissionItems()
 
 rtl_time_estimate_s RtlMissionFast::calc_rtl_time_estimate()
 {
-	rtl_time_estimate_s time_estimate;
-	time_estimate.valid = false;
-	time_estimate.timestamp = hrt_absolute_time();
+	_rtl_time_estimator.reset();
 
-	return time_estimate;
+	const float home_alt = _navigator->get_home_position()->alt;
+
+	if (_mission.count > 0 && updateMissionCostTable(home_alt)) {
+		const vehicle_global_position_s &global_position = _global_pos_sub.get();
+		int position_index;
+
+		if (isActive()) {
+			position_index = _mission_model.lowerBoundPosition(_mission.current_seq);
+
+		} else if (_mission_index_prior_rtl >= 0) {
+			position_index = _mission_model.lowerBoundPosition(_mission_index_prior_rtl);
+
+		} else {
+			// RTL continues at the closest mission item, approximated by the end of the closest leg
+			position_index = math::max(_mission_model.closestLeg(global_position.lat, global_position.lon).position_index, 0);
+		}
+
+		if (position_index < _mission_cost_table.size()) {
+			// the items are flown as plain waypoints, without loiter times
+			_rtl_time_estimator.addWait(timeToMissionEnd(global_position.lat, global_position.lon, global_position.alt, home_alt,
+						    position_index, false));
+		}
+	}
+
+	return _rtl_time_estimator.getEstimate();
 }
@@ -299,9 +299,55 @@ void RtlMissionFastReverse::handleLanding(WorkItemType &new_work_item_type)
 
 rtl_time_estimate_s RtlMissionFastReverse::calc_rtl_time_estimate()
 {
-	rtl_time_estimate_s time_estimate;
-	time_estimate.valid = false;
-	time_estimate.timestamp = hrt_absolute_time();
+	_rtl_time_estimator.reset();
 
-	return time_estimate;
+	const float home_alt = _navigator->get_home_position()->alt;
+
+	if (_mission.count > 0 && updateMissionCostTable(home_alt)) {
+		const vehicle_global_position_s &global_position = _global_pos_sub.get();
+		float time_estimate{NAN};
+
+		if (isActive() && _in_landing_phase) {
+			time_estimate = timeToLandAtHome(global_position.lat, global_position.lon, global_position.alt);
+
+		} else {
+			int position_index;
+
+			if (isActive()) {
+				position_index = _mission_model.lowerBoundPosition(_mission.current_seq);
+
+			} else if (_mission_index_prior_rtl >= 0) {
+				// the position item before the one the mission was heading to
+				position_index = math::max(_mission_model.lowerBoundPosition(_mission_index_prior_rtl) - 1, 0);
+
+			} else {
+				// RTL continues at the closest mission item, approximated by the start of the closest leg
+				position_index = math::max(_mission_model.closestLeg(global_position.lat, global_position.lon).position_index - 1, 0);
+			}
+
+			if (position_index < _mission_cost_table.size()) {
+				const MissionModel::PositionItem &first_item = _mission_model.positionItemAt(0);
+
+				time_estimate = timeToMissionStart(global_position.lat, global_position.lon, global_position.alt, home_alt,
+								   position_index)
+						+ timeToLandAtHome(first_item.latitude(), first_item.longitude(), first_item.absoluteAltitude(home_alt));
+			}
+		}
+
+		_rtl_time_estimator.addWait(time_estimate);
+	}
+
+	return _rtl_time_estimator.getEstimate();
+}
+
+float RtlMissionFastReverse::timeToLandAtHome(double lat, double lon, float alt) const
+{
+	const home_position_s &home = *_navigator->get_home_position();
+
+	// fly to home at the current altitude, then land
+	const float move_to_home_time = _mission_cost_table.legTime(NAV_CMD_WAYPOINT, 0.f,
+					get_distance_to_next_waypoint(lat, lon, home.lat, home.lon),
+					get_bearing_to_next_waypoint(lat, lon, home.lat, home.lon), 0.f);
+
+	return move_to_home_time + _mission_cost_table.legTime(NAV_CMD_LAND, 0.f, 0.f, 0.f, home.alt - alt);
 }
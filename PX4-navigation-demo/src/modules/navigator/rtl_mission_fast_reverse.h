@@ -69,6 +69,16 @@ private:
 	void setActiveMissionItems() override;
 	void handleLanding(WorkItemType &new_work_item_type);
 
+	/**
+	 * @brief Time to fly from a position to home and land there, requires a valid mission cost table
+	 *
+	 * @param lat latitude [deg]
+	 * @param lon longitude [deg]
+	 * @param alt AMSL altitude [m]
+	 * @return time [s]
+	 */
+	float timeToLandAtHome(double lat, double lon, float alt) const;
+
 	int32_t _mission_index_prior_rtl{INT32_C(-1)};
 
 	bool _in_landing_phase{false};
@@ -237,16 +237,17 @@ Replay::readDynamicParams(const char *filename)
 }
 
 bool
-Replay::readFileHeader(std::ifstream &file)
+Replay::readFileHeader()
 {
-	file.seekg(0);
-	ulog_file_header_s msg_header;
-	file.read((char *)&msg_header, sizeof(msg_header));
+	const uint8_t *header = _ulog.get(0, sizeof(ulog_file_header_s));
 
-	if (!file) {
+	if (!header) {
 		return false;
 	}
 
+	ulog_file_header_s msg_header;
+	memcpy(&msg_header, header, sizeof(msg_header));
+
 	_file_start_time = msg_header.timestamp;
 	//verify it's an ULog file
 	char magic[8];
@@ -261,76 +262,73 @@ Replay::readFileHeader(std::ifstream &file)
 }
 
 bool
-Replay::readFileDefinitions(std::ifstream &file)
+Replay::readFileDefinitions()
 {
 	PX4_INFO("Applying params from ULog file...");
 
 	ulog_message_header_s message_header;
-	file.seekg(sizeof(ulog_file_header_s));
+	uint64_t message_pos = sizeof(ulog_file_header_s);
 
 	while (true) {
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+		const uint8_t *message = _ulog.message(message_pos, message_header);
 
-		if (!file) {
+		if (!message) {
 			return false;
 		}
 
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::FLAG_BITS:
-			if (!readFlagBits(file, message_header.msg_size)) {
+			if (!readFlagBits(message, message_header.msg_size)) {
 				return false;
 			}
 
 			break;
 
 		case (int)ULogMessageType::FORMAT:
-			if (!readFormat(file, message_header.msg_size)) {
+			if (!readFormat(message, message_header.msg_size)) {
 				return false;
 			}
 
 			break;
 
 		case (int)ULogMessageType::PARAMETER:
-			if (!readAndApplyParameter(file, message_header.msg_size)) {
+			if (!readAndApplyParameter(message, message_header.msg_size)) {
 				return false;
 			}
 
 			break;
 
 		case (int)ULogMessageType::ADD_LOGGED_MSG:
-			_data_section_start = file.tellg() - (streamoff)ULOG_MSG_HEADER_LEN;
+			_data_section_start = message_pos;
 			return true;
 
 		case (int)ULogMessageType::INFO: //skip
 		case (int)ULogMessageType::INFO_MULTIPLE: //skip
 		case (int)ULogMessageType::PARAMETER_DEFAULT:
-			file.seekg(message_header.msg_size, ios::cur);
 			break;
 
 		default:
 			PX4_ERR("unknown log definition type %i, size %i (offset %i)",
-				(int)message_header.msg_type, (int)message_header.msg_size, (int)file.tellg());
-			file.seekg(message_header.msg_size, ios::cur);
+				(int)message_header.msg_type, (int)message_header.msg_size, (int)message_pos);
 			break;
 		}
+
+		message_pos += ULOG_MSG_HEADER_LEN + message_header.msg_size;
 	}
 
 	return true;
 }
 
 bool
-Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
+Replay::readFlagBits(const uint8_t *message, uint16_t msg_size)
 {
 	if (msg_size != 40) {
 		PX4_ERR("unsupported message length for FLAG_BITS message (%i)", msg_size);
 		return false;
 	}
 
-	_read_buffer.reserve(msg_size);
-	uint8_t *message = (uint8_t *)_read_buffer.data();
-	file.read((char *)message, msg_size);
-	//uint8_t *compat_flags = message;
-	uint8_t *incompat_flags = message + 8;
+	//const uint8_t *compat_flags = message;
+	const uint8_t *incompat_flags = message + 8;
 
 	// handle & validate the flags
 	bool contains_appended_data = incompat_flags[0] & ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK;
@@ -366,18 +364,9 @@ Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readFormat(std::ifstream &file, uint16_t msg_size)
+Replay::readFormat(const uint8_t *message, uint16_t msg_size)
 {
-	_read_buffer.reserve(msg_size + 1);
-	char *format = (char *)_read_buffer.data();
-	file.read(format, msg_size);
-	format[msg_size] = 0;
-
-	if (!file) {
-		return false;
-	}
-
-	string str_format(format);
+	string str_format((const char *)message, msg_size);
 	size_t pos = str_format.find(':');
 
 	if (pos == string::npos) {
@@ -419,27 +408,17 @@ string Replay::getOrbFields(const orb_metadata *meta)
 }
 
 Replay::ReadAndAndAddSubResult
-Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
+Replay::readAndAddSubscription(uint64_t message_pos, uint16_t msg_size)
 {
-	_read_buffer.reserve(msg_size + 1);
-	uint8_t *message = _read_buffer.data();
-	streampos this_message_pos = file.tellg() - (streamoff)ULOG_MSG_HEADER_LEN;
-	file.read((char *)message, msg_size);
-	message[msg_size] = 0;
+	const uint8_t *message = _ulog.get(message_pos + ULOG_MSG_HEADER_LEN, msg_size);
 
-	if (!file) {
+	if (!message || msg_size < 3) {
 		return ReadAndAndAddSubResult::kFailure;
 	}
 
-	if (file.tellg() <= _subscription_file_pos) { //already read this subscription
-		return ReadAndAndAddSubResult::kIgnoringMsg;
-	}
-
-	_subscription_file_pos = file.tellg();
-
-	uint8_t multi_id = *(uint8_t *)message;
+	uint8_t multi_id = message[0];
 	uint16_t msg_id = ((uint16_t)message[1]) | (((uint16_t)message[2]) << 8);
-	string topic_name((char *)message + 3);
+	string topic_name((const char *)message + 3, strnlen((const char *)message + 3, msg_size - 3));
 	const orb_metadata *orb_meta = findTopic(topic_name);
 
 	if (!orb_meta) {
@@ -545,16 +524,15 @@ Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
 	}
 
 	//find first data message (and the timestamp)
-	streampos cur_pos = file.tellg();
-	subscription->next_read_pos = this_message_pos; //this will be skipped
+	if (msg_id < _data_message_offsets.size()) {
+		const std::vector<uint64_t> &offsets = _data_message_offsets[msg_id];
+		const size_t first_index = std::upper_bound(offsets.begin(), offsets.end(), message_pos) - offsets.begin();
+		findDataMessage(*subscription, msg_id, first_index);
 
-	if (!nextDataMessage(file, *subscription, msg_id)) {
-		delete subscription;
-		return ReadAndAndAddSubResult::kFailure;
+	} else {
+		subscription->orb_meta = nullptr;
 	}
 
-	file.seekg(cur_pos);
-
 	if (!subscription->orb_meta) {
 		//no message found. This is not a fatal error
 		delete subscription;
@@ -606,52 +584,38 @@ Replay::findFieldOffset(const string &format, const string &field_name, int &off
 	return false;
 }
 
-bool
-Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position)
+void
+Replay::handleAdditionalMessages(uint64_t end_position)
 {
 	ulog_message_header_s message_header;
 
-	while (file.tellg() < end_position) {
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	while (_next_additional_message < _additional_message_offsets.size()
+	       && _additional_message_offsets[_next_additional_message] < end_position) {
 
-		if (!file) {
-			return false;
-		}
+		const uint8_t *message = _ulog.message(_additional_message_offsets[_next_additional_message], message_header);
+		++_next_additional_message;
 
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::PARAMETER:
-			if (!readAndApplyParameter(file, message_header.msg_size)) {
-				return false;
-			}
-
+			readAndApplyParameter(message, message_header.msg_size);
 			break;
 
 		case (int)ULogMessageType::DROPOUT:
-			readDropout(file, message_header.msg_size);
-			break;
-
-		default: //skip all others
-			file.seekg(message_header.msg_size, ios::cur);
+			readDropout(message, message_header.msg_size);
 			break;
 		}
 	}
-
-	return true;
 }
 
 bool
-Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
+Replay::readAndApplyParameter(const uint8_t *message, uint16_t msg_size)
 {
-	_read_buffer.reserve(msg_size);
-	uint8_t *message = (uint8_t *)_read_buffer.data();
-	file.read((char *)message, msg_size);
-
-	if (!file) {
+	if (msg_size < 1 || 1 + message[0] > msg_size) {
 		return false;
 	}
 
 	uint8_t key_len = message[0];
-	string key((char *)message + 1, key_len);
+	string key((const char *)message + 1, key_len);
 
 	size_t pos = key.find(' ');
 
@@ -683,97 +647,126 @@ Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readDropout(std::ifstream &file, uint16_t msg_size)
+Replay::readDropout(const uint8_t *message, uint16_t msg_size)
 {
+	if (msg_size < sizeof(uint16_t)) {
+		return false;
+	}
+
 	uint16_t duration;
-	file.read((char *)&duration, sizeof(duration));
+	memcpy(&duration, message, sizeof(duration));
 
 	PX4_ERR("Dropout in replayed log, %i ms", (int)duration);
-	return file.good();
+	return true;
 }
 
-bool
-Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id)
+void
+Replay::indexDataSection(std::vector<uint64_t> &add_logged_message_offsets)
 {
-	ulog_message_header_s message_header;
-	file.seekg(subscription.next_read_pos);
-	//ignore the first message (it's data we already read)
-	file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
-
-	if (file) {
-		file.seekg(message_header.msg_size, ios::cur);
-	}
+	_data_message_offsets.clear();
+	_additional_message_offsets.clear();
+	_next_additional_message = 0;
 
-	uint16_t file_msg_id;
-	bool done = false;
+	const uint64_t end_position = std::min(_ulog.size(), _read_until_file_position);
+	uint64_t message_pos = _data_section_start;
+	ulog_message_header_s message_header;
+	const uint8_t *message;
 
-	while (file && !done) {
-		streampos cur_pos = file.tellg();
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	while ((message = _ulog.message(message_pos, message_header)) != nullptr) {
+		const uint64_t next_message_pos = message_pos + ULOG_MSG_HEADER_LEN + message_header.msg_size;
 
-		if (!file) {
-			break;
-		}
-
-		if (((streamoff)cur_pos) + ULOG_MSG_HEADER_LEN + message_header.msg_size > _read_until_file_position) {
-			file.setstate(std::ios::eofbit);
+		if (next_message_pos > end_position) {
 			break;
 		}
 
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::DATA:
-			file.read((char *)&file_msg_id, sizeof(file_msg_id));
-
-			if (file) {
-				if (msg_id == file_msg_id) {
-					if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
-						subscription.next_read_pos = cur_pos;
-						file.seekg(subscription.timestamp_offset, ios::cur);
-						file.read((char *)&subscription.next_timestamp, sizeof(subscription.next_timestamp));
-						subscription.published = false;
-						done = true;
-
-					} else { //sanity check failed!
-						PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
-							subscription.orb_meta->o_name, message_header.msg_size,
-							subscription.orb_meta->o_size_no_padding + 2);
-						file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
-					}
+			if (message_header.msg_size >= sizeof(uint16_t)) {
+				uint16_t msg_id;
+				memcpy(&msg_id, message, sizeof(msg_id));
 
-				} else { //not the one we are looking for
-					file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
+				if (msg_id >= _data_message_offsets.size()) {
+					_data_message_offsets.resize(msg_id + 1);
 				}
+
+				_data_message_offsets[msg_id].push_back(message_pos);
 			}
 
 			break;
 
-		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
 		case (int)ULogMessageType::ADD_LOGGED_MSG:
+			add_logged_message_offsets.push_back(message_pos);
+			break;
+
 		case (int)ULogMessageType::PARAMETER:
 		case (int)ULogMessageType::DROPOUT:
+			_additional_message_offsets.push_back(message_pos);
+			break;
+
+		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
 		case (int)ULogMessageType::INFO:
 		case (int)ULogMessageType::INFO_MULTIPLE:
 		case (int)ULogMessageType::SYNC:
 		case (int)ULogMessageType::LOGGING:
+		case (int)ULogMessageType::LOGGING_TAGGED:
 		case (int)ULogMessageType::PARAMETER_DEFAULT:
-			file.seekg(message_header.msg_size, ios::cur);
 			break;
 
 		default:
 			//this really should not happen
 			PX4_ERR("unknown log message type %i, size %i (offset %i)",
-				(int)message_header.msg_type, (int)message_header.msg_size, (int)file.tellg());
-			file.seekg(message_header.msg_size, ios::cur);
+				(int)message_header.msg_type, (int)message_header.msg_size, (int)message_pos);
 			break;
 		}
+
+		message_pos = next_message_pos;
 	}
+}
 
-	if (file.eof()) { //no more data messages for this subscription
-		subscription.orb_meta = nullptr;
-		file.clear();
+void
+Replay::findDataMessage(Subscription &subscription, int msg_id, size_t index)
+{
+	const std::vector<uint64_t> &offsets = _data_message_offsets[msg_id];
+	const size_t expected_size = subscription.orb_meta->o_size_no_padding + 2;
+	ulog_message_header_s message_header;
+
+	for (; index < offsets.size(); ++index) {
+		// the index only contains complete messages
+		const uint8_t *message = _ulog.message(offsets[index], message_header);
+
+		if (message_header.msg_size == expected_size) {
+			subscription.next_index = index;
+			subscription.next_read_pos = offsets[index];
+			memcpy(&subscription.next_timestamp, message + 2 + subscription.timestamp_offset,
+			       sizeof(subscription.next_timestamp));
+			subscription.published = false;
+			scheduleNextMessage(subscription, msg_id);
+			return;
+		}
+
+		//sanity check failed!
+		PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
+			subscription.orb_meta->o_name, message_header.msg_size, (int)expected_size);
+	}
+
+	//no more data messages for this subscription
+	subscription.orb_meta = nullptr;
+}
+
+void
+Replay::nextDataMessage(Subscription &subscription, int msg_id)
+{
+	if (subscription.orb_meta) {
+		findDataMessage(subscription, msg_id, subscription.next_index + 1);
 	}
+}
 
-	return file.good();
+void
+Replay::scheduleNextMessage(const Subscription &subscription, uint16_t msg_id)
+{
+	if (subscription.orb_meta && !subscription.ignored) {
+		_next_messages.push(NextMessage{subscription.next_timestamp, subscription.next_read_pos, msg_id});
+	}
 }
 
 const orb_metadata *
@@ -849,7 +842,7 @@ Replay::sizeOfFullType(const std::string &type_name_full)
 }
 
 bool
-Replay::readDefinitionsAndApplyParams(std::ifstream &file)
+Replay::readDefinitionsAndApplyParams()
 {
 	// log reader currently assumes little endian
 	int num = 1;
@@ -859,18 +852,18 @@ Replay::readDefinitionsAndApplyParams(std::ifstream &file)
 		return false;
 	}
 
-	if (!file.is_open()) {
+	if (!_ulog.open(_replay_file)) {
 		PX4_ERR("Failed to open replay file");
 		return false;
 	}
 
-	if (!readFileHeader(file)) {
+	if (!readFileHeader()) {
 		PX4_ERR("Failed to read file header. Not a valid ULog file");
 		return false;
 	}
 
 	//initialize the formats and apply the parameters from the log file
-	if (!readFileDefinitions(file)) {
+	if (!readFileDefinitions()) {
 		PX4_ERR("Failed to read ULog definitions section. Broken file?");
 		return false;
 	}
@@ -883,9 +876,7 @@ Replay::readDefinitionsAndApplyParams(std::ifstream &file)
 void
 Replay::run()
 {
-	ifstream replay_file(_replay_file, ios::in | ios::binary);
-
-	if (!readDefinitionsAndApplyParams(replay_file)) {
+	if (!readDefinitionsAndApplyParams()) {
 		return;
 	}
 
@@ -902,77 +893,60 @@ Replay::run()
 
 	PX4_INFO("Replay in progress...");
 
-	// Find and add all subscriptions
-	ulog_message_header_s message_header;
-	replay_file.seekg(_data_section_start);
+	// Index the data section and add all subscriptions
+	std::vector<uint64_t> add_logged_message_offsets;
+	indexDataSection(add_logged_message_offsets);
 
-	while (true) {
-		//we are in the Definition & Data Section Message Header section
-		replay_file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	for (uint64_t message_pos : add_logged_message_offsets) {
+		ulog_message_header_s message_header;
+		_ulog.message(message_pos, message_header);
+		readAndAddSubscription(message_pos, message_header.msg_size);
+	}
 
-		if (!replay_file) {
-			// end of file
-			break;
+	// free the index of messages that are not replayed
+	for (size_t msg_id = 0; msg_id < _data_message_offsets.size(); ++msg_id) {
+		if (msg_id >= _subscriptions.size() || !_subscriptions[msg_id]) {
+			std::vector<uint64_t>().swap(_data_message_offsets[msg_id]);
 		}
+	}
 
-		if (message_header.msg_type == (int)ULogMessageType::ADD_LOGGED_MSG) {
-			readAndAddSubscription(replay_file, message_header.msg_size);
+	// only now it is known which subscriptions are handled from the main loop
+	_next_messages = {};
 
-		} else {
-			// Not important for now, skip
-			replay_file.seekg(message_header.msg_size, ios::cur);
+	for (size_t i = 0; i < _subscriptions.size(); ++i) {
+		if (_subscriptions[i]) {
+			scheduleNextMessage(*_subscriptions[i], i);
 		}
 	}
 
-	// Rewind back to the begining of the data section
-	replay_file.seekg(_data_section_start);
-	replay_file.clear();
-
 	const uint64_t timestamp_offset = getTimestampOffset();
 	uint32_t nr_published_messages = 0;
-	streampos last_additional_message_pos = _data_section_start;
 
-	while (!should_exit() && replay_file) {
+	while (!should_exit() && !_next_messages.empty()) {
 
 		//Find the next message to publish. Messages from different subscriptions don't need
-		//to be in chronological order, so we need to check all subscriptions
-		uint64_t next_file_time = 0;
-		int next_msg_id = -1;
-		bool first_time = true;
-
-		for (size_t i = 0; i < _subscriptions.size(); ++i) {
-			const Subscription *subscription = _subscriptions[i];
-
-			if (!subscription) {
-				continue;
-			}
+		//to be in chronological order, so we take the earliest from the heap
+		const NextMessage next_message = _next_messages.top();
+		_next_messages.pop();
 
-			if (subscription->orb_meta && !subscription->ignored) {
-				if (first_time || subscription->next_timestamp < next_file_time) {
-					first_time = false;
-					next_msg_id = (int)i;
-					next_file_time = subscription->next_timestamp;
-				}
-			}
-		}
+		Subscription &sub = *_subscriptions[next_message.msg_id];
 
-		if (next_msg_id == -1) {
-			break; //no active subscription anymore. We're done.
+		if (!sub.orb_meta || sub.next_read_pos != next_message.read_pos) {
+			// outdated entry, the subscription advanced in the meantime
+			continue;
 		}
 
-		Subscription &sub = *_subscriptions[next_msg_id];
+		const int next_msg_id = next_message.msg_id;
+		const uint64_t next_file_time = sub.next_timestamp;
 
 		if (next_file_time == 0 || next_file_time < _file_start_time) {
 			//someone didn't set the timestamp properly. Consider the message invalid
-			nextDataMessage(replay_file, sub, next_msg_id);
+			nextDataMessage(sub, next_msg_id);
 			continue;
 		}
 
 		//handle additional messages between last and next published data
-		replay_file.seekg(last_additional_message_pos);
-		streampos next_additional_message_pos = sub.next_read_pos;
-		readAndHandleAdditionalMessages(replay_file, next_additional_message_pos);
-		last_additional_message_pos = next_additional_message_pos;
+		handleAdditionalMessages(sub.next_read_pos);
 
 		// Perform scheduled parameter changes
 		while (_next_param_change < _dynamic_parameter_schedule.size() &&
@@ -988,14 +962,14 @@ Replay::run()
 		const uint64_t publish_timestamp = handleTopicDelay(next_file_time, timestamp_offset);
 
 		// It's time to publish
-		readTopicDataToBuffer(sub, replay_file);
+		readTopicDataToBuffer(sub);
 		memcpy(_read_buffer.data() + sub.timestamp_offset, &publish_timestamp, sizeof(uint64_t)); //adjust the timestamp
 
-		if (handleTopicUpdate(sub, _read_buffer.data(), replay_file)) {
+		if (handleTopicUpdate(sub, _read_buffer.data())) {
 			++nr_published_messages;
 		}
 
-		nextDataMessage(replay_file, sub, next_msg_id);
+		nextDataMessage(sub, next_msg_id);
 
 		// TODO: output status (eg. every sec), including total duration...
 	}
@@ -1024,7 +998,7 @@ Replay::run()
 	onExitMainLoop();
 
 	if (!should_exit()) {
-		replay_file.close();
+		_ulog.close();
 		px4_shutdown_request();
 		// we need to ensure the shutdown logic gets updated and eventually triggers shutdown
 		hrt_abstime t = hrt_absolute_time();
@@ -1039,17 +1013,17 @@ Replay::run()
 }
 
 void
-Replay::readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file)
+Replay::readTopicDataToBuffer(const Subscription &sub)
 {
 	const size_t msg_read_size = sub.orb_meta->o_size_no_padding;
 	const size_t msg_write_size = sub.orb_meta->o_size;
 	_read_buffer.reserve(msg_write_size);
-	replay_file.seekg(sub.next_read_pos + (streamoff)(ULOG_MSG_HEADER_LEN + 2)); //skip header & msg id
-	replay_file.read((char *)_read_buffer.data(), msg_read_size);
+	//skip header & msg id (the message is known to be complete from the index)
+	memcpy(_read_buffer.data(), _ulog.get(sub.next_read_pos + ULOG_MSG_HEADER_LEN + 2, msg_read_size), msg_read_size);
 }
 
 bool
-Replay::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+Replay::handleTopicUpdate(Subscription &sub, void *data)
 {
 	return publishTopic(sub, data);
 }
@@ -1196,9 +1170,7 @@ Replay::applyParams(bool quiet)
 		return -ENOMEM;
 	}
 
-	ifstream replay_file(_replay_file, ios::in | ios::binary);
-
-	if (!r->readDefinitionsAndApplyParams(replay_file)) {
+	if (!r->readDefinitionsAndApplyParams()) {
 		ret = -1;
 	}
 
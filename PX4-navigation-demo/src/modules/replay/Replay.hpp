@@ -34,13 +34,15 @@
 #pragma once
 
 #include <algorithm>
-#include <fstream>
+#include <functional>
 #include <map>
+#include <queue>
 #include <vector>
 #include <set>
 #include <string>
 
 #include "definitions.hpp"
+#include "ULogFile.hpp"
 
 #include <px4_platform_common/module.h>
 #include <uORB/topics/uORBTopics.hpp>
@@ -51,9 +53,10 @@ namespace px4
 /**
  * @class Replay
  * Parses an ULog file and replays it in 'real-time'. The timestamp of each replayed message is offset
- * to match the starting time of replay. It keeps a stream for each subscription to find the next message
- * to replay. This is necessary because data messages from different subscriptions don't need to be in
- * monotonic increasing order.
+ * to match the starting time of replay. The file is memory-mapped and the data section is indexed once,
+ * storing the offsets of the data messages per msg_id. Each subscription then keeps an index into its
+ * offsets, and a heap merges the subscriptions by timestamp. This is necessary because data messages
+ * from different subscriptions don't need to be in monotonic increasing order.
  */
 class Replay : public ModuleBase<Replay>
 {
@@ -134,7 +137,8 @@ protected:
 
 		bool ignored = false; ///< if true, it will not be considered for publication in the main loop
 
-		std::streampos next_read_pos;
+		uint64_t next_read_pos; ///< file offset of the next data message
+		size_t next_index; ///< index of the next data message into the offsets for this msg_id
 		uint64_t next_timestamp; ///< timestamp of the file
 
 		CompatBase *compat = nullptr;
@@ -191,21 +195,19 @@ protected:
 	 * handle the publication of a topic update
 	 * @return true if published, false otherwise
 	 */
-	virtual bool handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file);
+	virtual bool handleTopicUpdate(Subscription &sub, void *data);
 
 	/**
 	 * read a topic from the file (offset given by the subscription) into _read_buffer
 	 */
-	void readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file);
+	void readTopicDataToBuffer(const Subscription &sub);
 
 	/**
-	 * Find next data message for this subscription, starting with the stored file offset.
-	 * Skip the first message, and if found, read the timestamp and store the new file offset.
-	 * When reaching EOF, the subscription is set to invalid.
-	 * File seek position is arbitrary after this call.
-	 * @return false on file error
+	 * Find next data message for this subscription, starting after the stored one.
+	 * If found, read the timestamp and store the new file offset.
+	 * When reaching the end of the data, the subscription is set to invalid.
 	 */
-	bool nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id);
+	void nextDataMessage(Subscription &subscription, int msg_id);
 
 	virtual uint64_t getTimestampOffset()
 	{
@@ -242,47 +244,83 @@ private:
 
 	uint64_t _file_start_time;
 	uint64_t _replay_start_time;
-	std::streampos _data_section_start; ///< first ADD_LOGGED_MSG message
+	uint64_t _data_section_start; ///< first ADD_LOGGED_MSG message
 
-	/** keep track of file position to avoid adding a subscription multiple times. */
-	std::streampos _subscription_file_pos = 0;
-
-	int64_t _read_until_file_position = 1ULL << 60; ///< read limit if log contains appended data
+	uint64_t _read_until_file_position = 1ULL << 60; ///< read limit if log contains appended data
 
 	float _accumulated_delay{0.f};
 
-	bool readFileHeader(std::ifstream &file);
+	ULogFile _ulog;
+
+	std::vector<std::vector<uint64_t>> _data_message_offsets; ///< file offsets of all data messages, per msg_id
+	std::vector<uint64_t> _additional_message_offsets; ///< file offsets of parameter and dropout messages
+	size_t _next_additional_message{0};
+
+	struct NextMessage {
+		uint64_t timestamp;
+		uint64_t read_pos;
+		uint16_t msg_id;
+
+		// order by timestamp, then msg_id
+		bool operator>(const NextMessage &other) const
+		{
+			return timestamp > other.timestamp || (timestamp == other.timestamp && msg_id > other.msg_id);
+		}
+	};
+
+	/**
+	 * Next data message of each subscription that is replayed from the main loop. Entries for which
+	 * the subscription has advanced in the meantime are outdated and skipped.
+	 */
+	std::priority_queue<NextMessage, std::vector<NextMessage>, std::greater<NextMessage>> _next_messages;
+
+	bool readFileHeader();
 
 	/**
 	 * Read definitions section: check formats, apply parameters and store
 	 * the start of the data section.
 	 * @return true on success
 	 */
-	bool readFileDefinitions(std::ifstream &file);
+	bool readFileDefinitions();
 
 	///file parsing methods. They return false, when further parsing should be aborted.
-	bool readFormat(std::ifstream &file, uint16_t msg_size);
+	bool readFormat(const uint8_t *message, uint16_t msg_size);
 
 	enum class ReadAndAndAddSubResult : uint8_t { kSuccess, kIgnoringMsg, kFailure };
-	ReadAndAndAddSubResult readAndAddSubscription(std::ifstream &file, uint16_t msg_size);
-	bool readFlagBits(std::ifstream &file, uint16_t msg_size);
+	ReadAndAndAddSubResult readAndAddSubscription(uint64_t message_pos, uint16_t msg_size);
+	bool readFlagBits(const uint8_t *message, uint16_t msg_size);
 
 	/**
 	 * Read the file header and definitions sections. Apply the parameters from this section
 	 * and apply user-defined overridden parameters.
 	 * @return true on success
 	 */
-	bool readDefinitionsAndApplyParams(std::ifstream &file);
+	bool readDefinitionsAndApplyParams();
+
+	/**
+	 * Index the data section in a single pass: store the offsets of the data messages per msg_id,
+	 * of the additional messages, and of the ADD_LOGGED_MSG messages.
+	 */
+	void indexDataSection(std::vector<uint64_t> &add_logged_message_offsets);
+
+	/**
+	 * Find the first valid data message for this subscription, starting at index into the data message
+	 * offsets of msg_id. If found, read the timestamp and store the file offset, otherwise the subscription
+	 * is set to invalid.
+	 */
+	void findDataMessage(Subscription &subscription, int msg_id, size_t index);
+
+	/** push the next data message of a subscription onto the heap, if it is replayed from the main loop */
+	void scheduleNextMessage(const Subscription &subscription, uint16_t msg_id);
 
 	/**
-	 * Read and handle additional messages starting at current file position, while position < end_position.
+	 * Handle the additional messages located before end_position that are not handled yet.
 	 * This handles dropout and parameter update messages.
 	 * We need to handle these separately, because they have no timestamp. We look at the file position instead.
-	 * @return false on file error
 	 */
-	bool readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position);
-	bool readDropout(std::ifstream &file, uint16_t msg_size);
-	bool readAndApplyParameter(std::ifstream &file, uint16_t msg_size);
+	void handleAdditionalMessages(uint64_t end_position);
+	bool readDropout(const uint8_t *message, uint16_t msg_size);
+	bool readAndApplyParameter(const uint8_t *message, uint16_t msg_size);
 
 	static const orb_metadata *findTopic(const std::string &name);
 
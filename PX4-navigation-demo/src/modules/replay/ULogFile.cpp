@@ -0,0 +1,326 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "ULogFile.hpp"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <px4_platform_common/log.h>
+
+#define HEATSHRINK_DYNAMIC_ALLOC 0
+#include <lib/heatshrink/heatshrink/heatshrink_decoder.h>
+
+namespace px4
+{
+
+bool
+ULogFile::open(const char *file_name)
+{
+	close();
+
+	int fd = ::open(file_name, O_RDONLY);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat file_stat;
+
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+
+	void *data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping stays valid after closing the descriptor
+	::close(fd);
+
+	if (data == MAP_FAILED) {
+		return false;
+	}
+
+	_file = (const uint8_t *)data;
+	_file_size = file_stat.st_size;
+	_size = _file_size;
+
+	static constexpr uint8_t compressed_magic[] = {'U', 'L', 'o', 'g', 'C', 'm', 'p'};
+
+	if (_file_size >= sizeof(ulog_compressed_header_s) &&
+	    memcmp(_file, compressed_magic, sizeof(compressed_magic)) == 0) {
+		if (!indexFrames()) {
+			close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void
+ULogFile::close()
+{
+	if (_file) {
+		munmap((void *)_file, _file_size);
+		_file = nullptr;
+		_file_size = 0;
+		_size = 0;
+	}
+
+	free(_frames);
+	_frames = nullptr;
+	_num_frames = 0;
+	_max_frame_size = 0;
+
+	for (CachedFrame &cached : _cache) {
+		free(cached.data);
+		cached = CachedFrame{};
+	}
+
+	_cache_use_count = 0;
+
+	free(_span);
+	_span = nullptr;
+	_span_size = 0;
+}
+
+bool
+ULogFile::indexFrames()
+{
+	ulog_compressed_header_s header;
+	memcpy(&header, _file, sizeof(header));
+
+	if (header.hdr_ver != 1 || header.window_bits != HEATSHRINK_STATIC_WINDOW_BITS ||
+	    header.lookahead_bits != HEATSHRINK_STATIC_LOOKAHEAD_BITS) {
+		PX4_ERR("unsupported compressed log (version %i, window %i, lookahead %i)", header.hdr_ver, header.window_bits,
+			header.lookahead_bits);
+		return false;
+	}
+
+	// count the frames first, a truncated last frame (e.g. after a power loss) is ignored
+	uint64_t num_frames = 0;
+	uint64_t offset = sizeof(header);
+	ulog_compressed_frame_s frame;
+
+	while (offset + sizeof(frame) <= _file_size) {
+		memcpy(&frame, &_file[offset], sizeof(frame));
+
+		if (frame.compressed_size > _file_size - offset - sizeof(frame)) {
+			break;
+		}
+
+		if (frame.uncompressed_size > 0) {
+			++num_frames;
+		}
+
+		offset += sizeof(frame) + frame.compressed_size;
+	}
+
+	_frames = (Frame *)malloc(num_frames * sizeof(Frame));
+
+	if (num_frames == 0 || _frames == nullptr) {
+		return false;
+	}
+
+	uint64_t data_offset = 0;
+	offset = sizeof(header);
+
+	for (uint64_t i = 0; i < num_frames; offset += sizeof(frame) + frame.compressed_size) {
+		memcpy(&frame, &_file[offset], sizeof(frame));
+
+		if (frame.uncompressed_size > 0) {
+			_frames[i++] = Frame{data_offset, offset + sizeof(frame), frame.compressed_size, frame.uncompressed_size};
+			data_offset += frame.uncompressed_size;
+
+			if (frame.uncompressed_size > _max_frame_size) {
+				_max_frame_size = frame.uncompressed_size;
+			}
+		}
+	}
+
+	_num_frames = num_frames;
+	_size = data_offset;
+
+	for (CachedFrame &cached : _cache) {
+		cached.data = (uint8_t *)malloc(_max_frame_size);
+
+		if (cached.data == nullptr) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const uint8_t *
+ULogFile::getDecompressed(uint64_t offset, uint64_t length)
+{
+	// last frame starting at or before offset (offset == _size ends up in the last frame)
+	uint64_t first = 0;
+	uint64_t last = _num_frames - 1;
+
+	while (first < last) {
+		const uint64_t middle = (first + last + 1) / 2;
+
+		if (_frames[middle].data_offset <= offset) {
+			first = middle;
+
+		} else {
+			last = middle - 1;
+		}
+	}
+
+	const Frame &frame = _frames[first];
+	const uint64_t frame_offset = offset - frame.data_offset;
+
+	if (frame_offset + length <= frame.uncompressed_size) {
+		const uint8_t *data = frameData(first);
+		return data ? data + frame_offset : nullptr;
+	}
+
+	// the range continues in the next frames
+	if (length > _span_size) {
+		uint8_t *span = (uint8_t *)realloc(_span, length);
+
+		if (span == nullptr) {
+			return nullptr;
+		}
+
+		_span = span;
+		_span_size = length;
+	}
+
+	uint64_t copied = 0;
+
+	for (uint64_t i = first; copied < length; ++i) {
+		const uint8_t *data = frameData(i);
+
+		if (data == nullptr) {
+			return nullptr;
+		}
+
+		const uint64_t start = (i == first) ? frame_offset : 0;
+		uint64_t n = _frames[i].uncompressed_size - start;
+
+		if (n > length - copied) {
+			n = length - copied;
+		}
+
+		memcpy(&_span[copied], &data[start], n);
+		copied += n;
+	}
+
+	return _span;
+}
+
+const uint8_t *
+ULogFile::frameData(uint64_t frame_index)
+{
+	CachedFrame *cached = &_cache[0];
+
+	for (CachedFrame &entry : _cache) {
+		if (entry.frame == (int64_t)frame_index) {
+			entry.last_used = ++_cache_use_count;
+			return entry.data;
+		}
+
+		if (entry.last_used < cached->last_used) {
+			cached = &entry;
+		}
+	}
+
+	const Frame &frame = _frames[frame_index];
+	const uint8_t *input = &_file[frame.file_offset];
+	uint8_t *output = cached->data;
+	cached->frame = -1;
+
+	if (frame.compressed_size == frame.uncompressed_size) {
+		// stored uncompressed
+		memcpy(output, input, frame.uncompressed_size);
+
+	} else {
+		heatshrink_decoder decoder;
+		heatshrink_decoder_reset(&decoder);
+		size_t input_used = 0;
+		size_t output_used = 0;
+		bool success = true;
+
+		while (success && (input_used < frame.compressed_size || heatshrink_decoder_finish(&decoder) == HSDR_FINISH_MORE)) {
+			size_t sunk = 0;
+
+			if (input_used < frame.compressed_size) {
+				success = heatshrink_decoder_sink(&decoder, (uint8_t *)&input[input_used], frame.compressed_size - input_used,
+								  &sunk) >= 0;
+				input_used += sunk;
+			}
+
+			size_t polled = 0;
+			const HSD_poll_res res = heatshrink_decoder_poll(&decoder, &output[output_used],
+						 frame.uncompressed_size - output_used, &polled);
+			output_used += polled;
+
+			// no progress means the frame decodes to more than its uncompressed size
+			success = success && res >= 0 && (sunk > 0 || polled > 0);
+		}
+
+		if (!success || output_used != frame.uncompressed_size) {
+			PX4_ERR("corrupt frame in compressed log at offset %llu",
+				(unsigned long long)(frame.file_offset - sizeof(ulog_compressed_frame_s)));
+			return nullptr;
+		}
+	}
+
+	cached->frame = frame_index;
+	cached->last_used = ++_cache_use_count;
+	return output;
+}
+
+const uint8_t *
+ULogFile::message(uint64_t offset, ulog_message_header_s &header)
+{
+	const uint8_t *header_data = get(offset, ULOG_MSG_HEADER_LEN);
+
+	if (!header_data) {
+		return nullptr;
+	}
+
+	memcpy(&header, header_data, ULOG_MSG_HEADER_LEN);
+	return get(offset + ULOG_MSG_HEADER_LEN, header.msg_size);
+}
+
+} // namespace px4
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <logger/messages.h>
+
+namespace px4
+{
+
+/**
+ * @class ULogFile
+ * Read-only memory mapping of an ULog file. Messages are accessed by file offset, so
+ * replaying many interleaved subscriptions does not need any seeking or copying.
+ * Compressed log files (@see ulog_compressed_header_s) stay mapped as well, their frames are decompressed on
+ * access into a small cache of the most recently used frames.
+ */
+class ULogFile
+{
+public:
+	ULogFile() = default;
+	~ULogFile() { close(); }
+
+	ULogFile(const ULogFile &) = delete;
+	ULogFile &operator=(const ULogFile &) = delete;
+
+	/**
+	 * Map a file and index the frames if it is compressed (closes a previously mapped one)
+	 * @return true on success
+	 */
+	bool open(const char *file_name);
+
+	void close();
+
+	bool isOpen() const { return _file != nullptr; }
+
+	uint64_t size() const { return _size; }
+
+	/**
+	 * Get a range of the file (offsets of a compressed file refer to the decompressed ULog data)
+	 * @return pointer to length bytes at offset, or nullptr if the range is not within the file. For a compressed
+	 *         file it is only valid until the next call.
+	 */
+	const uint8_t *get(uint64_t offset, uint64_t length)
+	{
+		if (offset > _size || length > _size - offset) {
+			return nullptr;
+		}
+
+		if (_frames == nullptr) {
+			return _file + offset;
+		}
+
+		return getDecompressed(offset, length);
+	}
+
+	/**
+	 * Get the message at a file offset
+	 * @param header returned message header
+	 * @return pointer to the message (header.msg_size bytes following the header), or nullptr if it is not
+	 *         entirely within the file. For a compressed file it is only valid until the next call.
+	 */
+	const uint8_t *message(uint64_t offset, ulog_message_header_s &header);
+
+private:
+	struct Frame {
+		uint64_t data_offset;		///< offset of the frame in the decompressed data
+		uint64_t file_offset;		///< offset of the frame content in the file
+		uint16_t compressed_size;
+		uint16_t uncompressed_size;
+	};
+
+	struct CachedFrame {
+		int64_t frame{-1};		///< index in _frames, -1 if unused
+		uint32_t last_used{0};
+		uint8_t *data{nullptr};		///< _max_frame_size bytes
+	};
+
+	static constexpr int CACHED_FRAMES = 8;
+
+	/**
+	 * Index the frames of a compressed log file and allocate the frame cache
+	 * @return true on success
+	 */
+	bool indexFrames();
+
+	const uint8_t *getDecompressed(uint64_t offset, uint64_t length);
+
+	/**
+	 * Get a frame from the cache, decompressing it into the least recently used entry if needed
+	 * @return decompressed frame, nullptr if it is corrupt
+	 */
+	const uint8_t *frameData(uint64_t frame);
+
+	const uint8_t *_file{nullptr}; ///< mapped file
+	uint64_t _file_size{0};
+	uint64_t _size{0}; ///< size of the (decompressed) ULog data
+
+	Frame *_frames{nullptr}; ///< index of a compressed file, nullptr if the file is not compressed
+	uint64_t _num_frames{0};
+	uint16_t _max_frame_size{0};
+	CachedFrame _cache[CACHED_FRAMES] {};
+	uint32_t _cache_use_count{0};
+
+	uint8_t *_span{nullptr}; ///< a range spanning multiple frames is copied here
+	uint64_t _span_size{0};
+};
+
+} // namespace px4
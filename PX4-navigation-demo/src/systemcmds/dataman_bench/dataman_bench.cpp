@@ -0,0 +1,234 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file dataman_bench.cpp
+ *
+ * Dataman mission upload benchmarking
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+
+#include <drivers/drv_hrt.h>
+#include <dataman_client/DatamanClient.hpp>
+
+/** Number of items per range request, as used by the MAVLink mission upload */
+static constexpr uint32_t RANGE_ITEMS = 8;
+
+enum class UploadMode {
+	Item,		///< one synchronous write per item
+	Range,		///< range writes of RANGE_ITEMS items
+	Transaction	///< range writes in a transaction, committed once at the end
+};
+
+static const char *const MODE_NAMES[] = {"item", "range", "transaction"};
+
+static void usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+Measure how long a mission upload takes to be stored by dataman, for each way of writing it:
+one write per item, range writes and range writes in a transaction.
+
+The items are written to the inactive mission storage, which is overwritten by the next mission upload anyway.
+Do not run it while a mission is being uploaded.
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("dataman_bench", "command");
+	PRINT_MODULE_USAGE_PARAM_INT('n', 100, 1, DM_KEY_WAYPOINTS_OFFBOARD_0_MAX, "Number of mission items per upload", true);
+	PRINT_MODULE_USAGE_PARAM_INT('r', 5, 1, 1000, "Number of runs", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('v', "Verify the uploaded items", true);
+}
+
+static bool upload(DatamanClient &client, UploadMode mode, dm_item_t item, uint32_t num_items, uint8_t *items)
+{
+	const uint32_t item_size = g_per_item_size[item];
+
+	if ((mode == UploadMode::Transaction) && !client.beginTransaction()) {
+		return false;
+	}
+
+	for (uint32_t index = 0; index < num_items;) {
+		bool success;
+		uint32_t count = 1;
+
+		if (mode == UploadMode::Item) {
+			success = client.writeSync(item, index, &items[index * item_size], item_size);
+
+		} else {
+			count = (num_items - index < RANGE_ITEMS) ? num_items - index : RANGE_ITEMS;
+			success = client.writeRange(item, index, count, &items[index * item_size], item_size);
+		}
+
+		if (!success) {
+			return false;
+		}
+
+		index += count;
+	}
+
+	return (mode != UploadMode::Transaction) || client.commitTransaction();
+}
+
+static bool verify(DatamanClient &client, dm_item_t item, uint32_t num_items, const uint8_t *items)
+{
+	const uint32_t item_size = g_per_item_size[item];
+	uint8_t *buffer = (uint8_t *)malloc(RANGE_ITEMS * item_size);
+
+	if (!buffer) {
+		PX4_ERR("Failed to allocate the verification buffer");
+		return false;
+	}
+
+	bool success = true;
+
+	for (uint32_t index = 0; success && (index < num_items); index += RANGE_ITEMS) {
+		const uint32_t count = (num_items - index < RANGE_ITEMS) ? num_items - index : RANGE_ITEMS;
+
+		if (!client.readRange(item, index, count, buffer, item_size)
+		    || (memcmp(buffer, &items[index * item_size], count * item_size) != 0)) {
+			PX4_ERR("verification failed at index %" PRIu32, index);
+			success = false;
+		}
+	}
+
+	free(buffer);
+
+	return success;
+}
+
+extern "C" __EXPORT int dataman_bench_main(int argc, char *argv[])
+{
+	uint32_t num_items = 100;
+	int num_runs = 5;
+	bool verify_items = false;
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "n:r:v", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'n':
+			num_items = strtoul(myoptarg, nullptr, 0);
+			break;
+
+		case 'r':
+			num_runs = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 'v':
+			verify_items = true;
+			break;
+
+		default:
+			usage();
+			return -1;
+		}
+	}
+
+	if (num_items == 0 || num_items > DM_KEY_WAYPOINTS_OFFBOARD_0_MAX || num_runs <= 0) {
+		PX4_ERR("invalid argument");
+		return -1;
+	}
+
+	DatamanClient client{};
+
+	mission_s mission{};
+
+	if (!client.readSync(DM_KEY_MISSION_STATE, 0, reinterpret_cast<uint8_t *>(&mission), sizeof(mission_s))) {
+		PX4_ERR("Can't read the mission state");
+		return -1;
+	}
+
+	const dm_item_t item = (mission.mission_dataman_id == DM_KEY_WAYPOINTS_OFFBOARD_0) ? DM_KEY_WAYPOINTS_OFFBOARD_1 :
+			       DM_KEY_WAYPOINTS_OFFBOARD_0;
+	const uint32_t item_size = g_per_item_size[item];
+
+	uint8_t *items = (uint8_t *)malloc(num_items * item_size);
+
+	if (!items) {
+		PX4_ERR("Failed to allocate the mission items");
+		return -1;
+	}
+
+	PX4_INFO("Uploading %" PRIu32 " items of %" PRIu32 " bytes to storage %i, %i runs", num_items, item_size, (int)item,
+		 num_runs);
+
+	int ret = 0;
+
+	for (int mode = 0; mode <= (int)UploadMode::Transaction; ++mode) {
+		hrt_abstime total_time = 0;
+		hrt_abstime max_time = 0;
+
+		for (int run = 0; run < num_runs; ++run) {
+			for (uint32_t i = 0; i < num_items * item_size; ++i) {
+				items[i] = (uint8_t)(i + run + mode);
+			}
+
+			const hrt_abstime start = hrt_absolute_time();
+
+			if (!upload(client, (UploadMode)mode, item, num_items, items)) {
+				PX4_ERR("%s upload failed", MODE_NAMES[mode]);
+				ret = -1;
+				break;
+			}
+
+			const hrt_abstime elapsed = hrt_elapsed_time(&start);
+			total_time += elapsed;
+			max_time = (elapsed > max_time) ? elapsed : max_time;
+
+			if (verify_items && !verify(client, item, num_items, items)) {
+				ret = -1;
+				break;
+			}
+		}
+
+		if (ret != 0) {
+			break;
+		}
+
+		const double avg_ms = total_time / 1e3 / num_runs;
+		PX4_INFO("%-12s avg %8.1f ms, max %8.1f ms, %8.1f items/s", MODE_NAMES[mode], avg_ms, max_time / 1e3,
+			 num_items / (avg_ms / 1e3));
+	}
+
+	free(items);
+
+	return ret;
+}
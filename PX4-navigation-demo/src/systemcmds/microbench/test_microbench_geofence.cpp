@@ -0,0 +1,257 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_microbench_geofence.cpp
+ * Microbenchmark of geofence point checks: compiled GeofenceIndex vs. per-edge item lookups.
+ */
+
+#include <unit_test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/geofence/GeofenceIndex.hpp>
+
+namespace MicroBenchGeofence
+{
+
+// no critical section here: the item lookup path of large fences runs for milliseconds
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			next_point(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		perf_free(p); \
+	} while (0)
+
+static constexpr double kRefLat = 47.397742;
+static constexpr double kRefLon = 8.545594;
+
+/**
+ * Stand-in for the dataman cache the navigator geofence used to query for every polygon edge:
+ * a cache hit is a linear search over the cached items followed by a copy of the item.
+ */
+class FenceItemCache
+{
+public:
+	struct Item {
+		uint32_t index;
+		uint8_t data[56]; // size of a dataman item
+	};
+
+	struct FencePoint {
+		double lat;
+		double lon;
+	};
+
+	~FenceItemCache() { delete[] _items; }
+
+	bool resize(int num_items)
+	{
+		delete[] _items;
+		_items = new Item[num_items];
+		_num_items = (_items != nullptr) ? num_items : 0;
+		return _items != nullptr;
+	}
+
+	void store(int index, const FencePoint &point)
+	{
+		_items[index].index = index;
+		memcpy(_items[index].data, &point, sizeof(point));
+	}
+
+	bool loadWait(uint32_t index, FencePoint &point) const
+	{
+		for (int i = 0; i < _num_items; ++i) {
+			if (_items[i].index == index) {
+				memcpy(&point, _items[i].data, sizeof(point));
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool insidePolygon(double lat, double lon) const
+	{
+		FencePoint vertex_i;
+		FencePoint vertex_j;
+		bool c = false;
+
+		for (int i = 0, j = _num_items - 1; i < _num_items; j = i++) {
+			if (!loadWait(i, vertex_i) || !loadWait(j, vertex_j)) {
+				break;
+			}
+
+			if ((vertex_i.lon >= lon) != (vertex_j.lon >= lon) &&
+			    (lat <= (vertex_j.lat - vertex_i.lat) * (lon - vertex_i.lon) / (vertex_j.lon - vertex_i.lon) + vertex_i.lat)) {
+				c = !c;
+			}
+		}
+
+		return c;
+	}
+
+private:
+	Item *_items{nullptr};
+	int _num_items{0};
+};
+
+class MicroBenchGeofence : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_geofence_10();
+	bool time_geofence_100();
+	bool time_geofence_1000();
+
+	bool time_geofence(int num_vertices, int count);
+	bool build(int num_vertices);
+	void next_point();
+
+	MapProjection _proj{kRefLat, kRefLon};
+	FenceItemCache _cache;
+	GeofenceIndex _index;
+
+	double _lat{kRefLat};
+	double _lon{kRefLon};
+};
+
+bool MicroBenchGeofence::run_tests()
+{
+	ut_run_test(time_geofence_10);
+	ut_run_test(time_geofence_100);
+	ut_run_test(time_geofence_1000);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchGeofence::next_point()
+{
+	// random test point within a 3km x 3km square around the fence
+	const float x = (rand() / (float)RAND_MAX - 0.5f) * 3000.f;
+	const float y = (rand() / (float)RAND_MAX - 0.5f) * 3000.f;
+	_proj.reproject(x, y, _lat, _lon);
+}
+
+bool MicroBenchGeofence::build(int num_vertices)
+{
+	if (!_cache.resize(num_vertices)) {
+		return false;
+	}
+
+	_index.reset(kRefLat, kRefLon);
+
+	if (!_index.beginPolygon(GeofenceIndex::ShapeType::PolygonInclusion)) {
+		return false;
+	}
+
+	// non-convex survey-like polygon with a radius between 700m and 1300m
+	for (int i = 0; i < num_vertices; ++i) {
+		const float angle = 2.f * M_PI_F * i / num_vertices;
+		const float radius = 1000.f + 300.f * sinf(5.f * angle);
+
+		FenceItemCache::FencePoint point;
+		_proj.reproject(radius * cosf(angle), radius * sinf(angle), point.lat, point.lon);
+		_cache.store(i, point);
+
+		if (!_index.addVertex(point.lat, point.lon)) {
+			return false;
+		}
+	}
+
+	return _index.endPolygon();
+}
+
+bool MicroBenchGeofence::time_geofence(int num_vertices, int count)
+{
+	ut_assert_true(build(num_vertices));
+
+	int mismatches = 0;
+
+	for (int i = 0; i < 1000; ++i) {
+		next_point();
+
+		if (_cache.insidePolygon(_lat, _lon) != _index.checkAll(_lat, _lon)) {
+			++mismatches;
+		}
+	}
+
+	// both paths work on different coordinates (lat/lon vs. local frame), allow for points on the edges
+	ut_less_than("index and item lookup results differ", mismatches, 5);
+
+	bool inside = false;
+	char name[64];
+
+	snprintf(name, sizeof(name), "geofence %i vertices: item lookups", num_vertices);
+	PERF(name, inside = _cache.insidePolygon(_lat, _lon), count);
+
+	snprintf(name, sizeof(name), "geofence %i vertices: compiled index", num_vertices);
+	PERF(name, inside = _index.checkAll(_lat, _lon), count);
+
+	return true;
+}
+
+bool MicroBenchGeofence::time_geofence_10()
+{
+	return time_geofence(10, 100);
+}
+
+bool MicroBenchGeofence::time_geofence_100()
+{
+	return time_geofence(100, 100);
+}
+
+bool MicroBenchGeofence::time_geofence_1000()
+{
+	return time_geofence(1000, 20);
+}
+
+ut_declare_test_c(test_microbench_geofence, MicroBenchGeofence)
+
+} // namespace MicroBenchGeofence
@@ -47,12 +47,16 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
 
+#include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/sensor_accel.h>
 #include <uORB/topics/sensor_gyro.h>
 #include <uORB/topics/sensor_gyro_fifo.h>
 #include <uORB/topics/vehicle_local_position.h>
 #include <uORB/topics/failsafe_flags.h>
+#include <uORB/topics/orb_test_medium.h>
+#include <uORB/topics/orb_test_large.h>
 
 namespace MicroBenchORB
 {
@@ -102,6 +106,8 @@ private:
 
 	bool time_px4_uorb();
 	bool time_px4_uorb_direct();
+	bool time_px4_uorb_subscribers();
+	bool time_px4_uorb_loan();
 
 	void reset();
 
@@ -109,12 +115,26 @@ private:
 	vehicle_local_position_s lpos;
 	sensor_gyro_s gyro;
 	sensor_gyro_fifo_s gyro_fifo;
+	orb_test_medium_s test_medium;
+	orb_test_large_s test_large;
+};
+
+class CountingCallback : public uORB::SubscriptionCallback
+{
+public:
+	CountingCallback() : uORB::SubscriptionCallback(ORB_ID(orb_test_medium)) {}
+
+	void call() override { calls++; }
+
+	unsigned calls{0};
 };
 
 bool MicroBenchORB::run_tests()
 {
 	ut_run_test(time_px4_uorb);
 	ut_run_test(time_px4_uorb_direct);
+	ut_run_test(time_px4_uorb_subscribers);
+	ut_run_test(time_px4_uorb_loan);
 
 	return (_tests_failed == 0);
 }
@@ -140,6 +160,12 @@ void MicroBenchORB::reset()
 	gyro.timestamp = rand();
 
 	gyro_fifo.timestamp = rand();
+
+	test_medium.timestamp = rand();
+	test_medium.val = rand();
+
+	test_large.timestamp = rand();
+	test_large.val = rand();
 }
 
 ut_declare_test_c(test_microbench_uorb, MicroBenchORB)
@@ -246,4 +272,80 @@ bool MicroBenchORB::time_px4_uorb_direct()
 	return true;
 }
 
+bool MicroBenchORB::time_px4_uorb_subscribers()
+{
+	static constexpr int MAX_SUBSCRIBERS = 8;
+
+	uORB::Publication<orb_test_medium_s> test_medium_pub{ORB_ID(orb_test_medium)};
+	test_medium_pub.publish(test_medium);
+
+	uORB::Subscription test_medium_subs[MAX_SUBSCRIBERS] {
+		{ORB_ID(orb_test_medium)}, {ORB_ID(orb_test_medium)}, {ORB_ID(orb_test_medium)}, {ORB_ID(orb_test_medium)},
+		{ORB_ID(orb_test_medium)}, {ORB_ID(orb_test_medium)}, {ORB_ID(orb_test_medium)}, {ORB_ID(orb_test_medium)},
+	};
+	CountingCallback callbacks[MAX_SUBSCRIBERS];
+	bool ret = false;
+	char name[80];
+
+	// publish and copy latency while the number of subscribers (each with a registered callback) grows
+	for (int num_subscribers = 0; num_subscribers <= MAX_SUBSCRIBERS; num_subscribers = (num_subscribers == 0) ? 1 : num_subscribers * 2) {
+		for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
+			if (i < num_subscribers) {
+				test_medium_subs[i].subscribe();
+				callbacks[i].registerCallback();
+
+			} else {
+				callbacks[i].unregisterCallback();
+			}
+		}
+
+		printf("\n");
+
+		snprintf(name, sizeof(name), "uORB::Publication publish orb_test_medium, %d subscribers", num_subscribers);
+		PERF(name, ret = test_medium_pub.publish(test_medium), 100);
+
+		if (num_subscribers > 0) {
+			snprintf(name, sizeof(name), "uORB::Subscription copy orb_test_medium, %d subscribers", num_subscribers);
+			PERF(name, ret = test_medium_subs[0].copy(&test_medium), 100);
+		}
+	}
+
+	for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
+		callbacks[i].unregisterCallback();
+	}
+
+	return true;
+}
+
+bool MicroBenchORB::time_px4_uorb_loan()
+{
+	uORB::Publication<orb_test_large_s> test_large_pub{ORB_ID(orb_test_large)};
+	uORB::Subscription test_large_sub{ORB_ID(orb_test_large)};
+	uORB::BorrowedMessage msg{};
+	uint64_t timestamp = 0;
+	bool ret = false;
+
+	test_large_pub.publish(test_large);
+
+	if (test_large_pub.loan() == nullptr) {
+		PX4_INFO("uORB loan not supported");
+		return true;
+	}
+
+	test_large_pub.commit();
+
+	// one message from publisher to subscriber, the loaned struct gets the fields reset() changes
+	printf("\n");
+	PERF("uORB publish & update orb_test_large",
+	     test_large_pub.publish(test_large); ret = test_large_sub.update(&test_large), 1000);
+
+	PERF("uORB loan & borrow orb_test_large",
+	     orb_test_large_s *loaned = test_large_pub.loan();
+	     loaned->timestamp = test_large.timestamp; loaned->val = test_large.val; test_large_pub.commit();
+	     ret = test_large_sub.borrow(msg); timestamp = static_cast<const orb_test_large_s *>(msg.data)->timestamp;
+	     ret = test_large_sub.release(msg), 1000);
+
+	return true;
+}
+
 } // namespace MicroBenchORB
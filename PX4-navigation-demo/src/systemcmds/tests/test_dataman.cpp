@@ -76,6 +76,8 @@ private:
 	bool testSyncMutipleClients();
 	bool testSyncWriteReadAllItemsMaxSize();
 	bool testSyncClearAll();
+	bool testSyncRange();
+	bool testSyncTransaction();
 
 	//Async
 	bool testAsyncReadInvalidItem();
@@ -119,6 +121,10 @@ private:
 	uint16_t _max_index[DM_KEY_NUM_KEYS] {};
 
 	static constexpr uint32_t OVERFLOW_LENGTH = sizeof(_buffer_write) + 1;
+
+	static constexpr uint32_t RANGE_COUNT = 8;
+	uint8_t _range_buffer_read[RANGE_COUNT * DM_MAX_DATA_SIZE];
+	uint8_t _range_buffer_write[RANGE_COUNT * DM_MAX_DATA_SIZE];
 };
 
 DatamanTest::DatamanTest()
@@ -286,6 +292,129 @@ DatamanTest::testSyncClearAll()
 	return success;
 }
 
+bool
+DatamanTest::testSyncRange()
+{
+	const uint32_t start_index = 0x40;
+
+	// Prepare write buffer, each item filled with its index
+	for (uint32_t i = 0; i < RANGE_COUNT; ++i) {
+		memset(&_range_buffer_write[i * DM_MAX_DATA_SIZE], (uint8_t)(start_index + i), DM_MAX_DATA_SIZE);
+	}
+
+	bool success = _dataman_client1.writeRange(DM_KEY_WAYPOINTS_OFFBOARD_0, start_index, RANGE_COUNT, _range_buffer_write,
+			DM_MAX_DATA_SIZE);
+
+	if (!success) {
+		PX4_ERR("writeRange failed");
+		return false;
+	}
+
+	// Items written with a range request are readable with a single request
+	success = _dataman_client2.readSync(DM_KEY_WAYPOINTS_OFFBOARD_0, start_index + RANGE_COUNT - 1, _buffer_read,
+					    sizeof(_buffer_read));
+
+	if (!success || memcmp(_buffer_read, &_range_buffer_write[(RANGE_COUNT - 1) * DM_MAX_DATA_SIZE],
+			       DM_MAX_DATA_SIZE) != 0) {
+		PX4_ERR("readSync of range item failed");
+		return false;
+	}
+
+	success = _dataman_client1.readRange(DM_KEY_WAYPOINTS_OFFBOARD_0, start_index, RANGE_COUNT, _range_buffer_read,
+					     DM_MAX_DATA_SIZE);
+
+	if (!success || memcmp(_range_buffer_read, _range_buffer_write, sizeof(_range_buffer_write)) != 0) {
+		PX4_ERR("readRange failed");
+		return false;
+	}
+
+	// Clear the second half, the first half must be unchanged
+	success = _dataman_client1.clearRange(DM_KEY_WAYPOINTS_OFFBOARD_0, start_index + RANGE_COUNT / 2, RANGE_COUNT / 2);
+
+	if (!success) {
+		PX4_ERR("clearRange failed");
+		return false;
+	}
+
+	success = _dataman_client1.readRange(DM_KEY_WAYPOINTS_OFFBOARD_0, start_index, RANGE_COUNT, _range_buffer_read,
+					     DM_MAX_DATA_SIZE);
+
+	if (!success) {
+		PX4_ERR("readRange after clearRange failed");
+		return false;
+	}
+
+	for (uint32_t i = 0; i < sizeof(_range_buffer_read); ++i) {
+		const uint8_t expected_value = (i < sizeof(_range_buffer_read) / 2) ? _range_buffer_write[i] : 0;
+
+		if (_range_buffer_read[i] != expected_value) {
+			PX4_ERR("readRange after clearRange mismatch at byte %" PRIu32, i);
+			return false;
+		}
+	}
+
+	// Ranges exceeding the item size or length must be rejected
+	success = _dataman_client1.readRange(DM_KEY_WAYPOINTS_OFFBOARD_0, _max_index[DM_KEY_WAYPOINTS_OFFBOARD_0] - 1,
+					     RANGE_COUNT, _range_buffer_read, DM_MAX_DATA_SIZE);
+
+	if (success) {
+		PX4_ERR("readRange beyond max index succeeded");
+		return false;
+	}
+
+	// index + count wraps around
+	success = _dataman_client1.readRange(DM_KEY_WAYPOINTS_OFFBOARD_0, 1, UINT32_MAX, _range_buffer_read, DM_MAX_DATA_SIZE);
+
+	if (success) {
+		PX4_ERR("readRange with wrapping count succeeded");
+		return false;
+	}
+
+	success = _dataman_client1.writeRange(DM_KEY_WAYPOINTS_OFFBOARD_0, start_index, RANGE_COUNT, _range_buffer_write,
+					      OVERFLOW_LENGTH);
+
+	return !success;
+}
+
+bool
+DatamanTest::testSyncTransaction()
+{
+	bool success = _dataman_client1.beginTransaction();
+
+	if (!success) {
+		PX4_ERR("beginTransaction failed");
+		return false;
+	}
+
+	for (uint32_t index = 0; index < RANGE_COUNT; ++index) {
+		memset(_buffer_write, (uint8_t)(index + 0x10), sizeof(_buffer_write));
+		success = _dataman_client1.writeSync(DM_KEY_WAYPOINTS_OFFBOARD_1, index, _buffer_write, sizeof(_buffer_write));
+
+		if (!success) {
+			PX4_ERR("writeSync in transaction failed at index %" PRIu32, index);
+			return false;
+		}
+	}
+
+	// Writes of an open transaction are visible to all clients
+	success = _dataman_client2.readSync(DM_KEY_WAYPOINTS_OFFBOARD_1, RANGE_COUNT - 1, _buffer_read, sizeof(_buffer_read));
+
+	if (!success || memcmp(_buffer_read, _buffer_write, sizeof(_buffer_read)) != 0) {
+		PX4_ERR("readSync in transaction failed");
+		return false;
+	}
+
+	success = _dataman_client1.commitTransaction();
+
+	if (!success) {
+		PX4_ERR("commitTransaction failed");
+		return false;
+	}
+
+	// Committing without open transaction is allowed
+	return _dataman_client2.commitTransaction();
+}
+
 bool
 DatamanTest::testAsyncReadInvalidIndex()
 {
@@ -999,6 +1128,8 @@ bool DatamanTest::run_tests()
 	ut_run_test(testSyncMutipleClients);
 	ut_run_test(testSyncWriteReadAllItemsMaxSize);
 	ut_run_test(testSyncClearAll);
+	ut_run_test(testSyncRange);
+	ut_run_test(testSyncTransaction);
 
 	ut_run_test(testAsyncReadInvalidIndex);
 	ut_run_test(testAsyncWriteInvalidIndex);
@@ -78,6 +78,9 @@ usage()
 
 Command-line tool to show work queue status.
 
+For each work queue and WorkItem the status shows the wait latency (from being scheduled until it runs)
+and the run time as p50/p99/max in microseconds since the last status output.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("work_queue", "system");